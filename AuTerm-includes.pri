@@ -34,6 +34,15 @@ macx: DEFINES += "SKIPSERIALDETECT"
 # Uncomment to skip building MCUmgr plugin
 #DEFINES += "SKIPPLUGIN_MCUMGR"
 
+# Uncomment to skip building the headless MCUmgr command line tool (auterm-mcumgr)
+#DEFINES += "SKIPMCUMGR_CLI"
+
+# Uncomment to skip building the MCUmgr unit tests (run with "make check", requires qttestlib)
+#DEFINES += "SKIPMCUMGR_TESTS"
+
+# Uncomment to build the MCUmgr SMP device simulator (command line tool used for benchmarking and testing without hardware)
+#DEFINES += "MCUMGR_SIMULATOR"
+
 # Uncomment to skip building logger plugin
 #DEFINES += "SKIPPLUGIN_LOGGER"
 
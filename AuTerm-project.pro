@@ -11,6 +11,23 @@ SUBDIRS += \
             plugins/mcumgr
 
         AuTerm.depends += plugins/mcumgr
+
+        !contains(DEFINES, SKIPMCUMGR_CLI) {
+            SUBDIRS += \
+                plugins/mcumgr/cli
+        }
+
+        !contains(DEFINES, SKIPMCUMGR_TESTS) {
+            qtHaveModule(testlib) {
+                SUBDIRS += \
+                    plugins/mcumgr/tests
+            }
+        }
+
+        contains(DEFINES, MCUMGR_SIMULATOR) {
+            SUBDIRS += \
+                plugins/mcumgr/simulator
+        }
     }
 
     !contains(DEFINES, SKIPPLUGIN_LOGGER) {
@@ -48,12 +48,18 @@ RESOURCES += \
     SOURCES += \
         AutCodeEditor.cpp \
         AutHighlighter.cpp \
-        AutScripting.cpp
+        AutScripting.cpp \
+        AutStreamMatcher.cpp \
+        AutHeadlessRunner.cpp \
+        AutScriptProfile.cpp
 
     HEADERS += \
         AutCodeEditor.h \
         AutHighlighter.h \
-        AutScripting.h
+        AutScripting.h \
+        AutStreamMatcher.h \
+        AutHeadlessRunner.h \
+        AutScriptProfile.h
 
     FORMS += \
     AutScripting.ui
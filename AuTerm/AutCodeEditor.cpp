@@ -39,7 +39,8 @@ AutCodeEditor::AutCodeEditor(QWidget *parent) : QPlainTextEdit(parent)
     connect(this, SIGNAL(cursorPositionChanged()), this, SLOT(highlightCurrentLine()));
 
     //Set the margins for the viewport
-    setViewportMargins(IndicationAreaWidth, 0, 0, 0);
+    mintIndicationWidth = IndicationAreaWidth;
+    setViewportMargins(mintIndicationWidth, 0, 0, 0);
 
     //Run line highlighter at startup
     highlightCurrentLine();
@@ -78,7 +79,7 @@ void AutCodeEditor::resizeEvent(QResizeEvent *e)
     //Runs when code editor has been resized
     QPlainTextEdit::resizeEvent(e);
     QRect rectContents = contentsRect();
-    mwidIndicationArea->setGeometry(QRect(rectContents.left(), rectContents.top(), IndicationAreaWidth, rectContents.height()));
+    mwidIndicationArea->setGeometry(QRect(rectContents.left(), rectContents.top(), mintIndicationWidth, rectContents.height()));
 }
 
 void AutCodeEditor::highlightCurrentLine()
@@ -125,7 +126,7 @@ void AutCodeEditor::lineNumberAreaPaintEvent(QPaintEvent *event)
             if (mlistInvLines.contains(intBlockNumber))
             {
                 //Paint line as bad
-                pntPainter.drawEllipse(1, intTop+4, mwidIndicationArea->width()-3, fontMetrics().height()-7);
+                pntPainter.drawEllipse(1, intTop+4, IndicationAreaWidth-3, fontMetrics().height()-7);
             }
             else if (intBlockNumber == mintCLine)
             {
@@ -142,10 +143,18 @@ void AutCodeEditor::lineNumberAreaPaintEvent(QPaintEvent *event)
                     pntPainter.setPen(Qt::green);
                     pntPainter.setBrush(Qt::green);
                 }
-                pntPainter.drawEllipse(1, intTop+4, mwidIndicationArea->width()-3, fontMetrics().height()-7);
+                pntPainter.drawEllipse(1, intTop+4, IndicationAreaWidth-3, fontMetrics().height()-7);
                 pntPainter.setPen(Qt::red);
                 pntPainter.setBrush(Qt::red);
             }
+
+            if (mhashAnnotations.contains(intBlockNumber))
+            {
+                //Draw annotation to the right of the indicator
+                pntPainter.setPen(Qt::black);
+                pntPainter.drawText(IndicationAreaWidth, intTop, mintIndicationWidth-IndicationAreaWidth-AnnotationAreaPadding, fontMetrics().height(), Qt::AlignRight, mhashAnnotations.value(intBlockNumber));
+                pntPainter.setPen(Qt::red);
+            }
         }
 
         //Move to next text block (line)
@@ -196,6 +205,52 @@ void AutCodeEditor::SetExecutionLineStatus(bool bStatus)
     this->repaint();
 }
 
+void AutCodeEditor::SetLineAnnotations(const QHash<int, QString> &hashAnnotations)
+{
+    //Sets the text shown beside lines in the indication area and resizes it to fit
+    mhashAnnotations = hashAnnotations;
+    UpdateIndicationWidth();
+}
+
+void AutCodeEditor::ClearLineAnnotations()
+{
+    //Removes all line annotations
+    if (!mhashAnnotations.isEmpty())
+    {
+        mhashAnnotations.clear();
+        UpdateIndicationWidth();
+    }
+}
+
+int AutCodeEditor::IndicationWidth() const
+{
+    return mintIndicationWidth;
+}
+
+void AutCodeEditor::UpdateIndicationWidth()
+{
+    //Resizes the indication area to fit the widest annotation
+    int intWidest = 0;
+    QHash<int, QString>::const_iterator itAnnotation = mhashAnnotations.constBegin();
+
+    while (itAnnotation != mhashAnnotations.constEnd())
+    {
+        int intWidth = fontMetrics().horizontalAdvance(itAnnotation.value());
+        if (intWidth > intWidest)
+        {
+            intWidest = intWidth;
+        }
+
+        ++itAnnotation;
+    }
+
+    mintIndicationWidth = IndicationAreaWidth + (intWidest > 0 ? intWidest + AnnotationAreaPadding*2 : 0);
+    setViewportMargins(mintIndicationWidth, 0, 0, 0);
+    QRect rectContents = contentsRect();
+    mwidIndicationArea->setGeometry(QRect(rectContents.left(), rectContents.top(), mintIndicationWidth, rectContents.height()));
+    mwidIndicationArea->update();
+}
+
 /******************************************************************************/
 // END OF FILE
 /******************************************************************************/
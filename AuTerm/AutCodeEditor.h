@@ -34,6 +34,7 @@
 // Constants
 /******************************************************************************/
 const qint8 IndicationAreaWidth = 11;
+const qint8 AnnotationAreaPadding = 4; //Space (in pixels) either side of line annotations in the indication area
 
 /******************************************************************************/
 // Forward declaration of Class, Struct & Unions
@@ -61,6 +62,9 @@ public:
     void AddBadLine(unsigned int LineNumber);
     void SetExecutionLine(int LineNumber);
     void SetExecutionLineStatus(bool bStatus);
+    void SetLineAnnotations(const QHash<int, QString> &hashAnnotations);
+    void ClearLineAnnotations();
+    int IndicationWidth() const;
 
 protected:
     void resizeEvent(QResizeEvent *event) Q_DECL_OVERRIDE;
@@ -75,6 +79,9 @@ private:
     QList<unsigned int> mlistInvLines; //Contains a list of invalid lines
     int mintCLine; //Current execution line (if there is one)
     bool mbLineFail; //True if the current line is where the script failed or false if it is currently executing
+    QHash<int, QString> mhashAnnotations; //Text shown beside lines in the indication area (e.g. profiling times)
+    int mintIndicationWidth; //Current width of the indication area, including annotations
+    void UpdateIndicationWidth();
 };
 
 class LineNumberArea : public QWidget
@@ -87,7 +94,7 @@ public:
 
     QSize sizeHint() const Q_DECL_OVERRIDE
     {
-        return QSize(IndicationAreaWidth, 0);
+        return QSize(mceEditor->IndicationWidth(), 0);
     }
 
 protected:
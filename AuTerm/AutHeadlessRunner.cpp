@@ -0,0 +1,490 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module: AutHeadlessRunner.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "AutHeadlessRunner.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QXmlStreamWriter>
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+AutHeadlessRunner::AutHeadlessRunner(QObject *parent) : QObject(parent)
+{
+    scripting = new AutScripting();
+    report_junit = false;
+
+    connect(&serial_port, SIGNAL(readyRead()), this, SLOT(serial_read()));
+    connect(&serial_port, SIGNAL(bytesWritten(qint64)), this, SLOT(serial_bytes_written(qint64)));
+    connect(&serial_port, SIGNAL(errorOccurred(QSerialPort::SerialPortError)), this, SLOT(serial_error(QSerialPort::SerialPortError)));
+    connect(scripting, SIGNAL(SendData(QByteArray,bool,bool)), this, SLOT(script_send_data(QByteArray,bool,bool)));
+    connect(scripting, SIGNAL(ScriptStartRequest()), this, SLOT(script_start_request()));
+    connect(scripting, SIGNAL(ScriptFinished()), this, SLOT(script_finished()), Qt::QueuedConnection);
+}
+
+AutHeadlessRunner::~AutHeadlessRunner()
+{
+    if (serial_port.isOpen() == true)
+    {
+        serial_port.close();
+    }
+
+    delete scripting;
+}
+
+int AutHeadlessRunner::start(const QStringList &arguments)
+{
+    //Parses the arguments, opens the serial port and starts the script. Returns HeadlessStarted if the script is running, otherwise an exit code
+    QTextStream tsError(stderr);
+    QString port_name;
+    qint32 baud = HeadlessDefaultBaud;
+    QSerialPort::DataBits data_bits = QSerialPort::Data8;
+    QSerialPort::StopBits stop_bits = QSerialPort::OneStop;
+    QSerialPort::Parity parity = QSerialPort::NoParity;
+    QSerialPort::FlowControl flow_control = QSerialPort::NoFlowControl;
+    int repeats = 0;
+    int max_receive_time = HeadlessDefaultMaxReceiveTime;
+    int max_receive_buffer = HeadlessDefaultMaxReceiveBuffer;
+    bool wait_for_write = false;
+    bool report_format_set = false;
+    bool ok = true;
+    int i = 1;
+
+    while (i < arguments.length())
+    {
+        const QString &argument = arguments.at(i);
+        QString key = argument.section('=', 0, 0).toUpper();
+        QString value = argument.section('=', 1);
+
+        if (key == "PORT")
+        {
+            port_name = value;
+        }
+        else if (key == "BAUD")
+        {
+            baud = value.toInt(&ok);
+        }
+        else if (key == "STOP")
+        {
+            //Stop bits, 1 or 2
+            if (value == "1")
+            {
+                stop_bits = QSerialPort::OneStop;
+            }
+            else if (value == "2")
+            {
+                stop_bits = QSerialPort::TwoStop;
+            }
+            else
+            {
+                ok = false;
+            }
+        }
+        else if (key == "DATA")
+        {
+            //Data bits, 7 or 8
+            if (value == "7")
+            {
+                data_bits = QSerialPort::Data7;
+            }
+            else if (value == "8")
+            {
+                data_bits = QSerialPort::Data8;
+            }
+            else
+            {
+                ok = false;
+            }
+        }
+        else if (key == "PAR")
+        {
+            //Parity, 0 = none, 1 = odd, 2 = even
+            uint index = value.toUInt(&ok);
+            parity = (index == 1 ? QSerialPort::OddParity : (index == 2 ? QSerialPort::EvenParity : QSerialPort::NoParity));
+        }
+        else if (key == "FLOW")
+        {
+            //Flow control, 0 = none, 1 = hardware, 2 = software
+            uint index = value.toUInt(&ok);
+            flow_control = (index == 1 ? QSerialPort::HardwareControl : (index == 2 ? QSerialPort::SoftwareControl : QSerialPort::NoFlowControl));
+        }
+        else if (key == "SCRIPTFILE")
+        {
+            script_filename = value;
+        }
+        else if (key == "REPORT")
+        {
+            report_filename = value;
+        }
+        else if (key == "REPORTFORMAT")
+        {
+            if (value.toUpper() == "JUNIT")
+            {
+                report_junit = true;
+            }
+            else if (value.toUpper() == "JSON")
+            {
+                report_junit = false;
+            }
+            else
+            {
+                ok = false;
+            }
+
+            report_format_set = true;
+        }
+        else if (key == "REPEATS")
+        {
+            repeats = value.toInt(&ok);
+        }
+        else if (key == "RECVTIMEOUT")
+        {
+            max_receive_time = value.toInt(&ok);
+        }
+        else if (key == "RECVBUFFER")
+        {
+            max_receive_buffer = value.toInt(&ok);
+        }
+        else if (key == "WAITFORWRITE")
+        {
+            wait_for_write = (value == "1");
+        }
+        else if (key == "HEADLESS")
+        {
+            //Selects this mode, handled before the application is created
+        }
+        else
+        {
+            //Reported by name so that a mistyped key is not reported as a missing argument
+            tsError << "Unknown argument: " << key << " (in " << argument << ")" << "\n";
+            return HeadlessExitInvalidArguments;
+        }
+
+        if (ok == false)
+        {
+            tsError << "Invalid argument: " << argument << "\n";
+            return HeadlessExitInvalidArguments;
+        }
+
+        ++i;
+    }
+
+    if (port_name.isEmpty() || script_filename.isEmpty())
+    {
+        tsError << "Headless mode requires PORT=<port> and SCRIPTFILE=<file> arguments" << "\n";
+        return HeadlessExitInvalidArguments;
+    }
+
+    if (report_format_set == false && report_filename.endsWith(".xml", Qt::CaseInsensitive))
+    {
+        //Default to JUnit for XML report files
+        report_junit = true;
+    }
+
+    //Load script
+    QFile script_file(script_filename);
+
+    if (script_file.open(QIODevice::ReadOnly | QIODevice::Text) == false)
+    {
+        tsError << "Unable to open script file: " << script_filename << "\n";
+        return HeadlessExitInvalidArguments;
+    }
+
+    QString script = QString::fromUtf8(script_file.readAll());
+    script_file.close();
+    script_lines = script.split('\n');
+
+    serial_port.setPortName(port_name);
+
+    //Check the script before opening the port so an invalid script is reported as such even if the port is unavailable
+    scripting->SetRecordTimings(true);
+    scripting->SetRunOptions(repeats, max_receive_time, max_receive_buffer, wait_for_write);
+    scripting->SetScriptText(script);
+
+    if (scripting->CompileScript() == false)
+    {
+        tsError << "Script compilation failed: " << scripting->ScriptStatus() << "\n";
+
+        if (!report_filename.isEmpty())
+        {
+            write_report(false, scripting->ScriptStatus(), 0);
+        }
+
+        return HeadlessExitInvalidArguments;
+    }
+
+    //Open serial port
+    serial_port.setBaudRate(baud);
+    serial_port.setDataBits(data_bits);
+    serial_port.setStopBits(stop_bits);
+    serial_port.setParity(parity);
+    serial_port.setFlowControl(flow_control);
+
+    if (serial_port.open(QIODevice::ReadWrite) == false)
+    {
+        tsError << "Unable to open serial port " << port_name << ": " << serial_port.errorString() << "\n";
+        return HeadlessExitPortError;
+    }
+
+    //Run script
+    scripting->SerialPortStatus(true);
+    run_timer.start();
+
+    if (scripting->RunScript() == false)
+    {
+        //Script failed to compile, it was already checked so this is not expected
+        tsError << "Script compilation failed: " << scripting->ScriptStatus() << "\n";
+
+        if (!report_filename.isEmpty())
+        {
+            write_report(false, scripting->ScriptStatus(), 0);
+        }
+
+        serial_port.close();
+
+        return HeadlessExitInvalidArguments;
+    }
+
+    return HeadlessStarted;
+}
+
+void AutHeadlessRunner::serial_read()
+{
+    QByteArray data = serial_port.readAll();
+    scripting->SerialPortData(&data);
+}
+
+void AutHeadlessRunner::serial_bytes_written(qint64 bytes)
+{
+    scripting->SerialPortWritten(bytes);
+}
+
+void AutHeadlessRunner::serial_error(QSerialPort::SerialPortError error)
+{
+    scripting->SerialPortError(error);
+}
+
+void AutHeadlessRunner::script_send_data(QByteArray data, bool escape, bool from_scripting)
+{
+    Q_UNUSED(from_scripting);
+
+    if (escape == true)
+    {
+        //Escape string sequences
+        AutEscape::escape_characters(&data);
+    }
+
+    serial_port.write(data);
+}
+
+void AutHeadlessRunner::script_start_request()
+{
+    //There is no terminal to be busy, the script can always start
+    scripting->ScriptStartResult(true, ScriptingReasonOK);
+}
+
+void AutHeadlessRunner::script_finished()
+{
+    //Script has finished or failed, output the result and exit
+    QTextStream tsOutput(stdout);
+    bool passed = scripting->ScriptPassed();
+    QString status = scripting->ScriptStatus();
+    int exit_code = (passed == true ? HeadlessExitPassed : HeadlessExitFailed);
+
+    tsOutput << (passed == true ? "PASSED: " : "FAILED: ") << status << "\n";
+
+    if (!report_filename.isEmpty() && write_report(passed, status, run_timer.elapsed()) == false)
+    {
+        QTextStream(stderr) << "Unable to write report file: " << report_filename << "\n";
+
+        if (exit_code == HeadlessExitPassed)
+        {
+            exit_code = HeadlessExitReportError;
+        }
+    }
+
+    serial_port.close();
+    QCoreApplication::exit(exit_code);
+}
+
+QString AutHeadlessRunner::line_text(int line) const
+{
+    //Returns the source text of a (0-based) script line
+    if (line < 0 || line >= script_lines.length())
+    {
+        return QString();
+    }
+
+    QString text = script_lines.at(line);
+
+    if (text.endsWith('\r'))
+    {
+        text.chop(1);
+    }
+
+    return text;
+}
+
+bool AutHeadlessRunner::write_report(bool passed, const QString &status, qint64 elapsed_ms)
+{
+    //Writes the result and per-line timings of the script to the report file
+    const QVector<scripting_timing> *timings = scripting->GetTimings();
+    int failed_line = (passed == true ? -1 : scripting->LastTimedLine());
+    QFile report_file(report_filename);
+    int executed = 0;
+    int i = 0;
+
+    if (report_file.open(QIODevice::WriteOnly | QIODevice::Truncate) == false)
+    {
+        return false;
+    }
+
+    for (const scripting_timing &timing : *timings)
+    {
+        if (timing.count > 0)
+        {
+            ++executed;
+        }
+    }
+
+    if (report_junit == true)
+    {
+        //JUnit XML, one test case per executed line (with the times of all executions combined) so CI systems can show where time was spent
+        QXmlStreamWriter xml(&report_file);
+        QString suite_name = QFileInfo(script_filename).fileName();
+
+        xml.setAutoFormatting(true);
+        xml.writeStartDocument();
+        xml.writeStartElement("testsuites");
+        xml.writeStartElement("testsuite");
+        xml.writeAttribute("name", suite_name);
+        xml.writeAttribute("tests", QString::number(executed > 0 ? executed : 1));
+        xml.writeAttribute("failures", (passed == true ? "0" : "1"));
+        xml.writeAttribute("errors", "0");
+        xml.writeAttribute("time", QString::number((double)elapsed_ms / 1000.0, 'f', 3));
+        xml.writeAttribute("hostname", serial_port.portName());
+
+        if (executed == 0)
+        {
+            //Nothing executed (e.g. compilation failure), output a single test case with the result
+            xml.writeStartElement("testcase");
+            xml.writeAttribute("classname", suite_name);
+            xml.writeAttribute("name", "script");
+            xml.writeAttribute("time", "0.000");
+
+            if (passed == false)
+            {
+                xml.writeStartElement("failure");
+                xml.writeAttribute("message", status);
+                xml.writeEndElement();
+            }
+
+            xml.writeEndElement();
+        }
+
+        while (i < timings->length())
+        {
+            const scripting_timing &timing = timings->at(i);
+
+            if (timing.count == 0)
+            {
+                ++i;
+                continue;
+            }
+
+            xml.writeStartElement("testcase");
+            xml.writeAttribute("classname", suite_name);
+            xml.writeAttribute("name", QString("Line %1: %2").arg(QString::number(timing.line + 1), line_text(timing.line)));
+            xml.writeAttribute("time", QString::number((double)timing.total_ns / 1000000000.0, 'f', 6));
+
+            if (timing.line == failed_line)
+            {
+                //Script failed on the last executed line
+                xml.writeStartElement("failure");
+                xml.writeAttribute("message", status);
+                xml.writeEndElement();
+            }
+
+            xml.writeTextElement("system-out", QString("Executed %1 time%2, min %3 ms, mean %4 ms, max %5 ms").arg(QString::number(timing.count), (timing.count == 1 ? "" : "s"), QString::number((double)timing.min_ns / 1000000.0, 'f', 3), QString::number((double)timing.total_ns / (double)timing.count / 1000000.0, 'f', 3), QString::number((double)timing.max_ns / 1000000.0, 'f', 3)));
+            xml.writeEndElement();
+            ++i;
+        }
+
+        xml.writeEndElement();
+        xml.writeEndElement();
+        xml.writeEndDocument();
+    }
+    else
+    {
+        //JSON
+        QJsonObject root;
+        QJsonArray lines;
+
+        while (i < timings->length())
+        {
+            const scripting_timing &timing = timings->at(i);
+            QJsonObject line;
+
+            if (timing.count == 0)
+            {
+                ++i;
+                continue;
+            }
+
+            line.insert("line", timing.line + 1);
+            line.insert("text", line_text(timing.line));
+            line.insert("count", (qint64)timing.count);
+            line.insert("total_ms", (double)timing.total_ns / 1000000.0);
+            line.insert("min_ms", (double)timing.min_ns / 1000000.0);
+            line.insert("mean_ms", (double)timing.total_ns / (double)timing.count / 1000000.0);
+            line.insert("max_ms", (double)timing.max_ns / 1000000.0);
+            lines.append(line);
+            ++i;
+        }
+
+        root.insert("script", script_filename);
+        root.insert("port", serial_port.portName());
+        root.insert("result", (passed == true ? "passed" : "failed"));
+        root.insert("message", status);
+        root.insert("duration_ms", elapsed_ms);
+        root.insert("failed_line", (failed_line == -1 ? QJsonValue() : QJsonValue(failed_line + 1)));
+        root.insert("lines", lines);
+        report_file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    }
+
+    report_file.close();
+
+    return (report_file.error() == QFileDevice::NoError);
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,87 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module: AutHeadlessRunner.h
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef AUTHEADLESSRUNNER_H
+#define AUTHEADLESSRUNNER_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QObject>
+#include <QSerialPort>
+#include <QStringList>
+#include <QElapsedTimer>
+#include "AutScripting.h"
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+const int HeadlessStarted                  = -1; //Script has been started, exit code will be returned from the event loop
+const int HeadlessExitPassed               = 0;  //Exit code if the script completed
+const int HeadlessExitFailed               = 1;  //Exit code if the script failed
+const int HeadlessExitInvalidArguments     = 2;  //Exit code if the arguments or script file are invalid
+const int HeadlessExitPortError            = 3;  //Exit code if the serial port could not be opened
+const int HeadlessExitReportError          = 4;  //Exit code if the script completed but the report could not be written
+const int HeadlessDefaultBaud              = 115200;
+const int HeadlessDefaultMaxReceiveTime    = 900;   //Default maximum time (in seconds) to wait for data in < commands
+const int HeadlessDefaultMaxReceiveBuffer  = 4096;  //Default maximum receive buffer size (in bytes) for < commands
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+//Runs a script on a serial port without the main window, used for automated
+//testing where the GUI startup time would dominate
+class AutHeadlessRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AutHeadlessRunner(QObject *parent = nullptr);
+    ~AutHeadlessRunner();
+    int start(const QStringList &arguments);
+
+private slots:
+    void serial_read();
+    void serial_bytes_written(qint64 bytes);
+    void serial_error(QSerialPort::SerialPortError error);
+    void script_send_data(QByteArray data, bool escape, bool from_scripting);
+    void script_start_request();
+    void script_finished();
+
+private:
+    bool write_report(bool passed, const QString &status, qint64 elapsed_ms);
+    QString line_text(int line) const;
+
+    QSerialPort serial_port; //Serial port the script is run on
+    AutScripting *scripting; //Scripting object (never shown) which compiles and executes the script
+    QString script_filename; //Filename of the script being run
+    QStringList script_lines; //Lines of the script, used for the report
+    QString report_filename; //Filename of the report to write (if any)
+    bool report_junit; //True if the report should be JUnit XML, false for JSON
+    QElapsedTimer run_timer; //Times the whole run
+};
+
+#endif // AUTHEADLESSRUNNER_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -36,18 +36,21 @@ AutHighlighter::AutHighlighter(QTextDocument *parent) : QSyntaxHighlighter(paren
     OutPattern.setPattern("^\\<");
     InPattern.setPattern("^\\>");
     WaitPattern.setPattern("^\\~");
+    MatchPattern.setPattern("^[\\?%=:]");
     CommentPattern.setPattern("^//[^\n|\r]*");
 
     //Set pattern options
     OutPattern.setPatternOptions(QRegularExpression::MultilineOption);
     InPattern.setPatternOptions(QRegularExpression::MultilineOption);
     WaitPattern.setPatternOptions(QRegularExpression::MultilineOption);
+    MatchPattern.setPatternOptions(QRegularExpression::MultilineOption);
     CommentPattern.setPatternOptions(QRegularExpression::MultilineOption);
 
     //Optimise regular expression patterns
     OutPattern.optimize();
     InPattern.optimize();
     WaitPattern.optimize();
+    MatchPattern.optimize();
     CommentPattern.optimize();
 
     //Configure formatting for lines
@@ -82,6 +85,12 @@ void AutHighlighter::highlightBlock(const QString &text)
         QRegularExpressionMatch ThisMatch = nextmatch.next();
         setFormat(ThisMatch.capturedStart(), ThisMatch.capturedLength(), LineFormat);
     }
+    nextmatch = MatchPattern.globalMatch(texta);
+    while (nextmatch.hasNext())
+    {
+        QRegularExpressionMatch ThisMatch = nextmatch.next();
+        setFormat(ThisMatch.capturedStart(), ThisMatch.capturedLength(), LineFormat);
+    }
     nextmatch = CommentPattern.globalMatch(texta);
     while (nextmatch.hasNext())
     {
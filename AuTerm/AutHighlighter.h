@@ -56,6 +56,7 @@ private:
     QRegularExpression OutPattern; //Matches sending data lines
     QRegularExpression InPattern; //Matches receiving data lines
     QRegularExpression WaitPattern; //Matches time waiting lines
+    QRegularExpression MatchPattern; //Matches receive with timeout, jump and label lines
     QRegularExpression CommentPattern; //Matches comment lines
     QTextCharFormat LineFormat; //Format for valid lines
     QTextCharFormat CommentFormat; //Format for comment lines
@@ -1386,6 +1386,7 @@ void AutMainWindow::on_btn_TermClose_clicked(bool from_plugin)
             //Clear buffers
             gbaSpeedMatchData.clear();
             gbaSpeedReceivedData.clear();
+            gbaSpeedSendPool.clear();
 
             //Show finished message in status bar
             ui->statusBar->showMessage("Speed testing failed due to serial port being closed.");
@@ -2750,6 +2751,7 @@ void AutMainWindow::SerialError(QSerialPort::SerialPortError speErrorCode)
             //Clear buffers
             gbaSpeedMatchData.clear();
             gbaSpeedReceivedData.clear();
+            gbaSpeedSendPool.clear();
 
             //Show finished message in status bar
             ui->statusBar->showMessage("Speed testing failed due to serial port error.");
@@ -4033,6 +4035,7 @@ void AutMainWindow::on_btn_SpeedStartStop_clicked()
 
             //Update values
             OutputSpeedTestAvgStats((gtmrSpeedTimer.nsecsElapsed() < 1000000000LL ? 1000000000LL : gtmrSpeedTimer.nsecsElapsed()/1000000000LL));
+            SpeedTestCheckHostLimit(gtmrSpeedTimer.nsecsElapsed());
 
             //Set speed test as no longer running
             gchSpeedTestMode = SPEED_MODE_INACTIVE;
@@ -4057,6 +4060,7 @@ void AutMainWindow::on_btn_SpeedStartStop_clicked()
             //Clear buffers
             gbaSpeedMatchData.clear();
             gbaSpeedReceivedData.clear();
+            gbaSpeedSendPool.clear();
 
             //Show message that test has finished
             ui->statusBar->showMessage("Speed testing finished.");
@@ -4126,6 +4130,9 @@ void AutMainWindow::SpeedMenuSelected(QAction *qaAction)
         gintSpeedTestReceiveIndex = 0;
         gintSpeedTestStatSuccess = 0;
         gintSpeedTestStatErrors = 0;
+        gintSpeedTestRefills = 0;
+        gintSpeedTestUnderruns = 0;
+        gintSpeedTestGeneratorTime = 0;
         gbSpeedTestReceived = false;
         gintDelayedSpeedTestReceive = 0;
 
@@ -4151,9 +4158,11 @@ void AutMainWindow::SpeedMenuSelected(QAction *qaAction)
         ui->label_SpeedTx->setText("0");
         ui->label_SpeedTime->setText("00:00:00:00");
 
-        //Clear received buffer and data match buffer
+        //Clear received buffer, data match buffer and send pool
         gbaSpeedMatchData.clear();
         gbaSpeedReceivedData.clear();
+        gbaSpeedSendPool.clear();
+        gintSpeedSendPoolOffset = 0;
 
         //Check if this is a string match or throughput-only test
         if (ui->combo_SpeedDataType->currentIndex() != 0)
@@ -4173,6 +4182,12 @@ void AutMainWindow::SpeedMenuSelected(QAction *qaAction)
 
             //Set length of match data
             gintSpeedTestMatchDataLength = gbaSpeedMatchData.length();
+
+            //Prebuild the payload ring as a whole number of match data repetitions so that any
+            //slice starting at a packet boundary stays in phase, the ring is stored twice so that
+            //a slice of up to the ring size never needs to wrap
+            gbaSpeedSendPool = gbaSpeedMatchData.repeated((SpeedTestSendPoolSize + gintSpeedTestMatchDataLength - 1) / gintSpeedTestMatchDataLength);
+            gbaSpeedSendPool.append(gbaSpeedSendPool);
         }
 
         //By default, no send delay
@@ -4518,24 +4533,24 @@ void AutMainWindow::on_btn_SpeedCopy_clicked()
 void AutMainWindow::SendSpeedTestData(int intMaxLength)
 {
     //Send string out. It's OK to send less than the maximum length but not more, unless none fit
+    QElapsedTimer tmrGenerator;
     int intSendTimes = 1;
+    qint32 intSendSize;
+    qint32 intRingSize = gbaSpeedSendPool.length() / 2;
+
+    tmrGenerator.start();
 
     if (intMaxLength > gintSpeedTestMatchDataLength)
     {
         intSendTimes = (intMaxLength / gintSpeedTestMatchDataLength);
     }
 
-    if (ui->check_SpeedShowTX->isChecked())
-    {
-        //Show TX data in terminal
-        int print_times = intSendTimes;
+    intSendSize = intSendTimes * gintSpeedTestMatchDataLength;
 
-        while (print_times > 0)
-        {
-            //Append to buffer
-            gbaSpeedDisplayBuffer.append(gbaSpeedMatchData);
-            --print_times;
-        }
+    if (ui->check_SpeedShowTX->isChecked() && gbaSpeedDisplayBuffer.length() < SpeedTestDisplaySampleSize)
+    {
+        //Show a sample of the TX data in terminal, copying every repetition would make the display the bottleneck
+        gbaSpeedDisplayBuffer.append(gbaSpeedSendPool.constData() + gintSpeedSendPoolOffset, qMin(intSendSize, qMin(intRingSize, SpeedTestDisplaySampleSize)));
 
         if (!gtmrSpeedUpdateTimer.isActive())
         {
@@ -4543,14 +4558,20 @@ void AutMainWindow::SendSpeedTestData(int intMaxLength)
         }
     }
 
-    while (intSendTimes > 0)
+    gintSpeedBufferCount += intSendSize;
+    gintSpeedTestStatPacketsSent += intSendTimes;
+
+    while (intSendSize > 0)
     {
-        //Send out until finished
-        transport_write(gbaSpeedMatchData);
-        gintSpeedBufferCount += gintSpeedTestMatchDataLength;
-        --intSendTimes;
-        ++gintSpeedTestStatPacketsSent;
+        //Send out slices of the payload ring until finished, transports copy the data into their own buffers
+        qint32 intSliceSize = qMin(intSendSize, intRingSize);
+
+        transport_write(QByteArray::fromRawData(gbaSpeedSendPool.constData() + gintSpeedSendPoolOffset, intSliceSize));
+        gintSpeedSendPoolOffset = (gintSpeedSendPoolOffset + intSliceSize) % intRingSize;
+        intSendSize -= intSliceSize;
     }
+
+    gintSpeedTestGeneratorTime += tmrGenerator.nsecsElapsed();
 }
 
 void AutMainWindow::SpeedTestBytesWritten(qint64 intByteCount)
@@ -4562,8 +4583,15 @@ void AutMainWindow::SpeedTestBytesWritten(qint64 intByteCount)
         gintSpeedBufferCount -= intByteCount;
         if (gintSpeedBufferCount <= ui->edit_speed_test_minimum_buffer_size->value())
         {
-            //Buffer has space: send more data
-            SendSpeedTestData(ui->edit_speed_test_chunk_append_size->value());
+            //Buffer has space: top it back up, if it already fully drained then the link was left idle waiting for the host
+            ++gintSpeedTestRefills;
+
+            if (gintSpeedBufferCount <= 0)
+            {
+                ++gintSpeedTestUnderruns;
+            }
+
+            SendSpeedTestData(ui->edit_speed_test_chunk_append_size->value() + ui->edit_speed_test_minimum_buffer_size->value() - gintSpeedBufferCount);
         }
     }
 
@@ -4572,6 +4600,28 @@ void AutMainWindow::SpeedTestBytesWritten(qint64 intByteCount)
     gintSpeedBytesSent10s += intByteCount;
 }
 
+void AutMainWindow::SpeedTestCheckHostLimit(qint64 lngElapsed)
+{
+    //Reports if the data generator (host side) rather than the link limited the transmit rate
+    if (gintSpeedBytesSent == 0 || gintSpeedTestRefills == 0)
+    {
+        return;
+    }
+
+    quint32 intUnderrunPercent = (quint32)((quint64)gintSpeedTestUnderruns * 100ULL / (quint64)gintSpeedTestRefills);
+    quint32 intGeneratorPercent = (lngElapsed > 0 ? (quint32)((quint64)gintSpeedTestGeneratorTime * 100ULL / (quint64)lngElapsed) : 0);
+
+    if (intUnderrunPercent >= SpeedTestHostLimitPercent || intGeneratorPercent >= SpeedTestHostLimitPercent)
+    {
+        gbaSpeedDisplayBuffer.append(QString("\r\nWarning: Transmit rate was limited by the host, not the link.\r\n\tBuffer underruns: ").append(QString::number(gintSpeedTestUnderruns)).append(" of ").append(QString::number(gintSpeedTestRefills)).append(" refills (").append(QString::number(intUnderrunPercent)).append("%)\r\n\tGenerator time: ").append(QString::number(intGeneratorPercent)).append("% of test time\r\n\tIncrease the minimum buffer size or chunk append size, or disable showing TX data.\r\n").toUtf8());
+
+        if (!gtmrSpeedUpdateTimer.isActive())
+        {
+            gtmrSpeedUpdateTimer.start();
+        }
+    }
+}
+
 void AutMainWindow::SpeedTestReceive()
 {
     //Receieved data from serial port in speed test mode
@@ -4865,6 +4915,7 @@ void AutMainWindow::SpeedTestStopTimer()
 
     //Update values
     OutputSpeedTestAvgStats(gtmrSpeedTimer.nsecsElapsed()/1000000000LL);
+    SpeedTestCheckHostLimit(gtmrSpeedTimer.nsecsElapsed());
 
     //Set speed test as no longer running
     gchSpeedTestMode = SPEED_MODE_INACTIVE;
@@ -4889,6 +4940,7 @@ void AutMainWindow::SpeedTestStopTimer()
     //Clear buffers
     gbaSpeedMatchData.clear();
     gbaSpeedReceivedData.clear();
+    gbaSpeedSendPool.clear();
 
     //Show finished message in status bar
     ui->statusBar->showMessage("Speed testing finished.");
@@ -5973,6 +6025,7 @@ void AutMainWindow::plugin_transport_error(int error)
         //Clear buffers
         gbaSpeedMatchData.clear();
         gbaSpeedReceivedData.clear();
+        gbaSpeedSendPool.clear();
 
         //Show finished message in status bar
         ui->statusBar->showMessage("Speed testing failed due to serial port error.");
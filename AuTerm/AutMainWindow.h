@@ -142,6 +142,9 @@ const qint8 BalloonActionShow                   = 1;
 const qint8 BalloonActionExit                   = 2;
 //Constants for speed testing
 const qint16 SpeedTestStatUpdateTime            = 500;  //Time (in ms) between status updates for speed test mode
+const qint32 SpeedTestSendPoolSize              = 65536; //Minimum size (in bytes) of the prebuilt ring of speed test payload data
+const qint32 SpeedTestDisplaySampleSize         = 512;   //Maximum number of sent bytes copied to the speed test display per display update
+const quint8 SpeedTestHostLimitPercent          = 10;    //Percentage of buffer underruns (or generator time) above which the host is reported as the speed test bottleneck
 const QString WINDOWS_NEWLINE                   = "\r\n";
 const QChar NEWLINE                             = '\n';
 
@@ -396,6 +399,7 @@ private:
     void SpeedTestBytesWritten(qint64 intByteCount);
     void SpeedTestReceive();
     void OutputSpeedTestAvgStats(qint64 lngElapsed);
+    void SpeedTestCheckHostLimit(qint64 lngElapsed);
 #endif
     void SetLoopBackMode(bool bNewMode);
 #ifndef SKIPONLINE
@@ -512,6 +516,11 @@ private:
     QByteArray gbaSpeedDisplayBuffer; //Buffer of data to display for speed test mode
     QByteArray gbaSpeedMatchData; //Expected data to match in speed test mode
     QByteArray gbaSpeedReceivedData; //Received data from device in speed test mode
+    QByteArray gbaSpeedSendPool; //Prebuilt payload ring (stored twice back to back) that speed test data is sent from
+    qint32 gintSpeedSendPoolOffset; //Current offset into the payload ring, always a multiple of the match data length
+    quint32 gintSpeedTestRefills; //Number of times the transport buffer has been refilled in speed test mode
+    quint32 gintSpeedTestUnderruns; //Number of refills where the transport buffer had already fully drained in speed test mode
+    qint64 gintSpeedTestGeneratorTime; //Time (in ns) spent generating and queueing data in speed test mode
     QTimer gtmrSpeedTestStats; //Timer that runs every 250ms to update stats for speed test
     QTimer gtmrSpeedTestStats10s; //Timer that runs every 10 seconds to output 10s stats for speed test
     QTimer gtmrSpeedUpdateTimer; //Timer for slower updating of speed test buffer (but less display freezing)
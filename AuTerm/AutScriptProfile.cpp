@@ -0,0 +1,228 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module: AutScriptProfile.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "AutScriptProfile.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QFile>
+#include <QTextStream>
+#include <QMessageBox>
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+const QStringList ProfileColumnNames = {"Line", "Command", "Hits", "Total (ms)", "Send (ms)", "Send max (ms)", "Wait data (ms)", "Wait data max (ms)", "Wait write (ms)", "Wait write max (ms)", "Delay (ms)", "Delay max (ms)"};
+const int ProfileColumnLine = 0;
+const int ProfileColumnCommand = 1;
+const int ProfileColumnHits = 2;
+const int ProfileColumnTotal = 3;
+const int ProfileColumnStates = 4; //First of the total/max column pairs for each state
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+static QTableWidgetItem *NumericItem(double fValue)
+{
+    //Creates a table item which sorts numerically
+    QTableWidgetItem *twiItem = new QTableWidgetItem();
+    twiItem->setData(Qt::DisplayRole, fValue);
+    twiItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return twiItem;
+}
+
+static double NsToMs(qint64 intNs)
+{
+    //Converts nanoseconds to milliseconds rounded to 3 decimal places
+    return (double)((intNs + 500) / 1000) / 1000.0;
+}
+
+AutScriptProfile::AutScriptProfile(QWidget *parent) : QDialog(parent)
+{
+    QVBoxLayout *vblLayout = new QVBoxLayout(this);
+    QHBoxLayout *hblButtons = new QHBoxLayout();
+
+    this->setWindowTitle("Script Profile");
+    this->setWindowFlags((Qt::Window | Qt::WindowCloseButtonHint));
+    this->resize(900, 400);
+
+    mlblSummary = new QLabel(this);
+    mtblProfile = new QTableWidget(this);
+    mtblProfile->setColumnCount(ProfileColumnNames.length());
+    mtblProfile->setHorizontalHeaderLabels(ProfileColumnNames);
+    mtblProfile->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mtblProfile->setSelectionBehavior(QAbstractItemView::SelectRows);
+    mtblProfile->verticalHeader()->setVisible(false);
+    mtblProfile->horizontalHeader()->setSectionResizeMode(ProfileColumnCommand, QHeaderView::Stretch);
+
+    mbtnExport = new QPushButton("Export CSV...", this);
+    mbtnClose = new QPushButton("Close", this);
+    hblButtons->addStretch();
+    hblButtons->addWidget(mbtnExport);
+    hblButtons->addWidget(mbtnClose);
+
+    vblLayout->addWidget(mlblSummary);
+    vblLayout->addWidget(mtblProfile);
+    vblLayout->addLayout(hblButtons);
+
+    connect(mbtnExport, SIGNAL(clicked()), this, SLOT(ExportCSV()));
+    connect(mbtnClose, SIGNAL(clicked()), this, SLOT(close()));
+}
+
+AutScriptProfile::~AutScriptProfile()
+{
+    disconnect(mbtnExport, SIGNAL(clicked()), this, SLOT(ExportCSV()));
+    disconnect(mbtnClose, SIGNAL(clicked()), this, SLOT(close()));
+}
+
+void AutScriptProfile::SetProfile(const QVector<scripting_profile> *vecProfile, const QStringList &lstLines)
+{
+    //Fills the table with every line that has been executed
+    qint64 intStateTotals[ScriptingProfileStates] = {0};
+    qint64 intTotal = 0;
+    int intRow = 0;
+    int i = 0;
+
+    mtblProfile->setSortingEnabled(false);
+    mtblProfile->setRowCount(0);
+
+    while (i < vecProfile->length())
+    {
+        const scripting_profile &spLine = vecProfile->at(i);
+
+        if (spLine.hits > 0)
+        {
+            qint64 intLineTotal = 0;
+            int l = 0;
+
+            mtblProfile->insertRow(intRow);
+            mtblProfile->setItem(intRow, ProfileColumnLine, NumericItem(i + 1));
+            mtblProfile->setItem(intRow, ProfileColumnCommand, new QTableWidgetItem(i < lstLines.length() ? lstLines.at(i) : QString()));
+            mtblProfile->setItem(intRow, ProfileColumnHits, NumericItem(spLine.hits));
+
+            while (l < ScriptingProfileStates)
+            {
+                intLineTotal += spLine.total_ns[l];
+                intStateTotals[l] += spLine.total_ns[l];
+                mtblProfile->setItem(intRow, ProfileColumnStates + l*2, NumericItem(NsToMs(spLine.total_ns[l])));
+                mtblProfile->setItem(intRow, ProfileColumnStates + l*2 + 1, NumericItem(NsToMs(spLine.max_ns[l])));
+                ++l;
+            }
+
+            mtblProfile->setItem(intRow, ProfileColumnTotal, NumericItem(NsToMs(intLineTotal)));
+            intTotal += intLineTotal;
+            ++intRow;
+        }
+
+        ++i;
+    }
+
+    //Show the most expensive lines first
+    mtblProfile->setSortingEnabled(true);
+    mtblProfile->sortByColumn(ProfileColumnTotal, Qt::DescendingOrder);
+    mtblProfile->resizeColumnsToContents();
+    mtblProfile->horizontalHeader()->setSectionResizeMode(ProfileColumnCommand, QHeaderView::Stretch);
+
+    mlblSummary->setText(QString("%1 lines executed, total %2 (send %3, wait for data %4, wait for write %5, delay %6)").arg(QString::number(intRow), FormatDuration(intTotal), FormatDuration(intStateTotals[ScriptingProfileSend]), FormatDuration(intStateTotals[ScriptingProfileWaitData]), FormatDuration(intStateTotals[ScriptingProfileWaitWrite]), FormatDuration(intStateTotals[ScriptingProfileWaitTime])));
+}
+
+QString AutScriptProfile::FormatDuration(qint64 intNs)
+{
+    //Formats a duration compactly for display
+    if (intNs >= 60000000000LL)
+    {
+        return QString("%1m").arg(QString::number((double)intNs / 60000000000.0, 'f', 1));
+    }
+    else if (intNs >= 1000000000LL)
+    {
+        return QString("%1s").arg(QString::number((double)intNs / 1000000000.0, 'f', 1));
+    }
+    else if (intNs >= 1000000LL)
+    {
+        return QString("%1ms").arg(QString::number(intNs / 1000000LL));
+    }
+
+    return QString("%1us").arg(QString::number(intNs / 1000LL));
+}
+
+void AutScriptProfile::ExportCSV()
+{
+    //Exports the table, in the current sort order, to a CSV file
+    QString strFilename = QFileDialog::getSaveFileName(this, "Export Profile", mstrLastExportFile, "CSV Files (*.csv);;All Files (*.*)");
+
+    if (strFilename.isEmpty())
+    {
+        return;
+    }
+
+    QFile fileExport(strFilename);
+
+    if (fileExport.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text) == false)
+    {
+        QMessageBox::critical(this, "Export Profile", QString("Unable to open file for writing: ").append(strFilename));
+        return;
+    }
+
+    QTextStream tsExport(&fileExport);
+    int intRow = 0;
+
+    mstrLastExportFile = strFilename;
+    tsExport << ProfileColumnNames.join(",") << "\n";
+
+    while (intRow < mtblProfile->rowCount())
+    {
+        int intColumn = 0;
+
+        while (intColumn < mtblProfile->columnCount())
+        {
+            QString strValue = mtblProfile->item(intRow, intColumn)->text();
+
+            if (intColumn == ProfileColumnCommand)
+            {
+                //Quote command text as it may contain commas or quotes
+                strValue = QString("\"").append(strValue.replace("\"", "\"\"")).append("\"");
+            }
+
+            if (intColumn > 0)
+            {
+                tsExport << ",";
+            }
+
+            tsExport << strValue;
+            ++intColumn;
+        }
+
+        tsExport << "\n";
+        ++intRow;
+    }
+
+    fileExport.close();
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
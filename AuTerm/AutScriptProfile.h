@@ -0,0 +1,84 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module: AutScriptProfile.h
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef AUTSCRIPTPROFILE_H
+#define AUTSCRIPTPROFILE_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QDialog>
+#include <QTableWidget>
+#include <QPushButton>
+#include <QLabel>
+#include <QVector>
+#include <QStringList>
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+const qint8 ScriptingProfileNone      = -1; //Not currently timing a line
+const qint8 ScriptingProfileSend      = 0;  //Time spent sending data (> commands)
+const qint8 ScriptingProfileWaitData  = 1;  //Time spent waiting for data to be received (<, ? and % commands)
+const qint8 ScriptingProfileWaitWrite = 2;  //Time spent waiting for sent data to be written (> commands with wait for write enabled)
+const qint8 ScriptingProfileWaitTime  = 3;  //Time spent in fixed delays (~ commands)
+const qint8 ScriptingProfileStates    = 4;  //Number of profiled states
+
+/******************************************************************************/
+// Forward declaration of Class, Struct & Unions
+/******************************************************************************/
+//Struct used for holding the accumulated execution profile of a script line
+struct scripting_profile {
+    quint32 hits; //Number of times the line was executed
+    qint64 total_ns[ScriptingProfileStates]; //Total time spent in each state (in ns)
+    qint64 max_ns[ScriptingProfileStates]; //Longest single time spent in each state (in ns)
+};
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class AutScriptProfile : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit AutScriptProfile(QWidget *parent = nullptr);
+    ~AutScriptProfile();
+    void SetProfile(const QVector<scripting_profile> *vecProfile, const QStringList &lstLines);
+    static QString FormatDuration(qint64 intNs);
+
+private slots:
+    void ExportCSV();
+
+private:
+    QTableWidget *mtblProfile; //Table of profiled lines
+    QLabel *mlblSummary; //Summary of the profile totals
+    QPushButton *mbtnExport; //Button to export the table to a CSV file
+    QPushButton *mbtnClose; //Button to close the dialogue
+    QString mstrLastExportFile; //Last file which the profile was exported to
+};
+
+#endif // AUTSCRIPTPROFILE_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -51,6 +51,10 @@ AutScripting::AutScripting(QWidget *parent) : QDialog(parent), ui(new Ui::AutScr
     mtmrPauseTimer.setSingleShot(true);
     connect(&mtmrPauseTimer, SIGNAL(timeout()), this, SLOT(AdvanceLine()));
 
+    //Setup receive timeout timer
+    mtmrWaitTimeout.setSingleShot(true);
+    connect(&mtmrWaitTimeout, SIGNAL(timeout()), this, SLOT(WaitTimeout()));
+
     //Setup status bar update timer
     mtmrUpdateTimer.setSingleShot(false);
     connect(&mtmrUpdateTimer, SIGNAL(timeout()), this, SLOT(UpdateStatusBar()));
@@ -58,6 +62,22 @@ AutScripting::AutScripting(QWidget *parent) : QDialog(parent), ui(new Ui::AutScr
     //Script is not currently running or waiting for a data match
     mbIsRunning = false;
     mbWaitingForReceive = false;
+    mbBenchmark = false;
+    mbWaitForWrite = false;
+    mintProgramIndex = 0;
+    mintRecvDiscarded = 0;
+    mintRecvPartial = 0;
+    mintLastMatch = -1;
+    mbRecordTimings = false;
+    mintTimingLine = -1;
+    mintTimingStart = 0;
+    mintTimingLastLine = -1;
+    mbScriptPassed = false;
+    mbProfile = false;
+    mintProfileLine = -1;
+    mintProfileState = ScriptingProfileNone;
+    mintProfileStart = 0;
+    mfrmProfile = nullptr;
 
     //Set the icons and tooltip of the buttons
     ui->btn_Load->setIcon(this->style()->standardIcon(QStyle::SP_DialogOpenButton));
@@ -85,6 +105,11 @@ AutScripting::AutScripting(QWidget *parent) : QDialog(parent), ui(new Ui::AutScr
     //Create option menu items
     gpOptionsMenu = new QMenu(this);
     gpOptionsMenu->addAction("Change Font")->setData(MenuActionChangeFont);
+    gpOptionsMenu->addAction("Benchmark Execution")->setData(MenuActionBenchmark);
+    mqaProfile = gpOptionsMenu->addAction("Profile Execution");
+    mqaProfile->setData(MenuActionProfile);
+    mqaProfile->setCheckable(true);
+    gpOptionsMenu->addAction("Show Profile...")->setData(MenuActionShowProfile);
 
     //Connect signals
     connect(gpOptionsMenu, SIGNAL(triggered(QAction*)), this, SLOT(MenuSelected(QAction*)));
@@ -108,6 +133,7 @@ AutScripting::~AutScripting()
 {
     //On dialogue deletion
     disconnect(&mtmrPauseTimer, SIGNAL(timeout()), this, SLOT(AdvanceLine()));
+    disconnect(&mtmrWaitTimeout, SIGNAL(timeout()), this, SLOT(WaitTimeout()));
     disconnect(gpOptionsMenu, SIGNAL(triggered(QAction*)), this, SLOT(MenuSelected(QAction*)));
     disconnect(qaKeyShortcuts[0], SIGNAL(activated()), this, SLOT(on_btn_Save_clicked()));
     disconnect(qaKeyShortcuts[1], SIGNAL(activated()), this, SLOT(on_btn_Load_clicked()));
@@ -196,10 +222,13 @@ void AutScripting::on_btn_Save_clicked()
 
 bool AutScripting::on_btn_Compile_clicked()
 {
-    //Compile script
+    //Compile script into an instruction list
     ui->edit_Script->ClearBadLines();
+    ui->edit_Script->ClearLineAnnotations();
     mintCLine = -1;
     ui->edit_Script->SetExecutionLine(mintCLine);
+    mlstProgram.clear();
+    QHash<QString, int> hashLabels;
     unsigned int i = 0;
     bool bFailed = false;
     if (ui->edit_Script->document()->lineCount() > 0)
@@ -208,41 +237,12 @@ bool AutScripting::on_btn_Compile_clicked()
         QTextBlock tbCurrentBlock = ui->edit_Script->document()->firstBlock();
         while (tbCurrentBlock.isValid())
         {
-            int iLineLength = tbCurrentBlock.text().length();
-            if (iLineLength == 1)
+            if (CompileLine(tbCurrentBlock.text(), i, &mlstProgram, &hashLabels) == false)
             {
                 //Fail
                 ui->edit_Script->AddBadLine(i);
                 bFailed = true;
             }
-            else if (iLineLength > 1)
-            {
-                //Check the command
-                if (tbCurrentBlock.text().at(0) == ScriptingWaitTime)
-                {
-                    //Check if the time value is valid or not
-                    bool bConverted = false;
-                    int intConv = tbCurrentBlock.text().right(tbCurrentBlock.text().length()-1).toInt(&bConverted);
-                    if (bConverted == false)
-                    {
-                        //Invalid number
-                        ui->edit_Script->AddBadLine(i);
-                        bFailed = true;
-                    }
-                    else if (intConv <= 0)
-                    {
-                        //Time value is 0 or negative
-                        ui->edit_Script->AddBadLine(i);
-                        bFailed = true;
-                    }
-                }
-                else if (!(tbCurrentBlock.text().at(0) == ScriptingDataOut) && !(tbCurrentBlock.text().at(0) == ScriptingDataIn) && !(tbCurrentBlock.text().at(0) == ScriptingWaitTime) && !(tbCurrentBlock.text().left(2) == ScriptingComment) && QString(tbCurrentBlock.text()).replace("\t", "").replace(" ", "").length() > 0)
-                {
-                    //Text present that isn't space/tab or a valid command
-                    ui->edit_Script->AddBadLine(i);
-                    bFailed = true;
-                }
-            }
 
             //Progrss to next block
             tbCurrentBlock = tbCurrentBlock.next();
@@ -250,6 +250,33 @@ bool AutScripting::on_btn_Compile_clicked()
         }
     }
 
+    //Resolve jump labels to instruction indexes
+    i = 0;
+    while (i < (unsigned int)mlstProgram.length())
+    {
+        if (mlstProgram.at(i).action == ScriptingActionBranch)
+        {
+            if (hashLabels.contains(mlstProgram.at(i).label))
+            {
+                mlstProgram[i].jump_index = hashLabels.value(mlstProgram.at(i).label);
+            }
+            else
+            {
+                //Label does not exist
+                ui->edit_Script->AddBadLine(mlstProgram.at(i).line);
+                bFailed = true;
+            }
+        }
+
+        ++i;
+    }
+
+    if (bFailed == true)
+    {
+        //Do not keep a partial program
+        mlstProgram.clear();
+    }
+
     //Show status bar message
     msbStatusBar->showMessage((bFailed == false ? "Script compile successful: no errors." : "Script compile failed due to syntax errors."));
 
@@ -260,9 +287,192 @@ bool AutScripting::on_btn_Compile_clicked()
     return bFailed;
 }
 
+bool AutScripting::CompileLine(const QString &strLine, int intLine, QList<scripting_instruction> *lstProgram, QHash<QString, int> *hashLabels)
+{
+    //Compiles a single script line, appending an instruction if it performs an action. Returns false on syntax error
+    int iLineLength = strLine.length();
+    scripting_instruction siInstruction;
+
+    if (iLineLength == 1)
+    {
+        //Fail
+        return false;
+    }
+    else if (iLineLength == 0 || strLine.left(2) == ScriptingComment)
+    {
+        //Blank line or comment, nothing to execute
+        return true;
+    }
+
+    siInstruction.line = intLine;
+    siInstruction.write_length = 0;
+    siInstruction.wait_ms = 0;
+    siInstruction.match_value = 0;
+    siInstruction.jump_index = 0;
+
+    if (strLine.at(0) == ScriptingWaitTime)
+    {
+        //Check if the time value is valid or not
+        bool bConverted = false;
+        int intConv = strLine.right(iLineLength-1).toInt(&bConverted);
+        if (bConverted == false || intConv <= 0)
+        {
+            //Invalid number or time value is 0 or negative
+            return false;
+        }
+
+        siInstruction.action = ScriptingActionWaitTime;
+        siInstruction.wait_ms = intConv;
+    }
+    else if (strLine.at(0) == ScriptingDataOut)
+    {
+        //Data to send, escaped once now rather than on every execution
+        siInstruction.action = ScriptingActionDataOut;
+        siInstruction.data = strLine.right(iLineLength-1).toUtf8();
+        AutEscape::escape_characters(&siInstruction.data);
+
+        //Set the number of bytes remaining to be written to the length of the string (only used if the WaitForWrite checkout is enabled)
+        siInstruction.write_length = QString(siInstruction.data).length();
+    }
+    else if (strLine.at(0) == ScriptingDataIn)
+    {
+        //Data to wait for
+        siInstruction.action = ScriptingActionDataIn;
+        siInstruction.data = strLine.right(iLineLength-1).toUtf8();
+        AutEscape::escape_characters(&siInstruction.data);
+        siInstruction.matcher.set_patterns(QList<QByteArray>() << siInstruction.data);
+    }
+    else if (strLine.at(0) == ScriptingDataInAny || strLine.at(0) == ScriptingDataInRegex)
+    {
+        //Timeout followed by data strings or a regular expression
+        int intSeparator = strLine.indexOf(ScriptingPatternSeparator);
+        bool bConverted = false;
+        int intConv;
+
+        if (intSeparator == -1 || intSeparator == (iLineLength-1))
+        {
+            //Missing data
+            return false;
+        }
+
+        intConv = strLine.mid(1, intSeparator-1).toInt(&bConverted);
+        if (bConverted == false || intConv <= 0)
+        {
+            //Invalid number or time value is 0 or negative
+            return false;
+        }
+
+        siInstruction.wait_ms = intConv;
+
+        if (strLine.at(0) == ScriptingDataInRegex)
+        {
+            siInstruction.action = ScriptingActionDataInRegex;
+
+            //Received data is matched as Latin-1 so that each character is one byte, non-ASCII characters in the pattern
+            //are converted to the same form so that they match their UTF-8 encoding
+            siInstruction.regex.setPattern(QString::fromLatin1(strLine.mid(intSeparator+1).toUtf8()));
+
+            if (!siInstruction.regex.isValid())
+            {
+                //Invalid regular expression
+                return false;
+            }
+
+            siInstruction.regex.optimize();
+        }
+        else
+        {
+            QStringList lstPatterns = strLine.mid(intSeparator+1).split(ScriptingPatternSeparator);
+            QList<QByteArray> lstMatchData;
+            int i = 0;
+
+            siInstruction.action = ScriptingActionDataInAny;
+
+            while (i < lstPatterns.length())
+            {
+                QByteArray baPattern = lstPatterns.at(i).toUtf8();
+                AutEscape::escape_characters(&baPattern);
+
+                if (baPattern.isEmpty())
+                {
+                    //Empty data string
+                    return false;
+                }
+
+                lstMatchData.append(baPattern);
+                ++i;
+            }
+
+            siInstruction.matcher.set_patterns(lstMatchData);
+        }
+    }
+    else if (strLine.at(0) == ScriptingBranch)
+    {
+        //Result value followed by a label name
+        int intSeparator = strLine.indexOf(' ');
+        bool bConverted = false;
+
+        if (intSeparator == -1)
+        {
+            //Missing label
+            return false;
+        }
+
+        siInstruction.action = ScriptingActionBranch;
+        siInstruction.match_value = strLine.mid(1, intSeparator-1).toInt(&bConverted);
+        siInstruction.label = strLine.mid(intSeparator+1).trimmed();
+
+        if (bConverted == false || siInstruction.match_value < 0 || siInstruction.label.isEmpty())
+        {
+            //Invalid result value or label
+            return false;
+        }
+    }
+    else if (strLine.at(0) == ScriptingLabel)
+    {
+        //Label marks the index of the next instruction
+        QString strLabel = strLine.mid(1).trimmed();
+
+        if (strLabel.isEmpty() || hashLabels->contains(strLabel))
+        {
+            //Empty or duplicate label
+            return false;
+        }
+
+        hashLabels->insert(strLabel, lstProgram->length());
+        return true;
+    }
+    else if (QString(strLine).replace("\t", "").replace(" ", "").length() > 0)
+    {
+        //Text present that isn't space/tab or a valid command
+        return false;
+    }
+    else
+    {
+        //Whitespace only
+        return true;
+    }
+
+    lstProgram->append(siInstruction);
+
+    return true;
+}
+
 void AutScripting::on_btn_Run_clicked()
 {
     //Run script
+    RunScript();
+}
+
+bool AutScripting::CompileScript()
+{
+    //Compiles the script without running it, returns false if there are syntax errors
+    return (on_btn_Compile_clicked() == false);
+}
+
+bool AutScripting::RunScript()
+{
+    //Compiles the script and requests execution, returns false if the script cannot be run
     if (mbSerialStatus == true && on_btn_Compile_clicked() == false)
     {
         //Compile successful, check if main form is busy
@@ -270,7 +480,10 @@ void AutScripting::on_btn_Run_clicked()
         mnScriptLines = ui->edit_Script->blockCount();
         msbStatusBar->showMessage("Script execution request pending...");
         emit ScriptStartRequest();
+        return true;
     }
+
+    return false;
 }
 
 void AutScripting::SerialPortStatus(bool bPortStatus)
@@ -332,6 +545,9 @@ void AutScripting::on_btn_Stop_clicked()
     {
         //Stop execution and timer
         mbIsRunning = false;
+        mbScriptPassed = false;
+        FinishTiming();
+        ProfileEnd();
         if (mtmrPauseTimer.isActive())
         {
             mtmrPauseTimer.stop();
@@ -343,9 +559,16 @@ void AutScripting::on_btn_Stop_clicked()
             mtmrUpdateTimer.stop();
         }
 
+        //Stop receive timeout timer if running
+        if (mtmrWaitTimeout.isActive())
+        {
+            mtmrWaitTimeout.stop();
+        }
+
         //Clear buffers
         mbaRecvData.clear();
-        mbaMatchData.clear();
+        mmatcherRecv.reset();
+        mintRecvPartial = 0;
         mbWaitingForReceive = false;
 
         //Disable read only mode of editor
@@ -387,60 +610,94 @@ void AutScripting::on_btn_Stop_clicked()
 
 void AutScripting::AdvanceLine()
 {
-    //Executes the next script line
-    if (mtmrUpdateTimer.isActive() && ucLastAct != ScriptingActionDataIn)
+    //Executes the next compiled script instruction, the editor is only updated when execution has to wait
+    if (mtmrUpdateTimer.isActive() && ucLastAct != ScriptingActionDataIn && ucLastAct != ScriptingActionDataInAny && ucLastAct != ScriptingActionDataInRegex)
     {
         //Stop pause update timer
         mtmrUpdateTimer.stop();
     }
 
-    while (mtbExecutionBlock.isValid())
+    while (true)
     {
-        //Execution block exists
-        ui->edit_Script->SetExecutionLine(mintCLine);
-
-        if (mbIsRunning == false)
+        while (mintProgramIndex < mlstProgram.length())
         {
-            //Cancelled
-            return;
-        }
-        else if (ui->btn_Pause->isChecked())
-        {
-            //Execution is paused
-            return;
-        }
+            //Instruction exists
+            if (mbIsRunning == false)
+            {
+                //Cancelled
+                return;
+            }
+            else if (ui->btn_Pause->isChecked())
+            {
+                //Execution is paused
+                ui->edit_Script->SetExecutionLine(mintCLine);
+                return;
+            }
 
-        if (mtbExecutionBlock.text().length() > 0)
-        {
-            //Some data is present
-            if (mtbExecutionBlock.text().at(0) == ScriptingDataOut)
+            const scripting_instruction &siCurrent = mlstProgram.at(mintProgramIndex);
+            mintCLine = siCurrent.line;
+
+            if (mbRecordTimings == true && mbWaitingForReceive == false && siCurrent.action != ScriptingActionBranch)
+            {
+                //New line is starting execution
+                StartTiming(&siCurrent);
+            }
+
+            if (siCurrent.action == ScriptingActionDataOut)
             {
                 //Clear receive buffer and send data out
                 mbaRecvData.clear();
-                QByteArray baTmpDat(mtbExecutionBlock.text().right(mtbExecutionBlock.text().length()-1).toUtf8());
-                AutEscape::escape_characters(&baTmpDat);
+                mbBytesWriteRemain = siCurrent.write_length;
 
-                //Set the number of bytes remaining to be written to the length of the string (only used if the WaitForWrite checkout is enabled)
-                mbBytesWriteRemain = QString(baTmpDat).length();
+                if (mbBenchmark == false)
+                {
+                    if (mbProfile == true)
+                    {
+                        ProfileEnter(siCurrent.line, ScriptingProfileSend, true);
+                    }
 
-                //Pass the data back to the main form
-                emit SendData(baTmpDat, false, true);
+                    //Pass the data back to the main form
+                    emit SendData(siCurrent.data, false, true);
+                }
 
                 ucLastAct = ScriptingActionDataOut;
 
-                if (ui->check_WaitForWrite->isChecked() == true)
+                if (mbWaitForWrite == true)
                 {
                     //Wait for data to leave the buffer
+                    if (mbProfile == true)
+                    {
+                        ProfileEnter(siCurrent.line, ScriptingProfileWaitWrite, false);
+                    }
+
+                    ui->edit_Script->SetExecutionLine(mintCLine);
                     UpdateStatusBar();
                     return;
                 }
             }
-            else if (mtbExecutionBlock.text().at(0) == ScriptingDataIn)
+            else if (siCurrent.action == ScriptingActionDataIn || siCurrent.action == ScriptingActionDataInAny || siCurrent.action == ScriptingActionDataInRegex)
             {
                 //Receive
-                mbaMatchData = mtbExecutionBlock.text().right(mtbExecutionBlock.text().length()-1).toUtf8();
-                AutEscape::escape_characters(&mbaMatchData);
-                ucLastAct = ScriptingActionDataIn;
+                ucLastAct = siCurrent.action;
+
+                if (mbWaitingForReceive == false)
+                {
+                    //New receive command, load the precompiled matcher and start timeout if the command has one.
+                    //Bytes kept from a partial match of the previous command are fed to the new matcher again
+                    mmatcherRecv = siCurrent.matcher;
+                    mintRecvDiscarded = 0;
+                    mintRecvPartial = 0;
+
+                    if (mbProfile == true)
+                    {
+                        ProfileEnter(siCurrent.line, ScriptingProfileWaitData, true);
+                    }
+
+                    if (siCurrent.action != ScriptingActionDataIn)
+                    {
+                        mtmrWaitTimeout.start(siCurrent.wait_ms);
+                    }
+                }
 
                 if (!gtmrRecTimer.isValid())
                 {
@@ -452,10 +709,12 @@ void AutScripting::AdvanceLine()
                 if (CheckRecvMatchBuffers() == false)
                 {
                     //Waiting on a match
-                    if (mbaRecvData.length() > ui->spin_MaxRecBufSize->value())
+                    ui->edit_Script->SetExecutionLine(mintCLine);
+
+                    if ((mintRecvDiscarded + mbaRecvData.length()) > ui->spin_MaxRecBufSize->value())
                     {
                         //Buffer is too big, clear and fail the script
-                        QString strMsg = QString("Script failed (expected data not found after ").append(ui->spin_MaxRecBufSize->text()).append(" bytes (").append(QString::number(mbaRecvData.length())).append(" bytes in buffer) after ");
+                        QString strMsg = QString("Script failed (expected data not found after ").append(ui->spin_MaxRecBufSize->text()).append(" bytes (").append(QString::number(mintRecvDiscarded + mbaRecvData.length())).append(" bytes in buffer) after ");
                         ui->edit_Script->SetExecutionLineStatus(true);
                         on_btn_Stop_clicked();
                         strMsg.append(msbStatusBar->currentMessage().right(msbStatusBar->currentMessage().length()-21));
@@ -467,64 +726,76 @@ void AutScripting::AdvanceLine()
                     return;
                 }
             }
-            else if (mtbExecutionBlock.text().at(0) == ScriptingWaitTime)
+            else if (siCurrent.action == ScriptingActionBranch)
+            {
+                //Jump if the last ? or % command had the required result
+                if (mintLastMatch == siCurrent.match_value)
+                {
+                    //Result is consumed by the jump so that a loop cannot spin without another receive command
+                    mintLastMatch = -1;
+                    mintProgramIndex = siCurrent.jump_index;
+                    continue;
+                }
+            }
+            else if (siCurrent.action == ScriptingActionWaitTime)
             {
                 //Wait for a specified period of time
-                mtmrPauseTimer.start(mtbExecutionBlock.text().right(mtbExecutionBlock.text().length()-1).toUInt());
-                mtbExecutionBlock = mtbExecutionBlock.next();
-                ++mintCLine;
+                if (mbProfile == true)
+                {
+                    ProfileEnter(siCurrent.line, ScriptingProfileWaitTime, true);
+                }
+
+                mtmrPauseTimer.start(siCurrent.wait_ms);
+                ++mintProgramIndex;
                 ucLastAct = ScriptingActionWaitTime;
+                ui->edit_Script->SetExecutionLine(mintCLine);
                 UpdateStatusBar();
                 mtmrUpdateTimer.start(1000);
                 return;
             }
-            else
+
+            ++mintProgramIndex;
+
+            if (gtmrRecTimer.isValid())
             {
-                //Comment line
-                ucLastAct = ScriptingActionOther;
+                //Stop timer and invalidate it
+                gtmrRecTimer.invalidate();
+                mtmrUpdateTimer.stop();
             }
         }
-        else
-        {
-            //Blank line
-            ucLastAct = ScriptingActionOther;
-        }
-        UpdateStatusBar();
-        mtbExecutionBlock = mtbExecutionBlock.next();
-        ++mintCLine;
 
-        if (gtmrRecTimer.isValid())
+        //Means execution has finished
+        if (mbBenchmark == true)
         {
-            //Stop timer and invalidate it
-            gtmrRecTimer.invalidate();
-            mtmrUpdateTimer.stop();
+            //Benchmark runs are a single pass with no user visible state
+            mbIsRunning = false;
+            return;
         }
-    }
 
-    //Means execution has finished
-    if (ui->spin_Repeats->value() != 0)
-    {
-        //Script repeating is enabled, check if we need to repeat the script
-        if (ui->spin_Repeats->value() == -1 || mnRepeats < ui->spin_Repeats->value())
+        if (ui->spin_Repeats->value() != 0 && (ui->spin_Repeats->value() == -1 || mnRepeats < ui->spin_Repeats->value()))
         {
-            //Repeat script and increment loop count
-            mintCLine = 0;
-            mtbExecutionBlock = ui->edit_Script->document()->firstBlock();
+            //Script repeating is enabled, repeat script and increment loop count
+            mintProgramIndex = 0;
             ++mnRepeats;
 
             //Clear data buffers
             mbaRecvData.clear();
-            mbaMatchData.clear();
             mbWaitingForReceive = false;
+            mintLastMatch = -1;
 
-            //Advance to the next (first) line
-            AdvanceLine();
-            return;
+            //Continue from the first instruction
+            continue;
         }
+
+        break;
     }
+
     mintCLine = -1;
     ui->edit_Script->SetExecutionLine(mintCLine);
     mbIsRunning = false;
+    mbScriptPassed = true;
+    FinishTiming();
+    ProfileEnd();
 
     //Disable read only mode of editor
     SetButtonStatus(true);
@@ -553,10 +824,74 @@ void AutScripting::AdvanceLine()
     emit ScriptFinished();
 }
 
+void AutScripting::RunBenchmark()
+{
+    //Measures compile and execution speed of a generated script with no waits, data is not sent to the device
+    QList<scripting_instruction> lstBenchmarkProgram;
+    QHash<QString, int> hashBenchmarkLabels;
+    QStringList lstLines;
+    QElapsedTimer tmrBenchmark;
+    qint64 intCompileTime;
+    qint64 intExecuteTime;
+    bool bRecordTimings;
+    int i = 0;
+
+    if (mbIsRunning == true)
+    {
+        return;
+    }
+
+    while (i < ScriptingBenchmarkLines)
+    {
+        //Mix of send lines with escape codes and comments
+        lstLines.append((i % 4) == 3 ? QString("// Benchmark comment %1").arg(i) : QString(">AT+BENCH=%1\\r\\n").arg(i));
+        ++i;
+    }
+
+    tmrBenchmark.start();
+    i = 0;
+    while (i < lstLines.length())
+    {
+        CompileLine(lstLines.at(i), i, &lstBenchmarkProgram, &hashBenchmarkLabels);
+        ++i;
+    }
+    intCompileTime = tmrBenchmark.nsecsElapsed();
+
+    //Swap in the benchmark program and run it through the execution engine
+    mlstProgram.swap(lstBenchmarkProgram);
+    mintProgramIndex = 0;
+    bRecordTimings = mbRecordTimings;
+    mbRecordTimings = false;
+    mbBenchmark = true;
+    mbWaitForWrite = false;
+    mbIsRunning = true;
+    mbaRecvData.clear();
+    mbWaitingForReceive = false;
+    mintLastMatch = -1;
+
+    tmrBenchmark.restart();
+    AdvanceLine();
+    intExecuteTime = tmrBenchmark.nsecsElapsed();
+
+    mbBenchmark = false;
+    mbRecordTimings = bRecordTimings;
+    mbIsRunning = false;
+    mintCLine = -1;
+    mlstProgram.swap(lstBenchmarkProgram);
+
+    if (intExecuteTime == 0)
+    {
+        //Avoid division by zero
+        intExecuteTime = 1;
+    }
+
+    msbStatusBar->showMessage(QString("Benchmark: %1 lines compiled in %2ms, executed in %3ms (~%4 lines/second).").arg(QString::number(ScriptingBenchmarkLines), QString::number((double)intCompileTime/1000000.0, 'f', 1), QString::number((double)intExecuteTime/1000000.0, 'f', 1), QString::number((quint64)ScriptingBenchmarkLines * 1000000000ULL / (quint64)intExecuteTime)));
+}
+
 void AutScripting::on_btn_Help_clicked()
 {
     //Display help
-    QString strMessage = "AuTerm Scripting: This is a simple scripting language for sending/receiving data and waiting for specific periods of time. Each line must begin directly with a valid command and the parameter for that command. Commands are:\r\n    >  Send data out\r\n    <  Wait to receive data\r\n    ~  Wait for a period (in ms)\r\n    // A null-operation comment (used for describing the code)\r\n\r\nValid commands will be highlighed in red and comments in green. Use the check button (yellow warning icon) to check for syntax errors in a script before running it.\r\n\r\nTo the left side of the editor are individual line colours which will change to indicate the following:\r\n    Red:   Syntax error with line (compile failed)\r\n    Green: Currently executing line\r\n    Black: Script execution failed on this line";
+    QString strMessage = "AuTerm Scripting: This is a simple scripting language for sending/receiving data and waiting for specific periods of time. Each line must begin directly with a valid command and the parameter for that command. Commands are:\r\n    >  Send data out\r\n    <  Wait to receive data\r\n    ~  Wait for a period (in ms)\r\n    ?  Wait for any of several data strings, up to a timeout (in ms), e.g. ?5000|OK|ERROR\r\n    %  Wait for data matching a regular expression, up to a timeout (in ms), e.g. %5000|\\+RSSI: -?\\d+\r\n    =  Jump to a label if the last ? or % command matched data string n (0 for timeout), e.g. =2 error\r\n    :  Label which can be jumped to, e.g. :error\r\n    // A null-operation comment (used for describing the code)\r\n\r\nValid commands will be highlighed in red and comments in green. Use the check button (yellow warning icon) to check for syntax errors in a script before running it.\r\n\r\nTo the left side of the editor are individual line colours which will change to indicate the following:\r\n    Red:   Syntax error with line (compile failed)\r\n    Green: Currently executing line\r\n    Black: Script execution failed on this line";
     mFormAuto->SetMessage(&strMessage);
     mFormAuto->show();
 }
@@ -569,29 +904,112 @@ void AutScripting::SetAuTermVersion(const QString strVersion)
 
 bool AutScripting::CheckRecvMatchBuffers()
 {
-    //Check if the receive buffer contains the match data
-    if (mbaRecvData.length() >= mbaMatchData.length())
+    //Check newly received data against the current receive command. Data that cannot form part of a
+    //match is discarded and the matcher keeps partial match state, so each byte is only checked once
+    const scripting_instruction &siCurrent = mlstProgram.at(mintProgramIndex);
+    int intConsumed = 0;
+    int intMatch = -1;
+
+    if (siCurrent.action == ScriptingActionDataInRegex)
     {
-        //Length of receive buffer is greater than or equal to the match string, perform search
-        int intPos = mbaRecvData.indexOf(mbaMatchData);
+        //Regular expression, keep data from the start of any partial match for when more data arrives. This is not
+        //streaming: the retained data is matched again from the start of the partial match each time data arrives,
+        //the amount retained (and so rescanned) is limited by the maximum receive buffer size. The data is viewed as
+        //Latin-1 so that match offsets are byte offsets, even for invalid UTF-8 or binary data
+        QString strSubject = QString::fromLatin1(mbaRecvData);
+        QRegularExpressionMatch rxmMatch = siCurrent.regex.match(strSubject, 0, QRegularExpression::PartialPreferCompleteMatch);
+
+        if (rxmMatch.hasMatch())
+        {
+            intMatch = 0;
+            intConsumed = rxmMatch.capturedEnd();
 
-        if (intPos != -1 && intPos < ui->spin_MaxRecBufSize->value())
+            if ((mintRecvDiscarded + rxmMatch.capturedStart()) >= ui->spin_MaxRecBufSize->value())
+            {
+                //Match position is beyond the maximum receive buffer size
+                intMatch = -1;
+            }
+        }
+        else if (rxmMatch.hasPartialMatch())
         {
-            //Position OK: shift array and progress to next line
-            mbaRecvData = mbaRecvData.right(mbaRecvData.length() - intPos - mbaMatchData.length());
-            mbWaitingForReceive = false;
-            return true;
+            intConsumed = rxmMatch.capturedStart();
+        }
+        else
+        {
+            intConsumed = mbaRecvData.length();
         }
     }
+    else
+    {
+        //Bytes of a partial match are already known to the matcher, only data after them is fed
+        int intFed = 0;
 
-    //Buffer doesn't contain requested data
-    return false;
+        intMatch = mmatcherRecv.feed(mbaRecvData.constData() + mintRecvPartial, mbaRecvData.length() - mintRecvPartial, &intFed);
+        intConsumed = mintRecvPartial + intFed;
+
+        if (intMatch == -1)
+        {
+            //Keep the bytes of the longest partial match so that data spanning a timeout can still be matched by
+            //the next receive command
+            mintRecvPartial = mmatcherRecv.partial_length();
+            intConsumed -= mintRecvPartial;
+        }
+        else
+        {
+            mintRecvPartial = 0;
+
+            if ((mintRecvDiscarded + intConsumed - mmatcherRecv.pattern_length(intMatch)) >= ui->spin_MaxRecBufSize->value())
+            {
+                //Match position is beyond the maximum receive buffer size
+                intMatch = -1;
+            }
+        }
+    }
+
+    mbaRecvData.remove(0, intConsumed);
+
+    if (intMatch == -1)
+    {
+        //Buffer doesn't contain requested data
+        mintRecvDiscarded += intConsumed;
+        return false;
+    }
+
+    //Match found: remaining data is kept for the next command
+    if (siCurrent.action != ScriptingActionDataIn)
+    {
+        mtmrWaitTimeout.stop();
+        mintLastMatch = intMatch + 1;
+    }
+
+    mbWaitingForReceive = false;
+    return true;
+}
+
+void AutScripting::WaitTimeout()
+{
+    //A ? or % command has timed out, continue with no match
+    if (mbIsRunning == true && mbWaitingForReceive == true)
+    {
+        mbWaitingForReceive = false;
+        mintLastMatch = 0;
+        ++mintProgramIndex;
+
+        if (gtmrRecTimer.isValid())
+        {
+            //Stop timer and invalidate it
+            gtmrRecTimer.invalidate();
+            mtmrUpdateTimer.stop();
+        }
+
+        AdvanceLine();
+    }
 }
 
 void AutScripting::SerialPortWritten(int iWritten)
 {
     //Serial bytes have been written
-    if (mbIsRunning == true && ui->check_WaitForWrite->isChecked() == true)
+    if (mbIsRunning == true && mbWaitForWrite == true)
     {
         //Remove from the expected number of bytes
         mbBytesWriteRemain = mbBytesWriteRemain - iWritten;
@@ -599,8 +1017,7 @@ void AutScripting::SerialPortWritten(int iWritten)
         if (mbBytesWriteRemain <= 0)
         {
             //Bytes have been fully written, advance to next line
-            mtbExecutionBlock = mtbExecutionBlock.next();
-            ++mintCLine;
+            ++mintProgramIndex;
 
             //Run the next line
             AdvanceLine();
@@ -621,13 +1038,12 @@ void AutScripting::on_btn_Pause_toggled(bool)
         else if (ucLastAct == ScriptingActionDataOut)
         {
             //Waiting for data to be written
-            if (ui->check_WaitForWrite->isChecked() == true)
+            if (mbWaitForWrite == true)
             {
                 if (mbBytesWriteRemain <= 0)
                 {
                     //Bytes have been fully written, advance to next line
-                    mtbExecutionBlock = mtbExecutionBlock.next();
-                    ++mintCLine;
+                    ++mintProgramIndex;
 
                     //Run the next line
                     AdvanceLine();
@@ -677,13 +1093,18 @@ void AutScripting::UpdateStatusBar()
         else
         {
             //Time left
-            msbStatusBar->showMessage(QString("#%1: Waiting to receive data (%2 bytes received in %3 seconds)%4... (%5)").arg(QString::number(mintCLine+1), QString::number(mbaRecvData.length()), QString::number(dblRecTimeSec, 'f', 1), (mnRepeats > 0 ? QString(" with %1 repeat%s").arg(QString::number(mnRepeats), (mnRepeats == 1 ? "" : "s")) : ""), strPercent));
+            msbStatusBar->showMessage(QString("#%1: Waiting to receive data (%2 bytes received in %3 seconds)%4... (%5)").arg(QString::number(mintCLine+1), QString::number(mintRecvDiscarded + mbaRecvData.length()), QString::number(dblRecTimeSec, 'f', 1), (mnRepeats > 0 ? QString(" with %1 repeat%s").arg(QString::number(mnRepeats), (mnRepeats == 1 ? "" : "s")) : ""), strPercent));
         }
     }
+    else if (ucLastAct == ScriptingActionDataInAny || ucLastAct == ScriptingActionDataInRegex)
+    {
+        //Receiving data with a timeout
+        msbStatusBar->showMessage(QString("#%1: Waiting to receive %2 (%3 bytes received, %4ms left)%5... (%6)").arg(QString::number(mintCLine+1), (ucLastAct == ScriptingActionDataInRegex ? "regular expression match" : "any data match"), QString::number(mintRecvDiscarded + mbaRecvData.length()), QString::number(mtmrWaitTimeout.remainingTime()), (mnRepeats > 0 ? QString(" with %1 repeat%2").arg(QString::number(mnRepeats), (mnRepeats == 1 ? "" : "s")) : ""), strPercent));
+    }
     else if (ucLastAct == ScriptingActionDataOut)
     {
         //Data output
-        if (ui->check_WaitForWrite->isChecked() == true)
+        if (mbWaitForWrite == true)
         {
             //Sending data and waiting for it to be flushed
             msbStatusBar->showMessage(QString("#%1: Waiting to data to be flushed (%2 bytes remaining)%3... (%4)").arg(QString::number(mintCLine+1), QString::number(mbBytesWriteRemain), (mnRepeats > 0 ? QString(" with %1 repeat%2").arg(QString::number(mnRepeats), (mnRepeats == 1 ? "" : "s")) : ""), strPercent));
@@ -697,7 +1118,7 @@ void AutScripting::UpdateStatusBar()
     else if (ucLastAct == ScriptingActionWaitTime)
     {
         //Wait period
-        msbStatusBar->showMessage(QString("#%1: Wait period %2ms (%3ms left)%4... (%5)").arg(QString::number(mintCLine), QString::number(mtmrPauseTimer.interval()), QString::number(mtmrPauseTimer.remainingTime()), (mnRepeats > 0 ? QString(" with %1 repeat%2").arg(QString::number(mnRepeats), (mnRepeats == 1 ? "" : "s")) : ""), strPercent));
+        msbStatusBar->showMessage(QString("#%1: Wait period %2ms (%3ms left)%4... (%5)").arg(QString::number(mintCLine+1), QString::number(mtmrPauseTimer.interval()), QString::number(mtmrPauseTimer.remainingTime()), (mnRepeats > 0 ? QString(" with %1 repeat%2").arg(QString::number(mnRepeats), (mnRepeats == 1 ? "" : "s")) : ""), strPercent));
     }
     else
     {
@@ -735,6 +1156,39 @@ void AutScripting::MenuSelected(QAction *qaAction)
         //Change font
         ChangeFont();
     }
+    else if (intItem == MenuActionBenchmark)
+    {
+        //Run execution benchmark
+        RunBenchmark();
+    }
+    else if (intItem == MenuActionProfile)
+    {
+        //Enable or disable profiling for the next run
+        mbProfile = mqaProfile->isChecked();
+
+        if (mbProfile == false && mbIsRunning == false)
+        {
+            ui->edit_Script->ClearLineAnnotations();
+        }
+    }
+    else if (intItem == MenuActionShowProfile)
+    {
+        //Show profile table
+        if (mvecProfile.isEmpty())
+        {
+            msbStatusBar->showMessage("No profile available, enable Profile Execution in the options menu and run the script.");
+            return;
+        }
+
+        if (mfrmProfile == nullptr)
+        {
+            mfrmProfile = new AutScriptProfile(this);
+        }
+
+        UpdateProfileDisplay();
+        mfrmProfile->show();
+        mfrmProfile->raise();
+    }
 }
 
 void AutScripting::on_btn_Clear_clicked()
@@ -798,13 +1252,34 @@ void AutScripting::ScriptStartResult(bool bStatus, unsigned char ucReason)
     {
         //OK to start script execution
         mintCLine = 0;
-        mtbExecutionBlock = ui->edit_Script->document()->firstBlock();
+        mintProgramIndex = 0;
+        mbWaitForWrite = ui->check_WaitForWrite->isChecked();
         mbIsRunning = true;
 
         //Clear data buffers
         mbaRecvData.clear();
-        mbaMatchData.clear();
         mbWaitingForReceive = false;
+        mintLastMatch = -1;
+        mbScriptPassed = false;
+        mvecTimings.clear();
+        mintTimingLine = -1;
+        mintTimingLastLine = -1;
+        mvecProfile.clear();
+        mintProfileState = ScriptingProfileNone;
+
+        if (mbProfile == true)
+        {
+            //One entry per editor line, zero initialised
+            scripting_profile spEmpty = {};
+            mvecProfile.fill(spEmpty, ui->edit_Script->document()->blockCount());
+        }
+
+        if (mbRecordTimings == true)
+        {
+            //One entry per editor line, lines which are never executed keep a count of 0
+            scripting_timing stEmpty = {};
+            mvecTimings.fill(stEmpty, ui->edit_Script->document()->blockCount());
+        }
 
         //Set editor to be read only
         SetButtonStatus(false);
@@ -851,6 +1326,166 @@ void AutScripting::SetScriptLastDirectory(const QString *strDirectory)
     strLastScriptFile = *strDirectory;
 }
 
+void AutScripting::SetScriptText(const QString &strScript)
+{
+    //Replaces the editor contents
+    ui->edit_Script->setPlainText(strScript);
+}
+
+void AutScripting::SetRunOptions(int intRepeats, int intMaxReceiveTime, int intMaxReceiveBuffer, bool bWaitForWrite)
+{
+    //Sets the execution options which are normally set in the GUI
+    ui->spin_Repeats->setValue(intRepeats);
+    ui->spin_MaxRecTime->setValue(intMaxReceiveTime);
+    ui->spin_MaxRecBufSize->setValue(intMaxReceiveBuffer);
+    ui->check_WaitForWrite->setChecked(bWaitForWrite);
+}
+
+void AutScripting::SetRecordTimings(bool bEnabled)
+{
+    //Enables or disables recording the execution time of each line
+    mbRecordTimings = bEnabled;
+}
+
+const QVector<scripting_timing> *AutScripting::GetTimings() const
+{
+    return &mvecTimings;
+}
+
+int AutScripting::LastTimedLine() const
+{
+    return mintTimingLastLine;
+}
+
+bool AutScripting::ScriptPassed() const
+{
+    return mbScriptPassed;
+}
+
+QString AutScripting::ScriptStatus() const
+{
+    return msbStatusBar->currentMessage();
+}
+
+void AutScripting::StartTiming(const scripting_instruction *siInstruction)
+{
+    //Closes the timing of the previous line and begins timing the supplied line
+    FinishTiming();
+
+    if (siInstruction->line >= mvecTimings.length())
+    {
+        return;
+    }
+
+    mvecTimings[siInstruction->line].line = siInstruction->line;
+    mvecTimings[siInstruction->line].action = siInstruction->action;
+    mintTimingLine = siInstruction->line;
+    mintTimingLastLine = siInstruction->line;
+    mintTimingStart = gtmrScriptTimer.nsecsElapsed();
+}
+
+void AutScripting::FinishTiming()
+{
+    //Adds the duration of the line currently being timed to its totals, if there is one
+    if (mbRecordTimings == true && mintTimingLine != -1)
+    {
+        scripting_timing &stTiming = mvecTimings[mintTimingLine];
+        qint64 intDuration = gtmrScriptTimer.nsecsElapsed() - mintTimingStart;
+
+        if (stTiming.count == 0 || intDuration < stTiming.min_ns)
+        {
+            stTiming.min_ns = intDuration;
+        }
+
+        if (stTiming.count == 0 || intDuration > stTiming.max_ns)
+        {
+            stTiming.max_ns = intDuration;
+        }
+
+        stTiming.total_ns += intDuration;
+        ++stTiming.count;
+        mintTimingLine = -1;
+    }
+}
+
+void AutScripting::ProfileEnter(int intLine, qint8 intState, bool bHit)
+{
+    //Closes the state currently being profiled and begins profiling the supplied line and state
+    ProfileEnd();
+
+    if (intLine >= mvecProfile.length())
+    {
+        return;
+    }
+
+    if (bHit == true)
+    {
+        ++mvecProfile[intLine].hits;
+    }
+
+    mintProfileLine = intLine;
+    mintProfileState = intState;
+    mintProfileStart = gtmrScriptTimer.nsecsElapsed();
+}
+
+void AutScripting::ProfileEnd()
+{
+    //Adds the time spent in the current profiled state to the line totals
+    if (mintProfileState != ScriptingProfileNone)
+    {
+        qint64 intElapsed = gtmrScriptTimer.nsecsElapsed() - mintProfileStart;
+        scripting_profile &spLine = mvecProfile[mintProfileLine];
+
+        spLine.total_ns[mintProfileState] += intElapsed;
+        if (intElapsed > spLine.max_ns[mintProfileState])
+        {
+            spLine.max_ns[mintProfileState] = intElapsed;
+        }
+
+        mintProfileState = ScriptingProfileNone;
+    }
+
+    if (mbIsRunning == false && !mvecProfile.isEmpty())
+    {
+        //Run has ended, show the results
+        UpdateProfileDisplay();
+    }
+}
+
+void AutScripting::UpdateProfileDisplay()
+{
+    //Annotates the editor with the total time spent on each line and refreshes the profile table if it is open
+    QHash<int, QString> hashAnnotations;
+    int i = 0;
+
+    while (i < mvecProfile.length())
+    {
+        if (mvecProfile.at(i).hits > 0)
+        {
+            qint64 intTotal = 0;
+            int l = 0;
+
+            while (l < ScriptingProfileStates)
+            {
+                intTotal += mvecProfile.at(i).total_ns[l];
+                ++l;
+            }
+
+            hashAnnotations.insert(i, AutScriptProfile::FormatDuration(intTotal));
+        }
+
+        ++i;
+    }
+
+    ui->edit_Script->SetLineAnnotations(hashAnnotations);
+
+    if (mfrmProfile != nullptr)
+    {
+        QStringList lstLines = ui->edit_Script->toPlainText().split('\n');
+        mfrmProfile->SetProfile(&mvecProfile, lstLines);
+    }
+}
+
 /******************************************************************************/
 // END OF FILE
 /******************************************************************************/
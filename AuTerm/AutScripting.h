@@ -43,7 +43,11 @@
 #include <QMenu>
 #include <QKeySequence>
 #include <QShortcut>
+#include <QRegularExpression>
+#include <QHash>
 #include "AutEscape.h"
+#include "AutStreamMatcher.h"
+#include "AutScriptProfile.h"
 
 /******************************************************************************/
 // Defines
@@ -63,16 +67,28 @@
 const QChar   ScriptingDataIn              = '<';  //Command that waits for data to be received
 const QChar   ScriptingDataOut             = '>';  //Command that sends data out to module
 const QChar   ScriptingWaitTime            = '~';  //Command that waits for a period of time (in ms)
+const QChar   ScriptingDataInAny           = '?';  //Command that waits for any of several data strings to be received, with a timeout
+const QChar   ScriptingDataInRegex         = '%';  //Command that waits for data matching a regular expression to be received, with a timeout
+const QChar   ScriptingBranch              = '=';  //Command that jumps to a label depending upon the result of the last ? or % command
+const QChar   ScriptingLabel               = ':';  //Label that can be jumped to
+const QChar   ScriptingPatternSeparator    = '|';  //Separator between the timeout and data strings of ? and % commands
 const QString ScriptingComment             = "//"; //A null-function command that is used to explain/comment code
 const qint8   ScriptingActionDataIn        = 1;    //Action ID when waiting to receive data
 const qint8   ScriptingActionDataOut       = 2;    //Action ID when sending data out
 const qint8   ScriptingActionWaitTime      = 3;    //Action ID when waiting for a period of time
 const qint8   ScriptingActionOther         = 4;    //Action ID when doing no action (empty line/comment)
+const qint8   ScriptingActionDataInAny     = 5;    //Action ID when waiting to receive any of several data strings
+const qint8   ScriptingActionDataInRegex   = 6;    //Action ID when waiting to receive data matching a regular expression
+const qint8   ScriptingActionBranch        = 7;    //Action ID when jumping to a label
 const qint8   MenuActionChangeFont         = 1;    //Menu action ID for changing font
 const qint8   MenuActionExportStringPlayer = 2;    //Menu action ID for exporting to string player
+const qint8   MenuActionBenchmark          = 3;    //Menu action ID for running the execution benchmark
+const qint8   MenuActionProfile            = 4;    //Menu action ID for enabling execution profiling
+const qint8   MenuActionShowProfile        = 5;    //Menu action ID for showing the execution profile
 const qint8   ScriptingReasonOK            = 0;    //Return code for no error
 const qint8   ScriptingReasonPortClosed    = 1;    //Return code if serial port is not open
 const qint8   ScriptingReasonTermBusy      = 2;    //Return code if terminal is busy
+const int     ScriptingBenchmarkLines      = 100000; //Number of lines in the generated no-wait script used for the execution benchmark
 
 /******************************************************************************/
 // Forward declaration of Class, Struct & Unions
@@ -82,6 +98,30 @@ namespace Ui
     class AutScripting;
 }
 
+//Struct used for holding a compiled script instruction
+struct scripting_instruction {
+    qint8 action; //Action ID of the instruction
+    int line; //Editor line number that the instruction was compiled from
+    QByteArray data; //Escaped data to send or match
+    int write_length; //Length of data to wait for being written (send instructions)
+    uint32_t wait_ms; //Time to wait in ms (wait instructions) or receive timeout in ms (? and % instructions)
+    AutStreamMatcher matcher; //Matcher for data strings (receive instructions)
+    QRegularExpression regex; //Regular expression to match (% instructions)
+    int match_value; //Result of the last ? or % instruction which causes the jump (branch instructions)
+    int jump_index; //Instruction index to jump to (branch instructions)
+    QString label; //Name of label to jump to (branch instructions)
+};
+
+//Struct used for holding the execution times of a script line, accumulated over every execution so the size does not depend on the number of repeats
+struct scripting_timing {
+    int line; //Editor line number that was executed
+    qint8 action; //Action ID of the line
+    quint64 count; //Number of times the line was executed
+    qint64 total_ns; //Total time the line took to complete (in ns)
+    qint64 min_ns; //Shortest time the line took to complete (in ns)
+    qint64 max_ns; //Longest time the line took to complete (in ns)
+};
+
 /******************************************************************************/
 // Class definitions
 /******************************************************************************/
@@ -105,6 +145,15 @@ public:
     void ScriptStartResult(bool bStatus, unsigned char ucReason);
     void LoadScriptFile(const QString *strFilename);
     void SetScriptLastDirectory(const QString *strDirectory);
+    void SetScriptText(const QString &strScript);
+    bool CompileScript();
+    bool RunScript();
+    void SetRunOptions(int intRepeats, int intMaxReceiveTime, int intMaxReceiveBuffer, bool bWaitForWrite);
+    void SetRecordTimings(bool bEnabled);
+    const QVector<scripting_timing> *GetTimings() const;
+    int LastTimedLine() const;
+    bool ScriptPassed() const;
+    QString ScriptStatus() const;
 
 private slots:
     void ChangeFont();
@@ -121,19 +170,48 @@ private slots:
     void on_btn_Options_clicked();
     void MenuSelected(QAction *qaAction);
     void on_btn_Clear_clicked();
+    void WaitTimeout();
 
 private:
+    bool CompileLine(const QString &strLine, int intLine, QList<scripting_instruction> *lstProgram, QHash<QString, int> *hashLabels);
+    void RunBenchmark();
+    void StartTiming(const scripting_instruction *siInstruction);
+    void FinishTiming();
+    void ProfileEnter(int intLine, qint8 intState, bool bHit);
+    void ProfileEnd();
+    void UpdateProfileDisplay();
+
     Ui::AutScripting *ui;
     PopupMessage *mFormAuto; //Holds handle of error message dialogue
     AutHighlighter *mhlHighlighter; //Handle for text highlighter
     int mintCLine; //Current line number
     QTimer mtmrPauseTimer; //Timer used for wait commands
-    QTextBlock mtbExecutionBlock; //Holds the current execution block from the editor
+    QList<scripting_instruction> mlstProgram; //Compiled script instructions
+    int mintProgramIndex; //Index of the current instruction in the compiled script
+    bool mbWaitForWrite; //Cached wait for write option at script start
+    bool mbBenchmark; //Set to true if the execution benchmark is running (data is not sent)
+    bool mbRecordTimings; //Set to true if the execution time of each line should be recorded
+    QVector<scripting_timing> mvecTimings; //Accumulated execution time of each line in the last run (if recording is enabled)
+    int mintTimingLine; //Line currently being timed (-1 if none)
+    qint64 mintTimingStart; //Time since the script started that the line currently being timed began (in ns)
+    int mintTimingLastLine; //Last line which was timed, this is the line the script was on when it finished (-1 if none)
+    bool mbScriptPassed; //Set to true if the last run completed without failing or being stopped
+    bool mbProfile; //Set to true if the time spent in each state of each line should be accumulated
+    QVector<scripting_profile> mvecProfile; //Accumulated execution profile of each line in the last run (if profiling is enabled)
+    int mintProfileLine; //Line currently being profiled
+    qint8 mintProfileState; //State currently being profiled (ScriptingProfileNone if not timing)
+    qint64 mintProfileStart; //Time since the script started that the current profiled state began (in ns)
+    AutScriptProfile *mfrmProfile; //Profile table dialogue
+    QAction *mqaProfile; //Options menu item for enabling profiling
     bool mbIsRunning; //Set to true if the script is running
     QString mstrAuTermVersion; //String containing the AuTerm version
     bool mbWaitingForReceive; //Set to true if waiting in a receive data command for data to arrive
-    QByteArray mbaMatchData; //Buffer containing data that is matched against data received from the module (awating a match)
-    QByteArray mbaRecvData; //Buffer containing data received from the module (awating a match)
+    AutStreamMatcher mmatcherRecv; //Streaming matcher for the current receive command, holds partial match state between received chunks
+    QByteArray mbaRecvData; //Buffer containing data received from the module which has not yet been checked or consumed by a match
+    qint64 mintRecvDiscarded; //Number of bytes received and discarded (not matching) whilst waiting for the current receive command
+    int mintRecvPartial; //Number of bytes at the start of mbaRecvData which have been fed to the matcher and form part of a partial match
+    int mintLastMatch; //Result of the last ? or % command (0 for timeout, otherwise the 1-based index of the matched data string)
+    QTimer mtmrWaitTimeout; //Timer used for the timeout of ? and % commands
     int mbBytesWriteRemain; //Number of bytes remaining to be written from the buffer (when specific mode is enabled)
     QStatusBar *msbStatusBar; //Pointer to scripting status bar
     bool mbSerialStatus; //True if serial port is open in main window
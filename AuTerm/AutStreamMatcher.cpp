@@ -0,0 +1,155 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module: AutStreamMatcher.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "AutStreamMatcher.h"
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+AutStreamMatcher::AutStreamMatcher()
+{
+}
+
+void AutStreamMatcher::set_patterns(const QList<QByteArray> &new_patterns)
+{
+    //Builds the failure table for each pattern
+    int i = 0;
+
+    patterns = new_patterns;
+    failure_tables.clear();
+
+    while (i < patterns.length())
+    {
+        const QByteArray &pattern = patterns.at(i);
+        QVector<int> table(pattern.length(), 0);
+        int matched = 0;
+        int l = 1;
+
+        while (l < pattern.length())
+        {
+            while (matched > 0 && pattern.at(l) != pattern.at(matched))
+            {
+                matched = table.at(matched - 1);
+            }
+
+            if (pattern.at(l) == pattern.at(matched))
+            {
+                ++matched;
+            }
+
+            table[l] = matched;
+            ++l;
+        }
+
+        failure_tables.append(table);
+        ++i;
+    }
+
+    reset();
+}
+
+void AutStreamMatcher::reset()
+{
+    //Forget any partial matches
+    states.fill(0, patterns.length());
+}
+
+int AutStreamMatcher::feed(const char *data, int length, int *consumed)
+{
+    //Feeds data to the matcher, returns the index of the first pattern to complete (or -1 if
+    //none did) and sets consumed to the number of bytes inspected (up to and including the end
+    //of the match). If several patterns complete on the same byte, the lowest index wins
+    int i = 0;
+
+    while (i < length)
+    {
+        char current = data[i];
+        int l = 0;
+
+        while (l < patterns.length())
+        {
+            const QByteArray &pattern = patterns.at(l);
+            const QVector<int> &table = failure_tables.at(l);
+            int matched = states.at(l);
+
+            while (matched > 0 && current != pattern.at(matched))
+            {
+                matched = table.at(matched - 1);
+            }
+
+            if (current == pattern.at(matched))
+            {
+                ++matched;
+            }
+
+            if (matched == pattern.length())
+            {
+                //Pattern found, remaining states are not valid past this point
+                *consumed = i + 1;
+                reset();
+                return l;
+            }
+
+            states[l] = matched;
+            ++l;
+        }
+
+        ++i;
+    }
+
+    *consumed = length;
+    return -1;
+}
+
+int AutStreamMatcher::pattern_count() const
+{
+    return patterns.length();
+}
+
+int AutStreamMatcher::pattern_length(int index) const
+{
+    return patterns.at(index).length();
+}
+
+int AutStreamMatcher::partial_length() const
+{
+    //Length of the longest partial match, these are the last bytes fed to the matcher
+    int longest = 0;
+
+    for (int matched : states)
+    {
+        if (matched > longest)
+        {
+            longest = matched;
+        }
+    }
+
+    return longest;
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
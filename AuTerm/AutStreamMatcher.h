@@ -0,0 +1,60 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module: AutStreamMatcher.h
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef AUTSTREAMMATCHER_H
+#define AUTSTREAMMATCHER_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QByteArray>
+#include <QList>
+#include <QVector>
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+//Streaming (KMP) matcher for one or more byte patterns, state is kept between
+//calls to feed() so data can be supplied in chunks and each byte is only
+//inspected once per pattern
+class AutStreamMatcher
+{
+public:
+    AutStreamMatcher();
+    void set_patterns(const QList<QByteArray> &patterns);
+    void reset();
+    int feed(const char *data, int length, int *consumed);
+    int pattern_count() const;
+    int pattern_length(int index) const;
+    int partial_length() const;
+
+private:
+    QList<QByteArray> patterns; //Patterns being searched for
+    QList<QVector<int>> failure_tables; //KMP failure table for each pattern
+    QVector<int> states; //Number of bytes of each pattern currently matched
+};
+
+#endif // AUTSTREAMMATCHER_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -28,17 +28,59 @@
 #include "AutMainWindow.h"
 #include <QApplication>
 #include <QCommandLineParser>
+#ifndef SKIPSCRIPTINGFORM
+#include "AutHeadlessRunner.h"
+#endif
 #if TARGET_OS_MAC
 #include <QStyleFactory>
 #endif
 
 int main(int argc, char *argv[])
 {
+#ifndef SKIPSCRIPTINGFORM
+    bool headless = false;
+    int i = 1;
+
+    while (i < argc)
+    {
+        if (QString(argv[i]).toUpper() == "HEADLESS")
+        {
+            headless = true;
+            break;
+        }
+
+        ++i;
+    }
+
+    if (headless == true && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        //Nothing is displayed in headless mode, so do not require a display server
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+#endif
+
     QApplication a(argc, argv);
 #if TARGET_OS_MAC
     //Fix for Mac to stop bad styling
     QApplication::setStyle(QStyleFactory::create("Fusion"));
 #endif
+
+#ifndef SKIPSCRIPTINGFORM
+    if (headless == true)
+    {
+        //Run script on serial port without the main window and exit with the result
+        AutHeadlessRunner runner;
+        int result = runner.start(QCoreApplication::arguments());
+
+        if (result != HeadlessStarted)
+        {
+            return result;
+        }
+
+        return a.exec();
+    }
+#endif
+
     AutMainWindow w;
     w.show();
 
@@ -0,0 +1,100 @@
+include(../../../AuTerm-includes.pri)
+
+QT -= gui
+QT += core serialport
+
+TEMPLATE = app
+
+CONFIG += console
+CONFIG += c++17
+CONFIG -= app_bundle
+
+INCLUDEPATH    += ..
+TARGET          = auterm-mcumgr
+
+# There is no GUI_PRESENT define, so the transports are built without their
+# setup dialogs and are configured from the command line instead. The logger
+# plugin is not available, debug output goes to stderr as JSON lines only when
+# VERBOSE is given.
+DEFINES += SKIPPLUGIN_LOGGER
+
+SOURCES += \
+    ../crc16.cpp \
+    ../crc32.cpp \
+    ../smp_chunk_tuner.cpp \
+    ../smp_error.cpp \
+    ../smp_file_writer.cpp \
+    ../smp_group_fs_mgmt.cpp \
+    ../smp_group_img_mgmt.cpp \
+    ../smp_group_os_mgmt.cpp \
+    ../smp_group_stat_mgmt.cpp \
+    ../smp_hash_checksum.cpp \
+    ../smp_image_source.cpp \
+    ../smp_message.cpp \
+    ../smp_message_pool.cpp \
+    ../smp_metrics.cpp \
+    ../smp_processor.cpp \
+    ../smp_rtt_estimator.cpp \
+    ../smp_uart_auterm.cpp \
+    main.cpp \
+    smp_cli_fleet.cpp \
+    smp_cli_session.cpp
+
+HEADERS += \
+    ../crc16.h \
+    ../crc32.h \
+    ../debug_logger.h \
+    ../smp_chunk_tuner.h \
+    ../smp_error.h \
+    ../smp_file_writer.h \
+    ../smp_group.h \
+    ../smp_group_fs_mgmt.h \
+    ../smp_group_img_mgmt.h \
+    ../smp_group_os_mgmt.h \
+    ../smp_group_stat_mgmt.h \
+    ../smp_hash_checksum.h \
+    ../smp_image_source.h \
+    ../smp_message.h \
+    ../smp_message_pool.h \
+    ../smp_metrics.h \
+    ../smp_processor.h \
+    ../smp_rtt_estimator.h \
+    ../smp_transport.h \
+    ../smp_uart_auterm.h \
+    smp_cli_fleet.h \
+    smp_cli_session.h
+
+contains(DEFINES, PLUGIN_MCUMGR_JSON) {
+    SOURCES += \
+	../smp_json.cpp
+
+    HEADERS += \
+	../smp_json.h
+}
+
+contains(DEFINES, PLUGIN_MCUMGR_TRANSPORT_UDP) {
+    QT += network
+
+    SOURCES += \
+	../smp_udp.cpp
+
+    HEADERS += \
+	../smp_udp.h
+}
+
+contains(DEFINES, PLUGIN_MCUMGR_TRANSPORT_LORAWAN) {
+    QT += network mqtt
+
+    SOURCES += \
+	../smp_lorawan.cpp
+
+    HEADERS += \
+	../smp_lorawan.h
+}
+
+# Common build location
+CONFIG(release, debug|release) {
+    DESTDIR = ../../../release
+} else {
+    DESTDIR = ../../../debug
+}
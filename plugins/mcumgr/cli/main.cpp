@@ -0,0 +1,779 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  main.cpp
+**
+** Notes:   Headless MCUmgr command line tool, runs one SMP operation on a
+**          device over UART, UDP or LoRaWAN and outputs the result as JSON
+**          for use in scripts (e.g. production line programming). With a
+**          device list, the operation is run on many devices concurrently
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QCoreApplication>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QFile>
+#include <QRegularExpression>
+#include <QJsonObject>
+#include "smp_cli_session.h"
+#include "smp_cli_fleet.h"
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+const int cli_exit_ok                = 0;
+const int cli_exit_failed            = 1; //Exit code if the operation failed on the device
+const int cli_exit_invalid_arguments = 2; //Exit code if the arguments are invalid
+const int cli_exit_transport_error   = 3; //Exit code if the device could not be connected to
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+static bool verbose_output = false;
+
+static void message_handler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    //The shared SMP code logs through qDebug(), this is only output when asked for and then as JSON records so that stderr stays machine readable
+    QJsonObject record;
+    QString level;
+
+    Q_UNUSED(context);
+
+    switch (type)
+    {
+        case QtDebugMsg:
+        {
+            level = "debug";
+            break;
+        }
+        case QtInfoMsg:
+        {
+            level = "information";
+            break;
+        }
+        case QtWarningMsg:
+        {
+            level = "warning";
+            break;
+        }
+        default:
+        {
+            level = "error";
+            break;
+        }
+    };
+
+    if (verbose_output == false && (type == QtDebugMsg || type == QtInfoMsg))
+    {
+        return;
+    }
+
+    record.insert("log", level);
+    record.insert("message", message);
+    smp_cli_session::write_record(record);
+}
+
+static void usage(QTextStream &output)
+{
+    output << "Usage: auterm-mcumgr COMMAND=command [KEY=VALUE]..." << "\n"
+           << "Commands:" << "\n"
+           << "  image-list       List images and their state" << "\n"
+           << "  image-upload     Upload FILE to IMAGE, optionally MARK it and RESET" << "\n"
+           << "  image-test       Mark HASH for test on the next boot, optionally RESET" << "\n"
+           << "  image-confirm    Confirm HASH (or the running image if not given), optionally RESET" << "\n"
+           << "  fs-upload        Upload FILE to REMOTE" << "\n"
+           << "  fs-download      Download REMOTE to FILE" << "\n"
+           << "  os-echo          Echo TEXT" << "\n"
+           << "  os-reset         Reset the device, FORCE to reset even if the device is busy" << "\n"
+           << "  stat-list        List statistic groups" << "\n"
+           << "  stat-read        Read statistics of GROUP" << "\n"
+           << "Transport:" << "\n"
+           << "  TRANSPORT=type   uart (default)"
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+           << ", udp"
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+           << ", lorawan"
+#endif
+           << "\n"
+           << "  PORT=name        Serial port (uart)" << "\n"
+           << "  BAUD=rate        Serial port baud rate (default " << smp_cli_default_baud << ")" << "\n"
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP) || defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+           << "  HOST=address     Device address (udp) or MQTT broker (lorawan)" << "\n"
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+           << "  UDPPORT=port     Device UDP port (default " << smp_cli_default_udp_port << ")" << "\n"
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP_DTLS)
+           << "  DTLS             Use DTLS (udp)" << "\n"
+#endif
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+           << "  MQTTPORT=port    MQTT broker port (default " << smp_cli_default_mqtt_port << ")" << "\n"
+           << "  TLS              Connect to the MQTT broker using TLS" << "\n"
+           << "  USERNAME=user    MQTT username" << "\n"
+           << "  PASSWORD=pass    MQTT password" << "\n"
+           << "  TOPIC=topic      MQTT topic of the end device" << "\n"
+           << "  FPORT=port       LoRaWAN frame port" << "\n"
+           << "  FRAGMENT=bytes   Maximum downlink size (default " << smp_lorawan_default_fragment_size << ")" << "\n"
+           << "  CONFIRMED=0|1    Use confirmed downlinks (default " << (smp_lorawan_default_confirmed_downlinks == true ? 1 : 0) << ")" << "\n"
+           << "  RESENDS=count    Number of times to resend a request (default " << (uint)smp_lorawan_default_resends << ")" << "\n"
+#endif
+           << "  CONNECTTIMEOUT=ms Time to wait for the transport to connect (default " << smp_cli_default_connect_timeout_ms << ")" << "\n"
+           << "Options:" << "\n"
+           << "  FILE=path        Local file" << "\n"
+           << "  REMOTE=path      File on the device" << "\n"
+           << "  IMAGE=number     Image number (default 0)" << "\n"
+           << "  HASH=hex         Image hash" << "\n"
+           << "  MARK=test|confirm Mark the image after uploading" << "\n"
+           << "  RESET            Reset the device after the command" << "\n"
+           << "  FORCE            Force reset" << "\n"
+           << "  TEXT=text        Text to echo" << "\n"
+           << "  GROUP=name       Statistic group" << "\n"
+           << "  MTU=bytes        SMP MTU (default " << smp_cli_default_mtu << ")" << "\n"
+           << "  V1               Use SMP version 1 instead of version 2" << "\n"
+           << "  TIMEOUT=ms       Command timeout (default depends upon transport)" << "\n"
+           << "  PROGRESS         Output progress as JSON lines on stderr" << "\n"
+           << "  VERBOSE          Output debug messages as JSON lines on stderr" << "\n"
+           << "Fleet mode:" << "\n"
+           << "  DEVICES=path     Run the command on each device in a file, one device per line as transport KEY=VALUE" << "\n"
+           << "                   arguments (plus an optional NAME=name), arguments given on the command line are defaults" << "\n"
+           << "  CONCURRENCY=n    Maximum number of devices to operate on at the same time (default " << smp_cli_fleet_default_concurrency << ")" << "\n"
+           << "                   " << smp_cli_fleet_device_placeholder << " in FILE is replaced with the device name" << "\n"
+           << "The result is output as a JSON object on stdout, exit code is 0 on success, 1 if the command failed (on any device)," << "\n"
+           << "2 for invalid arguments, 3 if the device could not be connected to. In fleet mode, the status of each device is" << "\n"
+           << "output as JSON lines on stderr and the result includes a summary. Every line on stderr is a JSON object: status" << "\n"
+           << "lines have a status key, progress lines a progress key and log lines (warnings, or debug with VERBOSE) a log key" << "\n";
+}
+
+static void default_transport_config(smp_cli_transport_config_t *transport_config)
+{
+    transport_config->type = SMP_CLI_TRANSPORT_UART;
+    transport_config->baud = smp_cli_default_baud;
+    transport_config->connect_timeout = smp_cli_default_connect_timeout_ms;
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+    transport_config->udp.port = smp_cli_default_udp_port;
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP_DTLS)
+    transport_config->udp.dtls = false;
+#endif
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+    transport_config->lorawan.port = smp_cli_default_mqtt_port;
+    transport_config->lorawan.tls = false;
+    transport_config->lorawan.frame_port = 0;
+    transport_config->lorawan.fragment_size = smp_lorawan_default_fragment_size;
+    transport_config->lorawan.confirmed_downlinks = smp_lorawan_default_confirmed_downlinks;
+    transport_config->lorawan.resends = smp_lorawan_default_resends;
+    transport_config->lorawan.timeout = smp_lorawan_default_timeout_ms;
+#endif
+}
+
+static void default_operation(smp_cli_operation_t *operation)
+{
+    operation->command = SMP_CLI_COMMAND_NONE;
+    operation->image = 0;
+    operation->mark = SMP_CLI_IMAGE_MARK_NONE;
+    operation->reset = false;
+    operation->force = false;
+    operation->v2_protocol = true;
+    operation->mtu = smp_cli_default_mtu;
+    operation->timeout = 0;
+}
+
+static bool parse_transport_argument(const QString &key, const QString &value, smp_cli_transport_config_t *transport_config, bool *ok)
+{
+    //Returns true if the argument is a transport argument, ok is set to false if the value is invalid
+    if (key == "TRANSPORT")
+    {
+        QString type = value.toLower();
+
+        if (type == "uart")
+        {
+            transport_config->type = SMP_CLI_TRANSPORT_UART;
+        }
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+        else if (type == "udp")
+        {
+            transport_config->type = SMP_CLI_TRANSPORT_UDP;
+        }
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+        else if (type == "lorawan")
+        {
+            transport_config->type = SMP_CLI_TRANSPORT_LORAWAN;
+        }
+#endif
+        else
+        {
+            *ok = false;
+        }
+    }
+    else if (key == "PORT")
+    {
+        transport_config->port_name = value;
+    }
+    else if (key == "BAUD")
+    {
+        transport_config->baud = value.toUInt(ok);
+    }
+    else if (key == "CONNECTTIMEOUT")
+    {
+        transport_config->connect_timeout = value.toUInt(ok);
+    }
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP) || defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+    else if (key == "HOST")
+    {
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+        transport_config->udp.hostname = value;
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+        transport_config->lorawan.hostname = value;
+#endif
+    }
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+    else if (key == "UDPPORT")
+    {
+        transport_config->udp.port = value.toUShort(ok);
+    }
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP_DTLS)
+    else if (key == "DTLS")
+    {
+        transport_config->udp.dtls = true;
+    }
+#endif
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+    else if (key == "MQTTPORT")
+    {
+        transport_config->lorawan.port = value.toUShort(ok);
+    }
+    else if (key == "TLS")
+    {
+        transport_config->lorawan.tls = true;
+    }
+    else if (key == "USERNAME")
+    {
+        transport_config->lorawan.username = value;
+    }
+    else if (key == "PASSWORD")
+    {
+        transport_config->lorawan.password = value;
+    }
+    else if (key == "TOPIC")
+    {
+        transport_config->lorawan.topic = value;
+    }
+    else if (key == "FPORT")
+    {
+        uint port = value.toUInt(ok);
+
+        if (*ok == true && (port == 0 || port > 223))
+        {
+            *ok = false;
+        }
+
+        transport_config->lorawan.frame_port = (uint8_t)port;
+    }
+    else if (key == "FRAGMENT")
+    {
+        transport_config->lorawan.fragment_size = value.toUShort(ok);
+
+        if (*ok == true && transport_config->lorawan.fragment_size == 0)
+        {
+            *ok = false;
+        }
+    }
+    else if (key == "CONFIRMED")
+    {
+        transport_config->lorawan.confirmed_downlinks = (value == "1");
+    }
+    else if (key == "RESENDS")
+    {
+        uint resends = value.toUInt(ok);
+
+        if (*ok == true && resends > 255)
+        {
+            *ok = false;
+        }
+
+        transport_config->lorawan.resends = (uint8_t)resends;
+    }
+#endif
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+static bool parse_operation_argument(const QString &key, const QString &value, smp_cli_operation_t *operation, bool *ok)
+{
+    //Returns true if the argument is an operation argument, ok is set to false if the value is invalid
+    if (key == "COMMAND")
+    {
+        QString command = value.toLower();
+
+        operation->command = SMP_CLI_COMMAND_NONE;
+
+        for (int i = SMP_CLI_COMMAND_IMAGE_LIST; i <= SMP_CLI_COMMAND_STAT_READ; ++i)
+        {
+            if (command == smp_cli_session::command_to_string((smp_cli_command_t)i))
+            {
+                operation->command = (smp_cli_command_t)i;
+                break;
+            }
+        }
+
+        if (operation->command == SMP_CLI_COMMAND_NONE)
+        {
+            *ok = false;
+        }
+    }
+    else if (key == "FILE")
+    {
+        operation->local_file = value;
+    }
+    else if (key == "REMOTE")
+    {
+        operation->remote_file = value;
+    }
+    else if (key == "IMAGE")
+    {
+        uint image = value.toUInt(ok);
+
+        if (*ok == true && image > 255)
+        {
+            *ok = false;
+        }
+
+        operation->image = (uint8_t)image;
+    }
+    else if (key == "HASH")
+    {
+        operation->hash = QByteArray::fromHex(value.toLatin1());
+
+        if (operation->hash.isEmpty() == true)
+        {
+            *ok = false;
+        }
+    }
+    else if (key == "MARK")
+    {
+        QString mark = value.toLower();
+
+        if (mark == "test")
+        {
+            operation->mark = SMP_CLI_IMAGE_MARK_TEST;
+        }
+        else if (mark == "confirm")
+        {
+            operation->mark = SMP_CLI_IMAGE_MARK_CONFIRM;
+        }
+        else
+        {
+            *ok = false;
+        }
+    }
+    else if (key == "RESET")
+    {
+        operation->reset = true;
+    }
+    else if (key == "FORCE")
+    {
+        operation->force = true;
+    }
+    else if (key == "TEXT")
+    {
+        operation->text = value;
+    }
+    else if (key == "GROUP")
+    {
+        operation->stat_group = value;
+    }
+    else if (key == "MTU")
+    {
+        operation->mtu = value.toUShort(ok);
+
+        if (*ok == true && operation->mtu < 32)
+        {
+            *ok = false;
+        }
+    }
+    else if (key == "V1")
+    {
+        operation->v2_protocol = false;
+    }
+    else if (key == "TIMEOUT")
+    {
+        operation->timeout = value.toUInt(ok);
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+static QString validate_transport_config(const smp_cli_transport_config_t *transport_config)
+{
+    //Returns an error if required arguments are missing, otherwise an empty string
+    switch (transport_config->type)
+    {
+        case SMP_CLI_TRANSPORT_UART:
+        {
+            if (transport_config->port_name.isEmpty() == true)
+            {
+                return "The uart transport requires PORT=<port>";
+            }
+
+            break;
+        }
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+        case SMP_CLI_TRANSPORT_UDP:
+        {
+            if (transport_config->udp.hostname.isEmpty() == true)
+            {
+                return "The udp transport requires HOST=<address>";
+            }
+
+            break;
+        }
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+        case SMP_CLI_TRANSPORT_LORAWAN:
+        {
+            if (transport_config->lorawan.hostname.isEmpty() == true || transport_config->lorawan.topic.isEmpty() == true || transport_config->lorawan.frame_port == 0)
+            {
+                return "The lorawan transport requires HOST=<broker>, TOPIC=<topic> and FPORT=<port>";
+            }
+
+            break;
+        }
+#endif
+        default:
+        {
+            break;
+        }
+    };
+
+    return "";
+}
+
+static QString validate_operation(const smp_cli_operation_t *operation)
+{
+    //Returns an error if required arguments are missing, otherwise an empty string
+    switch (operation->command)
+    {
+        case SMP_CLI_COMMAND_NONE:
+        {
+            return "COMMAND=<command> is required";
+        }
+        case SMP_CLI_COMMAND_IMAGE_UPLOAD:
+        {
+            if (operation->local_file.isEmpty() == true)
+            {
+                return "image-upload requires FILE=<file>";
+            }
+
+            break;
+        }
+        case SMP_CLI_COMMAND_IMAGE_TEST:
+        {
+            if (operation->hash.isEmpty() == true)
+            {
+                return "image-test requires HASH=<hash>";
+            }
+
+            break;
+        }
+        case SMP_CLI_COMMAND_FS_UPLOAD:
+        case SMP_CLI_COMMAND_FS_DOWNLOAD:
+        {
+            if (operation->local_file.isEmpty() == true || operation->remote_file.isEmpty() == true)
+            {
+                return "File transfers require FILE=<file> and REMOTE=<file>";
+            }
+
+            break;
+        }
+        case SMP_CLI_COMMAND_OS_ECHO:
+        {
+            if (operation->text.isEmpty() == true)
+            {
+                return "os-echo requires TEXT=<text>";
+            }
+
+            break;
+        }
+        case SMP_CLI_COMMAND_STAT_READ:
+        {
+            if (operation->stat_group.isEmpty() == true)
+            {
+                return "stat-read requires GROUP=<group>";
+            }
+
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    };
+
+    return "";
+}
+
+static QString device_name(const smp_cli_transport_config_t *transport_config)
+{
+    switch (transport_config->type)
+    {
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+        case SMP_CLI_TRANSPORT_UDP:
+        {
+            return QString("%1:%2").arg(transport_config->udp.hostname, QString::number(transport_config->udp.port));
+        }
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+        case SMP_CLI_TRANSPORT_LORAWAN:
+        {
+            return transport_config->lorawan.topic;
+        }
+#endif
+        default:
+        {
+            return transport_config->port_name;
+        }
+    };
+}
+
+static bool load_devices(const QString &file_name, const smp_cli_transport_config_t *defaults, QList<smp_cli_fleet_device_t> *devices, QString *error)
+{
+    //Each line holds the transport arguments for one device, blank lines and lines starting with # are ignored
+    QFile file(file_name);
+    uint32_t line_number = 0;
+
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text) == false)
+    {
+        *error = QString("Failed to open device list %1: %2").arg(file_name, file.errorString());
+        return false;
+    }
+
+    while (file.atEnd() == false)
+    {
+        QString line = QString::fromUtf8(file.readLine()).trimmed();
+        QStringList arguments;
+        smp_cli_fleet_device_t device;
+        bool ok = true;
+        int i = 0;
+
+        ++line_number;
+
+        if (line.isEmpty() == true || line.startsWith('#') == true)
+        {
+            continue;
+        }
+
+        arguments = line.split(QRegularExpression("\\s+"));
+        device.transport = *defaults;
+
+        while (i < arguments.length() && ok == true)
+        {
+            QString key = arguments.at(i).section('=', 0, 0).toUpper();
+            QString value = arguments.at(i).section('=', 1);
+
+            if (key == "NAME")
+            {
+                device.name = value;
+            }
+            else if (parse_transport_argument(key, value, &device.transport, &ok) == false)
+            {
+                ok = false;
+            }
+
+            if (ok == false)
+            {
+                *error = QString("Invalid argument on line %1 of device list: %2").arg(QString::number(line_number), arguments.at(i));
+                return false;
+            }
+
+            ++i;
+        }
+
+        *error = validate_transport_config(&device.transport);
+
+        if (error->isEmpty() == false)
+        {
+            error->prepend(QString("Line %1 of device list: ").arg(line_number));
+            return false;
+        }
+
+        if (device.name.isEmpty() == true)
+        {
+            device.name = device_name(&device.transport);
+        }
+
+        devices->append(device);
+    }
+
+    if (devices->isEmpty() == true)
+    {
+        *error = QString("Device list %1 is empty").arg(file_name);
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+    QTextStream output(stdout);
+    QTextStream error_output(stderr);
+    QStringList arguments = QCoreApplication::arguments();
+    smp_cli_transport_config_t transport_config;
+    smp_cli_operation_t operation;
+    bool progress = false;
+    QString devices_file;
+    uint16_t concurrency = smp_cli_fleet_default_concurrency;
+    QString error;
+    bool ok = true;
+    int i = 1;
+
+    qInstallMessageHandler(message_handler);
+    default_transport_config(&transport_config);
+    default_operation(&operation);
+
+    while (i < arguments.length() && ok == true)
+    {
+        const QString &argument = arguments.at(i);
+        QString key = argument.section('=', 0, 0).toUpper();
+        QString value = argument.section('=', 1);
+
+        if (parse_transport_argument(key, value, &transport_config, &ok) == true || parse_operation_argument(key, value, &operation, &ok) == true)
+        {
+            //Handled
+        }
+        else if (key == "PROGRESS")
+        {
+            progress = true;
+        }
+        else if (key == "VERBOSE")
+        {
+            verbose_output = true;
+        }
+        else if (key == "DEVICES")
+        {
+            devices_file = value;
+        }
+        else if (key == "CONCURRENCY")
+        {
+            concurrency = value.toUShort(&ok);
+
+            if (ok == true && concurrency == 0)
+            {
+                ok = false;
+            }
+        }
+        else if (key == "HELP" || key == "-H" || key == "--HELP")
+        {
+            usage(output);
+            return cli_exit_ok;
+        }
+        else
+        {
+            ok = false;
+        }
+
+        if (ok == false)
+        {
+            error_output << "Invalid argument: " << argument << "\n";
+        }
+
+        ++i;
+    }
+
+    if (ok == false)
+    {
+        usage(error_output);
+        return cli_exit_invalid_arguments;
+    }
+
+    error = validate_operation(&operation);
+
+    if (error.isEmpty() == false)
+    {
+        error_output << error << "\n";
+        return cli_exit_invalid_arguments;
+    }
+
+    if (devices_file.isEmpty() == false)
+    {
+        QList<smp_cli_fleet_device_t> devices;
+        smp_cli_fleet fleet;
+
+        if (load_devices(devices_file, &transport_config, &devices, &error) == false)
+        {
+            error_output << error << "\n";
+            return cli_exit_invalid_arguments;
+        }
+
+        QObject::connect(&fleet, SIGNAL(finished()), &application, SLOT(quit()), Qt::QueuedConnection);
+        fleet.set_progress_output(progress);
+        fleet.start(devices, &operation, concurrency);
+        application.exec();
+
+        output << QJsonDocument(fleet.result()).toJson(QJsonDocument::Compact) << "\n";
+        output.flush();
+
+        return (fleet.failed_count() == 0 ? cli_exit_ok : cli_exit_failed);
+    }
+
+    error = validate_transport_config(&transport_config);
+
+    if (error.isEmpty() == false)
+    {
+        error_output << error << "\n";
+        return cli_exit_invalid_arguments;
+    }
+
+    smp_cli_session session(device_name(&transport_config), &transport_config);
+
+    QObject::connect(&session, SIGNAL(finished()), &application, SLOT(quit()), Qt::QueuedConnection);
+    session.set_progress_output(progress);
+    session.start(&operation);
+    application.exec();
+
+    output << QJsonDocument(session.result()).toJson(QJsonDocument::Compact) << "\n";
+    output.flush();
+
+    if (session.succeeded() == true)
+    {
+        return cli_exit_ok;
+    }
+
+    return (session.transport_failed() == true ? cli_exit_transport_error : cli_exit_failed);
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
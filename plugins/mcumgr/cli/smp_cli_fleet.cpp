@@ -0,0 +1,207 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_cli_fleet.cpp
+**
+** Notes:   Runs one MCUmgr operation across a list of devices, with a limit
+**          on how many devices are operated on at the same time
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_cli_fleet.h"
+#include <QJsonArray>
+#include <QRegularExpression>
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_cli_fleet::smp_cli_fleet(QObject *parent) : QObject(parent)
+{
+    max_concurrent = smp_cli_fleet_default_concurrency;
+    next_device = 0;
+    running = 0;
+    succeeded = 0;
+    failed = 0;
+    progress_output = false;
+    serial_ms = 0;
+}
+
+smp_cli_fleet::~smp_cli_fleet()
+{
+    qDeleteAll(sessions);
+}
+
+void smp_cli_fleet::start(const QList<smp_cli_fleet_device_t> &devices, const smp_cli_operation_t *operation_config, uint16_t concurrency)
+{
+    device_list = devices;
+    operation = *operation_config;
+    max_concurrent = (concurrency > 0 ? concurrency : 1);
+    next_device = 0;
+    running = 0;
+    succeeded = 0;
+    failed = 0;
+    serial_ms = 0;
+    device_results.clear();
+    device_results.resize(device_list.length());
+    sessions.fill(nullptr, device_list.length());
+    output = QJsonObject();
+    elapsed.start();
+
+    if (device_list.isEmpty() == true)
+    {
+        QTimer::singleShot(0, this, SLOT(session_finished()));
+        return;
+    }
+
+    while (running < max_concurrent && next_device < device_list.length())
+    {
+        start_next();
+    }
+}
+
+void smp_cli_fleet::set_progress_output(bool enabled)
+{
+    progress_output = enabled;
+}
+
+uint16_t smp_cli_fleet::failed_count()
+{
+    return failed;
+}
+
+QJsonObject smp_cli_fleet::result()
+{
+    return output;
+}
+
+void smp_cli_fleet::start_next()
+{
+    const smp_cli_fleet_device_t *device = &device_list.at(next_device);
+    smp_cli_operation_t device_operation = operation;
+    smp_cli_session *session = new smp_cli_session(device->name, &device->transport, this);
+    QJsonObject status;
+
+    if (device_operation.local_file.contains(smp_cli_fleet_device_placeholder) == true)
+    {
+        //Device names include characters (e.g. : and /) which cannot be used in file names
+        QString file_name = device->name;
+
+        file_name.replace(QRegularExpression("[^A-Za-z0-9._-]"), "_");
+        device_operation.local_file.replace(smp_cli_fleet_device_placeholder, file_name);
+    }
+
+    sessions[next_device] = session;
+    connect(session, SIGNAL(finished()), this, SLOT(session_finished()), Qt::QueuedConnection);
+    session->set_progress_output(progress_output);
+    session->start(&device_operation);
+
+    ++next_device;
+    ++running;
+
+    status.insert("status", "started");
+    status.insert("running", running);
+    report_status(device->name, status);
+}
+
+void smp_cli_fleet::session_finished()
+{
+    smp_cli_session *session = qobject_cast<smp_cli_session *>(sender());
+    int index = sessions.indexOf(session);
+
+    if (session != nullptr && index >= 0)
+    {
+        //Results are kept in device list order, not the order devices finish in
+        QJsonObject session_result = session->result();
+        QJsonObject status;
+
+        device_results[index] = session_result;
+        serial_ms += session_result.value("elapsed_ms").toVariant().toLongLong();
+
+        if (session->succeeded() == true)
+        {
+            ++succeeded;
+        }
+        else
+        {
+            ++failed;
+        }
+
+        --running;
+        sessions[index] = nullptr;
+        session->deleteLater();
+
+        status.insert("status", session_result.value("status"));
+        status.insert("success", session_result.value("success"));
+        status.insert("elapsed_ms", session_result.value("elapsed_ms"));
+        status.insert("completed", (int)(succeeded + failed));
+        status.insert("remaining", (int)(device_list.length() - succeeded - failed));
+        report_status(session->name(), status);
+    }
+
+    while (running < max_concurrent && next_device < device_list.length())
+    {
+        start_next();
+    }
+
+    if (running == 0 && next_device >= device_list.length())
+    {
+        complete();
+    }
+}
+
+void smp_cli_fleet::report_status(QString device, QJsonObject status)
+{
+    //Status lines share stderr with progress and log records, all are whole JSON objects so a controller can tell them apart by their keys
+    status.insert("device", device);
+    smp_cli_session::write_record(status);
+}
+
+void smp_cli_fleet::complete()
+{
+    QJsonArray device_array;
+    QJsonObject summary;
+    qint64 total_ms = elapsed.elapsed();
+    uint16_t i = 0;
+
+    while (i < device_results.length())
+    {
+        device_array.append(device_results.at(i));
+        ++i;
+    }
+
+    summary.insert("devices", device_list.length());
+    summary.insert("succeeded", succeeded);
+    summary.insert("failed", failed);
+    summary.insert("concurrency", max_concurrent);
+    summary.insert("elapsed_ms", total_ms);
+    summary.insert("serial_ms", serial_ms);
+    summary.insert("speedup", (total_ms > 0 ? QString::number((double)serial_ms / (double)total_ms, 'f', 2).toDouble() : 0.0));
+
+    output.insert("command", smp_cli_session::command_to_string(operation.command));
+    output.insert("success", (failed == 0));
+    output.insert("devices", device_array);
+    output.insert("summary", summary);
+
+    emit finished();
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,98 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_cli_fleet.h
+**
+** Notes:   Runs one MCUmgr operation across a list of devices, with a limit
+**          on how many devices are operated on at the same time
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_CLI_FLEET_H
+#define SMP_CLI_FLEET_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QObject>
+#include <QList>
+#include <QVector>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include "smp_cli_session.h"
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+const uint16_t smp_cli_fleet_default_concurrency = 4;
+
+//Replaced with the device name in local file names, so that downloads from each device go to a different file
+const QString smp_cli_fleet_device_placeholder = "{device}";
+
+/******************************************************************************/
+// Forward declaration of Class, Struct & Unions
+/******************************************************************************/
+struct smp_cli_fleet_device_t {
+    QString name;
+    smp_cli_transport_config_t transport;
+};
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_cli_fleet : public QObject
+{
+    Q_OBJECT
+
+public:
+    smp_cli_fleet(QObject *parent = nullptr);
+    ~smp_cli_fleet();
+    void start(const QList<smp_cli_fleet_device_t> &devices, const smp_cli_operation_t *operation_config, uint16_t concurrency);
+    void set_progress_output(bool enabled);
+    uint16_t failed_count();
+    QJsonObject result();
+
+signals:
+    void finished();
+
+private slots:
+    void session_finished();
+
+private:
+    void start_next();
+    void report_status(QString device, QJsonObject status);
+    void complete();
+
+    QList<smp_cli_fleet_device_t> device_list;
+    smp_cli_operation_t operation;
+    uint16_t max_concurrent;
+    uint16_t next_device;
+    uint16_t running;
+    uint16_t succeeded;
+    uint16_t failed;
+    bool progress_output;
+    QVector<smp_cli_session *> sessions; //Indexed by device, null if the device has not been started or has finished
+    QVector<QJsonObject> device_results;
+    qint64 serial_ms; //Sum of the time taken by each device, i.e. the time the operation would take if devices were done one at a time
+    QElapsedTimer elapsed;
+    QJsonObject output;
+};
+
+#endif // SMP_CLI_FLEET_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,806 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_cli_session.cpp
+**
+** Notes:   Connects to a single device over one SMP transport and runs one
+**          MCUmgr operation on it, without the GUI
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_cli_session.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QFileInfo>
+#include <stdio.h>
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+//Time allowed for the first image upload packet, the device may erase the slot before responding
+static const uint32_t timeout_erase_ms = 14000;
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+static QJsonArray image_list_to_json(const QList<image_state_t> &images)
+{
+    QJsonArray image_array;
+    uint16_t i = 0;
+
+    while (i < images.length())
+    {
+        QJsonObject image_object;
+        QJsonArray slot_array;
+        uint16_t l = 0;
+
+        while (l < images.at(i).slot_list.length())
+        {
+            const slot_state_t *slot = &images.at(i).slot_list.at(l);
+            QJsonObject slot_object;
+
+            slot_object.insert("slot", (int)slot->slot);
+            slot_object.insert("version", QString(slot->version));
+            slot_object.insert("hash", QString(slot->hash.toHex()));
+            slot_object.insert("bootable", slot->bootable);
+            slot_object.insert("pending", slot->pending);
+            slot_object.insert("confirmed", slot->confirmed);
+            slot_object.insert("active", slot->active);
+            slot_object.insert("permanent", slot->permanent);
+            slot_array.append(slot_object);
+            ++l;
+        }
+
+        if (images.at(i).image_set == true)
+        {
+            image_object.insert("image", (int)images.at(i).image);
+        }
+
+        image_object.insert("slots", slot_array);
+        image_array.append(image_object);
+        ++i;
+    }
+
+    return image_array;
+}
+
+smp_cli_session::smp_cli_session(QString name, const smp_cli_transport_config_t *transport_config, QObject *parent) : QObject(parent)
+{
+    session_name = name;
+    transport_settings = *transport_config;
+    state = SMP_CLI_STATE_IDLE;
+    transport = nullptr;
+    uart_transport = nullptr;
+    serial_port = nullptr;
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+    udp_transport = nullptr;
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+    lorawan_transport = nullptr;
+#endif
+    progress_output = false;
+    last_progress = 0;
+    success = false;
+    transport_error = false;
+    buffer_size = 0;
+    buffer_count = 0;
+
+    //Each session has its own processor and groups so that many devices can be operated on at the same time
+    processor = new smp_processor(this);
+    fs_mgmt = new smp_group_fs_mgmt(processor);
+    img_mgmt = new smp_group_img_mgmt(processor);
+    os_mgmt = new smp_group_os_mgmt(processor);
+    stat_mgmt = new smp_group_stat_mgmt(processor);
+
+    connect(fs_mgmt, SIGNAL(status(uint8_t,group_status,QString)), this, SLOT(operation_status(uint8_t,group_status,QString)));
+    connect(fs_mgmt, SIGNAL(progress(uint8_t,uint8_t)), this, SLOT(operation_progress(uint8_t,uint8_t)));
+    connect(img_mgmt, SIGNAL(status(uint8_t,group_status,QString)), this, SLOT(operation_status(uint8_t,group_status,QString)));
+    connect(img_mgmt, SIGNAL(progress(uint8_t,uint8_t)), this, SLOT(operation_progress(uint8_t,uint8_t)));
+    connect(os_mgmt, SIGNAL(status(uint8_t,group_status,QString)), this, SLOT(operation_status(uint8_t,group_status,QString)));
+    connect(os_mgmt, SIGNAL(progress(uint8_t,uint8_t)), this, SLOT(operation_progress(uint8_t,uint8_t)));
+    connect(stat_mgmt, SIGNAL(status(uint8_t,group_status,QString)), this, SLOT(operation_status(uint8_t,group_status,QString)));
+    connect(stat_mgmt, SIGNAL(progress(uint8_t,uint8_t)), this, SLOT(operation_progress(uint8_t,uint8_t)));
+
+    connect_timer.setSingleShot(true);
+    connect(&connect_timer, SIGNAL(timeout()), this, SLOT(connect_timeout()));
+}
+
+smp_cli_session::~smp_cli_session()
+{
+    connect_timer.stop();
+    close_transport();
+
+    delete stat_mgmt;
+    delete os_mgmt;
+    delete img_mgmt;
+    delete fs_mgmt;
+    delete processor;
+}
+
+void smp_cli_session::start(const smp_cli_operation_t *operation_config)
+{
+    operation = *operation_config;
+    state = SMP_CLI_STATE_CONNECTING;
+    success = false;
+    transport_error = false;
+    last_progress = 0;
+    output = QJsonObject();
+    elapsed.start();
+
+    //Opened from the event loop so that the finished signal is never emitted before the caller is waiting for it
+    QTimer::singleShot(0, this, SLOT(open_transport()));
+}
+
+void smp_cli_session::set_progress_output(bool enabled)
+{
+    progress_output = enabled;
+}
+
+QString smp_cli_session::name()
+{
+    return session_name;
+}
+
+bool smp_cli_session::succeeded()
+{
+    return success;
+}
+
+bool smp_cli_session::transport_failed()
+{
+    return transport_error;
+}
+
+QJsonObject smp_cli_session::result()
+{
+    return output;
+}
+
+void smp_cli_session::open_transport()
+{
+    switch (transport_settings.type)
+    {
+        case SMP_CLI_TRANSPORT_UART:
+        {
+            serial_port = new QSerialPort(this);
+            uart_transport = new smp_uart_auterm(this);
+            transport = uart_transport;
+
+            serial_port->setPortName(transport_settings.port_name);
+            serial_port->setBaudRate(transport_settings.baud);
+            serial_port->setDataBits(QSerialPort::Data8);
+            serial_port->setStopBits(QSerialPort::OneStop);
+            serial_port->setParity(QSerialPort::NoParity);
+            serial_port->setFlowControl(QSerialPort::NoFlowControl);
+
+            connect(serial_port, SIGNAL(readyRead()), this, SLOT(serial_read()));
+            connect(serial_port, SIGNAL(errorOccurred(QSerialPort::SerialPortError)), this, SLOT(serial_error(QSerialPort::SerialPortError)));
+            connect(uart_transport, SIGNAL(serial_write(QByteArray*)), this, SLOT(serial_write(QByteArray*)));
+            connect(uart_transport, SIGNAL(receive_waiting(smp_message*)), processor, SLOT(message_received(smp_message*)));
+
+            if (serial_port->open(QIODevice::ReadWrite) == false)
+            {
+                transport_error = true;
+                finish(false, "connect_failed", QString("Failed to open %1: %2").arg(transport_settings.port_name, serial_port->errorString()));
+                return;
+            }
+
+            transport_connected();
+            return;
+        }
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+        case SMP_CLI_TRANSPORT_UDP:
+        {
+            udp_transport = new smp_udp(this);
+            transport = udp_transport;
+            udp_transport->set_connection_config(&transport_settings.udp);
+            break;
+        }
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+        case SMP_CLI_TRANSPORT_LORAWAN:
+        {
+            lorawan_transport = new smp_lorawan(this);
+            transport = lorawan_transport;
+            lorawan_transport->set_connection_config(&transport_settings.lorawan);
+            break;
+        }
+#endif
+        default:
+        {
+            finish(false, "invalid", "Unsupported transport");
+            return;
+        }
+    };
+
+    //Network transports connect asynchronously
+    connect(transport, SIGNAL(receive_waiting(smp_message*)), processor, SLOT(message_received(smp_message*)));
+    connect(transport, SIGNAL(error(int)), processor, SLOT(transport_disconnect(int)));
+    connect(transport, SIGNAL(error(int)), this, SLOT(transport_error_occurred(int)));
+    connect(transport, SIGNAL(connected()), this, SLOT(transport_connected()));
+    connect(transport, SIGNAL(disconnected()), this, SLOT(transport_disconnected()));
+
+    connect_timer.start(transport_settings.connect_timeout);
+
+    if (transport->connect() != SMP_TRANSPORT_ERROR_OK)
+    {
+        transport_error = true;
+        finish(false, "connect_failed", "Failed to start connection");
+    }
+}
+
+void smp_cli_session::transport_connected()
+{
+    if (state != SMP_CLI_STATE_CONNECTING)
+    {
+        return;
+    }
+
+    connect_timer.stop();
+    state = SMP_CLI_STATE_RUNNING;
+    processor->set_transport(transport);
+
+    if (operation.command == SMP_CLI_COMMAND_IMAGE_UPLOAD || operation.command == SMP_CLI_COMMAND_FS_DOWNLOAD)
+    {
+        //Transfers are pipelined, so the number of requests the device can buffer is read first
+        start_parameters();
+        return;
+    }
+
+    run_command();
+}
+
+void smp_cli_session::transport_disconnected()
+{
+    if (state == SMP_CLI_STATE_CONNECTING)
+    {
+        transport_error = true;
+        finish(false, "connect_failed", "Transport disconnected whilst connecting");
+    }
+    else if (state == SMP_CLI_STATE_RUNNING)
+    {
+        processor->cancel();
+
+        if (state == SMP_CLI_STATE_RUNNING)
+        {
+            finish(false, status_to_string(STATUS_TRANSPORT_DISCONNECTED), "Transport disconnected");
+        }
+    }
+}
+
+void smp_cli_session::transport_error_occurred(int error_code)
+{
+    if (state == SMP_CLI_STATE_CONNECTING)
+    {
+        transport_error = true;
+        finish(false, "connect_failed", transport->to_error_string(error_code));
+    }
+}
+
+void smp_cli_session::connect_timeout()
+{
+    if (state == SMP_CLI_STATE_CONNECTING)
+    {
+        transport_error = true;
+        finish(false, "connect_timeout", "Timed out connecting to device");
+    }
+}
+
+void smp_cli_session::serial_read()
+{
+    QByteArray data = serial_port->readAll();
+
+    uart_transport->serial_read(&data);
+}
+
+void smp_cli_session::serial_write(QByteArray *data)
+{
+    serial_port->write(*data);
+}
+
+void smp_cli_session::serial_error(QSerialPort::SerialPortError error)
+{
+    //Open errors are reported when the port is opened, only loss of the port whilst running is handled here
+    if (error != QSerialPort::ResourceError || state != SMP_CLI_STATE_RUNNING)
+    {
+        return;
+    }
+
+    processor->cancel();
+
+    if (state == SMP_CLI_STATE_RUNNING)
+    {
+        finish(false, status_to_string(STATUS_TRANSPORT_DISCONNECTED), serial_port->errorString());
+    }
+}
+
+void smp_cli_session::set_group_parameters(smp_group *group, smp_cli_step_t step)
+{
+    uint32_t timeout = (operation.timeout != 0 ? operation.timeout : transport->get_timeout());
+
+    group->set_parameters((operation.v2_protocol == true ? 1 : 0), operation.mtu, transport->get_retries(), timeout, step);
+}
+
+void smp_cli_session::run_command()
+{
+    bool started = false;
+
+    switch (operation.command)
+    {
+        case SMP_CLI_COMMAND_IMAGE_LIST:
+        {
+            set_group_parameters(img_mgmt, SMP_CLI_STEP_COMMAND);
+            started = img_mgmt->start_image_get(&images);
+            break;
+        }
+        case SMP_CLI_COMMAND_IMAGE_UPLOAD:
+        {
+            output.insert("file", operation.local_file);
+            output.insert("image", operation.image);
+            output.insert("size", QFileInfo(operation.local_file).size());
+            set_group_parameters(img_mgmt, SMP_CLI_STEP_COMMAND);
+            started = img_mgmt->start_firmware_update(operation.image, operation.local_file, false, &upload_hash, timeout_erase_ms);
+            break;
+        }
+        case SMP_CLI_COMMAND_IMAGE_TEST:
+        {
+            started = start_image_set(&operation.hash, false);
+            break;
+        }
+        case SMP_CLI_COMMAND_IMAGE_CONFIRM:
+        {
+            if (operation.hash.isEmpty() == true)
+            {
+                //Confirm the running image, which needs its hash from the image list
+                set_group_parameters(img_mgmt, SMP_CLI_STEP_COMMAND);
+                started = img_mgmt->start_image_get(&images);
+            }
+            else
+            {
+                started = start_image_set(&operation.hash, true);
+            }
+
+            break;
+        }
+        case SMP_CLI_COMMAND_FS_UPLOAD:
+        {
+            output.insert("local", operation.local_file);
+            output.insert("remote", operation.remote_file);
+            output.insert("size", QFileInfo(operation.local_file).size());
+            set_group_parameters(fs_mgmt, SMP_CLI_STEP_COMMAND);
+            started = fs_mgmt->start_upload(operation.local_file, operation.remote_file);
+            break;
+        }
+        case SMP_CLI_COMMAND_FS_DOWNLOAD:
+        {
+            output.insert("local", operation.local_file);
+            output.insert("remote", operation.remote_file);
+            set_group_parameters(fs_mgmt, SMP_CLI_STEP_COMMAND);
+            started = fs_mgmt->start_download(operation.remote_file, operation.local_file);
+            break;
+        }
+        case SMP_CLI_COMMAND_OS_ECHO:
+        {
+            set_group_parameters(os_mgmt, SMP_CLI_STEP_COMMAND);
+            started = os_mgmt->start_echo(operation.text);
+            break;
+        }
+        case SMP_CLI_COMMAND_OS_RESET:
+        {
+            started = start_reset(operation.force);
+            break;
+        }
+        case SMP_CLI_COMMAND_STAT_LIST:
+        {
+            set_group_parameters(stat_mgmt, SMP_CLI_STEP_COMMAND);
+            started = stat_mgmt->start_list_groups(&stat_groups);
+            break;
+        }
+        case SMP_CLI_COMMAND_STAT_READ:
+        {
+            output.insert("group", operation.stat_group);
+            set_group_parameters(stat_mgmt, SMP_CLI_STEP_COMMAND);
+            started = stat_mgmt->start_group_data(operation.stat_group, &stats);
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    };
+
+    //Groups emit a status when a command fails to start, anything else is reported here
+    if (started == false && state == SMP_CLI_STATE_RUNNING)
+    {
+        finish(false, status_to_string(STATUS_ERROR), "Failed to start command");
+    }
+}
+
+void smp_cli_session::start_parameters()
+{
+    set_group_parameters(os_mgmt, SMP_CLI_STEP_PARAMETERS);
+
+    //Groups emit a status when a command fails to start, anything else is reported here
+    if (os_mgmt->start_mcumgr_parameters(&buffer_size, &buffer_count) == false && state == SMP_CLI_STATE_RUNNING)
+    {
+        finish(false, status_to_string(STATUS_ERROR), "Failed to start parameters command");
+    }
+}
+
+bool smp_cli_session::start_image_set(QByteArray *hash, bool confirm)
+{
+    output.insert("hash", QString(hash->toHex()));
+    output.insert("confirm", confirm);
+    images.clear();
+    set_group_parameters(img_mgmt, SMP_CLI_STEP_IMAGE_SET);
+
+    return img_mgmt->start_image_set(hash, confirm, &images);
+}
+
+bool smp_cli_session::start_reset(bool force)
+{
+    output.insert("reset", true);
+    set_group_parameters(os_mgmt, SMP_CLI_STEP_RESET);
+
+    return os_mgmt->start_reset(force, 0);
+}
+
+void smp_cli_session::operation_status(uint8_t user_data, group_status status, QString error_string)
+{
+    bool started = true;
+
+    if (state != SMP_CLI_STATE_RUNNING)
+    {
+        return;
+    }
+
+    if (user_data == SMP_CLI_STEP_PARAMETERS && (status == STATUS_COMPLETE || status == STATUS_ERROR || status == STATUS_UNSUPPORTED))
+    {
+        //A device which does not support the parameters command is sent one request at a time
+        processor->set_window(status == STATUS_COMPLETE ? smp_processor::window_for_buffer_count(buffer_count) : SMP_PROCESSOR_DEFAULT_WINDOW);
+        output.insert("window", processor->window());
+        run_command();
+        return;
+    }
+
+    if (status != STATUS_COMPLETE)
+    {
+        finish(false, status_to_string(status), error_string);
+        return;
+    }
+
+    switch (user_data)
+    {
+        case SMP_CLI_STEP_COMMAND:
+        {
+            command_complete(error_string);
+            return;
+        }
+        case SMP_CLI_STEP_IMAGE_SET:
+        {
+            output.insert("images", image_list_to_json(images));
+
+            if (operation.reset == true)
+            {
+                started = start_reset(false);
+            }
+            else
+            {
+                finish(true, status_to_string(STATUS_COMPLETE), "");
+            }
+
+            break;
+        }
+        case SMP_CLI_STEP_RESET:
+        {
+            finish(true, status_to_string(STATUS_COMPLETE), "");
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    };
+
+    if (started == false && state == SMP_CLI_STATE_RUNNING)
+    {
+        finish(false, status_to_string(STATUS_ERROR), "Failed to start reset");
+    }
+}
+
+void smp_cli_session::command_complete(QString response)
+{
+    bool started = true;
+
+    switch (operation.command)
+    {
+        case SMP_CLI_COMMAND_IMAGE_LIST:
+        {
+            output.insert("images", image_list_to_json(images));
+            finish(true, status_to_string(STATUS_COMPLETE), "");
+            break;
+        }
+        case SMP_CLI_COMMAND_IMAGE_UPLOAD:
+        {
+            output.insert("hash", QString(upload_hash.toHex()));
+
+            if (operation.mark != SMP_CLI_IMAGE_MARK_NONE)
+            {
+                started = start_image_set(&upload_hash, (operation.mark == SMP_CLI_IMAGE_MARK_CONFIRM));
+            }
+            else if (operation.reset == true)
+            {
+                started = start_reset(false);
+            }
+            else
+            {
+                finish(true, status_to_string(STATUS_COMPLETE), "");
+            }
+
+            break;
+        }
+        case SMP_CLI_COMMAND_IMAGE_CONFIRM:
+        {
+            //Image list received, find the running image
+            uint16_t i = 0;
+
+            while (i < images.length() && operation.hash.isEmpty() == true)
+            {
+                if (images.at(i).image_set == false || images.at(i).image == operation.image)
+                {
+                    uint16_t l = 0;
+
+                    while (l < images.at(i).slot_list.length())
+                    {
+                        if (images.at(i).slot_list.at(l).active == true)
+                        {
+                            operation.hash = images.at(i).slot_list.at(l).hash;
+                            break;
+                        }
+
+                        ++l;
+                    }
+                }
+
+                ++i;
+            }
+
+            if (operation.hash.isEmpty() == true)
+            {
+                finish(false, status_to_string(STATUS_ERROR), QString("No active slot found for image %1").arg(operation.image));
+                return;
+            }
+
+            started = start_image_set(&operation.hash, true);
+            break;
+        }
+        case SMP_CLI_COMMAND_OS_ECHO:
+        {
+            output.insert("response", response);
+            finish(true, status_to_string(STATUS_COMPLETE), "");
+            break;
+        }
+        case SMP_CLI_COMMAND_STAT_LIST:
+        {
+            output.insert("groups", QJsonArray::fromStringList(stat_groups));
+            finish(true, status_to_string(STATUS_COMPLETE), "");
+            break;
+        }
+        case SMP_CLI_COMMAND_STAT_READ:
+        {
+            QJsonObject stat_object;
+            uint16_t i = 0;
+
+            while (i < stats.length())
+            {
+                stat_object.insert(stats.at(i).name, (qint64)stats.at(i).value);
+                ++i;
+            }
+
+            output.insert("stats", stat_object);
+            finish(true, status_to_string(STATUS_COMPLETE), "");
+            break;
+        }
+        default:
+        {
+            finish(true, status_to_string(STATUS_COMPLETE), "");
+            break;
+        }
+    };
+
+    if (started == false && state == SMP_CLI_STATE_RUNNING)
+    {
+        finish(false, status_to_string(STATUS_ERROR), "Failed to start command");
+    }
+}
+
+void smp_cli_session::operation_progress(uint8_t user_data, uint8_t percent)
+{
+    Q_UNUSED(user_data);
+
+    if (progress_output == false || percent == last_progress)
+    {
+        return;
+    }
+
+    QJsonObject progress_object;
+
+    last_progress = percent;
+    progress_object.insert("device", session_name);
+    progress_object.insert("progress", percent);
+    write_record(progress_object);
+}
+
+void smp_cli_session::finish(bool succeeded, QString status, QString error)
+{
+    if (state == SMP_CLI_STATE_FINISHED)
+    {
+        return;
+    }
+
+    state = SMP_CLI_STATE_FINISHED;
+    success = succeeded;
+    connect_timer.stop();
+
+    output.insert("device", session_name);
+    output.insert("command", command_to_string(operation.command));
+    output.insert("success", succeeded);
+    output.insert("status", status);
+
+    if (error.isEmpty() == false)
+    {
+        output.insert("error", error);
+    }
+
+    output.insert("elapsed_ms", elapsed.elapsed());
+
+    close_transport();
+    emit finished();
+}
+
+void smp_cli_session::close_transport()
+{
+    if (serial_port != nullptr && serial_port->isOpen() == true)
+    {
+        serial_port->close();
+    }
+
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+    if (udp_transport != nullptr && udp_transport->is_connected() == 1)
+    {
+        udp_transport->disconnect(false);
+    }
+#endif
+
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+    if (lorawan_transport != nullptr && lorawan_transport->is_connected() == 1)
+    {
+        lorawan_transport->disconnect(false);
+    }
+#endif
+}
+
+void smp_cli_session::write_record(const QJsonObject &record)
+{
+    //One JSON object per line on stderr, so that stdout only contains the result. Each line is written and flushed in one go so that records are never split by other output
+    QByteArray line = QJsonDocument(record).toJson(QJsonDocument::Compact);
+
+    line.append('\n');
+    fwrite(line.constData(), 1, line.length(), stderr);
+    fflush(stderr);
+}
+
+QString smp_cli_session::command_to_string(smp_cli_command_t command)
+{
+    switch (command)
+    {
+        case SMP_CLI_COMMAND_IMAGE_LIST:
+        {
+            return "image-list";
+        }
+        case SMP_CLI_COMMAND_IMAGE_UPLOAD:
+        {
+            return "image-upload";
+        }
+        case SMP_CLI_COMMAND_IMAGE_TEST:
+        {
+            return "image-test";
+        }
+        case SMP_CLI_COMMAND_IMAGE_CONFIRM:
+        {
+            return "image-confirm";
+        }
+        case SMP_CLI_COMMAND_FS_UPLOAD:
+        {
+            return "fs-upload";
+        }
+        case SMP_CLI_COMMAND_FS_DOWNLOAD:
+        {
+            return "fs-download";
+        }
+        case SMP_CLI_COMMAND_OS_ECHO:
+        {
+            return "os-echo";
+        }
+        case SMP_CLI_COMMAND_OS_RESET:
+        {
+            return "os-reset";
+        }
+        case SMP_CLI_COMMAND_STAT_LIST:
+        {
+            return "stat-list";
+        }
+        case SMP_CLI_COMMAND_STAT_READ:
+        {
+            return "stat-read";
+        }
+        default:
+        {
+            return "";
+        }
+    };
+}
+
+QString smp_cli_session::status_to_string(group_status status)
+{
+    switch (status)
+    {
+        case STATUS_COMPLETE:
+        {
+            return "complete";
+        }
+        case STATUS_ERROR:
+        {
+            return "error";
+        }
+        case STATUS_UNSUPPORTED:
+        {
+            return "unsupported";
+        }
+        case STATUS_TIMEOUT:
+        {
+            return "timeout";
+        }
+        case STATUS_CANCELLED:
+        {
+            return "cancelled";
+        }
+        case STATUS_PROCESSOR_TRANSPORT_ERROR:
+        {
+            return "transport_error";
+        }
+        case STATUS_MESSAGE_TOO_LARGE:
+        {
+            return "message_too_large";
+        }
+        case STATUS_TRANSPORT_DISCONNECTED:
+        {
+            return "disconnected";
+        }
+        default:
+        {
+            return "unknown";
+        }
+    };
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
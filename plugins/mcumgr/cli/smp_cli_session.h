@@ -0,0 +1,222 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_cli_session.h
+**
+** Notes:   Connects to a single device over one SMP transport and runs one
+**          MCUmgr operation on it, without the GUI
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_CLI_SESSION_H
+#define SMP_CLI_SESSION_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QSerialPort>
+#include <QJsonObject>
+#include "smp_processor.h"
+#include "smp_uart_auterm.h"
+#include "smp_group_fs_mgmt.h"
+#include "smp_group_img_mgmt.h"
+#include "smp_group_os_mgmt.h"
+#include "smp_group_stat_mgmt.h"
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+#include "smp_udp.h"
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+#include "smp_lorawan.h"
+#endif
+
+/******************************************************************************/
+// Enum typedefs
+/******************************************************************************/
+enum smp_cli_transport_t {
+    SMP_CLI_TRANSPORT_UART,
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+    SMP_CLI_TRANSPORT_UDP,
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+    SMP_CLI_TRANSPORT_LORAWAN,
+#endif
+};
+
+enum smp_cli_command_t {
+    SMP_CLI_COMMAND_NONE,
+    SMP_CLI_COMMAND_IMAGE_LIST,
+    SMP_CLI_COMMAND_IMAGE_UPLOAD,
+    SMP_CLI_COMMAND_IMAGE_TEST,
+    SMP_CLI_COMMAND_IMAGE_CONFIRM,
+    SMP_CLI_COMMAND_FS_UPLOAD,
+    SMP_CLI_COMMAND_FS_DOWNLOAD,
+    SMP_CLI_COMMAND_OS_ECHO,
+    SMP_CLI_COMMAND_OS_RESET,
+    SMP_CLI_COMMAND_STAT_LIST,
+    SMP_CLI_COMMAND_STAT_READ,
+};
+
+//What to do with an image after it has been uploaded
+enum smp_cli_image_mark_t {
+    SMP_CLI_IMAGE_MARK_NONE,
+    SMP_CLI_IMAGE_MARK_TEST,
+    SMP_CLI_IMAGE_MARK_CONFIRM,
+};
+
+//Steps of an operation, used as the group user data so that status signals can be matched to the step which caused them
+enum smp_cli_step_t {
+    SMP_CLI_STEP_PARAMETERS,
+    SMP_CLI_STEP_COMMAND,
+    SMP_CLI_STEP_IMAGE_SET,
+    SMP_CLI_STEP_RESET,
+};
+
+enum smp_cli_state_t {
+    SMP_CLI_STATE_IDLE,
+    SMP_CLI_STATE_CONNECTING,
+    SMP_CLI_STATE_RUNNING,
+    SMP_CLI_STATE_FINISHED,
+};
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+const uint16_t smp_cli_default_mtu = 256;
+const uint32_t smp_cli_default_baud = 115200;
+const uint32_t smp_cli_default_connect_timeout_ms = 10000;
+const uint16_t smp_cli_default_udp_port = 1337;
+const uint16_t smp_cli_default_mqtt_port = 1883;
+
+/******************************************************************************/
+// Forward declaration of Class, Struct & Unions
+/******************************************************************************/
+struct smp_cli_transport_config_t {
+    smp_cli_transport_t type;
+    QString port_name;
+    uint32_t baud;
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+    smp_udp_config_t udp;
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+    smp_lorawan_config_t lorawan;
+#endif
+    uint32_t connect_timeout;
+};
+
+struct smp_cli_operation_t {
+    smp_cli_command_t command;
+    QString local_file;
+    QString remote_file;
+    QString text;
+    QString stat_group;
+    QByteArray hash;
+    uint8_t image;
+    smp_cli_image_mark_t mark;
+    bool reset;
+    bool force;
+    bool v2_protocol;
+    uint16_t mtu;
+    uint32_t timeout; //0 to use the transport's default
+};
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_cli_session : public QObject
+{
+    Q_OBJECT
+
+public:
+    smp_cli_session(QString name, const smp_cli_transport_config_t *transport_config, QObject *parent = nullptr);
+    ~smp_cli_session();
+    void start(const smp_cli_operation_t *operation_config);
+    void set_progress_output(bool enabled);
+    QString name();
+    bool succeeded();
+    bool transport_failed();
+    QJsonObject result();
+    static QString command_to_string(smp_cli_command_t command);
+    static void write_record(const QJsonObject &record);
+
+signals:
+    void finished();
+
+private slots:
+    void open_transport();
+    void transport_connected();
+    void transport_disconnected();
+    void transport_error_occurred(int error_code);
+    void connect_timeout();
+    void serial_read();
+    void serial_write(QByteArray *data);
+    void serial_error(QSerialPort::SerialPortError error);
+    void operation_status(uint8_t user_data, group_status status, QString error_string);
+    void operation_progress(uint8_t user_data, uint8_t percent);
+
+private:
+    void start_parameters();
+    void run_command();
+    bool start_image_set(QByteArray *hash, bool confirm);
+    bool start_reset(bool force);
+    void set_group_parameters(smp_group *group, smp_cli_step_t step);
+    void command_complete(QString response);
+    void finish(bool succeeded, QString status, QString error);
+    void close_transport();
+    static QString status_to_string(group_status status);
+
+    QString session_name;
+    smp_cli_transport_config_t transport_settings;
+    smp_cli_operation_t operation;
+    smp_cli_state_t state;
+    smp_transport *transport;
+    smp_uart_auterm *uart_transport;
+    QSerialPort *serial_port;
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+    smp_udp *udp_transport;
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_LORAWAN)
+    smp_lorawan *lorawan_transport;
+#endif
+    smp_processor *processor;
+    smp_group_fs_mgmt *fs_mgmt;
+    smp_group_img_mgmt *img_mgmt;
+    smp_group_os_mgmt *os_mgmt;
+    smp_group_stat_mgmt *stat_mgmt;
+    QTimer connect_timer;
+    QElapsedTimer elapsed;
+    bool progress_output;
+    uint8_t last_progress;
+    bool success;
+    bool transport_error;
+    QJsonObject output;
+
+    //Results filled in by the groups
+    QList<image_state_t> images;
+    QByteArray upload_hash;
+    QList<stat_value_t> stats;
+    QStringList stat_groups;
+    uint32_t buffer_size;
+    uint32_t buffer_count;
+};
+
+#endif // SMP_CLI_SESSION_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
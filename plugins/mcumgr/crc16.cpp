@@ -5,7 +5,7 @@
 **
 ** Module:  crc16.cpp
 **
-** Notes:   Taken from Zephyr source
+** Notes:   Taken from Zephyr source, table driven CRC16-ITU-T added
 **
 ** License: Licensed under the Apache License, Version 2.0 (the "License");
 **          you may not use this file except in compliance with the License.
@@ -22,6 +22,41 @@
 *******************************************************************************/
 #include "crc16.h"
 
+struct crc16_itu_t_tables {
+    /* table[n][b] is the CRC of byte b followed by n zero bytes */
+    uint16_t table[8][256];
+
+    crc16_itu_t_tables()
+    {
+        uint16_t i;
+        uint8_t b;
+
+        for (i = 0; i < 256U; i++) {
+            uint16_t crc = (uint16_t)(i << 8U);
+
+            for (b = 0; b < 8U; b++) {
+                crc = (crc & 0x8000U) ? (uint16_t)((crc << 1U) ^ 0x1021U) : (uint16_t)(crc << 1U);
+            }
+
+            table[0][i] = crc;
+        }
+
+        for (b = 1; b < 8U; b++) {
+            for (i = 0; i < 256U; i++) {
+                table[b][i] = (uint16_t)(table[b - 1][i] << 8U) ^ table[0][table[b - 1][i] >> 8U];
+            }
+        }
+    }
+};
+
+static const crc16_itu_t_tables &crc16_itu_t_get_tables()
+{
+    /* Built on first use */
+    static const crc16_itu_t_tables tables;
+
+    return tables;
+}
+
 uint16_t crc16(const QByteArray *src, size_t i, size_t len, uint16_t polynomial,
                uint16_t initial_value, bool pad)
 {
@@ -29,6 +64,11 @@ uint16_t crc16(const QByteArray *src, size_t i, size_t len, uint16_t polynomial,
     size_t padding = pad ? sizeof(crc) : 0;
     size_t b;
 
+    if (polynomial == 0x1021U && initial_value == 0U && pad == true && i <= len) {
+        /* Common SMP case, use the table driven implementation */
+        return crc16_itu_t(0, (const uint8_t *)src->constData() + i, (len - i));
+    }
+
     /* src length + padding (if required) */
     while (i < (len + padding))
     {
@@ -51,3 +91,30 @@ uint16_t crc16(const QByteArray *src, size_t i, size_t len, uint16_t polynomial,
 
     return crc;
 }
+
+uint16_t crc16_itu_t(uint16_t seed, const uint8_t *src, size_t len)
+{
+    /* Same result as crc16() with polynomial 0x1021, initial value of 0 and
+     * padding, but can be updated incrementally by passing the previous
+     * result as the seed. Uses slice-by-8 tables, 8 bytes per iteration */
+    const crc16_itu_t_tables &tables = crc16_itu_t_get_tables();
+
+    while (len >= 8U) {
+        seed = tables.table[7][(src[0] ^ (seed >> 8U)) & 0xffU] ^
+               tables.table[6][(src[1] ^ seed) & 0xffU] ^
+               tables.table[5][src[2]] ^
+               tables.table[4][src[3]] ^
+               tables.table[3][src[4]] ^
+               tables.table[2][src[5]] ^
+               tables.table[1][src[6]] ^
+               tables.table[0][src[7]];
+        src += 8U;
+        len -= 8U;
+    }
+
+    for (; len > 0; len--) {
+        seed = (seed << 8U) ^ tables.table[0][((seed >> 8U) ^ *src++) & 0xffU];
+    }
+
+    return seed;
+}
@@ -5,7 +5,7 @@
 **
 ** Module:  crc16.h
 **
-** Notes:   Taken from Zephyr source
+** Notes:   Taken from Zephyr source, table driven CRC16-ITU-T added
 **
 ** License: Licensed under the Apache License, Version 2.0 (the "License");
 **          you may not use this file except in compliance with the License.
@@ -30,5 +30,6 @@
 
 uint16_t crc16(const QByteArray *src, size_t i, size_t len, uint16_t polynomial,
                uint16_t initial_value, bool pad);
+uint16_t crc16_itu_t(uint16_t seed, const uint8_t *src, size_t len);
 
 #endif // CRC16_H
@@ -0,0 +1,113 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  crc32.cpp
+**
+** Notes:   Table driven (slice-by-8) CRC32-IEEE, API matches Zephyr crc32_ieee
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#include "crc32.h"
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+static const uint32_t crc32_ieee_polynomial = 0xedb88320U;
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+struct crc32_ieee_tables {
+    //table[n][b] is the CRC of byte b followed by n zero bytes
+    uint32_t table[8][256];
+
+    crc32_ieee_tables()
+    {
+        uint16_t i;
+        uint8_t b;
+
+        for (i = 0; i < 256U; i++)
+        {
+            uint32_t crc = i;
+
+            for (b = 0; b < 8U; b++)
+            {
+                crc = (crc & 1U) ? ((crc >> 1U) ^ crc32_ieee_polynomial) : (crc >> 1U);
+            }
+
+            table[0][i] = crc;
+        }
+
+        for (b = 1; b < 8U; b++)
+        {
+            for (i = 0; i < 256U; i++)
+            {
+                table[b][i] = (table[b - 1][i] >> 8U) ^ table[0][table[b - 1][i] & 0xffU];
+            }
+        }
+    }
+};
+
+static const crc32_ieee_tables &crc32_ieee_get_tables()
+{
+    //Built on first use
+    static const crc32_ieee_tables tables;
+
+    return tables;
+}
+
+uint32_t crc32_ieee(const uint8_t *src, size_t len)
+{
+    return crc32_ieee_update(0, src, len);
+}
+
+uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *src, size_t len)
+{
+    //Pass the previous result as crc to continue a calculation, 0 to start one
+    const crc32_ieee_tables &tables = crc32_ieee_get_tables();
+
+    crc = ~crc;
+
+    while (len >= 8U)
+    {
+        //Bytes are combined individually so this is independent of host endianness
+        uint32_t low = crc ^ ((uint32_t)src[0] | ((uint32_t)src[1] << 8U) | ((uint32_t)src[2] << 16U) | ((uint32_t)src[3] << 24U));
+
+        crc = tables.table[7][low & 0xffU] ^
+              tables.table[6][(low >> 8U) & 0xffU] ^
+              tables.table[5][(low >> 16U) & 0xffU] ^
+              tables.table[4][low >> 24U] ^
+              tables.table[3][src[4]] ^
+              tables.table[2][src[5]] ^
+              tables.table[1][src[6]] ^
+              tables.table[0][src[7]];
+        src += 8U;
+        len -= 8U;
+    }
+
+    while (len > 0)
+    {
+        crc = (crc >> 8U) ^ tables.table[0][(crc ^ *src) & 0xffU];
+        ++src;
+        --len;
+    }
+
+    return ~crc;
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,33 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  crc32.h
+**
+** Notes:   CRC32-IEEE (as used by zlib/ethernet and the MCUmgr fs_mgmt crc32
+**          checksum)
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+uint32_t crc32_ieee(const uint8_t *src, size_t len);
+uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *src, size_t len);
+
+#endif // CRC32_H
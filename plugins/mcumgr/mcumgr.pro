@@ -18,10 +18,14 @@ SOURCES += \
     ../../AuTerm/AutScrollEdit.cpp \
     ../../AuTerm/AutEscape.cpp \
     crc16.cpp \
+    crc32.cpp \
     debug_logger.cpp \
     error_lookup.cpp \
     plugin_mcumgr.cpp \
+    smp_chunk_tuner.cpp \
     smp_error.cpp \
+    smp_file_writer.cpp \
+    smp_fs_sync.cpp \
     smp_group_enum_mgmt.cpp \
     smp_group_fs_mgmt.cpp \
     smp_group_os_mgmt.cpp \
@@ -29,10 +33,20 @@ SOURCES += \
     smp_group_shell_mgmt.cpp \
     smp_group_stat_mgmt.cpp \
     smp_group_zephyr_mgmt.cpp \
+    smp_hash_checksum.cpp \
+    smp_image_source.cpp \
     smp_json.cpp \
+    smp_link_benchmark.cpp \
     smp_message.cpp \
+    smp_message_pool.cpp \
+    smp_metrics.cpp \
     smp_processor.cpp \
+    smp_rtt_estimator.cpp \
+    smp_stat_history.cpp \
+    smp_stat_poller.cpp \
+    smp_task_sampler.cpp \
     smp_uart_auterm.cpp \
+    stat_plot.cpp \
     smp_group_img_mgmt.cpp
 
 HEADERS += \
@@ -40,10 +54,14 @@ HEADERS += \
     ../../AuTerm/AutScrollEdit.h \
     ../../AuTerm/AutEscape.h \
     crc16.h \
+    crc32.h \
     debug_logger.h \
     error_lookup.h \
     plugin_mcumgr.h \
+    smp_chunk_tuner.h \
     smp_error.h \
+    smp_file_writer.h \
+    smp_fs_sync.h \
     smp_group_array.h \
     smp_group_enum_mgmt.h \
     smp_group_fs_mgmt.h \
@@ -52,11 +70,21 @@ HEADERS += \
     smp_group_shell_mgmt.h \
     smp_group_stat_mgmt.h \
     smp_group_zephyr_mgmt.h \
+    smp_hash_checksum.h \
+    smp_image_source.h \
     smp_json.h \
+    smp_link_benchmark.h \
     smp_message.h \
+    smp_message_pool.h \
+    smp_metrics.h \
     smp_processor.h \
+    smp_rtt_estimator.h \
+    smp_stat_history.h \
+    smp_stat_poller.h \
+    smp_task_sampler.h \
     smp_transport.h \
     smp_uart_auterm.h \
+    stat_plot.h \
     smp_group.h \
     smp_group_img_mgmt.h
 
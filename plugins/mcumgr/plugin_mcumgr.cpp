@@ -31,6 +31,32 @@
 #include "plugin_mcumgr.h"
 
 static const uint16_t timeout_erase_ms = 14000;
+static const uint32_t img_reconnect_interval_ms = 5000;
+static const uint8_t img_reconnect_max_attempts = 5;
+static const QString img_resume_setting = "mcumgr_img_resume_session";
+static const QString upload_chunk_size_setting = "mcumgr_upload_chunk_sizes";
+static const qint64 upload_chunk_limit_expiry_s = 24 * 60 * 60;
+static const uint16_t metrics_refresh_interval_ms = 1000;
+static const uint8_t metrics_histogram_bar_width = 40;
+
+enum table_metrics_columns {
+    TABLE_METRICS_COLUMN_GROUP,
+    TABLE_METRICS_COLUMN_COMMAND,
+    TABLE_METRICS_COLUMN_REQUESTS,
+    TABLE_METRICS_COLUMN_RESPONSES,
+    TABLE_METRICS_COLUMN_ERRORS,
+    TABLE_METRICS_COLUMN_RETRIES,
+    TABLE_METRICS_COLUMN_TIMEOUTS,
+    TABLE_METRICS_COLUMN_SENT_BYTES,
+    TABLE_METRICS_COLUMN_RECEIVED_BYTES,
+    TABLE_METRICS_COLUMN_LATENCY_MIN,
+    TABLE_METRICS_COLUMN_LATENCY_MEAN,
+    TABLE_METRICS_COLUMN_LATENCY_P90,
+    TABLE_METRICS_COLUMN_LATENCY_P99,
+    TABLE_METRICS_COLUMN_LATENCY_MAX,
+
+    TABLE_METRICS_COLUMN_COUNT
+};
 
 enum tree_img_slot_info_columns {
     TREE_IMG_SLOT_INFO_COLUMN_IMAGE_SLOT,
@@ -70,6 +96,10 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     smp_groups.stat_mgmt = new smp_group_stat_mgmt(processor);
     smp_groups.zephyr_mgmt = new smp_group_zephyr_mgmt(processor);
     smp_groups.enum_mgmt = new smp_group_enum_mgmt(processor);
+    fs_sync = new smp_fs_sync(smp_groups.fs_mgmt, smp_groups.shell_mgmt);
+    link_benchmark = new smp_link_benchmark(smp_groups.os_mgmt);
+    stat_poller = new smp_stat_poller(processor, smp_groups.stat_mgmt, &stat_history);
+    task_sampler = new smp_task_sampler(processor, smp_groups.os_mgmt);
     error_lookup_form = new error_lookup(parent_window, &smp_groups);
 
     processor->set_json(log_json);
@@ -82,6 +112,13 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     //Set defaults
     mode = ACTION_IDLE;
     uart_transport_locked = false;
+    window_resume_slot = nullptr;
+    window_resume_status = nullptr;
+    img_reconnect_attempts = 0;
+    upload_device_unique = false;
+    tmr_img_reconnect.setSingleShot(true);
+    tmr_img_reconnect.setInterval(img_reconnect_interval_ms);
+    tmr_metrics_refresh.setInterval(metrics_refresh_interval_ms);
     parent_row = -1;
     parent_column = -1;
     child_row = -1;
@@ -121,6 +158,12 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
 
     horizontalLayout_7->addWidget(edit_MTU);
 
+    check_MTU_Tune = new QCheckBox(tab);
+    check_MTU_Tune->setObjectName("check_MTU_Tune");
+    check_MTU_Tune->setChecked(true);
+
+    horizontalLayout_7->addWidget(check_MTU_Tune);
+
     line_9 = new QFrame(tab);
     line_9->setObjectName("line_9");
     line_9->setFrameShape(QFrame::Shape::VLine);
@@ -203,6 +246,11 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
 
     horizontalLayout_27->addWidget(check_transport_uart_show_transfer);
 
+    lbl_transport_rto = new QLabel(tab);
+    lbl_transport_rto->setObjectName("lbl_transport_rto");
+
+    horizontalLayout_27->addWidget(lbl_transport_rto);
+
     horizontalSpacer_27 = new QSpacerItem(40, 20, QSizePolicy::Policy::Expanding, QSizePolicy::Policy::Minimum);
 
     horizontalLayout_27->addItem(horizontalSpacer_27);
@@ -310,9 +358,32 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
 
     gridLayout_4->addLayout(horizontalLayout_4, 1, 1, 1, 1);
 
+    label_IMG_Resume = new QLabel(tab_IMG_Upload);
+    label_IMG_Resume->setObjectName("label_IMG_Resume");
+
+    gridLayout_4->addWidget(label_IMG_Resume, 4, 0, 1, 1);
+
+    horizontalLayout_IMG_Resume = new QHBoxLayout();
+    horizontalLayout_IMG_Resume->setSpacing(2);
+    horizontalLayout_IMG_Resume->setObjectName("horizontalLayout_IMG_Resume");
+    check_IMG_Resume = new QCheckBox(tab_IMG_Upload);
+    check_IMG_Resume->setObjectName("check_IMG_Resume");
+    check_IMG_Resume->setChecked(true);
+
+    horizontalLayout_IMG_Resume->addWidget(check_IMG_Resume);
+
+    check_IMG_Reconnect = new QCheckBox(tab_IMG_Upload);
+    check_IMG_Reconnect->setObjectName("check_IMG_Reconnect");
+    check_IMG_Reconnect->setChecked(false);
+
+    horizontalLayout_IMG_Resume->addWidget(check_IMG_Reconnect);
+
+
+    gridLayout_4->addLayout(horizontalLayout_IMG_Resume, 4, 1, 1, 1);
+
     verticalSpacer_4 = new QSpacerItem(20, 40, QSizePolicy::Policy::Minimum, QSizePolicy::Policy::Expanding);
 
-    gridLayout_4->addItem(verticalSpacer_4, 4, 0, 1, 1);
+    gridLayout_4->addItem(verticalSpacer_4, 5, 0, 1, 1);
 
     selector_img->addTab(tab_IMG_Upload, QString());
     tab_IMG_Images = new QWidget();
@@ -589,6 +660,16 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
 
     horizontalLayout->addWidget(radio_FS_Hash_Checksum_Types);
 
+    check_FS_Directory = new QCheckBox(tab_FS);
+    check_FS_Directory->setObjectName("check_FS_Directory");
+
+    horizontalLayout->addWidget(check_FS_Directory);
+
+    check_FS_Verify = new QCheckBox(tab_FS);
+    check_FS_Verify->setObjectName("check_FS_Verify");
+
+    horizontalLayout->addWidget(check_FS_Verify);
+
     horizontalSpacer_32 = new QSpacerItem(40, 20, QSizePolicy::Policy::Expanding, QSizePolicy::Policy::Minimum);
 
     horizontalLayout->addItem(horizontalSpacer_32);
@@ -657,13 +738,56 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     gridLayout_8->addWidget(edit_OS_Echo_Output, 1, 1, 1, 1);
 
     selector_OS->addTab(tab_OS_Echo, QString());
+    tab_OS_Benchmark = new QWidget();
+    tab_OS_Benchmark->setObjectName("tab_OS_Benchmark");
+    gridLayout_19 = new QGridLayout(tab_OS_Benchmark);
+    gridLayout_19->setObjectName("gridLayout_19");
+    label_49 = new QLabel(tab_OS_Benchmark);
+    label_49->setObjectName("label_49");
+
+    gridLayout_19->addWidget(label_49, 0, 0, 1, 1);
+
+    edit_OS_Benchmark_Sizes = new QSpinBox(tab_OS_Benchmark);
+    edit_OS_Benchmark_Sizes->setObjectName("edit_OS_Benchmark_Sizes");
+    edit_OS_Benchmark_Sizes->setMinimum(1);
+    edit_OS_Benchmark_Sizes->setMaximum(64);
+    edit_OS_Benchmark_Sizes->setValue(8);
+
+    gridLayout_19->addWidget(edit_OS_Benchmark_Sizes, 0, 1, 1, 1);
+
+    label_50 = new QLabel(tab_OS_Benchmark);
+    label_50->setObjectName("label_50");
+
+    gridLayout_19->addWidget(label_50, 0, 2, 1, 1);
+
+    edit_OS_Benchmark_Iterations = new QSpinBox(tab_OS_Benchmark);
+    edit_OS_Benchmark_Iterations->setObjectName("edit_OS_Benchmark_Iterations");
+    edit_OS_Benchmark_Iterations->setMinimum(1);
+    edit_OS_Benchmark_Iterations->setMaximum(1000);
+    edit_OS_Benchmark_Iterations->setValue(20);
+
+    gridLayout_19->addWidget(edit_OS_Benchmark_Iterations, 0, 3, 1, 1);
+
+    horizontalSpacer_38 = new QSpacerItem(40, 20, QSizePolicy::Policy::Expanding, QSizePolicy::Policy::Minimum);
+
+    gridLayout_19->addItem(horizontalSpacer_38, 0, 4, 1, 1);
+
+    edit_OS_Benchmark_Output = new QPlainTextEdit(tab_OS_Benchmark);
+    edit_OS_Benchmark_Output->setObjectName("edit_OS_Benchmark_Output");
+    edit_OS_Benchmark_Output->setUndoRedoEnabled(false);
+    edit_OS_Benchmark_Output->setLineWrapMode(QPlainTextEdit::LineWrapMode::NoWrap);
+    edit_OS_Benchmark_Output->setReadOnly(true);
+
+    gridLayout_19->addWidget(edit_OS_Benchmark_Output, 1, 0, 1, 5);
+
+    selector_OS->addTab(tab_OS_Benchmark, QString());
     tab_OS_Tasks = new QWidget();
     tab_OS_Tasks->setObjectName("tab_OS_Tasks");
     gridLayout_14 = new QGridLayout(tab_OS_Tasks);
     gridLayout_14->setObjectName("gridLayout_14");
     table_OS_Tasks = new QTableWidget(tab_OS_Tasks);
-    if (table_OS_Tasks->columnCount() < 8)
-        table_OS_Tasks->setColumnCount(8);
+    if (table_OS_Tasks->columnCount() < 12)
+        table_OS_Tasks->setColumnCount(12);
     QTableWidgetItem *__qtablewidgetitem = new QTableWidgetItem();
     table_OS_Tasks->setHorizontalHeaderItem(0, __qtablewidgetitem);
     QTableWidgetItem *__qtablewidgetitem1 = new QTableWidgetItem();
@@ -680,6 +804,14 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     table_OS_Tasks->setHorizontalHeaderItem(6, __qtablewidgetitem6);
     QTableWidgetItem *__qtablewidgetitem7 = new QTableWidgetItem();
     table_OS_Tasks->setHorizontalHeaderItem(7, __qtablewidgetitem7);
+    QTableWidgetItem *__qtablewidgetitem19 = new QTableWidgetItem();
+    table_OS_Tasks->setHorizontalHeaderItem(8, __qtablewidgetitem19);
+    QTableWidgetItem *__qtablewidgetitem20 = new QTableWidgetItem();
+    table_OS_Tasks->setHorizontalHeaderItem(9, __qtablewidgetitem20);
+    QTableWidgetItem *__qtablewidgetitem21 = new QTableWidgetItem();
+    table_OS_Tasks->setHorizontalHeaderItem(10, __qtablewidgetitem21);
+    QTableWidgetItem *__qtablewidgetitem22 = new QTableWidgetItem();
+    table_OS_Tasks->setHorizontalHeaderItem(11, __qtablewidgetitem22);
     table_OS_Tasks->setObjectName("table_OS_Tasks");
     table_OS_Tasks->setEditTriggers(QAbstractItemView::EditTrigger::NoEditTriggers);
     table_OS_Tasks->setProperty("showDropIndicator", QVariant(false));
@@ -689,7 +821,35 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     table_OS_Tasks->setSortingEnabled(true);
     table_OS_Tasks->setCornerButtonEnabled(false);
 
-    gridLayout_14->addWidget(table_OS_Tasks, 0, 0, 1, 1);
+    gridLayout_14->addWidget(table_OS_Tasks, 0, 0, 1, 3);
+
+    check_OS_Tasks_Sample = new QCheckBox(tab_OS_Tasks);
+    check_OS_Tasks_Sample->setObjectName("check_OS_Tasks_Sample");
+
+    gridLayout_14->addWidget(check_OS_Tasks_Sample, 1, 0, 1, 1);
+
+    edit_OS_Tasks_Interval = new QSpinBox(tab_OS_Tasks);
+    edit_OS_Tasks_Interval->setObjectName("edit_OS_Tasks_Interval");
+    edit_OS_Tasks_Interval->setEnabled(false);
+    edit_OS_Tasks_Interval->setMinimum(100);
+    edit_OS_Tasks_Interval->setMaximum(3600000);
+    edit_OS_Tasks_Interval->setSingleStep(100);
+    edit_OS_Tasks_Interval->setValue(1000);
+
+    gridLayout_14->addWidget(edit_OS_Tasks_Interval, 1, 1, 1, 1);
+
+    horizontalSpacer_40 = new QSpacerItem(40, 20, QSizePolicy::Policy::Expanding, QSizePolicy::Policy::Minimum);
+
+    gridLayout_14->addItem(horizontalSpacer_40, 1, 2, 1, 1);
+
+    edit_OS_Tasks_Events = new QPlainTextEdit(tab_OS_Tasks);
+    edit_OS_Tasks_Events->setObjectName("edit_OS_Tasks_Events");
+    edit_OS_Tasks_Events->setMaximumSize(QSize(16777215, 80));
+    edit_OS_Tasks_Events->setUndoRedoEnabled(false);
+    edit_OS_Tasks_Events->setReadOnly(true);
+    edit_OS_Tasks_Events->setMaximumBlockCount(200);
+
+    gridLayout_14->addWidget(edit_OS_Tasks_Events, 2, 0, 1, 3);
 
     selector_OS->addTab(tab_OS_Tasks, QString());
     tab_OS_Memory = new QWidget();
@@ -951,6 +1111,51 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
 
     horizontalLayout_9->addWidget(radio_STAT_Fetch);
 
+    radio_STAT_Poll = new QRadioButton(tab_Stats);
+    radio_STAT_Poll->setObjectName("radio_STAT_Poll");
+
+    horizontalLayout_9->addWidget(radio_STAT_Poll);
+
+    edit_STAT_Interval = new QSpinBox(tab_Stats);
+    edit_STAT_Interval->setObjectName("edit_STAT_Interval");
+    edit_STAT_Interval->setEnabled(false);
+    edit_STAT_Interval->setMinimum(100);
+    edit_STAT_Interval->setMaximum(3600000);
+    edit_STAT_Interval->setSingleStep(100);
+    edit_STAT_Interval->setValue(1000);
+
+    horizontalLayout_9->addWidget(edit_STAT_Interval);
+
+    horizontalSpacer_39 = new QSpacerItem(40, 20, QSizePolicy::Policy::Expanding, QSizePolicy::Policy::Minimum);
+
+    horizontalLayout_9->addItem(horizontalSpacer_39);
+
+    label_51 = new QLabel(tab_Stats);
+    label_51->setObjectName("label_51");
+
+    horizontalLayout_9->addWidget(label_51);
+
+    combo_STAT_Plot_Mode = new QComboBox(tab_Stats);
+    combo_STAT_Plot_Mode->addItem(QString());
+    combo_STAT_Plot_Mode->addItem(QString());
+    combo_STAT_Plot_Mode->setObjectName("combo_STAT_Plot_Mode");
+
+    horizontalLayout_9->addWidget(combo_STAT_Plot_Mode);
+
+    combo_STAT_Plot_Window = new QComboBox(tab_Stats);
+    combo_STAT_Plot_Window->addItem(QString());
+    combo_STAT_Plot_Window->addItem(QString());
+    combo_STAT_Plot_Window->addItem(QString());
+    combo_STAT_Plot_Window->addItem(QString());
+    combo_STAT_Plot_Window->setObjectName("combo_STAT_Plot_Window");
+
+    horizontalLayout_9->addWidget(combo_STAT_Plot_Window);
+
+    btn_STAT_Export = new QPushButton(tab_Stats);
+    btn_STAT_Export->setObjectName("btn_STAT_Export");
+
+    horizontalLayout_9->addWidget(btn_STAT_Export);
+
 
     gridLayout_11->addLayout(horizontalLayout_9, 2, 0, 1, 2);
 
@@ -990,13 +1195,20 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
 
     gridLayout_11->addWidget(label_15, 0, 0, 1, 1);
 
-    table_STAT_Values = new QTableWidget(tab_Stats);
-    if (table_STAT_Values->columnCount() < 2)
-        table_STAT_Values->setColumnCount(2);
+    splitter_STAT = new QSplitter(tab_Stats);
+    splitter_STAT->setObjectName("splitter_STAT");
+    splitter_STAT->setOrientation(Qt::Orientation::Vertical);
+    table_STAT_Values = new QTableWidget(splitter_STAT);
+    if (table_STAT_Values->columnCount() < 4)
+        table_STAT_Values->setColumnCount(4);
     QTableWidgetItem *__qtablewidgetitem12 = new QTableWidgetItem();
     table_STAT_Values->setHorizontalHeaderItem(0, __qtablewidgetitem12);
     QTableWidgetItem *__qtablewidgetitem13 = new QTableWidgetItem();
     table_STAT_Values->setHorizontalHeaderItem(1, __qtablewidgetitem13);
+    QTableWidgetItem *__qtablewidgetitem17 = new QTableWidgetItem();
+    table_STAT_Values->setHorizontalHeaderItem(2, __qtablewidgetitem17);
+    QTableWidgetItem *__qtablewidgetitem18 = new QTableWidgetItem();
+    table_STAT_Values->setHorizontalHeaderItem(3, __qtablewidgetitem18);
     table_STAT_Values->setObjectName("table_STAT_Values");
     table_STAT_Values->setEditTriggers(QAbstractItemView::EditTrigger::NoEditTriggers);
     table_STAT_Values->setProperty("showDropIndicator", QVariant(false));
@@ -1006,8 +1218,12 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     table_STAT_Values->setCornerButtonEnabled(false);
     table_STAT_Values->horizontalHeader()->setCascadingSectionResizes(true);
     table_STAT_Values->horizontalHeader()->setDefaultSectionSize(180);
+    splitter_STAT->addWidget(table_STAT_Values);
+    plot_STAT = new stat_plot(splitter_STAT);
+    plot_STAT->setObjectName("plot_STAT");
+    splitter_STAT->addWidget(plot_STAT);
 
-    gridLayout_11->addWidget(table_STAT_Values, 1, 1, 1, 1);
+    gridLayout_11->addWidget(splitter_STAT, 1, 1, 1, 1);
 
     selector_group->addTab(tab_Stats, QString());
     tab_Shell = new QWidget();
@@ -1754,6 +1970,65 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     verticalLayout_5->addLayout(horizontalLayout_24);
 
     selector_group->addTab(tab_custom, QString());
+    tab_metrics = new QWidget();
+    tab_metrics->setObjectName("tab_metrics");
+    verticalLayout_metrics = new QVBoxLayout(tab_metrics);
+    verticalLayout_metrics->setSpacing(2);
+    verticalLayout_metrics->setObjectName("verticalLayout_metrics");
+    verticalLayout_metrics->setContentsMargins(6, 6, 6, 6);
+    lbl_metrics_summary = new QLabel(tab_metrics);
+    lbl_metrics_summary->setObjectName("lbl_metrics_summary");
+    lbl_metrics_summary->setWordWrap(true);
+
+    verticalLayout_metrics->addWidget(lbl_metrics_summary);
+
+    table_metrics_commands = new QTableWidget(tab_metrics);
+    table_metrics_commands->setColumnCount(TABLE_METRICS_COLUMN_COUNT);
+    table_metrics_commands->setObjectName("table_metrics_commands");
+    table_metrics_commands->setEditTriggers(QAbstractItemView::EditTrigger::NoEditTriggers);
+    table_metrics_commands->setSelectionMode(QAbstractItemView::SelectionMode::SingleSelection);
+    table_metrics_commands->setSelectionBehavior(QAbstractItemView::SelectionBehavior::SelectRows);
+    table_metrics_commands->setAlternatingRowColors(true);
+    table_metrics_commands->setCornerButtonEnabled(false);
+    table_metrics_commands->verticalHeader()->setVisible(false);
+    table_metrics_commands->horizontalHeader()->setDefaultSectionSize(70);
+
+    verticalLayout_metrics->addWidget(table_metrics_commands);
+
+    edit_metrics_histogram = new QPlainTextEdit(tab_metrics);
+    edit_metrics_histogram->setObjectName("edit_metrics_histogram");
+    edit_metrics_histogram->setUndoRedoEnabled(false);
+    edit_metrics_histogram->setReadOnly(true);
+    edit_metrics_histogram->setLineWrapMode(QPlainTextEdit::LineWrapMode::NoWrap);
+
+    verticalLayout_metrics->addWidget(edit_metrics_histogram);
+
+    horizontalLayout_metrics = new QHBoxLayout();
+    horizontalLayout_metrics->setSpacing(2);
+    horizontalLayout_metrics->setObjectName("horizontalLayout_metrics");
+    lbl_metrics_status = new QLabel(tab_metrics);
+    lbl_metrics_status->setObjectName("lbl_metrics_status");
+
+    horizontalLayout_metrics->addWidget(lbl_metrics_status);
+
+    horizontalSpacer_metrics = new QSpacerItem(40, 20, QSizePolicy::Policy::Expanding, QSizePolicy::Policy::Minimum);
+
+    horizontalLayout_metrics->addItem(horizontalSpacer_metrics);
+
+    btn_metrics_reset = new QPushButton(tab_metrics);
+    btn_metrics_reset->setObjectName("btn_metrics_reset");
+
+    horizontalLayout_metrics->addWidget(btn_metrics_reset);
+
+    btn_metrics_export = new QPushButton(tab_metrics);
+    btn_metrics_export->setObjectName("btn_metrics_export");
+
+    horizontalLayout_metrics->addWidget(btn_metrics_export);
+
+
+    verticalLayout_metrics->addLayout(horizontalLayout_metrics);
+
+    selector_group->addTab(tab_metrics, QString());
 
     verticalLayout_2->addWidget(selector_group);
 
@@ -1844,7 +2119,8 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
 //    gridLayout->addWidget(tabWidget, 0, 0, 1, 1);
 
 //    QWidget::setTabOrder(tabWidget, edit_MTU);
-    QWidget::setTabOrder(edit_MTU, check_V2_Protocol);
+    QWidget::setTabOrder(edit_MTU, check_MTU_Tune);
+    QWidget::setTabOrder(check_MTU_Tune, check_V2_Protocol);
     QWidget::setTabOrder(check_V2_Protocol, radio_transport_uart);
     QWidget::setTabOrder(radio_transport_uart, radio_transport_udp);
     QWidget::setTabOrder(radio_transport_udp, radio_transport_bluetooth);
@@ -1858,7 +2134,9 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     QWidget::setTabOrder(radio_IMG_No_Action, radio_IMG_Test);
     QWidget::setTabOrder(radio_IMG_Test, radio_IMG_Confirm);
     QWidget::setTabOrder(radio_IMG_Confirm, check_IMG_Reset);
-    QWidget::setTabOrder(check_IMG_Reset, colview_IMG_Images);
+    QWidget::setTabOrder(check_IMG_Reset, check_IMG_Resume);
+    QWidget::setTabOrder(check_IMG_Resume, check_IMG_Reconnect);
+    QWidget::setTabOrder(check_IMG_Reconnect, colview_IMG_Images);
 //    QWidget::setTabOrder(colview_IMG_Images, edit_IMG_Preview_Hash);
     QWidget::setTabOrder(edit_IMG_Preview_Hash, edit_IMG_Preview_Version);
     QWidget::setTabOrder(edit_IMG_Preview_Version, check_IMG_Preview_Active);
@@ -1885,12 +2163,20 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     QWidget::setTabOrder(radio_FS_Download, radio_FS_Size);
     QWidget::setTabOrder(radio_FS_Size, radio_FS_HashChecksum);
     QWidget::setTabOrder(radio_FS_HashChecksum, radio_FS_Hash_Checksum_Types);
-    QWidget::setTabOrder(radio_FS_Hash_Checksum_Types, btn_FS_Go);
+    QWidget::setTabOrder(radio_FS_Hash_Checksum_Types, check_FS_Directory);
+    QWidget::setTabOrder(check_FS_Directory, check_FS_Verify);
+    QWidget::setTabOrder(check_FS_Verify, btn_FS_Go);
     QWidget::setTabOrder(btn_FS_Go, selector_OS);
     QWidget::setTabOrder(selector_OS, edit_OS_Echo_Input);
     QWidget::setTabOrder(edit_OS_Echo_Input, edit_OS_Echo_Output);
-    QWidget::setTabOrder(edit_OS_Echo_Output, table_OS_Tasks);
-    QWidget::setTabOrder(table_OS_Tasks, table_OS_Memory);
+    QWidget::setTabOrder(edit_OS_Echo_Output, edit_OS_Benchmark_Sizes);
+    QWidget::setTabOrder(edit_OS_Benchmark_Sizes, edit_OS_Benchmark_Iterations);
+    QWidget::setTabOrder(edit_OS_Benchmark_Iterations, edit_OS_Benchmark_Output);
+    QWidget::setTabOrder(edit_OS_Benchmark_Output, table_OS_Tasks);
+    QWidget::setTabOrder(table_OS_Tasks, check_OS_Tasks_Sample);
+    QWidget::setTabOrder(check_OS_Tasks_Sample, edit_OS_Tasks_Interval);
+    QWidget::setTabOrder(edit_OS_Tasks_Interval, edit_OS_Tasks_Events);
+    QWidget::setTabOrder(edit_OS_Tasks_Events, table_OS_Memory);
     QWidget::setTabOrder(table_OS_Memory, check_OS_Force_Reboot);
     QWidget::setTabOrder(check_OS_Force_Reboot, edit_os_datetime_date_time);
     QWidget::setTabOrder(edit_os_datetime_date_time, combo_os_datetime_timezone);
@@ -1908,7 +2194,12 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     QWidget::setTabOrder(combo_STAT_Group, table_STAT_Values);
     QWidget::setTabOrder(table_STAT_Values, radio_STAT_List);
     QWidget::setTabOrder(radio_STAT_List, radio_STAT_Fetch);
-    QWidget::setTabOrder(radio_STAT_Fetch, btn_STAT_Go);
+    QWidget::setTabOrder(radio_STAT_Fetch, radio_STAT_Poll);
+    QWidget::setTabOrder(radio_STAT_Poll, edit_STAT_Interval);
+    QWidget::setTabOrder(edit_STAT_Interval, combo_STAT_Plot_Mode);
+    QWidget::setTabOrder(combo_STAT_Plot_Mode, combo_STAT_Plot_Window);
+    QWidget::setTabOrder(combo_STAT_Plot_Window, btn_STAT_Export);
+    QWidget::setTabOrder(btn_STAT_Export, btn_STAT_Go);
     QWidget::setTabOrder(btn_STAT_Go, edit_SHELL_Output);
     QWidget::setTabOrder(edit_SHELL_Output, check_shell_vt100_decoding);
     QWidget::setTabOrder(check_shell_vt100_decoding, check_shel_unescape_strings);
@@ -1958,6 +2249,10 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     QWidget::setTabOrder(btn_custom_copy_receive, btn_custom_copy_both);
     QWidget::setTabOrder(btn_custom_copy_both, btn_custom_clear);
     QWidget::setTabOrder(btn_custom_clear, btn_custom_go);
+    QWidget::setTabOrder(btn_custom_go, table_metrics_commands);
+    QWidget::setTabOrder(table_metrics_commands, edit_metrics_histogram);
+    QWidget::setTabOrder(edit_metrics_histogram, btn_metrics_reset);
+    QWidget::setTabOrder(btn_metrics_reset, btn_metrics_export);
 
 //    retranslateUi(Form);
 
@@ -1972,6 +2267,10 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
 ///AUTOGEN_START_TRANSLATE
 //    Form->setWindowTitle(QCoreApplication::translate("Form", "Form", nullptr));
     label->setText(QCoreApplication::translate("Form", "MTU:", nullptr));
+#if QT_CONFIG(tooltip)
+    check_MTU_Tune->setToolTip(QCoreApplication::translate("Form", "If checked, the chunk size of image and file uploads is tuned (up to the MTU) for the best throughput, the result is remembered for each device", nullptr));
+#endif // QT_CONFIG(tooltip)
+    check_MTU_Tune->setText(QCoreApplication::translate("Form", "Tune", nullptr));
     check_V2_Protocol->setText(QCoreApplication::translate("Form", "SMP v2", nullptr));
     radio_transport_uart->setText(QCoreApplication::translate("Form", "UART", nullptr));
     radio_transport_udp->setText(QCoreApplication::translate("Form", "UDP", nullptr));
@@ -1987,10 +2286,23 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     check_transport_uart_show_transfer->setToolTip(QCoreApplication::translate("Form", "<html><head/><body><p>Will show incoming and outgoing packets in terminal view. Note: will also hide non-MCUmgr traffic that appears during a transfer. It is not recommended to enable this when the raw UART transport is used due to being binary data.</p></body></html>", nullptr));
 #endif // QT_CONFIG(tooltip)
     check_transport_uart_show_transfer->setText(QCoreApplication::translate("Form", "Show transfer", nullptr));
+#if QT_CONFIG(tooltip)
+    lbl_transport_rto->setToolTip(QCoreApplication::translate("Form", "Response timeout, estimated from measured response times of each command on the active transport", nullptr));
+#endif // QT_CONFIG(tooltip)
+    lbl_transport_rto->setText(QCoreApplication::translate("Form", "Timeout: default", nullptr));
     btn_cancel->setText(QCoreApplication::translate("Form", "&Cancel", nullptr));
     label_6->setText(QCoreApplication::translate("Form", "Progress:", nullptr));
     check_IMG_Reset->setText(QCoreApplication::translate("Form", "After upload", nullptr));
     label_9->setText(QCoreApplication::translate("Form", "Reset:", nullptr));
+    label_IMG_Resume->setText(QCoreApplication::translate("Form", "Resume:", nullptr));
+#if QT_CONFIG(tooltip)
+    check_IMG_Resume->setToolTip(QCoreApplication::translate("Form", "If checked, an upload of the same file which was interrupted will continue from where the device got to", nullptr));
+#endif // QT_CONFIG(tooltip)
+    check_IMG_Resume->setText(QCoreApplication::translate("Form", "After interruption", nullptr));
+#if QT_CONFIG(tooltip)
+    check_IMG_Reconnect->setToolTip(QCoreApplication::translate("Form", "If checked, the Bluetooth or UDP transport will be reconnected and the upload resumed if it disconnects during an upload", nullptr));
+#endif // QT_CONFIG(tooltip)
+    check_IMG_Reconnect->setText(QCoreApplication::translate("Form", "Reconnect automatically", nullptr));
     label_4->setText(QCoreApplication::translate("Form", "Image:", nullptr));
     btn_IMG_Local->setText(QCoreApplication::translate("Form", "...", nullptr));
     label_43->setText(QCoreApplication::translate("Form", "File:", nullptr));
@@ -2027,12 +2339,29 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     radio_FS_Size->setText(QCoreApplication::translate("Form", "Size", nullptr));
     radio_FS_HashChecksum->setText(QCoreApplication::translate("Form", "Hash/checksum", nullptr));
     radio_FS_Hash_Checksum_Types->setText(QCoreApplication::translate("Form", "Types", nullptr));
+#if QT_CONFIG(tooltip)
+    check_FS_Directory->setToolTip(QCoreApplication::translate("Form", "If checked, upload/download synchronises a whole directory (including subdirectories), files which already match (by the selected hash/checksum, default crc32) are skipped. Listing and creating remote directories uses the device shell", nullptr));
+#endif // QT_CONFIG(tooltip)
+    check_FS_Directory->setText(QCoreApplication::translate("Form", "Directory", nullptr));
+#if QT_CONFIG(tooltip)
+    check_FS_Verify->setToolTip(QCoreApplication::translate("Form", "If checked, uploaded files are verified by comparing the device hash/checksum (selected type, default crc32) with one calculated whilst the file was being read", nullptr));
+#endif // QT_CONFIG(tooltip)
+    check_FS_Verify->setText(QCoreApplication::translate("Form", "Verify", nullptr));
     selector_group->setTabText(selector_group->indexOf(tab_FS), QCoreApplication::translate("Form", "FS", nullptr));
     btn_OS_Go->setText(QCoreApplication::translate("Form", "Go", nullptr));
     lbl_OS_Status->setText(QCoreApplication::translate("Form", "[Status]", nullptr));
     label_10->setText(QCoreApplication::translate("Form", "Input:", nullptr));
     label_11->setText(QCoreApplication::translate("Form", "Output:", nullptr));
     selector_OS->setTabText(selector_OS->indexOf(tab_OS_Echo), QCoreApplication::translate("Form", "Echo", nullptr));
+    label_49->setText(QCoreApplication::translate("Form", "Sizes:", nullptr));
+#if QT_CONFIG(tooltip)
+    edit_OS_Benchmark_Sizes->setToolTip(QCoreApplication::translate("Form", "Number of echo payload sizes to test, spread evenly from 1 byte up to the largest echo which fits in the MTU", nullptr));
+#endif // QT_CONFIG(tooltip)
+    label_50->setText(QCoreApplication::translate("Form", "Iterations:", nullptr));
+#if QT_CONFIG(tooltip)
+    edit_OS_Benchmark_Iterations->setToolTip(QCoreApplication::translate("Form", "Number of echoes sent for each payload size", nullptr));
+#endif // QT_CONFIG(tooltip)
+    selector_OS->setTabText(selector_OS->indexOf(tab_OS_Benchmark), QCoreApplication::translate("Form", "Benchmark", nullptr));
     QTableWidgetItem *___qtablewidgetitem = table_OS_Tasks->horizontalHeaderItem(0);
     ___qtablewidgetitem->setText(QCoreApplication::translate("Form", "Task", nullptr));
     QTableWidgetItem *___qtablewidgetitem1 = table_OS_Tasks->horizontalHeaderItem(1);
@@ -2049,6 +2378,22 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     ___qtablewidgetitem6->setText(QCoreApplication::translate("Form", "Stack size", nullptr));
     QTableWidgetItem *___qtablewidgetitem7 = table_OS_Tasks->horizontalHeaderItem(7);
     ___qtablewidgetitem7->setText(QCoreApplication::translate("Form", "Stack usage", nullptr));
+    QTableWidgetItem *___qtablewidgetitem19 = table_OS_Tasks->horizontalHeaderItem(8);
+    ___qtablewidgetitem19->setText(QCoreApplication::translate("Form", "CPU %", nullptr));
+    QTableWidgetItem *___qtablewidgetitem20 = table_OS_Tasks->horizontalHeaderItem(9);
+    ___qtablewidgetitem20->setText(QCoreApplication::translate("Form", "Average CPU %", nullptr));
+    QTableWidgetItem *___qtablewidgetitem21 = table_OS_Tasks->horizontalHeaderItem(10);
+    ___qtablewidgetitem21->setText(QCoreApplication::translate("Form", "Stack peak", nullptr));
+    QTableWidgetItem *___qtablewidgetitem22 = table_OS_Tasks->horizontalHeaderItem(11);
+    ___qtablewidgetitem22->setText(QCoreApplication::translate("Form", "Stack trend", nullptr));
+#if QT_CONFIG(tooltip)
+    check_OS_Tasks_Sample->setToolTip(QCoreApplication::translate("Form", "Repeatedly fetches task stats until stopped, showing the share of CPU time each thread used since the previous sample and how its stack usage has changed. Threads with a sharp change are shown in bold and logged below", nullptr));
+#endif // QT_CONFIG(tooltip)
+    check_OS_Tasks_Sample->setText(QCoreApplication::translate("Form", "Sample every", nullptr));
+#if QT_CONFIG(tooltip)
+    edit_OS_Tasks_Interval->setToolTip(QCoreApplication::translate("Form", "Time between the start of each task stats request", nullptr));
+#endif // QT_CONFIG(tooltip)
+    edit_OS_Tasks_Interval->setSuffix(QCoreApplication::translate("Form", " ms", nullptr));
     selector_OS->setTabText(selector_OS->indexOf(tab_OS_Tasks), QCoreApplication::translate("Form", "Tasks", nullptr));
     QTableWidgetItem *___qtablewidgetitem8 = table_OS_Memory->horizontalHeaderItem(0);
     ___qtablewidgetitem8->setText(QCoreApplication::translate("Form", "Name", nullptr));
@@ -2085,6 +2430,25 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     lbl_STAT_Status->setText(QCoreApplication::translate("Form", "[Status]", nullptr));
     radio_STAT_List->setText(QCoreApplication::translate("Form", "List Groups", nullptr));
     radio_STAT_Fetch->setText(QCoreApplication::translate("Form", "Fetch Stats", nullptr));
+#if QT_CONFIG(tooltip)
+    radio_STAT_Poll->setToolTip(QCoreApplication::translate("Form", "Repeatedly fetches the group (or comma separated groups, blank for all listed groups) until stopped, one request at a time. Select counters in the table to plot them", nullptr));
+#endif // QT_CONFIG(tooltip)
+    radio_STAT_Poll->setText(QCoreApplication::translate("Form", "Poll", nullptr));
+#if QT_CONFIG(tooltip)
+    edit_STAT_Interval->setToolTip(QCoreApplication::translate("Form", "Time between the start of each poll of all groups", nullptr));
+#endif // QT_CONFIG(tooltip)
+    edit_STAT_Interval->setSuffix(QCoreApplication::translate("Form", " ms", nullptr));
+    label_51->setText(QCoreApplication::translate("Form", "Plot:", nullptr));
+    combo_STAT_Plot_Mode->setItemText(0, QCoreApplication::translate("Form", "Rate", nullptr));
+    combo_STAT_Plot_Mode->setItemText(1, QCoreApplication::translate("Form", "Value", nullptr));
+    combo_STAT_Plot_Window->setItemText(0, QCoreApplication::translate("Form", "1 minute", nullptr));
+    combo_STAT_Plot_Window->setItemText(1, QCoreApplication::translate("Form", "10 minutes", nullptr));
+    combo_STAT_Plot_Window->setItemText(2, QCoreApplication::translate("Form", "1 hour", nullptr));
+    combo_STAT_Plot_Window->setItemText(3, QCoreApplication::translate("Form", "All", nullptr));
+#if QT_CONFIG(tooltip)
+    btn_STAT_Export->setToolTip(QCoreApplication::translate("Form", "Export all polled samples, with deltas and rates, to a CSV file", nullptr));
+#endif // QT_CONFIG(tooltip)
+    btn_STAT_Export->setText(QCoreApplication::translate("Form", "Export CSV", nullptr));
     btn_STAT_Go->setText(QCoreApplication::translate("Form", "Go", nullptr));
     label_16->setText(QCoreApplication::translate("Form", "Values:", nullptr));
     label_15->setText(QCoreApplication::translate("Form", "Group:", nullptr));
@@ -2092,6 +2456,10 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     ___qtablewidgetitem12->setText(QCoreApplication::translate("Form", "Name", nullptr));
     QTableWidgetItem *___qtablewidgetitem13 = table_STAT_Values->horizontalHeaderItem(1);
     ___qtablewidgetitem13->setText(QCoreApplication::translate("Form", "Value", nullptr));
+    QTableWidgetItem *___qtablewidgetitem17 = table_STAT_Values->horizontalHeaderItem(2);
+    ___qtablewidgetitem17->setText(QCoreApplication::translate("Form", "Delta", nullptr));
+    QTableWidgetItem *___qtablewidgetitem18 = table_STAT_Values->horizontalHeaderItem(3);
+    ___qtablewidgetitem18->setText(QCoreApplication::translate("Form", "Rate (/s)", nullptr));
     selector_group->setTabText(selector_group->indexOf(tab_Stats), QCoreApplication::translate("Form", "Stats", nullptr));
     lbl_SHELL_Status->setText(QCoreApplication::translate("Form", "[Status]", nullptr));
     btn_SHELL_Clear->setText(QCoreApplication::translate("Form", "Clear", nullptr));
@@ -2164,6 +2532,14 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     lbl_custom_status->setText(QCoreApplication::translate("Form", "[Status]", nullptr));
     btn_custom_go->setText(QCoreApplication::translate("Form", "Go", nullptr));
     selector_group->setTabText(selector_group->indexOf(tab_custom), QCoreApplication::translate("Form", "Custom", nullptr));
+    table_metrics_commands->setHorizontalHeaderLabels(QStringList() << QCoreApplication::translate("Form", "Group", nullptr) << QCoreApplication::translate("Form", "Command", nullptr) << QCoreApplication::translate("Form", "Requests", nullptr) << QCoreApplication::translate("Form", "Responses", nullptr) << QCoreApplication::translate("Form", "Errors", nullptr) << QCoreApplication::translate("Form", "Retries", nullptr) << QCoreApplication::translate("Form", "Timeouts", nullptr) << QCoreApplication::translate("Form", "Sent (B)", nullptr) << QCoreApplication::translate("Form", "Received (B)", nullptr) << QCoreApplication::translate("Form", "Min (ms)", nullptr) << QCoreApplication::translate("Form", "Mean (ms)", nullptr) << QCoreApplication::translate("Form", "P90 (ms)", nullptr) << QCoreApplication::translate("Form", "P99 (ms)", nullptr) << QCoreApplication::translate("Form", "Max (ms)", nullptr));
+#if QT_CONFIG(tooltip)
+    table_metrics_commands->setToolTip(QCoreApplication::translate("Form", "Requests sent by each group and command, latency is from when a request was first sent so includes retries. Select a row to view its latency histogram", nullptr));
+#endif // QT_CONFIG(tooltip)
+    lbl_metrics_status->setText(QString());
+    btn_metrics_reset->setText(QCoreApplication::translate("Form", "Reset", nullptr));
+    btn_metrics_export->setText(QCoreApplication::translate("Form", "Export JSON", nullptr));
+    selector_group->setTabText(selector_group->indexOf(tab_metrics), QCoreApplication::translate("Form", "Metrics", nullptr));
 //    tabWidget->setTabText(tabWidget->indexOf(tab), QCoreApplication::translate("Form", "MCUmgr", nullptr));
     label_7->setText(QCoreApplication::translate("Form", "Hash:", nullptr));
     label_8->setText(QCoreApplication::translate("Form", "Version:", nullptr));
@@ -2184,6 +2560,11 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     connect(this, SIGNAL(plugin_add_open_close_button(QPushButton*)), parent_window, SLOT(plugin_add_open_close_button(QPushButton*)));
     connect(this, SIGNAL(plugin_to_hex(QByteArray*)), parent_window, SLOT(plugin_to_hex(QByteArray*)));
     connect(this, SIGNAL(plugin_serial_open_close(uint8_t)), parent_window, SLOT(plugin_serial_open_close(uint8_t)));
+    connect(this, SIGNAL(plugin_save_setting(QString,QVariant)), parent_window, SLOT(plugin_save_setting(QString,QVariant)));
+    connect(this, SIGNAL(plugin_load_setting(QString,QVariant*,bool*)), parent_window, SLOT(plugin_load_setting(QString,QVariant*,bool*)));
+    connect(&tmr_img_reconnect, SIGNAL(timeout()), this, SLOT(img_reconnect_timeout()));
+    connect(&tmr_metrics_refresh, SIGNAL(timeout()), this, SLOT(metrics_refresh()));
+    tmr_metrics_refresh.start();
 
     connect(parent_window, SIGNAL(plugin_serial_receive(QByteArray*)), this, SLOT(serial_receive(QByteArray*)));
     connect(parent_window, SIGNAL(plugin_serial_error(QSerialPort::SerialPortError)), this, SLOT(serial_error(QSerialPort::SerialPortError)));
@@ -2229,6 +2610,17 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     connect(smp_groups.enum_mgmt, SIGNAL(progress(uint8_t,uint8_t)), this, SLOT(progress(uint8_t,uint8_t)));
 
     connect(processor, SIGNAL(custom_message_callback(custom_message_callback_t,smp_error_t*)), this, SLOT(custom_message_callback(custom_message_callback_t,smp_error_t*)));
+    connect(processor, SIGNAL(rtt_updated(QString)), this, SLOT(rtt_updated(QString)));
+    connect(fs_sync, SIGNAL(progress(uint8_t)), this, SLOT(fs_sync_progress(uint8_t)));
+    connect(fs_sync, SIGNAL(file_status(QString)), this, SLOT(fs_sync_file_status(QString)));
+    connect(fs_sync, SIGNAL(finished(bool,QString)), this, SLOT(fs_sync_finished(bool,QString)));
+    connect(link_benchmark, SIGNAL(progress(uint8_t)), this, SLOT(link_benchmark_progress(uint8_t)));
+    connect(link_benchmark, SIGNAL(finished(bool,QString)), this, SLOT(link_benchmark_finished(bool,QString)));
+    connect(stat_poller, SIGNAL(polled(QString)), this, SLOT(stat_poller_polled(QString)));
+    connect(stat_poller, SIGNAL(finished(bool,QString)), this, SLOT(stat_poller_finished(bool,QString)));
+    connect(task_sampler, SIGNAL(sampled()), this, SLOT(task_sampler_sampled()));
+    connect(task_sampler, SIGNAL(thread_event(QString)), this, SLOT(task_sampler_thread_event(QString)));
+    connect(task_sampler, SIGNAL(finished(bool,QString)), this, SLOT(task_sampler_finished(bool,QString)));
 
     //Form signals
     connect(btn_FS_Local, SIGNAL(clicked()), this, SLOT(on_btn_FS_Local_clicked()));
@@ -2238,12 +2630,20 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     connect(radio_FS_Size, SIGNAL(toggled(bool)), this, SLOT(on_radio_FS_Size_toggled(bool)));
     connect(radio_FS_HashChecksum, SIGNAL(toggled(bool)), this, SLOT(on_radio_FS_HashChecksum_toggled(bool)));
     connect(radio_FS_Hash_Checksum_Types, SIGNAL(toggled(bool)), this, SLOT(on_radio_FS_Hash_Checksum_Types_toggled(bool)));
+    connect(check_FS_Directory, SIGNAL(toggled(bool)), this, SLOT(on_check_FS_Directory_toggled(bool)));
+    connect(check_FS_Verify, SIGNAL(toggled(bool)), this, SLOT(on_check_FS_Verify_toggled(bool)));
     connect(btn_IMG_Local, SIGNAL(clicked()), this, SLOT(on_btn_IMG_Local_clicked()));
     connect(btn_IMG_Go, SIGNAL(clicked()), this, SLOT(on_btn_IMG_Go_clicked()));
     connect(radio_IMG_No_Action, SIGNAL(toggled(bool)), this, SLOT(on_radio_IMG_No_Action_toggled(bool)));
     connect(btn_IMG_Preview_Copy, SIGNAL(clicked()), this, SLOT(on_btn_IMG_Preview_Copy_clicked()));
     connect(btn_OS_Go, SIGNAL(clicked()), this, SLOT(on_btn_OS_Go_clicked()));
+    connect(check_OS_Tasks_Sample, SIGNAL(toggled(bool)), this, SLOT(on_check_OS_Tasks_Sample_toggled(bool)));
     connect(btn_STAT_Go, SIGNAL(clicked()), this, SLOT(on_btn_STAT_Go_clicked()));
+    connect(radio_STAT_Poll, SIGNAL(toggled(bool)), this, SLOT(on_radio_STAT_Poll_toggled(bool)));
+    connect(btn_STAT_Export, SIGNAL(clicked()), this, SLOT(on_btn_STAT_Export_clicked()));
+    connect(table_STAT_Values, SIGNAL(itemSelectionChanged()), this, SLOT(on_table_STAT_Values_itemSelectionChanged()));
+    connect(combo_STAT_Plot_Mode, SIGNAL(currentIndexChanged(int)), this, SLOT(stat_plot_settings_changed()));
+    connect(combo_STAT_Plot_Window, SIGNAL(currentIndexChanged(int)), this, SLOT(stat_plot_settings_changed()));
     connect(btn_SHELL_Clear, SIGNAL(clicked()), this, SLOT(on_btn_SHELL_Clear_clicked()));
     connect(btn_SHELL_Copy, SIGNAL(clicked()), this, SLOT(on_btn_SHELL_Copy_clicked()));
     connect(btn_transport_connect, SIGNAL(clicked()), this, SLOT(on_btn_transport_connect_clicked()));
@@ -2291,6 +2691,9 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     connect(btn_custom_clear, SIGNAL(clicked()), this, SLOT(on_btn_custom_clear_clicked()));
     connect(edit_custom_indent, SIGNAL(valueChanged(int)), this, SLOT(on_edit_custom_indent_valueChanged(int)));
     connect(btn_custom_go, SIGNAL(clicked()), this, SLOT(on_btn_custom_go_clicked()));
+    connect(table_metrics_commands, SIGNAL(itemSelectionChanged()), this, SLOT(metrics_refresh()));
+    connect(btn_metrics_reset, SIGNAL(clicked()), this, SLOT(on_btn_metrics_reset_clicked()));
+    connect(btn_metrics_export, SIGNAL(clicked()), this, SLOT(on_btn_metrics_export_clicked()));
     connect(tree_IMG_Slot_Info, SIGNAL(itemDoubleClicked(QTreeWidgetItem*,int)), this, SLOT(on_tree_IMG_Slot_Info_itemDoubleClicked(QTreeWidgetItem*,int)));
     connect(btn_error_lookup, SIGNAL(clicked()), this, SLOT(on_btn_error_lookup_clicked()));
     connect(btn_cancel, SIGNAL(clicked()), this, SLOT(on_btn_cancel_clicked()));
@@ -2298,6 +2701,8 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     //Use monospace font for shell
     QFont shell_font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
     edit_SHELL_Output->setFont(shell_font);
+    edit_metrics_histogram->setFont(shell_font);
+    edit_OS_Benchmark_Output->setFont(shell_font);
 
     //Setup font spacing
     QFontMetrics shell_font_metrics(shell_font);
@@ -2310,6 +2715,10 @@ void plugin_mcumgr::setup(QMainWindow *main_window)
     colview_IMG_Images->setModel(&model_image_state);
     colview_IMG_Images->setColumnWidths(QList<int>() << 50 << 50 << 460);
 
+    plot_STAT->set_history(&stat_history);
+    table_STAT_Values->setSelectionBehavior(QAbstractItemView::SelectionBehavior::SelectRows);
+    stat_plot_settings_changed();
+
     check_IMG_Preview_Confirmed->setChecked(true);
     check_IMG_Preview_Confirmed->installEventFilter(this);
     check_IMG_Preview_Active->installEventFilter(this);
@@ -2390,6 +2799,10 @@ plugin_mcumgr::~plugin_mcumgr()
     disconnect(this, SIGNAL(plugin_add_open_close_button(QPushButton*)), this, SLOT(plugin_add_open_close_button(QPushButton*)));
     disconnect(this, SIGNAL(plugin_to_hex(QByteArray*)), parent_window, SLOT(plugin_to_hex(QByteArray*)));
     disconnect(this, SIGNAL(plugin_serial_open_close(uint8_t)), parent_window, SLOT(plugin_serial_open_close(uint8_t)));
+    disconnect(this, SIGNAL(plugin_save_setting(QString,QVariant)), parent_window, SLOT(plugin_save_setting(QString,QVariant)));
+    disconnect(this, SIGNAL(plugin_load_setting(QString,QVariant*,bool*)), parent_window, SLOT(plugin_load_setting(QString,QVariant*,bool*)));
+    tmr_img_reconnect.stop();
+    tmr_metrics_refresh.stop();
     disconnect(uart_transport, SIGNAL(serial_write(QByteArray*)), parent_window, SLOT(plugin_serial_transmit(QByteArray*)));
 
     disconnect(parent_window, SIGNAL(plugin_serial_receive(QByteArray*)), this, SLOT(serial_receive(QByteArray*)));
@@ -2407,6 +2820,17 @@ plugin_mcumgr::~plugin_mcumgr()
     disconnect(this, SIGNAL(custom_log(bool,QString*)));
 
     disconnect(this, SLOT(custom_message_callback(custom_message_callback_t,smp_error_t*)));
+    disconnect(this, SLOT(rtt_updated(QString)));
+    disconnect(this, SLOT(fs_sync_progress(uint8_t)));
+    disconnect(this, SLOT(fs_sync_file_status(QString)));
+    disconnect(this, SLOT(fs_sync_finished(bool,QString)));
+    disconnect(this, SLOT(link_benchmark_progress(uint8_t)));
+    disconnect(this, SLOT(link_benchmark_finished(bool,QString)));
+    disconnect(this, SLOT(stat_poller_polled(QString)));
+    disconnect(this, SLOT(stat_poller_finished(bool,QString)));
+    disconnect(this, SLOT(task_sampler_sampled()));
+    disconnect(this, SLOT(task_sampler_thread_event(QString)));
+    disconnect(this, SLOT(task_sampler_finished(bool,QString)));
 
     //Form signals
     disconnect(this, SLOT(on_btn_FS_Local_clicked()));
@@ -2416,12 +2840,19 @@ plugin_mcumgr::~plugin_mcumgr()
     disconnect(this, SLOT(on_radio_FS_Size_toggled(bool)));
     disconnect(this, SLOT(on_radio_FS_HashChecksum_toggled(bool)));
     disconnect(this, SLOT(on_radio_FS_Hash_Checksum_Types_toggled(bool)));
+    disconnect(this, SLOT(on_check_FS_Directory_toggled(bool)));
+    disconnect(this, SLOT(on_check_FS_Verify_toggled(bool)));
     disconnect(this, SLOT(on_btn_IMG_Local_clicked()));
     disconnect(this, SLOT(on_btn_IMG_Go_clicked()));
     disconnect(this, SLOT(on_radio_IMG_No_Action_toggled(bool)));
     disconnect(this, SLOT(on_btn_IMG_Preview_Copy_clicked()));
     disconnect(this, SLOT(on_btn_OS_Go_clicked()));
+    disconnect(this, SLOT(on_check_OS_Tasks_Sample_toggled(bool)));
     disconnect(this, SLOT(on_btn_STAT_Go_clicked()));
+    disconnect(this, SLOT(on_radio_STAT_Poll_toggled(bool)));
+    disconnect(this, SLOT(on_btn_STAT_Export_clicked()));
+    disconnect(this, SLOT(on_table_STAT_Values_itemSelectionChanged()));
+    disconnect(this, SLOT(stat_plot_settings_changed()));
     disconnect(this, SLOT(on_btn_SHELL_Clear_clicked()));
     disconnect(this, SLOT(on_btn_SHELL_Copy_clicked()));
     disconnect(this, SLOT(on_btn_transport_connect_clicked()));
@@ -2469,6 +2900,9 @@ plugin_mcumgr::~plugin_mcumgr()
     disconnect(this, SLOT(on_btn_custom_clear_clicked()));
     disconnect(this, SLOT(on_edit_custom_indent_valueChanged(int)));
     disconnect(this, SLOT(on_btn_custom_go_clicked()));
+    disconnect(this, SLOT(metrics_refresh()));
+    disconnect(this, SLOT(on_btn_metrics_reset_clicked()));
+    disconnect(this, SLOT(on_btn_metrics_export_clicked()));
     disconnect(this, SLOT(on_tree_IMG_Slot_Info_itemDoubleClicked(QTreeWidgetItem*,int)));
     disconnect(this, SLOT(on_btn_error_lookup_clicked()));
     disconnect(this, SLOT(on_btn_cancel_clicked()));
@@ -2489,6 +2923,10 @@ plugin_mcumgr::~plugin_mcumgr()
 #endif
 
     delete error_lookup_form;
+    delete fs_sync;
+    delete link_benchmark;
+    delete stat_poller;
+    delete task_sampler;
     delete smp_groups.enum_mgmt;
     delete smp_groups.zephyr_mgmt;
     delete smp_groups.stat_mgmt;
@@ -2583,6 +3021,9 @@ void plugin_mcumgr::serial_closed()
     }
 #endif
 
+    //The port may be opened to a different device, the window is negotiated again before the next pipelined transfer
+    processor->reset_window();
+
     switch (mode)
     {
         case ACTION_IMG_UPLOAD:
@@ -2604,6 +3045,7 @@ void plugin_mcumgr::serial_closed()
         case ACTION_OS_DATETIME_GET:
         case ACTION_OS_DATETIME_SET:
         case ACTION_OS_MCUMGR_BUFFER:
+        case ACTION_OS_WINDOW_NEGOTIATE:
         case ACTION_OS_OS_APPLICATION_INFO:
         case ACTION_OS_BOOTLOADER_INFO:
         {
@@ -2624,6 +3066,12 @@ void plugin_mcumgr::serial_closed()
             break;
         }
 
+        case ACTION_STAT_POLL:
+        {
+            stat_poller->cancel();
+            break;
+        }
+
         case ACTION_FS_UPLOAD:
         case ACTION_FS_DOWNLOAD:
         case ACTION_FS_STATUS:
@@ -2634,6 +3082,24 @@ void plugin_mcumgr::serial_closed()
             break;
         }
 
+        case ACTION_FS_SYNC:
+        {
+            fs_sync->cancel();
+            break;
+        }
+
+        case ACTION_OS_BENCHMARK:
+        {
+            link_benchmark->cancel();
+            break;
+        }
+
+        case ACTION_OS_TASK_SAMPLE:
+        {
+            task_sampler->cancel();
+            break;
+        }
+
         case ACTION_SETTINGS_READ:
         case ACTION_SETTINGS_WRITE:
         case ACTION_SETTINGS_DELETE:
@@ -2676,7 +3142,11 @@ void plugin_mcumgr::on_btn_FS_Local_clicked()
 {
     QString filename;
 
-    if (radio_FS_Upload->isChecked())
+    if (check_FS_Directory->isEnabled() && check_FS_Directory->isChecked())
+    {
+        filename = QFileDialog::getExistingDirectory(parent_window, (radio_FS_Upload->isChecked() ? "Select source directory for sync" : "Select target directory for sync"), edit_FS_Local->text());
+    }
+    else if (radio_FS_Upload->isChecked())
     {
         //TODO: load path
         filename = QFileDialog::getOpenFileName(parent_window, "Select source file for transfer", "", "All Files (*)");
@@ -2702,7 +3172,45 @@ void plugin_mcumgr::on_btn_FS_Go_clicked()
         return;
     }
 
-    if (radio_FS_Upload->isChecked())
+    if (check_FS_Directory->isChecked() && (radio_FS_Upload->isChecked() || radio_FS_Download->isChecked()))
+    {
+        //Directory sync, the transfers are run back to back by the sync object and reported through its signals
+        QString error;
+
+        if (edit_FS_Local->text().isEmpty())
+        {
+            lbl_FS_Status->setText("Error: Local directory name is required");
+        }
+        else if (edit_FS_Remote->text().isEmpty())
+        {
+            lbl_FS_Status->setText("Error: Remote directory name is required");
+        }
+        else if (radio_FS_Download->isChecked() && negotiate_window(lbl_FS_Status, SLOT(on_btn_FS_Go_clicked())) == true)
+        {
+            //Downloads are pipelined, the window is read from the device once the arguments are known to be valid
+            return;
+        }
+        else
+        {
+            mode = ACTION_FS_SYNC;
+            processor->set_transport(active_transport());
+            set_group_transport_settings(smp_groups.fs_mgmt);
+            set_group_transport_settings(smp_groups.shell_mgmt);
+            set_group_upload_tuning(smp_groups.fs_mgmt);
+            started = fs_sync->start((radio_FS_Upload->isChecked() ? SMP_FS_SYNC_UPLOAD : SMP_FS_SYNC_DOWNLOAD), edit_FS_Local->text(), edit_FS_Remote->text(), fs_hash_checksum_type(), (radio_FS_Upload->isChecked() && check_FS_Verify->isChecked()), ACTION_FS_SYNC, &error);
+
+            if (started == true)
+            {
+                lbl_FS_Status->setText("Synchronising...");
+            }
+            else
+            {
+                mode = ACTION_IDLE;
+                lbl_FS_Status->setText(QString("Error: ").append(error));
+            }
+        }
+    }
+    else if (radio_FS_Upload->isChecked())
     {
         if (edit_FS_Local->text().isEmpty())
         {
@@ -2721,7 +3229,8 @@ void plugin_mcumgr::on_btn_FS_Go_clicked()
             mode = ACTION_FS_UPLOAD;
             processor->set_transport(active_transport());
             set_group_transport_settings(smp_groups.fs_mgmt);
-            started = smp_groups.fs_mgmt->start_upload(edit_FS_Local->text(), edit_FS_Remote->text());
+            set_group_upload_tuning(smp_groups.fs_mgmt);
+            started = smp_groups.fs_mgmt->start_upload(edit_FS_Local->text(), edit_FS_Remote->text(), (check_FS_Verify->isChecked() ? fs_hash_checksum_type() : QString()));
 
             if (started == true)
             {
@@ -2739,6 +3248,11 @@ void plugin_mcumgr::on_btn_FS_Go_clicked()
         {
             lbl_FS_Status->setText("Error: Remote file name is required");
         }
+        else if (negotiate_window(lbl_FS_Status, SLOT(on_btn_FS_Go_clicked())) == true)
+        {
+            //Downloads are pipelined, the window is read from the device once the arguments are known to be valid
+            return;
+        }
         else
         {
             mode = ACTION_FS_DOWNLOAD;
@@ -2825,7 +3339,9 @@ void plugin_mcumgr::on_radio_FS_Upload_toggled(bool checked)
         edit_FS_Local->setEnabled(true);
         btn_FS_Local->setEnabled(true);
         edit_FS_Remote->setEnabled(true);
-        combo_FS_type->setEnabled(false);
+        check_FS_Directory->setEnabled(true);
+        check_FS_Verify->setEnabled(true);
+        update_fs_hash_checksum_enabled();
         edit_FS_Result->setEnabled(false);
         edit_FS_Size->setEnabled(false);
     }
@@ -2838,7 +3354,9 @@ void plugin_mcumgr::on_radio_FS_Download_toggled(bool checked)
         edit_FS_Local->setEnabled(true);
         btn_FS_Local->setEnabled(true);
         edit_FS_Remote->setEnabled(true);
-        combo_FS_type->setEnabled(false);
+        check_FS_Directory->setEnabled(true);
+        check_FS_Verify->setEnabled(false);
+        update_fs_hash_checksum_enabled();
         edit_FS_Result->setEnabled(false);
         edit_FS_Size->setEnabled(false);
     }
@@ -2851,6 +3369,8 @@ void plugin_mcumgr::on_radio_FS_Size_toggled(bool checked)
         edit_FS_Local->setEnabled(false);
         btn_FS_Local->setEnabled(false);
         edit_FS_Remote->setEnabled(true);
+        check_FS_Directory->setEnabled(false);
+        check_FS_Verify->setEnabled(false);
         combo_FS_type->setEnabled(false);
         edit_FS_Result->setEnabled(false);
         edit_FS_Size->setEnabled(true);
@@ -2864,6 +3384,8 @@ void plugin_mcumgr::on_radio_FS_HashChecksum_toggled(bool checked)
         edit_FS_Local->setEnabled(false);
         btn_FS_Local->setEnabled(false);
         edit_FS_Remote->setEnabled(true);
+        check_FS_Directory->setEnabled(false);
+        check_FS_Verify->setEnabled(false);
         combo_FS_type->setEnabled(true);
         edit_FS_Result->setEnabled(true);
         edit_FS_Size->setEnabled(true);
@@ -2877,12 +3399,45 @@ void plugin_mcumgr::on_radio_FS_Hash_Checksum_Types_toggled(bool checked)
         edit_FS_Local->setEnabled(false);
         btn_FS_Local->setEnabled(false);
         edit_FS_Remote->setEnabled(false);
+        check_FS_Directory->setEnabled(false);
+        check_FS_Verify->setEnabled(false);
         combo_FS_type->setEnabled(true);
         edit_FS_Result->setEnabled(false);
         edit_FS_Size->setEnabled(false);
     }
 }
 
+void plugin_mcumgr::on_check_FS_Directory_toggled(bool checked)
+{
+    Q_UNUSED(checked);
+
+    if (radio_FS_Upload->isChecked() || radio_FS_Download->isChecked())
+    {
+        update_fs_hash_checksum_enabled();
+    }
+}
+
+void plugin_mcumgr::on_check_FS_Verify_toggled(bool checked)
+{
+    Q_UNUSED(checked);
+
+    if (radio_FS_Upload->isChecked())
+    {
+        update_fs_hash_checksum_enabled();
+    }
+}
+
+void plugin_mcumgr::update_fs_hash_checksum_enabled()
+{
+    //Hash/checksum type is used to compare files when synchronising a directory and to verify uploads
+    combo_FS_type->setEnabled(check_FS_Directory->isChecked() || (radio_FS_Upload->isChecked() && check_FS_Verify->isChecked()));
+}
+
+QString plugin_mcumgr::fs_hash_checksum_type()
+{
+    return (combo_FS_type->currentText().isEmpty() ? QString("crc32") : combo_FS_type->currentText());
+}
+
 void plugin_mcumgr::on_btn_IMG_Local_clicked()
 {
     QString strFilename = QFileDialog::getOpenFileName(parent_window, tr("Open firmware file"), edit_IMG_Local->text(), tr("Binary Files (*.bin);;All Files (*)"));
@@ -2896,6 +3451,7 @@ void plugin_mcumgr::on_btn_IMG_Local_clicked()
 void plugin_mcumgr::on_btn_IMG_Go_clicked()
 {
     bool started = false;
+    QString error;
 
     if (claim_transport(lbl_IMG_Status) == false)
     {
@@ -2913,16 +3469,42 @@ void plugin_mcumgr::on_btn_IMG_Go_clicked()
         {
             lbl_IMG_Status->setText("Error: File does not exist");
         }
+        else if (smp_groups.img_mgmt->check_firmware_file(edit_IMG_Local->text(), &error) == false)
+        {
+            lbl_IMG_Status->setText(QString("Error: ").append(error));
+        }
+        else if (negotiate_window(lbl_IMG_Status, SLOT(on_btn_IMG_Go_clicked())) == true)
+        {
+            //Uploads are pipelined, the window is read from the device once the file is known to be valid
+            return;
+        }
         else
         {
+            img_upload_session_t session;
+
             mode = ACTION_IMG_UPLOAD;
+            tmr_img_reconnect.stop();
             processor->set_transport(active_transport());
             set_group_transport_settings(smp_groups.img_mgmt);
-            started = smp_groups.img_mgmt->start_firmware_update(edit_IMG_Image->value(), edit_IMG_Local->text(), false, &upload_hash, timeout_erase_ms);
+            set_group_upload_tuning(smp_groups.img_mgmt);
 
-            if (started == true)
+            if (check_IMG_Resume->isChecked() == true && smp_groups.img_mgmt->get_resume_session(&session) == true && session.file_name == edit_IMG_Local->text() && session.image == edit_IMG_Image->value())
+            {
+                started = smp_groups.img_mgmt->resume_firmware_update(&upload_hash, timeout_erase_ms);
+
+                if (started == true)
+                {
+                    lbl_IMG_Status->setText("Resuming upload...");
+                }
+            }
+            else
             {
-                lbl_IMG_Status->setText("Uploading...");
+                started = smp_groups.img_mgmt->start_firmware_update(edit_IMG_Image->value(), edit_IMG_Local->text(), false, &upload_hash, timeout_erase_ms);
+
+                if (started == true)
+                {
+                    lbl_IMG_Status->setText("Uploading...");
+                }
             }
         }
     }
@@ -3017,6 +3599,57 @@ void plugin_mcumgr::on_btn_IMG_Go_clicked()
     }
 }
 
+void plugin_mcumgr::img_reconnect_timeout()
+{
+    smp_transport *transport = active_transport();
+
+    if (mode != ACTION_IDLE || transport == uart_transport)
+    {
+        //Another operation has been started or the transport changed
+        return;
+    }
+
+    if (transport->is_connected() == 1)
+    {
+        //Transport is back, resume the upload from where the device got to
+        bool started;
+
+        if (claim_transport(lbl_IMG_Status) == false)
+        {
+            return;
+        }
+
+        mode = ACTION_IMG_UPLOAD;
+        processor->set_transport(transport);
+        set_group_transport_settings(smp_groups.img_mgmt);
+        started = smp_groups.img_mgmt->resume_firmware_update(&upload_hash, timeout_erase_ms);
+
+        if (started == true)
+        {
+            lbl_IMG_Status->setText("Reconnected, resuming upload...");
+            btn_cancel->setEnabled(true);
+        }
+        else
+        {
+            mode = ACTION_IDLE;
+            relase_transport();
+        }
+
+        return;
+    }
+
+    if (img_reconnect_attempts >= img_reconnect_max_attempts)
+    {
+        lbl_IMG_Status->setText("Reconnection failed, upload can be resumed once connected");
+        return;
+    }
+
+    ++img_reconnect_attempts;
+    lbl_IMG_Status->setText(QString("Reconnecting (attempt %1 of %2)...").arg(QString::number(img_reconnect_attempts), QString::number(img_reconnect_max_attempts)));
+    transport->connect();
+    tmr_img_reconnect.start();
+}
+
 void plugin_mcumgr::on_radio_IMG_No_Action_toggled(bool checked)
 {
 }
@@ -3029,6 +3662,13 @@ void plugin_mcumgr::on_btn_OS_Go_clicked()
 {
     bool started = false;
 
+    if (task_sampler->is_busy() == true)
+    {
+        //Button stops sampling
+        task_sampler->cancel();
+        return;
+    }
+
     if (claim_transport(lbl_OS_Status) == false)
     {
         return;
@@ -3054,8 +3694,73 @@ void plugin_mcumgr::on_btn_OS_Go_clicked()
             }
         }
     }
+    else if (selector_OS->currentWidget() == tab_OS_Benchmark)
+    {
+        //Echoes are sent back to back by the benchmark object and reported through its signals
+        QString error;
+        QString link_name = radio_transport_uart->text();
+
+        if (radio_transport_udp->isChecked())
+        {
+            link_name = radio_transport_udp->text();
+        }
+        else if (radio_transport_bluetooth->isChecked())
+        {
+            link_name = radio_transport_bluetooth->text();
+        }
+        else if (radio_transport_lora->isChecked())
+        {
+            link_name = radio_transport_lora->text();
+        }
+
+        edit_OS_Benchmark_Output->clear();
+        mode = ACTION_OS_BENCHMARK;
+        processor->set_transport(active_transport());
+        set_group_transport_settings(smp_groups.os_mgmt);
+        started = link_benchmark->start(link_name, processor->max_message_data_size(edit_MTU->value()), edit_OS_Benchmark_Sizes->value(), edit_OS_Benchmark_Iterations->value(), ACTION_OS_BENCHMARK, &error);
+
+        if (started == true)
+        {
+            lbl_OS_Status->setText("Benchmarking...");
+        }
+        else
+        {
+            mode = ACTION_IDLE;
+            lbl_OS_Status->setText(QString("Error: ").append(error));
+        }
+    }
+    else if (selector_OS->currentWidget() == tab_OS_Tasks && check_OS_Tasks_Sample->isChecked())
+    {
+        //Task stats are fetched by the sampler until stopped, and reported through its signals
+        QString error;
+
+        mode = ACTION_OS_TASK_SAMPLE;
+        processor->set_transport(active_transport());
+        set_group_transport_settings(smp_groups.os_mgmt);
+        table_OS_Tasks->setRowCount(0);
+        table_OS_Tasks->sortByColumn(8, Qt::DescendingOrder);
+        edit_OS_Tasks_Events->clear();
+        started = task_sampler->start(edit_OS_Tasks_Interval->value(), ACTION_OS_TASK_SAMPLE, &error);
+
+        if (started == true)
+        {
+            lbl_OS_Status->setText("Sampling task stats...");
+            btn_OS_Go->setText("Stop");
+        }
+        else
+        {
+            mode = ACTION_IDLE;
+            lbl_OS_Status->setText(QString("Error: ").append(error));
+        }
+    }
     else if (selector_OS->currentWidget() == tab_OS_Tasks)
     {
+        if (table_OS_Tasks->rowCount() > 0 && table_OS_Tasks->item(0, 8) != nullptr)
+        {
+            //Rows from sampling have columns which a single fetch does not update
+            table_OS_Tasks->setRowCount(0);
+        }
+
         mode = ACTION_OS_TASK_STATS;
         processor->set_transport(active_transport());
         set_group_transport_settings(smp_groups.os_mgmt);
@@ -3188,6 +3893,13 @@ void plugin_mcumgr::on_btn_STAT_Go_clicked()
 {
     bool started = false;
 
+    if (stat_poller->is_busy() == true)
+    {
+        //Button stops polling
+        stat_poller->cancel();
+        return;
+    }
+
     if (claim_transport(lbl_STAT_Status) == false)
     {
         return;
@@ -3226,8 +3938,56 @@ void plugin_mcumgr::on_btn_STAT_Go_clicked()
             }
         }
     }
-
-    if (started == true)
+    else if (radio_STAT_Poll->isChecked())
+    {
+        //Groups are fetched in turn by the poller until stopped, and reported through its signals
+        QStringList groups;
+        QString error;
+
+        if (combo_STAT_Group->currentText().isEmpty())
+        {
+            groups = group_list;
+        }
+        else
+        {
+            for (const QString &group : combo_STAT_Group->currentText().split(','))
+            {
+                if (group.trimmed().isEmpty() == false)
+                {
+                    groups.append(group.trimmed());
+                }
+            }
+        }
+
+        if (groups.isEmpty())
+        {
+            lbl_STAT_Status->setText("Error: No group name provided and no groups have been listed");
+        }
+        else
+        {
+            mode = ACTION_STAT_POLL;
+            processor->set_transport(active_transport());
+            set_group_transport_settings(smp_groups.stat_mgmt);
+            stat_history.clear();
+            stat_poll_rows.clear();
+            table_STAT_Values->setRowCount(0);
+            plot_STAT->set_series(QList<int>());
+            started = stat_poller->start(groups, edit_STAT_Interval->value(), ACTION_STAT_POLL, &error);
+
+            if (started == true)
+            {
+                lbl_STAT_Status->setText(QString("Polling %1 group%2...").arg(QString::number(groups.length()), (groups.length() == 1 ? "" : "s")));
+                btn_STAT_Go->setText("Stop");
+            }
+            else
+            {
+                mode = ACTION_IDLE;
+                lbl_STAT_Status->setText(QString("Error: ").append(error));
+            }
+        }
+    }
+
+    if (started == true)
     {
         btn_cancel->setEnabled(true);
     }
@@ -3295,11 +4055,66 @@ void plugin_mcumgr::status(uint8_t user_data, group_status status, QString error
 
     log_debug() << "Status: " << status;
 
+    if (user_data == ACTION_FS_SYNC)
+    {
+        //Directory sync steps are handled by the sync object, which reports once it has finished
+        return;
+    }
+
+    if (user_data == ACTION_OS_WINDOW_NEGOTIATE)
+    {
+        mode = ACTION_IDLE;
+        relase_transport();
+        btn_cancel->setEnabled(false);
+
+        if (status == STATUS_COMPLETE)
+        {
+            processor->set_window(smp_processor::window_for_buffer_count(os_buffer_count));
+        }
+        else if (status == STATUS_ERROR || status == STATUS_UNSUPPORTED)
+        {
+            //Device does not support the parameters command, only one request can be outstanding
+            processor->set_window(SMP_PROCESSOR_DEFAULT_WINDOW);
+        }
+        else
+        {
+            window_resume_status->setText(QString("Error: Failed to read device buffer count: ").append(error_string));
+            return;
+        }
+
+        //Window is now known, the operation which was waiting for it is started again
+        QTimer::singleShot(0, this, window_resume_slot);
+        return;
+    }
+
+    if (user_data == ACTION_OS_BENCHMARK)
+    {
+        //Each echo is timed by the benchmark object, which reports once it has finished
+        return;
+    }
+
+    if (user_data == ACTION_STAT_POLL)
+    {
+        //Polled samples are stored by the poller, which reports each group as it is fetched
+        return;
+    }
+
+    if (user_data == ACTION_OS_TASK_SAMPLE)
+    {
+        //Deltas are worked out by the sampler, which reports after each sample
+        return;
+    }
+
     if (sender() == smp_groups.img_mgmt)
     {
         log_debug() << "img sender";
         label_status = lbl_IMG_Status;
 
+        if (user_data == ACTION_IMG_UPLOAD)
+        {
+            save_group_upload_chunk_size(smp_groups.img_mgmt);
+        }
+
         if (status == STATUS_COMPLETE)
         {
             log_debug() << "complete";
@@ -3309,6 +4124,9 @@ void plugin_mcumgr::status(uint8_t user_data, group_status status, QString error
             {
                 log_debug() << "is upload";
 
+                //Upload is complete, there is nothing left to resume
+                emit plugin_save_setting(img_resume_setting, QVariantMap());
+
                 if (radio_IMG_Test->isChecked() || radio_IMG_Confirm->isChecked())
                 {
                     //Mark image for test or confirmation
@@ -3455,6 +4273,42 @@ void plugin_mcumgr::status(uint8_t user_data, group_status status, QString error
                 }
             }
         }
+        else if (user_data == ACTION_IMG_UPLOAD)
+        {
+            img_upload_session_t session;
+
+            if (check_IMG_Resume->isChecked() == true && smp_groups.img_mgmt->get_resume_session(&session) == true)
+            {
+                //Upload was interrupted, keep the session so it can be resumed even if the application is restarted
+                QVariantMap session_map;
+
+                session_map.insert("file", session.file_name);
+                session_map.insert("size", session.file_size);
+                session_map.insert("modified", session.file_modified);
+                session_map.insert("hash", session.session_hash);
+                session_map.insert("image", (uint)session.image);
+                session_map.insert("upgrade", session.upgrade);
+                session_map.insert("offset", session.offset);
+                emit plugin_save_setting(img_resume_setting, session_map);
+
+                if (error_string.isNull() == false)
+                {
+                    error_string.append(QString(", upload can be resumed from %1%").arg(QString::number(session.offset * 100 / session.file_size)));
+                }
+
+                if (status == STATUS_TRANSPORT_DISCONNECTED && check_IMG_Reconnect->isChecked() == true && active_transport() != uart_transport && active_transport()->is_connected() == 0)
+                {
+                    //Reconnect and resume the upload
+                    img_reconnect_attempts = 0;
+                    tmr_img_reconnect.start();
+
+                    if (error_string.isNull() == false)
+                    {
+                        error_string.append(", reconnecting...");
+                    }
+                }
+            }
+        }
     }
     else if (sender() == smp_groups.os_mgmt)
     {
@@ -3576,6 +4430,10 @@ void plugin_mcumgr::status(uint8_t user_data, group_status status, QString error
             {
                 edit_OS_Info_Output->clear();
                 edit_OS_Info_Output->appendPlainText(QString::number(os_buffer_count) % " buffers of " % QString::number(os_buffer_size) % " bytes each");
+
+                //Allow as many requests to be outstanding as the device can buffer
+                processor->set_window(smp_processor::window_for_buffer_count(os_buffer_count));
+                edit_OS_Info_Output->appendPlainText(QString("Up to ") % QString::number(processor->window()) % " requests will be sent before awaiting a response");
                 error_string = nullptr;
             }
             else if (user_data == ACTION_OS_OS_APPLICATION_INFO)
@@ -3696,7 +4554,16 @@ void plugin_mcumgr::status(uint8_t user_data, group_status status, QString error
             if (user_data == ACTION_STAT_GROUP_DATA)
             {
                 uint16_t i = 0;
-                uint16_t l = table_STAT_Values->rowCount();
+                uint16_t l;
+
+                if (stat_poll_rows.isEmpty() == false)
+                {
+                    //Rows from polling are replaced by the snapshot
+                    stat_poll_rows.clear();
+                    table_STAT_Values->setRowCount(0);
+                }
+
+                l = table_STAT_Values->rowCount();
 
                 table_STAT_Values->setSortingEnabled(false);
 
@@ -3742,6 +4609,11 @@ void plugin_mcumgr::status(uint8_t user_data, group_status status, QString error
         log_debug() << "fs sender";
         label_status = lbl_FS_Status;
 
+        if (user_data == ACTION_FS_UPLOAD)
+        {
+            save_group_upload_chunk_size(smp_groups.fs_mgmt);
+        }
+
         if (status == STATUS_COMPLETE)
         {
             log_debug() << "complete";
@@ -3957,10 +4829,14 @@ void plugin_mcumgr::status(uint8_t user_data, group_status status, QString error
 
 void plugin_mcumgr::progress(uint8_t user_data, uint8_t percent)
 {
-    Q_UNUSED(user_data);
-
     log_debug() << "Progress " << percent << " from " << this->sender();
 
+    if (user_data == ACTION_FS_SYNC)
+    {
+        //Directory sync reports progress across all of its files
+        return;
+    }
+
     if (this->sender() == smp_groups.img_mgmt)
     {
         log_debug() << "img sender";
@@ -3988,6 +4864,8 @@ void plugin_mcumgr::on_btn_transport_connect_clicked()
     }
     else
     {
+        //The connection may be changed to a different device
+        processor->reset_window();
         transport->open_connect_dialog();
     }
 }
@@ -4132,6 +5010,20 @@ bool plugin_mcumgr::claim_transport(QLabel *status)
 {
     bool successful = false;
 
+    if (stat_poller->is_busy() == true)
+    {
+        //Polling holds the transport until it is stopped
+        status->setText("Error: Stat polling in progress");
+        return false;
+    }
+
+    if (task_sampler->is_busy() == true)
+    {
+        //As does task sampling
+        status->setText("Error: Task sampling in progress");
+        return false;
+    }
+
     if (active_transport() == uart_transport)
     {
         emit plugin_set_status(true, !check_transport_uart_show_transfer->isChecked(), &successful);
@@ -4154,6 +5046,32 @@ bool plugin_mcumgr::claim_transport(QLabel *status)
     return successful;
 }
 
+bool plugin_mcumgr::negotiate_window(QLabel *status, const char *resume_slot)
+{
+    //Starts reading the device buffer count if the request window is not yet known for this connection, returns
+    //false if it is already known. Otherwise the operation is started again from resume_slot once the window is set
+    processor->set_transport(active_transport());
+
+    if (processor->window_negotiated() == true)
+    {
+        return false;
+    }
+
+    mode = ACTION_OS_WINDOW_NEGOTIATE;
+    window_resume_slot = resume_slot;
+    window_resume_status = status;
+    set_group_transport_settings(smp_groups.os_mgmt);
+
+    if (smp_groups.os_mgmt->start_mcumgr_parameters(&os_buffer_size, &os_buffer_count) == true)
+    {
+        status->setText("Reading device buffer count...");
+        btn_cancel->setEnabled(true);
+    }
+
+    //A request which could not be sent has already been reported to the status handler
+    return true;
+}
+
 void plugin_mcumgr::relase_transport(void)
 {
     if (active_transport() == uart_transport && uart_transport_locked == true)
@@ -4341,10 +5259,46 @@ void plugin_mcumgr::on_btn_settings_go_clicked()
 
 void plugin_mcumgr::setup_finished()
 {
+    QVariant saved_chunk_sizes;
+    QVariant saved_session;
+    bool found = false;
+
 #ifndef SKIPPLUGIN_LOGGER
     logger->find_logger_plugin(parent_window);
 #endif
 
+    //Restore chunk sizes learnt for each device in previous sessions
+    emit plugin_load_setting(upload_chunk_size_setting, &saved_chunk_sizes, &found);
+
+    if (found == true)
+    {
+        upload_chunk_sizes = saved_chunk_sizes.toMap();
+    }
+
+    found = false;
+
+    //Restore details of an upload which was interrupted in a previous session
+    emit plugin_load_setting(img_resume_setting, &saved_session, &found);
+
+    if (found == true && saved_session.toMap().isEmpty() == false)
+    {
+        QVariantMap session_map = saved_session.toMap();
+        img_upload_session_t session;
+
+        session.file_name = session_map.value("file").toString();
+        session.file_size = session_map.value("size").toLongLong();
+        session.file_modified = session_map.value("modified").toDateTime();
+        session.session_hash = session_map.value("hash").toByteArray();
+        session.image = session_map.value("image").toUInt();
+        session.upgrade = session_map.value("upgrade").toBool();
+        session.offset = session_map.value("offset").toUInt();
+
+        if (session.file_name.isEmpty() == false && session.session_hash.isEmpty() == false)
+        {
+            smp_groups.img_mgmt->set_resume_session(&session);
+        }
+    }
+
 #if defined(PLUGIN_MCUMGR_TRANSPORT_BLUETOOTH)
     bluetooth_transport->setup_finished();
 #endif
@@ -4925,6 +5879,278 @@ void plugin_mcumgr::on_btn_custom_go_clicked()
     btn_cancel->setEnabled(true);
 }
 
+void plugin_mcumgr::rtt_updated(QString summary)
+{
+    //Shows the most recently updated response time estimate, all estimates for the transport are listed in the tooltip
+    QStringList estimates = processor->rtt_summary();
+
+    if (summary.isEmpty() == true)
+    {
+        lbl_transport_rto->setText("Timeout: default");
+    }
+    else
+    {
+        lbl_transport_rto->setText(summary.section(": ", 1));
+    }
+
+    lbl_transport_rto->setToolTip(estimates.isEmpty() == true ? "No response times have been measured on this transport" : estimates.join("\n"));
+}
+
+void plugin_mcumgr::fs_sync_progress(uint8_t percent)
+{
+    progress_FS_Complete->setValue(percent);
+}
+
+void plugin_mcumgr::fs_sync_file_status(QString message)
+{
+    lbl_FS_Status->setText(message);
+}
+
+void plugin_mcumgr::fs_sync_finished(bool success, QString summary)
+{
+    Q_UNUSED(success);
+
+    save_group_upload_chunk_size(smp_groups.fs_mgmt);
+    mode = ACTION_IDLE;
+    relase_transport();
+    btn_cancel->setEnabled(false);
+    lbl_FS_Status->setText(summary);
+}
+
+void plugin_mcumgr::link_benchmark_progress(uint8_t percent)
+{
+    lbl_OS_Status->setText(QString("Benchmarking... %1%").arg(QString::number(percent)));
+}
+
+void plugin_mcumgr::link_benchmark_finished(bool success, QString summary)
+{
+    Q_UNUSED(success);
+
+    mode = ACTION_IDLE;
+    relase_transport();
+    btn_cancel->setEnabled(false);
+    lbl_OS_Status->setText(summary);
+
+    //Partial results are shown if the benchmark did not complete
+    edit_OS_Benchmark_Output->setPlainText(link_benchmark->report());
+}
+
+void plugin_mcumgr::task_sampler_sampled()
+{
+    const QList<smp_task_thread_t> &threads = task_sampler->threads();
+    int i = 0;
+
+    table_OS_Tasks->setSortingEnabled(false);
+    table_OS_Tasks->setRowCount(threads.length());
+
+    //Rows are refilled in sampler order, sorting is restored afterwards so the busiest threads stay at the top
+    while (i < threads.length())
+    {
+        const smp_task_thread_t &thread = threads.at(i);
+        QVariant values[] = {thread.name, thread.id, thread.priority, thread.state, thread.context_switches, thread.runtime, thread.stack_size, thread.stack_usage, QVariant(), QVariant(), thread.stack_peak, QVariant()};
+        int column = 0;
+
+        if (smp_task_sampler::sample_count(&thread) > 0)
+        {
+            //Numeric values so that the columns sort by value rather than as text
+            values[8] = qRound(smp_task_sampler::sample(&thread, smp_task_sampler::sample_count(&thread) - 1).cpu_percent * 10.0) / 10.0;
+            values[9] = qRound(smp_task_sampler::average_cpu_percent(&thread) * 10.0) / 10.0;
+            values[11] = smp_task_sampler::stack_trend(&thread);
+        }
+
+        while (column < table_OS_Tasks->columnCount())
+        {
+            QTableWidgetItem *item = table_OS_Tasks->item(i, column);
+            QFont font;
+
+            if (item == nullptr)
+            {
+                item = new QTableWidgetItem();
+                table_OS_Tasks->setItem(i, column, item);
+            }
+
+            font = item->font();
+            font.setBold(thread.flagged);
+            item->setFont(font);
+            item->setData(Qt::DisplayRole, values[column]);
+            ++column;
+        }
+
+        ++i;
+    }
+
+    table_OS_Tasks->setSortingEnabled(true);
+}
+
+void plugin_mcumgr::task_sampler_thread_event(QString message)
+{
+    edit_OS_Tasks_Events->appendPlainText(QString("%1 %2").arg(QDateTime::currentDateTime().toString("hh:mm:ss"), message));
+}
+
+void plugin_mcumgr::task_sampler_finished(bool success, QString summary)
+{
+    Q_UNUSED(success);
+
+    mode = ACTION_IDLE;
+    relase_transport();
+    btn_cancel->setEnabled(false);
+    btn_OS_Go->setText("Go");
+    lbl_OS_Status->setText(summary);
+}
+
+void plugin_mcumgr::on_check_OS_Tasks_Sample_toggled(bool checked)
+{
+    edit_OS_Tasks_Interval->setEnabled(checked);
+}
+
+void plugin_mcumgr::stat_poller_polled(QString group)
+{
+    int i = 0;
+
+    table_STAT_Values->setSortingEnabled(false);
+
+    while (i < stat_history.series_count())
+    {
+        if (stat_history.series_group(i) == group)
+        {
+            QTableWidgetItem *row_name = stat_poll_rows.value(i, nullptr);
+            uint32_t value;
+            uint32_t delta;
+            double rate;
+            int row;
+
+            if (row_name == nullptr)
+            {
+                row = table_STAT_Values->rowCount();
+                row_name = new QTableWidgetItem(QString("%1/%2").arg(group, stat_history.series_counter(i)));
+                row_name->setData(Qt::UserRole, i);
+                table_STAT_Values->insertRow(row);
+                table_STAT_Values->setItem(row, 0, row_name);
+                table_STAT_Values->setItem(row, 1, new QTableWidgetItem());
+                table_STAT_Values->setItem(row, 2, new QTableWidgetItem());
+                table_STAT_Values->setItem(row, 3, new QTableWidgetItem());
+                stat_poll_rows.insert(i, row_name);
+            }
+            else
+            {
+                row = row_name->row();
+            }
+
+            if (stat_history.latest(i, &value, &delta, &rate) == true)
+            {
+                table_STAT_Values->item(row, 1)->setText(QString::number(value));
+                table_STAT_Values->item(row, 2)->setText(QString::number(delta));
+                table_STAT_Values->item(row, 3)->setText(QString::number(rate, 'f', 2));
+            }
+        }
+
+        ++i;
+    }
+
+    table_STAT_Values->setSortingEnabled(true);
+    plot_STAT->update();
+}
+
+void plugin_mcumgr::stat_poller_finished(bool success, QString summary)
+{
+    Q_UNUSED(success);
+
+    mode = ACTION_IDLE;
+    relase_transport();
+    btn_cancel->setEnabled(false);
+    btn_STAT_Go->setText("Go");
+    lbl_STAT_Status->setText(summary);
+}
+
+void plugin_mcumgr::on_radio_STAT_Poll_toggled(bool checked)
+{
+    edit_STAT_Interval->setEnabled(checked);
+}
+
+void plugin_mcumgr::on_btn_STAT_Export_clicked()
+{
+    QString filename;
+    QFile file;
+    QTextStream stream;
+
+    if (stat_history.series_count() == 0)
+    {
+        lbl_STAT_Status->setText("Error: No polled stats to export");
+        return;
+    }
+
+    filename = QFileDialog::getSaveFileName(parent_window, "Export polled stats", "", "CSV Files (*.csv);;All Files (*)");
+
+    if (filename.isEmpty() == true)
+    {
+        return;
+    }
+
+    file.setFileName(filename);
+
+    if (file.open(QFile::WriteOnly | QFile::Truncate) == false)
+    {
+        lbl_STAT_Status->setText("Error: file could not be opened in write mode");
+        return;
+    }
+
+    stream.setDevice(&file);
+    stat_history.write_csv(&stream);
+    stream.flush();
+    file.close();
+    lbl_STAT_Status->setText("Exported");
+}
+
+void plugin_mcumgr::on_table_STAT_Values_itemSelectionChanged()
+{
+    //Only rows from polling have a series to plot
+    QList<int> series;
+
+    for (const QTableWidgetItem *item : table_STAT_Values->selectedItems())
+    {
+        QTableWidgetItem *row_name = table_STAT_Values->item(item->row(), 0);
+
+        if (row_name != nullptr && row_name->data(Qt::UserRole).isValid() == true && series.contains(row_name->data(Qt::UserRole).toInt()) == false)
+        {
+            series.append(row_name->data(Qt::UserRole).toInt());
+        }
+    }
+
+    plot_STAT->set_series(series);
+}
+
+void plugin_mcumgr::stat_plot_settings_changed()
+{
+    uint32_t window_ms;
+
+    switch (combo_STAT_Plot_Window->currentIndex())
+    {
+        case 0:
+        {
+            window_ms = 60 * 1000;
+            break;
+        }
+        case 1:
+        {
+            window_ms = 10 * 60 * 1000;
+            break;
+        }
+        case 2:
+        {
+            window_ms = 60 * 60 * 1000;
+            break;
+        }
+        default:
+        {
+            window_ms = 0;
+            break;
+        }
+    };
+
+    plot_STAT->set_rate(combo_STAT_Plot_Mode->currentIndex() == 0);
+    plot_STAT->set_window(window_ms);
+}
+
 void plugin_mcumgr::custom_message_callback(enum custom_message_callback_t type, smp_error_t *data)
 {
     mode = ACTION_IDLE;
@@ -4983,6 +6209,214 @@ void plugin_mcumgr::set_group_transport_settings(smp_group *group, uint32_t time
     group->set_parameters((check_V2_Protocol->isChecked() ? 1 : 0), edit_MTU->value(), transport->get_retries(), (timeout >= transport->get_timeout() ? timeout : transport->get_timeout()), mode);
 }
 
+void plugin_mcumgr::metrics_refresh()
+{
+    //Only updated whilst the metrics tab is being viewed
+    smp_metrics *metrics = processor->metrics();
+    const QList<smp_metrics_entry_t> &entries = metrics->entries();
+    uint32_t requests = 0;
+    uint32_t retries = 0;
+    uint32_t timeouts = 0;
+    uint64_t request_bytes = 0;
+    smp_message_pool *pool = processor->messages();
+    uint32_t pool_allocations = pool->get_message_allocations() + pool->get_buffer_allocations();
+    int selected_row = table_metrics_commands->currentRow();
+    int i = 0;
+
+    if (tab_metrics->isVisible() == false)
+    {
+        return;
+    }
+
+    table_metrics_commands->setRowCount(entries.length());
+
+    while (i < entries.length())
+    {
+        const smp_metrics_entry_t *entry = &entries.at(i);
+        QStringList values;
+        uint8_t l = 0;
+
+        values << QString::number(entry->group) << QString::number(entry->command) << QString::number(entry->requests) << QString::number(entry->responses) << QString::number(entry->errors) << QString::number(entry->retries) << QString::number(entry->timeouts) << QString::number(entry->request_bytes) << QString::number(entry->response_bytes);
+
+        if (entry->responses > 0)
+        {
+            values << QString::number(entry->latency_min_ms) << QString::number((double)entry->latency_total_ms / (double)entry->responses, 'f', 1) << QString::number(smp_metrics::latency_percentile(entry, 90)) << QString::number(smp_metrics::latency_percentile(entry, 99)) << QString::number(entry->latency_max_ms);
+        }
+
+        while (l < TABLE_METRICS_COLUMN_COUNT)
+        {
+            QTableWidgetItem *item = table_metrics_commands->item(i, l);
+
+            if (item == nullptr)
+            {
+                item = new QTableWidgetItem();
+                table_metrics_commands->setItem(i, l, item);
+            }
+
+            item->setText(l < values.length() ? values.at(l) : "");
+            ++l;
+        }
+
+        requests += entry->requests;
+        retries += entry->retries;
+        timeouts += entry->timeouts;
+        request_bytes += entry->request_bytes;
+        ++i;
+    }
+
+    lbl_metrics_summary->setText(QString("%1 requests, %2 retries, %3 timeouts, %4 sequence mismatches, %5 header mismatches, %6 unexpected and %7 invalid responses in %8 s").arg(QString::number(requests), QString::number(retries), QString::number(timeouts), QString::number(metrics->get_sequence_mismatches()), QString::number(metrics->get_header_mismatches()), QString::number(metrics->get_unexpected_responses()), QString::number(metrics->get_invalid_responses()), QString::number(metrics->duration_ms() / 1000)));
+
+    if (request_bytes >= 1024)
+    {
+        //Without the pool each transfer message needed its own allocation plus at least one for its buffer
+        double kb_sent = (double)request_bytes / 1024.0;
+
+        lbl_metrics_summary->setText(lbl_metrics_summary->text().append(QString("\nMessage pool: %1 transfer messages, %2 allocations (%3 per KB sent, unpooled would be at least %4 per KB)").arg(QString::number(pool->get_acquired()), QString::number(pool_allocations), QString::number((double)pool_allocations / kb_sent, 'f', 3), QString::number((double)(pool->get_acquired() * 2) / kb_sent, 'f', 3))));
+    }
+
+    if (selected_row >= 0 && selected_row < entries.length())
+    {
+        //Text histogram of the selected command's latency
+        const smp_metrics_entry_t *entry = &entries.at(selected_row);
+        uint32_t largest = 0;
+        uint8_t first = SMP_METRICS_LATENCY_BUCKETS;
+        uint8_t last = 0;
+        uint8_t l = 0;
+        QString histogram = QString("Group %1 command %2 latency:\n").arg(QString::number(entry->group), QString::number(entry->command));
+
+        while (l < SMP_METRICS_LATENCY_BUCKETS)
+        {
+            if (entry->latency_histogram[l] > 0)
+            {
+                if (first == SMP_METRICS_LATENCY_BUCKETS)
+                {
+                    first = l;
+                }
+
+                last = l;
+
+                if (entry->latency_histogram[l] > largest)
+                {
+                    largest = entry->latency_histogram[l];
+                }
+            }
+
+            ++l;
+        }
+
+        l = first;
+
+        while (l <= last && first < SMP_METRICS_LATENCY_BUCKETS)
+        {
+            histogram.append(QString("%1 %2 %3\n").arg(smp_metrics::latency_bucket_name(l), 10).arg(QString::number(entry->latency_histogram[l]), 8).arg(QString((int)(entry->latency_histogram[l] * metrics_histogram_bar_width / largest), '#')));
+            ++l;
+        }
+
+        edit_metrics_histogram->setPlainText(histogram);
+    }
+    else
+    {
+        edit_metrics_histogram->clear();
+    }
+}
+
+void plugin_mcumgr::on_btn_metrics_reset_clicked()
+{
+    processor->metrics()->reset();
+    processor->messages()->reset_counters();
+    table_metrics_commands->setRowCount(0);
+    lbl_metrics_status->clear();
+    metrics_refresh();
+}
+
+void plugin_mcumgr::on_btn_metrics_export_clicked()
+{
+    //Exports the metrics along with details of the connection, so transports and firmware builds can be compared
+    QString filename = QFileDialog::getSaveFileName(parent_window, "Export SMP metrics", "", "JSON Files (*.json);;All Files (*)");
+    QJsonObject output;
+    QFile file;
+
+    if (filename.isEmpty() == true)
+    {
+        return;
+    }
+
+    output = processor->metrics()->to_json();
+    output.insert("exported", QDateTime::currentDateTime().toString(Qt::ISODate));
+    output.insert("transport", active_transport()->device_identifier());
+    output.insert("mtu", edit_MTU->value());
+    output.insert("smp_version", (check_V2_Protocol->isChecked() ? 2 : 1));
+    output.insert("window", processor->window());
+    output.insert("rtt_estimates", QJsonArray::fromStringList(processor->rtt_summary()));
+    output.insert("message_pool", QJsonObject({{"acquired", (qint64)processor->messages()->get_acquired()}, {"message_allocations", (qint64)processor->messages()->get_message_allocations()}, {"buffer_allocations", (qint64)processor->messages()->get_buffer_allocations()}, {"released", (qint64)processor->messages()->get_released()}, {"idle", (qint64)processor->messages()->get_idle()}}));
+
+    file.setFileName(filename);
+
+    if (file.open(QFile::WriteOnly | QFile::Truncate) == false)
+    {
+        lbl_metrics_status->setText("Error: file could not be opened in write mode");
+        return;
+    }
+
+    file.write(QJsonDocument(output).toJson());
+    file.close();
+    lbl_metrics_status->setText("Exported");
+}
+
+void plugin_mcumgr::set_group_upload_tuning(smp_group *group)
+{
+    //Starts from the chunk size learnt for this device in a previous upload. A size limit is only applied to the device which
+    //rejected the larger size and expires so that the device is probed again (e.g. after a firmware update)
+    QVariantMap device_sizes;
+    uint32_t limit = 0;
+
+    upload_device_identifier = active_transport()->device_identifier();
+    upload_device_unique = active_transport()->device_identifier_is_unique();
+
+    if (upload_device_identifier.isEmpty() == false)
+    {
+        device_sizes = upload_chunk_sizes.value(upload_device_identifier).toMap();
+    }
+
+    if (upload_device_unique == true && device_sizes.contains("limit_time") == true && (QDateTime::currentSecsSinceEpoch() - device_sizes.value("limit_time").toLongLong()) < upload_chunk_limit_expiry_s)
+    {
+        limit = device_sizes.value("limit").toUInt();
+    }
+
+    group->set_upload_chunk_tuning(check_MTU_Tune->isChecked(), device_sizes.value("size").toUInt(), limit);
+}
+
+void plugin_mcumgr::save_group_upload_chunk_size(smp_group *group)
+{
+    QVariantMap device_sizes;
+    QVariantMap previous_sizes;
+    uint32_t limit;
+
+    if (group->get_upload_chunk_size() == 0 || upload_device_identifier.isEmpty() == true)
+    {
+        return;
+    }
+
+    previous_sizes = upload_chunk_sizes.value(upload_device_identifier).toMap();
+    limit = group->get_upload_chunk_limit();
+    device_sizes.insert("size", group->get_upload_chunk_size());
+
+    if (limit > 0 && upload_device_unique == true)
+    {
+        //A limit carried over from a previous upload keeps the time it was learnt so that it still expires
+        device_sizes.insert("limit", limit);
+        device_sizes.insert("limit_time", (previous_sizes.value("limit").toUInt() == limit && previous_sizes.contains("limit_time") == true ? previous_sizes.value("limit_time") : QVariant(QDateTime::currentSecsSinceEpoch())));
+    }
+
+    if (previous_sizes == device_sizes)
+    {
+        return;
+    }
+
+    upload_chunk_sizes.insert(upload_device_identifier, device_sizes);
+    emit plugin_save_setting(upload_chunk_size_setting, upload_chunk_sizes);
+}
+
 void plugin_mcumgr::on_btn_error_lookup_clicked()
 {
     error_lookup_form->show();
@@ -4990,6 +6424,19 @@ void plugin_mcumgr::on_btn_error_lookup_clicked()
 
 void plugin_mcumgr::on_btn_cancel_clicked()
 {
+    if (mode == ACTION_STAT_POLL)
+    {
+        //There is no request outstanding between polls, so polling is stopped directly
+        stat_poller->cancel();
+        return;
+    }
+
+    if (mode == ACTION_OS_TASK_SAMPLE)
+    {
+        task_sampler->cancel();
+        return;
+    }
+
     processor->cancel();
 }
 
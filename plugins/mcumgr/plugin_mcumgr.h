@@ -28,6 +28,7 @@
 #include <QMainWindow>
 #include <QCryptographicHash>
 #include <QElapsedTimer>
+#include <QTimer>
 #include <QCborStreamReader>
 #include <QCborStreamWriter>
 #include <QCborArray>
@@ -45,6 +46,12 @@
 #include "smp_group_stat_mgmt.h"
 #include "smp_error.h"
 #include "smp_group_array.h"
+#include "smp_fs_sync.h"
+#include "smp_link_benchmark.h"
+#include "smp_stat_history.h"
+#include "smp_stat_poller.h"
+#include "smp_task_sampler.h"
+#include "stat_plot.h"
 #include "error_lookup.h"
 #include "debug_logger.h"
 #include "smp_json.h"
@@ -84,6 +91,7 @@
 #include <QtWidgets/QRadioButton>
 #include <QtWidgets/QSpacerItem>
 #include <QtWidgets/QSpinBox>
+#include <QtWidgets/QSplitter>
 #include <QtWidgets/QTabWidget>
 #include <QtWidgets/QTableWidget>
 #include <QtWidgets/QToolButton>
@@ -114,19 +122,24 @@ enum mcumgr_action_t {
     ACTION_OS_DATETIME_GET,
     ACTION_OS_DATETIME_SET,
     ACTION_OS_MCUMGR_BUFFER,
+    ACTION_OS_WINDOW_NEGOTIATE,
     ACTION_OS_OS_APPLICATION_INFO,
     ACTION_OS_BOOTLOADER_INFO,
+    ACTION_OS_BENCHMARK,
+    ACTION_OS_TASK_SAMPLE,
 
     ACTION_SHELL_EXECUTE,
 
     ACTION_STAT_GROUP_DATA,
     ACTION_STAT_LIST_GROUPS,
+    ACTION_STAT_POLL,
 
     ACTION_FS_UPLOAD,
     ACTION_FS_DOWNLOAD,
     ACTION_FS_STATUS,
     ACTION_FS_HASH_CHECKSUM,
     ACTION_FS_SUPPORTED_HASHES_CHECKSUMS,
+    ACTION_FS_SYNC,
 
     ACTION_SETTINGS_READ,
     ACTION_SETTINGS_WRITE,
@@ -168,6 +181,8 @@ signals:
     void plugin_to_hex(QByteArray *data);
     void plugin_serial_open_close(uint8_t mode);
     void plugin_serial_is_open(bool *open);
+    void plugin_save_setting(QString name, QVariant data);
+    void plugin_load_setting(QString name, QVariant *data, bool *found);
 
 private slots:
     void serial_receive(QByteArray *data);
@@ -186,6 +201,17 @@ private slots:
 
     void custom_log(bool sent, QString *data);
     void custom_message_callback(enum custom_message_callback_t type, smp_error_t *data);
+    void rtt_updated(QString summary);
+    void fs_sync_progress(uint8_t percent);
+    void fs_sync_file_status(QString message);
+    void fs_sync_finished(bool success, QString summary);
+    void link_benchmark_progress(uint8_t percent);
+    void link_benchmark_finished(bool success, QString summary);
+    void stat_poller_polled(QString group);
+    void stat_poller_finished(bool success, QString summary);
+    void task_sampler_sampled();
+    void task_sampler_thread_event(QString message);
+    void task_sampler_finished(bool success, QString summary);
 
     //Form slots
     void on_btn_FS_Local_clicked();
@@ -195,12 +221,23 @@ private slots:
     void on_radio_FS_Size_toggled(bool checked);
     void on_radio_FS_HashChecksum_toggled(bool checked);
     void on_radio_FS_Hash_Checksum_Types_toggled(bool checked);
+    void on_check_FS_Directory_toggled(bool checked);
+    void on_check_FS_Verify_toggled(bool checked);
     void on_btn_IMG_Local_clicked();
     void on_btn_IMG_Go_clicked();
+    void img_reconnect_timeout();
+    void metrics_refresh();
+    void on_btn_metrics_reset_clicked();
+    void on_btn_metrics_export_clicked();
     void on_radio_IMG_No_Action_toggled(bool checked);
     void on_btn_IMG_Preview_Copy_clicked();
     void on_btn_OS_Go_clicked();
+    void on_check_OS_Tasks_Sample_toggled(bool checked);
     void on_btn_STAT_Go_clicked();
+    void on_radio_STAT_Poll_toggled(bool checked);
+    void on_btn_STAT_Export_clicked();
+    void on_table_STAT_Values_itemSelectionChanged();
+    void stat_plot_settings_changed();
     void on_btn_SHELL_Clear_clicked();
     void on_btn_SHELL_Copy_clicked();
     void on_btn_transport_connect_clicked();
@@ -256,6 +293,7 @@ private:
     smp_transport *active_transport();
     bool claim_transport(QLabel *status);
     void relase_transport(void);
+    bool negotiate_window(QLabel *status, const char *resume_slot);
     void flip_endian(uint8_t *data, uint8_t size);
     bool update_settings_display();
     void show_transport_open_status();
@@ -263,6 +301,10 @@ private:
     void close_transport_windows();
     void set_group_transport_settings(smp_group *group);
     void set_group_transport_settings(smp_group *group, uint32_t timeout);
+    void set_group_upload_tuning(smp_group *group);
+    void save_group_upload_chunk_size(smp_group *group);
+    QString fs_hash_checksum_type();
+    void update_fs_hash_checksum_enabled();
     void update_img_state_table();
 
     //Form items
@@ -274,6 +316,7 @@ private:
     QHBoxLayout *horizontalLayout_7;
     QLabel *label;
     QSpinBox *edit_MTU;
+    QCheckBox *check_MTU_Tune;
     QFrame *line_9;
     QCheckBox *check_V2_Protocol;
     QFrame *line_8;
@@ -287,6 +330,7 @@ private:
     QHBoxLayout *horizontalLayout_27;
     QCheckBox *check_transport_uart_raw;
     QCheckBox *check_transport_uart_show_transfer;
+    QLabel *lbl_transport_rto;
     QSpacerItem *horizontalSpacer_27;
     QPushButton *btn_cancel;
     QTabWidget *selector_group;
@@ -297,6 +341,10 @@ private:
     QGridLayout *gridLayout_4;
     QLabel *label_6;
     QCheckBox *check_IMG_Reset;
+    QLabel *label_IMG_Resume;
+    QHBoxLayout *horizontalLayout_IMG_Resume;
+    QCheckBox *check_IMG_Resume;
+    QCheckBox *check_IMG_Reconnect;
     QProgressBar *progress_IMG_Complete;
     QLabel *label_9;
     QLabel *label_4;
@@ -362,6 +410,8 @@ private:
     QRadioButton *radio_FS_Size;
     QRadioButton *radio_FS_HashChecksum;
     QRadioButton *radio_FS_Hash_Checksum_Types;
+    QCheckBox *check_FS_Directory;
+    QCheckBox *check_FS_Verify;
     QSpacerItem *horizontalSpacer_32;
     QWidget *tab_OS;
     QGridLayout *gridLayout_7;
@@ -377,9 +427,21 @@ private:
     QPlainTextEdit *edit_OS_Echo_Input;
     QLabel *label_11;
     QPlainTextEdit *edit_OS_Echo_Output;
+    QWidget *tab_OS_Benchmark;
+    QGridLayout *gridLayout_19;
+    QLabel *label_49;
+    QSpinBox *edit_OS_Benchmark_Sizes;
+    QLabel *label_50;
+    QSpinBox *edit_OS_Benchmark_Iterations;
+    QSpacerItem *horizontalSpacer_38;
+    QPlainTextEdit *edit_OS_Benchmark_Output;
     QWidget *tab_OS_Tasks;
     QGridLayout *gridLayout_14;
     QTableWidget *table_OS_Tasks;
+    QCheckBox *check_OS_Tasks_Sample;
+    QSpinBox *edit_OS_Tasks_Interval;
+    QSpacerItem *horizontalSpacer_40;
+    QPlainTextEdit *edit_OS_Tasks_Events;
     QWidget *tab_OS_Memory;
     QVBoxLayout *verticalLayout_4;
     QTableWidget *table_OS_Memory;
@@ -428,6 +490,13 @@ private:
     QHBoxLayout *horizontalLayout_9;
     QRadioButton *radio_STAT_List;
     QRadioButton *radio_STAT_Fetch;
+    QRadioButton *radio_STAT_Poll;
+    QSpinBox *edit_STAT_Interval;
+    QSpacerItem *horizontalSpacer_39;
+    QLabel *label_51;
+    QComboBox *combo_STAT_Plot_Mode;
+    QComboBox *combo_STAT_Plot_Window;
+    QPushButton *btn_STAT_Export;
     QComboBox *combo_STAT_Group;
     QHBoxLayout *horizontalLayout_14;
     QSpacerItem *horizontalSpacer_19;
@@ -435,7 +504,9 @@ private:
     QSpacerItem *horizontalSpacer_20;
     QLabel *label_16;
     QLabel *label_15;
+    QSplitter *splitter_STAT;
     QTableWidget *table_STAT_Values;
+    stat_plot *plot_STAT;
     QWidget *tab_Shell;
     QGridLayout *gridLayout_9;
     QLabel *lbl_SHELL_Status;
@@ -565,6 +636,16 @@ private:
     QSpacerItem *horizontalSpacer_23;
     QPushButton *btn_custom_go;
     QSpacerItem *horizontalSpacer_24;
+    QWidget *tab_metrics;
+    QVBoxLayout *verticalLayout_metrics;
+    QLabel *lbl_metrics_summary;
+    QTableWidget *table_metrics_commands;
+    QPlainTextEdit *edit_metrics_histogram;
+    QHBoxLayout *horizontalLayout_metrics;
+    QLabel *lbl_metrics_status;
+    QSpacerItem *horizontalSpacer_metrics;
+    QPushButton *btn_metrics_reset;
+    QPushButton *btn_metrics_export;
     QWidget *tab_2;
     QWidget *verticalLayoutWidget;
     QVBoxLayout *verticalLayout;
@@ -601,10 +682,16 @@ private:
     int32_t shell_rc;
     QStringList group_list;
     QList<stat_value_t> stat_list;
+    QHash<int, QTableWidgetItem *> stat_poll_rows; //Name item of each polled series in the stats table
     QStandardItemModel model_image_state;
     error_lookup *error_lookup_form;
     smp_processor *processor;
     smp_group_array smp_groups;
+    smp_fs_sync *fs_sync;
+    smp_link_benchmark *link_benchmark;
+    smp_stat_history stat_history;
+    smp_stat_poller *stat_poller;
+    smp_task_sampler *task_sampler;
     class smp_uart_auterm *uart_transport;
     uint16_t enum_count;
     QList<uint16_t> enum_groups;
@@ -641,6 +728,14 @@ private:
     smp_json *log_json;
     uint32_t os_buffer_size;
     uint32_t os_buffer_count;
+    const char *window_resume_slot;
+    QLabel *window_resume_status;
+    QTimer tmr_img_reconnect;
+    uint8_t img_reconnect_attempts;
+    QVariantMap upload_chunk_sizes;
+    QString upload_device_identifier;
+    bool upload_device_unique;
+    QTimer tmr_metrics_refresh;
 };
 
 #endif // PLUGIN_MCUMGR_H
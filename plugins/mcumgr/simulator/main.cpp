@@ -0,0 +1,270 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  main.cpp
+**
+** Notes:   MCUmgr SMP device simulator, serves the simulated device over a
+**          pseudo terminal (SMP UART) and/or UDP with configurable latency,
+**          loss, buffer size (MTU) and buffer count so that transfers can be
+**          benchmarked and regression tested without hardware
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QCoreApplication>
+#include <QTextStream>
+#include "smp_simulator.h"
+#include "smp_simulator_link.h"
+#if defined(Q_OS_UNIX)
+#include "smp_simulator_uart.h"
+#include <signal.h>
+#endif
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+#include "smp_simulator_udp.h"
+#endif
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+const int simulator_exit_ok                  = 0;
+const int simulator_exit_invalid_arguments   = 2; //Exit code if the arguments are invalid
+const int simulator_exit_transport_error     = 3; //Exit code if a transport could not be opened
+const uint16_t simulator_minimum_buffer_size = 64;
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+#if defined(Q_OS_UNIX)
+static void exit_signal(int signal)
+{
+    Q_UNUSED(signal);
+    QCoreApplication::quit();
+}
+#endif
+
+static void usage(QTextStream &output)
+{
+    output << "Usage: smp_simulator [KEY=VALUE]..." << "\n"
+           << "  PTY[=link]       Serve SMP UART over a pseudo terminal, optionally creating a symlink to it" << "\n"
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+           << "  UDP=port         Serve SMP UDP on port (default " << smp_simulator_default_udp_port << ", 0 to disable)" << "\n"
+           << "  BIND=address     Address to bind the UDP port to (default 127.0.0.1)" << "\n"
+#endif
+           << "  MTU=bytes        SMP buffer size (default " << smp_simulator_default_buffer_size << ")" << "\n"
+           << "  BUFFERS=count    Number of SMP buffers, requests beyond this are dropped (default " << (uint)smp_simulator_default_buffer_count << ")" << "\n"
+           << "  LATENCY=ms       Delay from receiving a request to sending the response (default 0)" << "\n"
+           << "  JITTER=ms        Maximum random variation of the latency (default 0)" << "\n"
+           << "  LOSS=percent     Percentage of requests and responses to discard (default 0)" << "\n"
+           << "  SEED=value       Random number seed, runs with the same seed are repeatable (default 0)" << "\n"
+           << "  SLOTSIZE=bytes   Size of each image slot (default " << smp_simulator_default_slot_size << ")" << "\n"
+           << "  VERBOSE          Print each request" << "\n";
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+    QTextStream output(stdout);
+    QTextStream error_output(stderr);
+    QStringList arguments = QCoreApplication::arguments();
+    smp_simulator simulator;
+    smp_simulator_link_config_t link_config;
+    bool pty = false;
+    QString pty_link;
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+    uint16_t udp_port = smp_simulator_default_udp_port;
+    QHostAddress udp_address = QHostAddress::LocalHost;
+#endif
+    QString error;
+    bool ok = true;
+    int exit_code;
+    int i = 1;
+
+    link_config.latency = 0;
+    link_config.jitter = 0;
+    link_config.loss = 0.0;
+    link_config.seed = 0;
+    link_config.verbose = false;
+
+    while (i < arguments.length() && ok == true)
+    {
+        const QString &argument = arguments.at(i);
+        QString key = argument.section('=', 0, 0).toUpper();
+        QString value = argument.section('=', 1);
+
+        if (key == "PTY")
+        {
+            pty = true;
+            pty_link = value;
+        }
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+        else if (key == "UDP")
+        {
+            udp_port = value.toUShort(&ok);
+        }
+        else if (key == "BIND")
+        {
+            ok = udp_address.setAddress(value);
+        }
+#endif
+        else if (key == "MTU")
+        {
+            uint16_t size = value.toUShort(&ok);
+
+            if (ok == true && size < simulator_minimum_buffer_size)
+            {
+                ok = false;
+            }
+
+            simulator.set_buffer_size(size);
+        }
+        else if (key == "BUFFERS")
+        {
+            uint count = value.toUInt(&ok);
+
+            if (ok == true && (count == 0 || count > 255))
+            {
+                ok = false;
+            }
+
+            simulator.set_buffer_count((uint8_t)count);
+        }
+        else if (key == "LATENCY")
+        {
+            link_config.latency = value.toUInt(&ok);
+        }
+        else if (key == "JITTER")
+        {
+            link_config.jitter = value.toUInt(&ok);
+        }
+        else if (key == "LOSS")
+        {
+            link_config.loss = value.toDouble(&ok);
+
+            if (ok == true && (link_config.loss < 0.0 || link_config.loss > 100.0))
+            {
+                ok = false;
+            }
+        }
+        else if (key == "SEED")
+        {
+            link_config.seed = value.toUInt(&ok);
+        }
+        else if (key == "SLOTSIZE")
+        {
+            uint32_t size = value.toUInt(&ok);
+
+            if (ok == true && size == 0)
+            {
+                ok = false;
+            }
+
+            simulator.set_slot_size(size);
+        }
+        else if (key == "VERBOSE")
+        {
+            link_config.verbose = true;
+        }
+        else if (key == "HELP" || key == "-H" || key == "--HELP")
+        {
+            usage(output);
+            return simulator_exit_ok;
+        }
+        else
+        {
+            ok = false;
+        }
+
+        if (ok == false)
+        {
+            error_output << "Invalid argument: " << argument << "\n";
+        }
+
+        ++i;
+    }
+
+    if (ok == false)
+    {
+        usage(error_output);
+        return simulator_exit_invalid_arguments;
+    }
+
+#if defined(Q_OS_UNIX)
+    smp_simulator_uart uart(&simulator);
+
+    if (pty == true)
+    {
+        if (uart.open(pty_link, &error) == false)
+        {
+            error_output << error << "\n";
+            return simulator_exit_transport_error;
+        }
+
+        uart.set_config(&link_config);
+        output << "SMP UART: " << uart.port_name() << "\n";
+    }
+
+    signal(SIGINT, exit_signal);
+    signal(SIGTERM, exit_signal);
+#else
+    if (pty == true)
+    {
+        error_output << "Pseudo terminals are not supported on this platform" << "\n";
+        return simulator_exit_invalid_arguments;
+    }
+#endif
+
+#if defined(PLUGIN_MCUMGR_TRANSPORT_UDP)
+    smp_simulator_udp udp(&simulator);
+
+    if (udp_port != 0)
+    {
+        if (udp.open(udp_address, udp_port, &error) == false)
+        {
+            error_output << error << "\n";
+            return simulator_exit_transport_error;
+        }
+
+        udp.set_config(&link_config);
+        output << "SMP UDP: " << udp_address.toString() << ":" << udp_port << "\n";
+    }
+    else if (pty == false)
+#else
+    if (pty == false)
+#endif
+    {
+        error_output << "No transports enabled" << "\n";
+        usage(error_output);
+        return simulator_exit_invalid_arguments;
+    }
+
+    output << "Buffers: " << (uint)simulator.buffer_count() << " x " << simulator.buffer_size() << " bytes, latency: " << link_config.latency << "ms (+/- " << link_config.jitter << "ms), loss: " << link_config.loss << "%, seed: " << link_config.seed << "\n";
+
+    //Clients (e.g. test scripts) read the port details before connecting
+    output.flush();
+    exit_code = application.exec();
+
+    smp_simulator_counters_t *counters = simulator.counters();
+    output << "Requests: " << counters->requests << ", responses: " << counters->responses << ", dropped requests: " << counters->dropped_requests << ", dropped responses: " << counters->dropped_responses << ", buffer overflows: " << counters->buffer_overflows << ", oversize: " << counters->oversize << ", invalid: " << counters->invalid << "\n";
+
+    return exit_code;
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,63 @@
+include(../../../AuTerm-includes.pri)
+
+QT -= gui
+QT += core
+
+TEMPLATE = app
+
+CONFIG += console
+CONFIG += c++17
+CONFIG -= app_bundle
+
+INCLUDEPATH    += ..
+TARGET          = smp_simulator
+
+# The simulator has no access to the logger plugin, debug output goes to the console
+DEFINES += SKIPPLUGIN_LOGGER
+
+SOURCES += \
+    ../crc16.cpp \
+    ../crc32.cpp \
+    ../smp_hash_checksum.cpp \
+    ../smp_message.cpp \
+    ../smp_uart_auterm.cpp \
+    main.cpp \
+    smp_simulator.cpp \
+    smp_simulator_link.cpp
+
+HEADERS += \
+    ../crc16.h \
+    ../crc32.h \
+    ../debug_logger.h \
+    ../smp_error.h \
+    ../smp_hash_checksum.h \
+    ../smp_message.h \
+    ../smp_transport.h \
+    ../smp_uart_auterm.h \
+    smp_simulator.h \
+    smp_simulator_link.h
+
+unix {
+    SOURCES += \
+	smp_simulator_uart.cpp
+
+    HEADERS += \
+	smp_simulator_uart.h
+}
+
+contains(DEFINES, PLUGIN_MCUMGR_TRANSPORT_UDP) {
+    QT += network
+
+    SOURCES += \
+	smp_simulator_udp.cpp
+
+    HEADERS += \
+	smp_simulator_udp.h
+}
+
+# Common build location
+CONFIG(release, debug|release) {
+    DESTDIR = ../../../release
+} else {
+    DESTDIR = ../../../debug
+}
@@ -0,0 +1,1549 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_simulator.cpp
+**
+** Notes:   Simulated SMP server (MCUmgr device), implements the OS, IMG, STAT,
+**          SETTINGS, FS, SHELL and ENUM groups against in-memory images,
+**          settings and files
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_simulator.h"
+#include "smp_error.h"
+#include "smp_hash_checksum.h"
+#include <QCryptographicHash>
+#include <QtEndian>
+#include <string.h>
+
+/******************************************************************************/
+// Enum typedefs
+/******************************************************************************/
+enum os_mgmt_commands : uint8_t {
+    OS_MGMT_ECHO = 0,
+    OS_MGMT_TASK_STATS = 2,
+    OS_MGMT_MEMORY_POOL,
+    OS_MGMT_DATE_TIME,
+    OS_MGMT_RESET,
+    OS_MGMT_MCUMGR_PARAMETERS,
+    OS_MGMT_OS_APPLICATION_INFO,
+    OS_MGMT_BOOTLOADER_INFO,
+};
+
+enum img_mgmt_commands : uint8_t {
+    IMG_MGMT_STATE = 0,
+    IMG_MGMT_UPLOAD,
+    IMG_MGMT_ERASE = 5,
+    IMG_MGMT_SLOT_INFO,
+};
+
+enum stat_mgmt_commands : uint8_t {
+    STAT_MGMT_GROUP_DATA = 0,
+    STAT_MGMT_LIST_GROUPS,
+};
+
+enum settings_mgmt_commands : uint8_t {
+    SETTINGS_MGMT_READ_WRITE = 0,
+    SETTINGS_MGMT_DELETE,
+    SETTINGS_MGMT_COMMIT,
+    SETTINGS_MGMT_LOAD_SAVE,
+};
+
+enum fs_mgmt_commands : uint8_t {
+    FS_MGMT_UPLOAD_DOWNLOAD = 0,
+    FS_MGMT_STATUS,
+    FS_MGMT_HASH_CHECKSUM,
+    FS_MGMT_SUPPORTED_HASHES_CHECKSUMS,
+    FS_MGMT_FILE_CLOSE,
+};
+
+enum fs_mgmt_errs : uint16_t {
+    FS_MGMT_ERR_FILE_INVALID_NAME = 2,
+    FS_MGMT_ERR_FILE_NOT_FOUND,
+    FS_MGMT_ERR_FILE_IS_DIRECTORY,
+    FS_MGMT_ERR_FILE_OPEN_FAILED,
+    FS_MGMT_ERR_FILE_OFFSET_NOT_VALID = 11,
+    FS_MGMT_ERR_FILE_OFFSET_LARGER_THAN_FILE,
+    FS_MGMT_ERR_CHECKSUM_HASH_NOT_FOUND,
+    FS_MGMT_ERR_MOUNT_POINT_NOT_FOUND,
+    FS_MGMT_ERR_FILE_EMPTY = 16,
+};
+
+enum shell_mgmt_commands : uint8_t {
+    SHELL_MGMT_EXECUTE = 0,
+};
+
+enum enum_mgmt_commands : uint8_t {
+    ENUM_MGMT_COUNT = 0,
+    ENUM_MGMT_LIST,
+    ENUM_MGMT_SINGLE,
+    ENUM_MGMT_DETAILS,
+};
+
+/******************************************************************************/
+// Forward declaration of Class, Struct & Unions
+/******************************************************************************/
+struct smp_simulator_group_t {
+    uint16_t group;
+    const char *name;
+    uint8_t handlers;
+};
+
+struct smp_simulator_task_t {
+    const char *name;
+    uint8_t priority;
+    uint16_t stack_size;
+    uint16_t stack_used;
+    uint8_t runtime_share; //Percentage of the uptime the task has been running for
+};
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+static const int32_t group_error_set = -1; //The response contains an SMP version 2 group error, it is sent as-is
+static const char fs_mount_point[] = "/lfs";
+static const int32_t shell_error_no_exec = -8;
+static const int32_t shell_error_no_entry = -2;
+static const int32_t shell_error_exists = -17;
+static const int32_t shell_error_invalid = -22;
+static const int32_t shell_error_not_empty = -39;
+
+//MCUboot image format
+static const uint32_t mcuboot_image_magic = 0x96f3b83d;
+static const uint16_t mcuboot_tlv_info_magic = 0x6907;
+static const uint16_t mcuboot_tlv_sha256 = 0x10;
+static const uint8_t mcuboot_header_size = 32;
+static const uint8_t mcuboot_bootloader_mode_swap_using_move = 3;
+
+static const smp_simulator_group_t simulator_groups[] = {
+    {SMP_SIMULATOR_GROUP_OS, "os mgmt", 8},
+    {SMP_SIMULATOR_GROUP_IMG, "img mgmt", 4},
+    {SMP_SIMULATOR_GROUP_STATS, "stat mgmt", 2},
+    {SMP_SIMULATOR_GROUP_SETTINGS, "settings mgmt", 4},
+    {SMP_SIMULATOR_GROUP_FS, "fs mgmt", 5},
+    {SMP_SIMULATOR_GROUP_SHELL, "shell mgmt", 1},
+    {SMP_SIMULATOR_GROUP_ENUM, "enum mgmt", 4},
+};
+
+static const smp_simulator_task_t simulator_tasks[] = {
+    {"idle", 15, 80, 16, 70},
+    {"main", 0, 1024, 412, 5},
+    {"logging", 14, 768, 290, 3},
+    {"sysworkq", 255, 1024, 376, 2},
+    {"smp_sim", 9, 2048, 948, 20},
+};
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+static void append_uint16(QByteArray *data, uint16_t value)
+{
+    char buffer[sizeof(uint16_t)];
+
+    qToLittleEndian<uint16_t>(value, buffer);
+    data->append(buffer, sizeof(buffer));
+}
+
+static void append_uint32(QByteArray *data, uint32_t value)
+{
+    char buffer[sizeof(uint32_t)];
+
+    qToLittleEndian<uint32_t>(value, buffer);
+    data->append(buffer, sizeof(buffer));
+}
+
+static QByteArray build_image(uint8_t major, uint8_t minor, uint16_t revision, uint32_t body_size)
+{
+    //Creates a minimal MCUboot image (header, body and a SHA256 TLV) for the initially active slot
+    QByteArray image;
+    uint32_t i = 0;
+
+    append_uint32(&image, mcuboot_image_magic);
+    append_uint32(&image, 0);
+    append_uint16(&image, mcuboot_header_size);
+    append_uint16(&image, 0);
+    append_uint32(&image, body_size);
+    append_uint32(&image, 0);
+    image.append((char)major);
+    image.append((char)minor);
+    append_uint16(&image, revision);
+    append_uint32(&image, 0);
+    append_uint32(&image, 0);
+
+    while (i < body_size)
+    {
+        image.append((char)(i & 0xff));
+        ++i;
+    }
+
+    QByteArray hash = QCryptographicHash::hash(image, QCryptographicHash::Sha256);
+    append_uint16(&image, mcuboot_tlv_info_magic);
+    append_uint16(&image, (uint16_t)(4 + 4 + hash.length()));
+    append_uint16(&image, mcuboot_tlv_sha256);
+    append_uint16(&image, (uint16_t)hash.length());
+    image.append(hash);
+
+    return image;
+}
+
+smp_simulator::smp_simulator(QObject *parent) : QObject{parent}
+{
+    net_buffer_size = smp_simulator_default_buffer_size;
+    net_buffer_count = smp_simulator_default_buffer_count;
+    slot_size = smp_simulator_default_slot_size;
+    request_version = 0;
+    date_time_offset = 0;
+    upload_offset = 0;
+    upload_length = 0;
+    memset(&statistics, 0, sizeof(statistics));
+
+    images[0].data = build_image(1, 0, 0, 2048);
+    parse_image(&images[0]);
+    images[0].pending = false;
+    images[0].confirmed = true;
+    images[0].active = true;
+    images[0].permanent = false;
+
+    images[1].bootable = false;
+    images[1].pending = false;
+    images[1].confirmed = false;
+    images[1].active = false;
+    images[1].permanent = false;
+
+    settings.insert("sim/name", QByteArray("AuTerm SMP simulator"));
+    saved_settings = settings;
+
+    directories.insert(fs_mount_point);
+
+    uptime.start();
+}
+
+smp_simulator::~smp_simulator()
+{
+}
+
+void smp_simulator::set_buffer_size(uint16_t size)
+{
+    net_buffer_size = size;
+}
+
+uint16_t smp_simulator::buffer_size()
+{
+    return net_buffer_size;
+}
+
+void smp_simulator::set_buffer_count(uint8_t count)
+{
+    net_buffer_count = count;
+}
+
+uint8_t smp_simulator::buffer_count()
+{
+    return net_buffer_count;
+}
+
+void smp_simulator::set_slot_size(uint32_t size)
+{
+    slot_size = size;
+}
+
+smp_simulator_counters_t *smp_simulator::counters()
+{
+    return &statistics;
+}
+
+bool smp_simulator::process(const QByteArray &request, QByteArray *response)
+{
+    //Handles a single SMP request, returns false if the request is invalid, in which case no response is sent
+    smp_hdr header;
+    uint16_t length;
+    uint16_t group;
+    QCborParserError parse_error;
+    QCborValue payload;
+    QCborMap response_map;
+    int32_t rc;
+
+    if (request.length() < (int)sizeof(smp_hdr))
+    {
+        ++statistics.invalid;
+        return false;
+    }
+
+    memcpy(&header, request.constData(), sizeof(smp_hdr));
+    length = qFromBigEndian<uint16_t>(header.nh_len);
+    group = qFromBigEndian<uint16_t>(header.nh_group);
+
+    if (request.length() < ((int)sizeof(smp_hdr) + length) || (header.nh_op != SMP_OP_READ && header.nh_op != SMP_OP_WRITE))
+    {
+        ++statistics.invalid;
+        return false;
+    }
+
+    ++statistics.requests;
+    request_version = header.nh_version;
+    payload = QCborValue::fromCbor(request.mid(sizeof(smp_hdr), length), &parse_error);
+
+    if (parse_error.error != QCborError::NoError || payload.isMap() == false)
+    {
+        rc = SMP_RC_ERROR_EINVAL;
+    }
+    else
+    {
+        switch (group)
+        {
+            case SMP_SIMULATOR_GROUP_OS:
+                rc = os_command(header.nh_op, header.nh_id, payload.toMap(), &response_map);
+                break;
+            case SMP_SIMULATOR_GROUP_IMG:
+                rc = img_command(header.nh_op, header.nh_id, payload.toMap(), &response_map);
+                break;
+            case SMP_SIMULATOR_GROUP_STATS:
+                rc = stat_command(header.nh_op, header.nh_id, payload.toMap(), &response_map);
+                break;
+            case SMP_SIMULATOR_GROUP_SETTINGS:
+                rc = settings_command(header.nh_op, header.nh_id, payload.toMap(), &response_map);
+                break;
+            case SMP_SIMULATOR_GROUP_FS:
+                rc = fs_command(header.nh_op, header.nh_id, payload.toMap(), &response_map);
+                break;
+            case SMP_SIMULATOR_GROUP_SHELL:
+                rc = shell_command(header.nh_op, header.nh_id, payload.toMap(), &response_map);
+                break;
+            case SMP_SIMULATOR_GROUP_ENUM:
+                rc = enum_command(header.nh_op, header.nh_id, payload.toMap(), &response_map);
+                break;
+            default:
+                rc = SMP_RC_ERROR_ENOTSUP;
+                break;
+        };
+    }
+
+    if (rc != SMP_RC_ERROR_EOK && rc != group_error_set)
+    {
+        response_map = QCborMap();
+        response_map.insert(QStringLiteral("rc"), (qint64)rc);
+    }
+
+    *response = encode_response(&header, response_map);
+
+    if (response->length() > net_buffer_size)
+    {
+        //Response does not fit in a buffer, as with a real device the command fails
+        response_map = QCborMap();
+        response_map.insert(QStringLiteral("rc"), (qint64)SMP_RC_ERROR_EMSGSIZE);
+        *response = encode_response(&header, response_map);
+    }
+
+    if (group == SMP_SIMULATOR_GROUP_OS && header.nh_id == OS_MGMT_RESET && header.nh_op == SMP_OP_WRITE && rc == SMP_RC_ERROR_EOK)
+    {
+        //Reset after the response has been generated, as a real device would
+        reset();
+    }
+
+    return true;
+}
+
+QByteArray smp_simulator::encode_response(const smp_hdr *request_header, const QCborMap &response)
+{
+    smp_message message;
+
+    message.start_message(smp_message::response_op(request_header->nh_op), request_header->nh_version, qFromBigEndian<uint16_t>(request_header->nh_group), request_header->nh_id);
+    message.end_custom_message(response.toCborValue().toCbor());
+    message.get_header()->nh_seq = request_header->nh_seq;
+
+    return *message.data();
+}
+
+int32_t smp_simulator::group_error(QCborMap *response, uint16_t group, uint16_t rc, int32_t legacy_rc)
+{
+    //SMP version 2 reports group errors in an err map, version 1 only supports the legacy rc codes
+    if (request_version == 1)
+    {
+        QCborMap error;
+
+        error.insert(QStringLiteral("group"), (qint64)group);
+        error.insert(QStringLiteral("rc"), (qint64)rc);
+        *response = QCborMap();
+        response->insert(QStringLiteral("err"), error);
+
+        return group_error_set;
+    }
+
+    return legacy_rc;
+}
+
+void smp_simulator::reset()
+{
+    //Performs an image swap if the secondary slot is pending, as MCUboot would, then restarts the uptime
+    if (images[1].pending == true)
+    {
+        smp_simulator_image_t previous = images[0];
+
+        images[0] = images[1];
+        images[0].pending = false;
+        images[0].active = true;
+        images[0].confirmed = images[1].permanent;
+        images[0].permanent = false;
+
+        images[1] = previous;
+        images[1].pending = false;
+        images[1].active = false;
+        images[1].confirmed = false;
+        images[1].permanent = false;
+    }
+    else if (images[0].confirmed == false && images[1].bootable == true)
+    {
+        //Test image was not confirmed, revert to the previous image
+        smp_simulator_image_t tested = images[0];
+
+        images[0] = images[1];
+        images[0].active = true;
+        images[0].confirmed = true;
+
+        images[1] = tested;
+        images[1].active = false;
+    }
+
+    upload_offset = 0;
+    upload_length = 0;
+    upload_sha.clear();
+    ++statistics.resets;
+    uptime.restart();
+}
+
+QDateTime smp_simulator::date_time()
+{
+    return QDateTime::currentDateTime().addMSecs(date_time_offset);
+}
+
+int32_t smp_simulator::os_command(smp_op_t op, uint8_t command, const QCborMap &request, QCborMap *response)
+{
+    switch (command)
+    {
+        case OS_MGMT_ECHO:
+        {
+            if (op != SMP_OP_WRITE)
+            {
+                break;
+            }
+
+            if (request.value(QStringLiteral("d")).isString() == false)
+            {
+                return SMP_RC_ERROR_EINVAL;
+            }
+
+            response->insert(QStringLiteral("r"), request.value(QStringLiteral("d")));
+            return SMP_RC_ERROR_EOK;
+        }
+        case OS_MGMT_TASK_STATS:
+        {
+            QCborMap tasks;
+            qint64 elapsed = uptime.elapsed();
+            uint8_t i = 0;
+
+            if (op != SMP_OP_READ)
+            {
+                break;
+            }
+
+            while (i < (sizeof(simulator_tasks) / sizeof(simulator_tasks[0])))
+            {
+                const smp_simulator_task_t *entry = &simulator_tasks[i];
+                QCborMap task;
+
+                task.insert(QStringLiteral("prio"), (qint64)entry->priority);
+                task.insert(QStringLiteral("tid"), (qint64)i);
+                task.insert(QStringLiteral("state"), (qint64)(i == 0 ? 0 : 1));
+                task.insert(QStringLiteral("stkuse"), (qint64)(entry->stack_used / 4));
+                task.insert(QStringLiteral("stksiz"), (qint64)(entry->stack_size / 4));
+                task.insert(QStringLiteral("cswcnt"), (qint64)(elapsed / (10 * (i + 1))));
+                task.insert(QStringLiteral("runtime"), (qint64)(elapsed * entry->runtime_share / 100));
+                task.insert(QStringLiteral("last_checkin"), (qint64)0);
+                task.insert(QStringLiteral("next_checkin"), (qint64)0);
+                tasks.insert(QString(entry->name), task);
+                ++i;
+            }
+
+            response->insert(QStringLiteral("tasks"), tasks);
+            return SMP_RC_ERROR_EOK;
+        }
+        case OS_MGMT_MEMORY_POOL:
+        {
+            QCborMap pools;
+            QCborMap pool;
+
+            if (op != SMP_OP_READ)
+            {
+                break;
+            }
+
+            pool.insert(QStringLiteral("blksiz"), (qint64)net_buffer_size);
+            pool.insert(QStringLiteral("nblks"), (qint64)net_buffer_count);
+            pool.insert(QStringLiteral("nfree"), (qint64)net_buffer_count);
+            pool.insert(QStringLiteral("min"), (qint64)net_buffer_count);
+            pools.insert(QStringLiteral("smp_netbuf"), pool);
+            response->insert(QStringLiteral("pools"), pools);
+            return SMP_RC_ERROR_EOK;
+        }
+        case OS_MGMT_DATE_TIME:
+        {
+            if (op == SMP_OP_READ)
+            {
+                response->insert(QStringLiteral("datetime"), date_time().toString("yyyy-MM-dd'T'HH:mm:ss.zzz"));
+                return SMP_RC_ERROR_EOK;
+            }
+
+            QDateTime new_date_time = QDateTime::fromString(request.value(QStringLiteral("datetime")).toString(), Qt::ISODateWithMs);
+
+            if (new_date_time.isValid() == false)
+            {
+                return SMP_RC_ERROR_EINVAL;
+            }
+
+            date_time_offset = QDateTime::currentDateTime().msecsTo(new_date_time);
+            return SMP_RC_ERROR_EOK;
+        }
+        case OS_MGMT_RESET:
+        {
+            if (op != SMP_OP_WRITE)
+            {
+                break;
+            }
+
+            //The reset itself is performed once the response has been generated
+            return SMP_RC_ERROR_EOK;
+        }
+        case OS_MGMT_MCUMGR_PARAMETERS:
+        {
+            if (op != SMP_OP_READ)
+            {
+                break;
+            }
+
+            response->insert(QStringLiteral("buf_size"), (qint64)net_buffer_size);
+            response->insert(QStringLiteral("buf_count"), (qint64)net_buffer_count);
+            return SMP_RC_ERROR_EOK;
+        }
+        case OS_MGMT_OS_APPLICATION_INFO:
+        {
+            QString format = request.value(QStringLiteral("format")).toString("s");
+            QStringList output;
+            int i = 0;
+
+            if (op != SMP_OP_READ)
+            {
+                break;
+            }
+
+            if (format.contains('a') == true)
+            {
+                format = "snrvbmpio";
+            }
+
+            while (i < format.length())
+            {
+                switch (format.at(i).toLatin1())
+                {
+                    case 's':
+                    case 'o':
+                        output.append("Zephyr");
+                        break;
+                    case 'n':
+                        output.append("auterm-simulator");
+                        break;
+                    case 'r':
+                        output.append(images[0].version);
+                        break;
+                    case 'v':
+                        output.append("v" + images[0].version);
+                        break;
+                    case 'b':
+                        output.append(QString("%1 %2").arg(__DATE__, __TIME__));
+                        break;
+                    case 'm':
+                    case 'p':
+                        output.append("simulator");
+                        break;
+                    case 'i':
+                        output.append("native_sim");
+                        break;
+                    default:
+                        return SMP_RC_ERROR_EINVAL;
+                };
+
+                ++i;
+            }
+
+            response->insert(QStringLiteral("output"), output.join(' '));
+            return SMP_RC_ERROR_EOK;
+        }
+        case OS_MGMT_BOOTLOADER_INFO:
+        {
+            QString query = request.value(QStringLiteral("query")).toString();
+
+            if (op != SMP_OP_READ)
+            {
+                break;
+            }
+
+            if (query.isEmpty() == true)
+            {
+                response->insert(QStringLiteral("bootloader"), QStringLiteral("MCUboot"));
+            }
+            else if (query == "mode")
+            {
+                response->insert(QStringLiteral("mode"), (qint64)mcuboot_bootloader_mode_swap_using_move);
+            }
+            else
+            {
+                return SMP_RC_ERROR_ENOTSUP;
+            }
+
+            return SMP_RC_ERROR_EOK;
+        }
+        default:
+            break;
+    };
+
+    return SMP_RC_ERROR_ENOTSUP;
+}
+
+void smp_simulator::parse_image(smp_simulator_image_t *image)
+{
+    //Reads the version and hash of an MCUboot image, data without a valid header is not bootable and is identified by the hash of the whole data
+    const QByteArray &data = image->data;
+    const char *raw = data.constData();
+    uint16_t header_size;
+    uint16_t protected_tlv_size;
+    uint32_t image_size;
+    uint32_t build;
+    uint32_t position;
+    uint32_t end;
+
+    image->bootable = false;
+    image->version = "0.0.0";
+    image->hash = QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+
+    if (data.length() < mcuboot_header_size || qFromLittleEndian<uint32_t>(raw) != mcuboot_image_magic)
+    {
+        return;
+    }
+
+    header_size = qFromLittleEndian<uint16_t>(raw + 8);
+    protected_tlv_size = qFromLittleEndian<uint16_t>(raw + 10);
+    image_size = qFromLittleEndian<uint32_t>(raw + 12);
+    build = qFromLittleEndian<uint32_t>(raw + 24);
+    image->version = QString("%1.%2.%3").arg(QString::number((uint8_t)raw[20]), QString::number((uint8_t)raw[21]), QString::number(qFromLittleEndian<uint16_t>(raw + 22)));
+
+    if (build != 0)
+    {
+        image->version.append(QString(".%1").arg(build));
+    }
+
+    image->bootable = true;
+
+    //The unprotected TLV area follows the protected TLV area (if present), it contains the image hash
+    position = (uint32_t)header_size + image_size + protected_tlv_size;
+
+    if ((position + 4) > (uint32_t)data.length() || qFromLittleEndian<uint16_t>(raw + position) != mcuboot_tlv_info_magic)
+    {
+        return;
+    }
+
+    end = position + qFromLittleEndian<uint16_t>(raw + position + 2);
+    position += 4;
+
+    if (end > (uint32_t)data.length())
+    {
+        return;
+    }
+
+    while ((position + 4) <= end)
+    {
+        uint16_t type = qFromLittleEndian<uint16_t>(raw + position);
+        uint16_t length = qFromLittleEndian<uint16_t>(raw + position + 2);
+
+        position += 4;
+
+        if (type == mcuboot_tlv_sha256 && (position + length) <= end)
+        {
+            image->hash = data.mid(position, length);
+            break;
+        }
+
+        position += length;
+    }
+}
+
+QCborMap smp_simulator::image_state(uint8_t slot)
+{
+    QCborMap state;
+
+    state.insert(QStringLiteral("image"), (qint64)0);
+    state.insert(QStringLiteral("slot"), (qint64)slot);
+    state.insert(QStringLiteral("version"), images[slot].version);
+    state.insert(QStringLiteral("hash"), images[slot].hash);
+    state.insert(QStringLiteral("bootable"), images[slot].bootable);
+    state.insert(QStringLiteral("pending"), images[slot].pending);
+    state.insert(QStringLiteral("confirmed"), images[slot].confirmed);
+    state.insert(QStringLiteral("active"), images[slot].active);
+    state.insert(QStringLiteral("permanent"), images[slot].permanent);
+
+    return state;
+}
+
+int32_t smp_simulator::img_command(smp_op_t op, uint8_t command, const QCborMap &request, QCborMap *response)
+{
+    switch (command)
+    {
+        case IMG_MGMT_STATE:
+        {
+            if (op == SMP_OP_WRITE)
+            {
+                QByteArray hash = request.value(QStringLiteral("hash")).toByteArray();
+                bool confirm = request.value(QStringLiteral("confirm")).toBool(false);
+
+                if (hash.isEmpty() == true || hash == images[0].hash)
+                {
+                    //Only the active image can be confirmed, it cannot be marked for test
+                    if (confirm == false)
+                    {
+                        return SMP_RC_ERROR_EBADSTATE;
+                    }
+
+                    images[0].confirmed = true;
+                }
+                else if (images[1].data.isEmpty() == false && hash == images[1].hash)
+                {
+                    if (images[1].bootable == false)
+                    {
+                        return SMP_RC_ERROR_EBADSTATE;
+                    }
+
+                    images[1].pending = true;
+                    images[1].permanent = confirm;
+                }
+                else
+                {
+                    return SMP_RC_ERROR_ENOENT;
+                }
+            }
+
+            QCborArray states;
+
+            states.append(image_state(0));
+
+            if (images[1].data.isEmpty() == false)
+            {
+                states.append(image_state(1));
+            }
+
+            response->insert(QStringLiteral("images"), states);
+            response->insert(QStringLiteral("splitStatus"), (qint64)0);
+            return SMP_RC_ERROR_EOK;
+        }
+        case IMG_MGMT_UPLOAD:
+        {
+            qint64 offset = request.value(QStringLiteral("off")).toInteger(-1);
+            QByteArray data = request.value(QStringLiteral("data")).toByteArray();
+
+            if (op != SMP_OP_WRITE)
+            {
+                break;
+            }
+
+            if (offset < 0 || request.value(QStringLiteral("data")).isByteArray() == false || request.value(QStringLiteral("image")).toInteger(0) != 0)
+            {
+                return SMP_RC_ERROR_EINVAL;
+            }
+
+            if (images[1].pending == true)
+            {
+                return SMP_RC_ERROR_EBADSTATE;
+            }
+
+            if (offset == 0)
+            {
+                qint64 length = request.value(QStringLiteral("len")).toInteger(-1);
+                QByteArray sha = request.value(QStringLiteral("sha")).toByteArray();
+
+                if (length <= 0 || length > slot_size)
+                {
+                    return SMP_RC_ERROR_EINVAL;
+                }
+
+                if (sha.isEmpty() == false && sha == upload_sha && length == upload_length && upload_offset > 0 && upload_offset < upload_length)
+                {
+                    //Same image as the interrupted upload, resume from where it got to
+                    response->insert(QStringLiteral("off"), (qint64)upload_offset);
+                    return SMP_RC_ERROR_EOK;
+                }
+
+                images[1].data.clear();
+                images[1].data.reserve((int)length);
+                images[1].hash.clear();
+                images[1].version.clear();
+                images[1].bootable = false;
+                images[1].confirmed = false;
+                images[1].permanent = false;
+                upload_offset = 0;
+                upload_length = (uint32_t)length;
+                upload_sha = sha;
+            }
+            else if (upload_length == 0)
+            {
+                return SMP_RC_ERROR_EINVAL;
+            }
+
+            if (offset != upload_offset)
+            {
+                //Out of order or repeated chunk, tell the client where the upload is up to
+                response->insert(QStringLiteral("off"), (qint64)upload_offset);
+                return SMP_RC_ERROR_EOK;
+            }
+
+            if ((upload_offset + data.length()) > upload_length)
+            {
+                return SMP_RC_ERROR_EINVAL;
+            }
+
+            images[1].data.append(data);
+            upload_offset += data.length();
+            response->insert(QStringLiteral("off"), (qint64)upload_offset);
+
+            if (upload_offset == upload_length)
+            {
+                parse_image(&images[1]);
+
+                if (upload_sha.isEmpty() == false)
+                {
+                    response->insert(QStringLiteral("match"), (QCryptographicHash::hash(images[1].data, QCryptographicHash::Sha256) == upload_sha));
+                }
+            }
+
+            return SMP_RC_ERROR_EOK;
+        }
+        case IMG_MGMT_ERASE:
+        {
+            qint64 slot = request.value(QStringLiteral("slot")).toInteger(1);
+
+            if (op != SMP_OP_WRITE)
+            {
+                break;
+            }
+
+            if (slot != 1)
+            {
+                return (slot == 0 ? SMP_RC_ERROR_EBADSTATE : SMP_RC_ERROR_EINVAL);
+            }
+
+            if (images[1].pending == true)
+            {
+                return SMP_RC_ERROR_EBADSTATE;
+            }
+
+            images[1].data.clear();
+            images[1].hash.clear();
+            images[1].version.clear();
+            images[1].bootable = false;
+            images[1].confirmed = false;
+            images[1].permanent = false;
+            upload_offset = 0;
+            upload_length = 0;
+            upload_sha.clear();
+            return SMP_RC_ERROR_EOK;
+        }
+        case IMG_MGMT_SLOT_INFO:
+        {
+            QCborArray image_list;
+            QCborMap image;
+            QCborArray slot_list;
+            uint8_t i = 0;
+
+            if (op != SMP_OP_READ)
+            {
+                break;
+            }
+
+            while (i < 2)
+            {
+                QCborMap slot;
+
+                slot.insert(QStringLiteral("slot"), (qint64)i);
+                slot.insert(QStringLiteral("size"), (qint64)slot_size);
+
+                if (i == 1)
+                {
+                    slot.insert(QStringLiteral("upload_image_id"), (qint64)0);
+                }
+
+                slot_list.append(slot);
+                ++i;
+            }
+
+            image.insert(QStringLiteral("image"), (qint64)0);
+            image.insert(QStringLiteral("slots"), slot_list);
+            image.insert(QStringLiteral("max_image_size"), (qint64)slot_size);
+            image_list.append(image);
+            response->insert(QStringLiteral("images"), image_list);
+            return SMP_RC_ERROR_EOK;
+        }
+        default:
+            break;
+    };
+
+    return SMP_RC_ERROR_ENOTSUP;
+}
+
+int32_t smp_simulator::stat_command(smp_op_t op, uint8_t command, const QCborMap &request, QCborMap *response)
+{
+    if (op != SMP_OP_READ)
+    {
+        return SMP_RC_ERROR_ENOTSUP;
+    }
+
+    if (command == STAT_MGMT_GROUP_DATA)
+    {
+        QString name = request.value(QStringLiteral("name")).toString();
+        QCborMap fields;
+
+        if (name == "smp_sim")
+        {
+            //Link statistics, allows a client to see what the simulated conditions did to its traffic
+            fields.insert(QStringLiteral("requests"), (qint64)statistics.requests);
+            fields.insert(QStringLiteral("responses"), (qint64)statistics.responses);
+            fields.insert(QStringLiteral("dropped_requests"), (qint64)statistics.dropped_requests);
+            fields.insert(QStringLiteral("dropped_responses"), (qint64)statistics.dropped_responses);
+            fields.insert(QStringLiteral("buffer_overflows"), (qint64)statistics.buffer_overflows);
+            fields.insert(QStringLiteral("oversize"), (qint64)statistics.oversize);
+            fields.insert(QStringLiteral("invalid"), (qint64)statistics.invalid);
+        }
+        else if (name == "os")
+        {
+            fields.insert(QStringLiteral("uptime_ms"), (qint64)uptime.elapsed());
+            fields.insert(QStringLiteral("resets"), (qint64)statistics.resets);
+        }
+        else
+        {
+            return SMP_RC_ERROR_ENOENT;
+        }
+
+        response->insert(QStringLiteral("name"), name);
+        response->insert(QStringLiteral("fields"), fields);
+        return SMP_RC_ERROR_EOK;
+    }
+    else if (command == STAT_MGMT_LIST_GROUPS)
+    {
+        QCborArray groups;
+
+        groups.append(QStringLiteral("smp_sim"));
+        groups.append(QStringLiteral("os"));
+        response->insert(QStringLiteral("stat_list"), groups);
+        return SMP_RC_ERROR_EOK;
+    }
+
+    return SMP_RC_ERROR_ENOTSUP;
+}
+
+int32_t smp_simulator::settings_command(smp_op_t op, uint8_t command, const QCborMap &request, QCborMap *response)
+{
+    QString name = request.value(QStringLiteral("name")).toString();
+
+    switch (command)
+    {
+        case SETTINGS_MGMT_READ_WRITE:
+        {
+            if (name.isEmpty() == true)
+            {
+                return SMP_RC_ERROR_EINVAL;
+            }
+
+            if (op == SMP_OP_READ)
+            {
+                qint64 max_size = request.value(QStringLiteral("max_size")).toInteger(-1);
+                QByteArray value;
+
+                if (settings.contains(name) == false)
+                {
+                    return SMP_RC_ERROR_ENOENT;
+                }
+
+                value = settings.value(name);
+
+                if (max_size >= 0 && value.length() > max_size)
+                {
+                    value.truncate((int)max_size);
+                }
+
+                response->insert(QStringLiteral("val"), value);
+                return SMP_RC_ERROR_EOK;
+            }
+
+            if (request.value(QStringLiteral("val")).isByteArray() == false)
+            {
+                return SMP_RC_ERROR_EINVAL;
+            }
+
+            settings.insert(name, request.value(QStringLiteral("val")).toByteArray());
+            return SMP_RC_ERROR_EOK;
+        }
+        case SETTINGS_MGMT_DELETE:
+        {
+            if (op != SMP_OP_WRITE)
+            {
+                break;
+            }
+
+            if (settings.remove(name) == 0)
+            {
+                return SMP_RC_ERROR_ENOENT;
+            }
+
+            return SMP_RC_ERROR_EOK;
+        }
+        case SETTINGS_MGMT_COMMIT:
+        {
+            if (op != SMP_OP_WRITE)
+            {
+                break;
+            }
+
+            return SMP_RC_ERROR_EOK;
+        }
+        case SETTINGS_MGMT_LOAD_SAVE:
+        {
+            if (op == SMP_OP_READ)
+            {
+                settings = saved_settings;
+            }
+            else
+            {
+                saved_settings = settings;
+            }
+
+            return SMP_RC_ERROR_EOK;
+        }
+        default:
+            break;
+    };
+
+    return SMP_RC_ERROR_ENOTSUP;
+}
+
+QString smp_simulator::fs_parent_directory(QString path)
+{
+    int index = path.lastIndexOf('/');
+
+    return (index <= 0 ? QString("/") : path.left(index));
+}
+
+int32_t smp_simulator::fs_check_name(QString name, QCborMap *response, bool write)
+{
+    //Returns the error for a file name which cannot be read (or written), or SMP_RC_ERROR_EOK if it can be
+    QString mount_point = fs_mount_point;
+
+    if (name.startsWith('/') == false || name.endsWith('/') == true)
+    {
+        return group_error(response, SMP_SIMULATOR_GROUP_FS, FS_MGMT_ERR_FILE_INVALID_NAME, SMP_RC_ERROR_EINVAL);
+    }
+
+    if (name.startsWith(mount_point + "/") == false)
+    {
+        return group_error(response, SMP_SIMULATOR_GROUP_FS, (name == mount_point ? FS_MGMT_ERR_FILE_IS_DIRECTORY : FS_MGMT_ERR_MOUNT_POINT_NOT_FOUND), (name == mount_point ? SMP_RC_ERROR_EINVAL : SMP_RC_ERROR_ENOENT));
+    }
+
+    if (directories.contains(name) == true)
+    {
+        return group_error(response, SMP_SIMULATOR_GROUP_FS, FS_MGMT_ERR_FILE_IS_DIRECTORY, SMP_RC_ERROR_EINVAL);
+    }
+
+    if (write == true)
+    {
+        if (directories.contains(fs_parent_directory(name)) == false)
+        {
+            return group_error(response, SMP_SIMULATOR_GROUP_FS, FS_MGMT_ERR_FILE_OPEN_FAILED, SMP_RC_ERROR_EUNKNOWN);
+        }
+    }
+    else if (files.contains(name) == false)
+    {
+        return group_error(response, SMP_SIMULATOR_GROUP_FS, FS_MGMT_ERR_FILE_NOT_FOUND, SMP_RC_ERROR_ENOENT);
+    }
+
+    return SMP_RC_ERROR_EOK;
+}
+
+int32_t smp_simulator::fs_command(smp_op_t op, uint8_t command, const QCborMap &request, QCborMap *response)
+{
+    QString name = request.value(QStringLiteral("name")).toString();
+    int32_t rc;
+
+    switch (command)
+    {
+        case FS_MGMT_UPLOAD_DOWNLOAD:
+        {
+            qint64 offset = request.value(QStringLiteral("off")).toInteger(-1);
+
+            if (offset < 0)
+            {
+                return SMP_RC_ERROR_EINVAL;
+            }
+
+            if (op == SMP_OP_WRITE)
+            {
+                QByteArray data = request.value(QStringLiteral("data")).toByteArray();
+                QByteArray *file;
+
+                if (request.value(QStringLiteral("data")).isByteArray() == false)
+                {
+                    return SMP_RC_ERROR_EINVAL;
+                }
+
+                rc = fs_check_name(name, response, true);
+
+                if (rc != SMP_RC_ERROR_EOK)
+                {
+                    return rc;
+                }
+
+                if (offset == 0)
+                {
+                    //A new upload replaces the file
+                    files.insert(name, QByteArray());
+                }
+                else if (files.contains(name) == false)
+                {
+                    return group_error(response, SMP_SIMULATOR_GROUP_FS, FS_MGMT_ERR_FILE_NOT_FOUND, SMP_RC_ERROR_ENOENT);
+                }
+
+                file = &files[name];
+
+                if (offset > file->length())
+                {
+                    return group_error(response, SMP_SIMULATOR_GROUP_FS, FS_MGMT_ERR_FILE_OFFSET_NOT_VALID, SMP_RC_ERROR_EINVAL);
+                }
+
+                if ((offset + data.length()) > file->length())
+                {
+                    file->resize((int)offset + data.length());
+                }
+
+                memcpy(file->data() + offset, data.constData(), data.length());
+                response->insert(QStringLiteral("off"), (qint64)(offset + data.length()));
+                return SMP_RC_ERROR_EOK;
+            }
+
+            rc = fs_check_name(name, response, false);
+
+            if (rc != SMP_RC_ERROR_EOK)
+            {
+                return rc;
+            }
+
+            const QByteArray &file = files[name];
+            int available;
+
+            if (offset > file.length())
+            {
+                return group_error(response, SMP_SIMULATOR_GROUP_FS, FS_MGMT_ERR_FILE_OFFSET_LARGER_THAN_FILE, SMP_RC_ERROR_EINVAL);
+            }
+
+            response->insert(QStringLiteral("off"), offset);
+
+            if (offset == 0)
+            {
+                response->insert(QStringLiteral("len"), (qint64)file.length());
+            }
+
+            //Fill the remainder of the buffer with file data, the byte string header grows by up to 2 bytes once it has data
+            response->insert(QStringLiteral("data"), QByteArray());
+            available = (int)net_buffer_size - (int)sizeof(smp_hdr) - response->toCborValue().toCbor().length() - 2;
+
+            if (available < 0)
+            {
+                available = 0;
+            }
+
+            response->insert(QStringLiteral("data"), file.mid((int)offset, available));
+            return SMP_RC_ERROR_EOK;
+        }
+        case FS_MGMT_STATUS:
+        {
+            if (op != SMP_OP_READ)
+            {
+                break;
+            }
+
+            rc = fs_check_name(name, response, false);
+
+            if (rc != SMP_RC_ERROR_EOK)
+            {
+                return rc;
+            }
+
+            response->insert(QStringLiteral("len"), (qint64)files[name].length());
+            return SMP_RC_ERROR_EOK;
+        }
+        case FS_MGMT_HASH_CHECKSUM:
+        {
+            QString type = request.value(QStringLiteral("type")).toString("crc32");
+            qint64 offset = request.value(QStringLiteral("off")).toInteger(0);
+            qint64 length;
+            smp_hash_checksum hash_checksum;
+            QByteArray result;
+
+            if (op != SMP_OP_READ)
+            {
+                break;
+            }
+
+            if (smp_hash_checksum::is_supported(type) == false)
+            {
+                return group_error(response, SMP_SIMULATOR_GROUP_FS, FS_MGMT_ERR_CHECKSUM_HASH_NOT_FOUND, SMP_RC_ERROR_EINVAL);
+            }
+
+            rc = fs_check_name(name, response, false);
+
+            if (rc != SMP_RC_ERROR_EOK)
+            {
+                return rc;
+            }
+
+            const QByteArray &file = files[name];
+
+            if (file.isEmpty() == true)
+            {
+                return group_error(response, SMP_SIMULATOR_GROUP_FS, FS_MGMT_ERR_FILE_EMPTY, SMP_RC_ERROR_EINVAL);
+            }
+
+            if (offset < 0 || offset >= file.length())
+            {
+                return group_error(response, SMP_SIMULATOR_GROUP_FS, FS_MGMT_ERR_FILE_OFFSET_LARGER_THAN_FILE, SMP_RC_ERROR_EINVAL);
+            }
+
+            length = request.value(QStringLiteral("len")).toInteger(file.length() - offset);
+
+            if (length <= 0 || length > (file.length() - offset))
+            {
+                length = file.length() - offset;
+            }
+
+            hash_checksum.start(type);
+            hash_checksum.add_data(file.mid((int)offset, (int)length));
+            result = hash_checksum.result();
+
+            response->insert(QStringLiteral("type"), type);
+            response->insert(QStringLiteral("off"), offset);
+            response->insert(QStringLiteral("len"), length);
+
+            if (type == "crc32")
+            {
+                //Checksums are returned as integers, hashes as byte strings
+                response->insert(QStringLiteral("output"), (qint64)qFromBigEndian<uint32_t>(result.constData()));
+            }
+            else
+            {
+                response->insert(QStringLiteral("output"), result);
+            }
+
+            return SMP_RC_ERROR_EOK;
+        }
+        case FS_MGMT_SUPPORTED_HASHES_CHECKSUMS:
+        {
+            QCborMap types;
+            QCborMap crc32;
+            QCborMap sha256;
+
+            if (op != SMP_OP_READ)
+            {
+                break;
+            }
+
+            crc32.insert(QStringLiteral("format"), (qint64)0);
+            crc32.insert(QStringLiteral("size"), (qint64)4);
+            sha256.insert(QStringLiteral("format"), (qint64)1);
+            sha256.insert(QStringLiteral("size"), (qint64)32);
+            types.insert(QStringLiteral("crc32"), crc32);
+            types.insert(QStringLiteral("sha256"), sha256);
+            response->insert(QStringLiteral("types"), types);
+            return SMP_RC_ERROR_EOK;
+        }
+        case FS_MGMT_FILE_CLOSE:
+        {
+            if (op != SMP_OP_WRITE)
+            {
+                break;
+            }
+
+            //Files are held in memory so there is nothing to close
+            return SMP_RC_ERROR_EOK;
+        }
+        default:
+            break;
+    };
+
+    return SMP_RC_ERROR_ENOTSUP;
+}
+
+QString smp_simulator::shell_fs(QStringList arguments, int32_t *ret)
+{
+    //Subset of the Zephyr fs shell commands, operating on the simulated file system
+    QString command = (arguments.isEmpty() == true ? QString() : arguments.takeFirst());
+    QString path = (arguments.isEmpty() == true ? QString(fs_mount_point) : arguments.first());
+
+    if (path.startsWith('/') == false)
+    {
+        path.prepend(QString(fs_mount_point) + "/");
+    }
+
+    while (path.length() > 1 && path.endsWith('/') == true)
+    {
+        path.chop(1);
+    }
+
+    *ret = 0;
+
+    if (command == "ls")
+    {
+        QStringList entries;
+        QString prefix = path + "/";
+
+        if (directories.contains(path) == false)
+        {
+            *ret = shell_error_no_entry;
+            return QString("Unable to open %1 (err %2)\n").arg(path, QString::number(*ret));
+        }
+
+        foreach (const QString &directory, directories)
+        {
+            if (fs_parent_directory(directory) == path && directory != path)
+            {
+                entries.append(directory.mid(prefix.length()) + "/");
+            }
+        }
+
+        foreach (const QString &file, files.keys())
+        {
+            if (fs_parent_directory(file) == path)
+            {
+                entries.append(file.mid(prefix.length()));
+            }
+        }
+
+        entries.sort();
+
+        return (entries.isEmpty() == true ? QString() : entries.join('\n') + "\n");
+    }
+    else if (command == "mkdir" && arguments.isEmpty() == false)
+    {
+        if (directories.contains(path) == true || files.contains(path) == true)
+        {
+            *ret = shell_error_exists;
+        }
+        else if (directories.contains(fs_parent_directory(path)) == false)
+        {
+            *ret = shell_error_no_entry;
+        }
+        else
+        {
+            directories.insert(path);
+            return QString();
+        }
+
+        return QString("Error creating dir[%1]\n").arg(*ret);
+    }
+    else if (command == "rm" && arguments.isEmpty() == false)
+    {
+        if (files.remove(path) > 0)
+        {
+            return QString();
+        }
+
+        if (directories.contains(path) == false || path == fs_mount_point)
+        {
+            *ret = shell_error_no_entry;
+        }
+        else
+        {
+            QString prefix = path + "/";
+
+            foreach (const QString &directory, directories)
+            {
+                if (directory.startsWith(prefix) == true)
+                {
+                    *ret = shell_error_not_empty;
+                    break;
+                }
+            }
+
+            foreach (const QString &file, files.keys())
+            {
+                if (file.startsWith(prefix) == true)
+                {
+                    *ret = shell_error_not_empty;
+                    break;
+                }
+            }
+
+            if (*ret == 0)
+            {
+                directories.remove(path);
+                return QString();
+            }
+        }
+
+        return QString("Failed to remove %1 (%2)\n").arg(path, QString::number(*ret));
+    }
+
+    *ret = shell_error_invalid;
+    return QString("fs: wrong parameter count or unknown command\n");
+}
+
+int32_t smp_simulator::shell_command(smp_op_t op, uint8_t command, const QCborMap &request, QCborMap *response)
+{
+    QCborArray argv = request.value(QStringLiteral("argv")).toArray();
+    QStringList arguments;
+    QString output;
+    int32_t ret = 0;
+    int i = 0;
+
+    if (op != SMP_OP_WRITE || command != SHELL_MGMT_EXECUTE)
+    {
+        return SMP_RC_ERROR_ENOTSUP;
+    }
+
+    while (i < argv.size())
+    {
+        arguments.append(argv.at(i).toString());
+        ++i;
+    }
+
+    if (arguments.isEmpty() == true)
+    {
+        return SMP_RC_ERROR_EINVAL;
+    }
+
+    if (arguments.first() == "echo")
+    {
+        output = arguments.mid(1).join(' ') + "\n";
+    }
+    else if (arguments.first() == "kernel" && arguments.length() > 1 && arguments.at(1) == "uptime")
+    {
+        output = QString("Uptime: %1 ms\n").arg(uptime.elapsed());
+    }
+    else if (arguments.first() == "fs")
+    {
+        output = shell_fs(arguments.mid(1), &ret);
+    }
+    else if (arguments.first() == "help")
+    {
+        output = "Available commands:\n  echo\n  fs\n  help\n  kernel\n";
+    }
+    else
+    {
+        output = QString("%1: command not found\n").arg(arguments.first());
+        ret = shell_error_no_exec;
+    }
+
+    response->insert(QStringLiteral("o"), output);
+    response->insert(QStringLiteral("ret"), (qint64)ret);
+    return SMP_RC_ERROR_EOK;
+}
+
+int32_t smp_simulator::enum_command(smp_op_t op, uint8_t command, const QCborMap &request, QCborMap *response)
+{
+    const uint8_t group_count = sizeof(simulator_groups) / sizeof(simulator_groups[0]);
+    uint8_t i = 0;
+
+    if (op != SMP_OP_READ)
+    {
+        return SMP_RC_ERROR_ENOTSUP;
+    }
+
+    switch (command)
+    {
+        case ENUM_MGMT_COUNT:
+        {
+            response->insert(QStringLiteral("count"), (qint64)group_count);
+            return SMP_RC_ERROR_EOK;
+        }
+        case ENUM_MGMT_LIST:
+        {
+            QCborArray groups;
+
+            while (i < group_count)
+            {
+                groups.append((qint64)simulator_groups[i].group);
+                ++i;
+            }
+
+            response->insert(QStringLiteral("groups"), groups);
+            return SMP_RC_ERROR_EOK;
+        }
+        case ENUM_MGMT_SINGLE:
+        {
+            qint64 index = request.value(QStringLiteral("index")).toInteger(0);
+
+            if (index < 0 || index >= group_count)
+            {
+                return SMP_RC_ERROR_ENOENT;
+            }
+
+            response->insert(QStringLiteral("group"), (qint64)simulator_groups[index].group);
+
+            if (index == (group_count - 1))
+            {
+                response->insert(QStringLiteral("end"), true);
+            }
+
+            return SMP_RC_ERROR_EOK;
+        }
+        case ENUM_MGMT_DETAILS:
+        {
+            QCborArray filter = request.value(QStringLiteral("groups")).toArray();
+            QCborArray groups;
+
+            while (i < group_count)
+            {
+                if (filter.isEmpty() == true || filter.contains((qint64)simulator_groups[i].group) == true)
+                {
+                    QCborMap group;
+
+                    group.insert(QStringLiteral("group"), (qint64)simulator_groups[i].group);
+                    group.insert(QStringLiteral("name"), QString(simulator_groups[i].name));
+                    group.insert(QStringLiteral("handlers"), (qint64)simulator_groups[i].handlers);
+                    groups.append(group);
+                }
+
+                ++i;
+            }
+
+            response->insert(QStringLiteral("groups"), groups);
+            return SMP_RC_ERROR_EOK;
+        }
+        default:
+            break;
+    };
+
+    return SMP_RC_ERROR_ENOTSUP;
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,150 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_simulator.h
+**
+** Notes:   Simulated SMP server (MCUmgr device), implements the OS, IMG, STAT,
+**          SETTINGS, FS, SHELL and ENUM groups against in-memory images,
+**          settings and files
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_SIMULATOR_H
+#define SMP_SIMULATOR_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QObject>
+#include <QMap>
+#include <QSet>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QCborMap>
+#include <QCborArray>
+#include <QCborValue>
+#include "smp_message.h"
+
+/******************************************************************************/
+// Enum typedefs
+/******************************************************************************/
+enum smp_simulator_group_ids : uint16_t {
+    SMP_SIMULATOR_GROUP_OS = 0,
+    SMP_SIMULATOR_GROUP_IMG,
+    SMP_SIMULATOR_GROUP_STATS,
+    SMP_SIMULATOR_GROUP_SETTINGS,
+    SMP_SIMULATOR_GROUP_FS = 8,
+    SMP_SIMULATOR_GROUP_SHELL,
+    SMP_SIMULATOR_GROUP_ENUM,
+};
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+const uint16_t smp_simulator_default_buffer_size = 384; //Matches the default Zephyr CONFIG_MCUMGR_TRANSPORT_NETBUF_SIZE
+const uint8_t smp_simulator_default_buffer_count = 4; //Matches the default Zephyr CONFIG_MCUMGR_TRANSPORT_NETBUF_COUNT
+const uint32_t smp_simulator_default_slot_size = 0x100000;
+
+/******************************************************************************/
+// Forward declaration of Class, Struct & Unions
+/******************************************************************************/
+struct smp_simulator_image_t {
+    QByteArray data;
+    QByteArray hash;
+    QString version;
+    bool bootable;
+    bool pending;
+    bool confirmed;
+    bool active;
+    bool permanent;
+};
+
+struct smp_simulator_counters_t {
+    uint32_t requests; //Requests received and processed
+    uint32_t responses; //Responses transmitted
+    uint32_t dropped_requests; //Requests discarded by the simulated packet loss
+    uint32_t dropped_responses; //Responses discarded by the simulated packet loss
+    uint32_t buffer_overflows; //Requests discarded because all buffers were in use
+    uint32_t oversize; //Requests discarded because they were larger than the buffer size
+    uint32_t invalid; //Requests which could not be decoded
+    uint32_t resets; //Number of times the device has been reset
+};
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_simulator : public QObject
+{
+    Q_OBJECT
+
+public:
+    smp_simulator(QObject *parent = nullptr);
+    ~smp_simulator();
+    void set_buffer_size(uint16_t size);
+    uint16_t buffer_size();
+    void set_buffer_count(uint8_t count);
+    uint8_t buffer_count();
+    void set_slot_size(uint32_t size);
+    bool process(const QByteArray &request, QByteArray *response);
+    smp_simulator_counters_t *counters();
+
+private:
+    int32_t os_command(smp_op_t op, uint8_t command, const QCborMap &request, QCborMap *response);
+    int32_t img_command(smp_op_t op, uint8_t command, const QCborMap &request, QCborMap *response);
+    int32_t stat_command(smp_op_t op, uint8_t command, const QCborMap &request, QCborMap *response);
+    int32_t settings_command(smp_op_t op, uint8_t command, const QCborMap &request, QCborMap *response);
+    int32_t fs_command(smp_op_t op, uint8_t command, const QCborMap &request, QCborMap *response);
+    int32_t shell_command(smp_op_t op, uint8_t command, const QCborMap &request, QCborMap *response);
+    int32_t enum_command(smp_op_t op, uint8_t command, const QCborMap &request, QCborMap *response);
+    int32_t group_error(QCborMap *response, uint16_t group, uint16_t rc, int32_t legacy_rc);
+    QByteArray encode_response(const smp_hdr *request_header, const QCborMap &response);
+    void reset();
+    void parse_image(smp_simulator_image_t *image);
+    QCborMap image_state(uint8_t slot);
+    int32_t fs_check_name(QString name, QCborMap *response, bool write);
+    QString fs_parent_directory(QString path);
+    QString shell_fs(QStringList arguments, int32_t *ret);
+    QDateTime date_time();
+
+    uint16_t net_buffer_size;
+    uint8_t net_buffer_count;
+    uint32_t slot_size;
+    uint8_t request_version;
+    smp_simulator_counters_t statistics;
+    QElapsedTimer uptime;
+    qint64 date_time_offset;
+
+    //Image management, slot 0 is the active (primary) slot and slot 1 is the upload (secondary) slot
+    smp_simulator_image_t images[2];
+    uint32_t upload_offset;
+    uint32_t upload_length;
+    QByteArray upload_sha;
+
+    //Settings management, saved values are restored by a load command
+    QMap<QString, QByteArray> settings;
+    QMap<QString, QByteArray> saved_settings;
+
+    //File system management, paths are absolute and must be inside the mount point
+    QMap<QString, QByteArray> files;
+    QSet<QString> directories;
+};
+
+#endif // SMP_SIMULATOR_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,197 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_simulator_link.cpp
+**
+** Notes:   Base class for simulator transports, applies the simulated link
+**          conditions (latency, jitter, loss and buffer exhaustion)
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_simulator_link.h"
+#include <QDebug>
+#include <QtEndian>
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_simulator_link::smp_simulator_link(smp_simulator *device, QObject *parent) : QObject{parent}
+{
+    simulator = device;
+    link_config.latency = 0;
+    link_config.jitter = 0;
+    link_config.loss = 0.0;
+    link_config.seed = 0;
+    link_config.verbose = false;
+    random.seed(link_config.seed);
+
+    response_timer.setSingleShot(true);
+    QObject::connect(&response_timer, SIGNAL(timeout()), this, SLOT(response_timer_timeout()));
+    clock.start();
+}
+
+smp_simulator_link::~smp_simulator_link()
+{
+    response_timer.stop();
+}
+
+void smp_simulator_link::set_config(const smp_simulator_link_config_t *config)
+{
+    link_config = *config;
+    random.seed(link_config.seed);
+}
+
+bool smp_simulator_link::lose()
+{
+    if (link_config.loss <= 0.0)
+    {
+        return false;
+    }
+
+    return (random.bounded(100.0) < link_config.loss);
+}
+
+void smp_simulator_link::request_received(const QByteArray &request, uint32_t peer)
+{
+    //Applies the link conditions to a request, then queues the response for when the latency has elapsed
+    smp_simulator_counters_t *counters = simulator->counters();
+    smp_simulator_pending_t entry;
+    qint64 delay = link_config.latency;
+
+    if (request.length() > simulator->buffer_size())
+    {
+        ++counters->oversize;
+
+        if (link_config.verbose == true)
+        {
+            qDebug() << name() << "request of" << request.length() << "bytes exceeds buffer size, dropped";
+        }
+
+        return;
+    }
+
+    if (lose() == true)
+    {
+        ++counters->dropped_requests;
+
+        if (link_config.verbose == true)
+        {
+            qDebug() << name() << "request lost";
+        }
+
+        return;
+    }
+
+    if (pending.length() >= simulator->buffer_count())
+    {
+        //All buffers are holding requests which have not been responded to yet
+        ++counters->buffer_overflows;
+
+        if (link_config.verbose == true)
+        {
+            qDebug() << name() << "no free buffers, request dropped";
+        }
+
+        return;
+    }
+
+    if (simulator->process(request, &entry.response) == false)
+    {
+        if (link_config.verbose == true)
+        {
+            qDebug() << name() << "invalid request dropped";
+        }
+
+        return;
+    }
+
+    if (link_config.jitter > 0)
+    {
+        delay += (qint64)random.bounded((int)(link_config.jitter * 2 + 1)) - (qint64)link_config.jitter;
+
+        if (delay < 0)
+        {
+            delay = 0;
+        }
+    }
+
+    entry.due = clock.elapsed() + delay;
+    entry.peer = peer;
+    entry.lost = lose();
+
+    //Responses are sent in the order the requests were received, as a device processes them one at a time
+    if (pending.isEmpty() == false && entry.due < pending.last().due)
+    {
+        entry.due = pending.last().due;
+    }
+
+    if (link_config.verbose == true)
+    {
+        const smp_hdr *header = (const smp_hdr *)request.constData();
+
+        qDebug() << name() << "group" << qFromBigEndian<uint16_t>(header->nh_group) << "command" << header->nh_id << "sequence" << header->nh_seq << "request" << request.length() << "bytes, response" << entry.response.length() << "bytes in" << (entry.due - clock.elapsed()) << "ms" << (entry.lost == true ? "(lost)" : "");
+    }
+
+    pending.append(entry);
+
+    if (response_timer.isActive() == false)
+    {
+        start_response_timer();
+    }
+}
+
+void smp_simulator_link::start_response_timer()
+{
+    qint64 remaining;
+
+    if (pending.isEmpty() == true)
+    {
+        return;
+    }
+
+    remaining = pending.first().due - clock.elapsed();
+    response_timer.start(remaining > 0 ? (int)remaining : 0);
+}
+
+void smp_simulator_link::response_timer_timeout()
+{
+    qint64 now = clock.elapsed();
+
+    while (pending.isEmpty() == false && pending.first().due <= now)
+    {
+        smp_simulator_pending_t entry = pending.takeFirst();
+
+        if (entry.lost == true)
+        {
+            ++simulator->counters()->dropped_responses;
+        }
+        else
+        {
+            transmit(entry.response, entry.peer);
+            ++simulator->counters()->responses;
+        }
+    }
+
+    start_response_timer();
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,91 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_simulator_link.h
+**
+** Notes:   Base class for simulator transports, applies the simulated link
+**          conditions (latency, jitter, loss and buffer exhaustion)
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_SIMULATOR_LINK_H
+#define SMP_SIMULATOR_LINK_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QObject>
+#include <QList>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include "smp_simulator.h"
+
+/******************************************************************************/
+// Forward declaration of Class, Struct & Unions
+/******************************************************************************/
+struct smp_simulator_pending_t {
+    QByteArray response;
+    qint64 due; //Time (in ms since the link was created) that the response is sent at
+    uint32_t peer; //Sender of the request, used by links with more than one peer
+    bool lost; //Response is discarded when due, it still occupies a buffer until then
+};
+
+struct smp_simulator_link_config_t {
+    uint32_t latency; //Time (in ms) from a request being received to the response being sent
+    uint32_t jitter; //Maximum random variation (in ms) of the latency
+    double loss; //Percentage of requests and responses which are discarded
+    quint32 seed; //Seed for the random number generator, the same seed gives the same sequence of losses and delays
+    bool verbose;
+};
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_simulator_link : public QObject
+{
+    Q_OBJECT
+
+public:
+    smp_simulator_link(smp_simulator *device, QObject *parent = nullptr);
+    ~smp_simulator_link();
+    void set_config(const smp_simulator_link_config_t *config);
+    virtual QString name() = 0;
+
+protected:
+    void request_received(const QByteArray &request, uint32_t peer);
+    virtual void transmit(const QByteArray &response, uint32_t peer) = 0;
+
+private slots:
+    void response_timer_timeout();
+
+private:
+    bool lose();
+    void start_response_timer();
+
+    smp_simulator *simulator;
+    smp_simulator_link_config_t link_config;
+    QRandomGenerator random;
+    QList<smp_simulator_pending_t> pending;
+    QTimer response_timer;
+    QElapsedTimer clock;
+};
+
+#endif // SMP_SIMULATOR_LINK_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,208 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_simulator_uart.cpp
+**
+** Notes:   Simulator transport using the SMP UART (base64 framed) protocol
+**          over a pseudo terminal, which AuTerm opens as a serial port
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_simulator_uart.h"
+#include <QFile>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+static const int pty_read_size = 1024;
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_simulator_uart::smp_simulator_uart(smp_simulator *device, QObject *parent) : smp_simulator_link(device, parent)
+{
+    notifier = nullptr;
+    master_fd = -1;
+    slave_fd = -1;
+
+    QObject::connect(&framing, SIGNAL(receive_waiting(smp_message*)), this, SLOT(uart_receive(smp_message*)));
+    QObject::connect(&framing, SIGNAL(serial_write(QByteArray*)), this, SLOT(uart_write(QByteArray*)));
+}
+
+smp_simulator_uart::~smp_simulator_uart()
+{
+    close();
+}
+
+bool smp_simulator_uart::open(QString link_name, QString *error)
+{
+    //Creates a pseudo terminal, the slave side is what a client opens as its serial port
+    struct termios settings;
+    const char *name;
+
+    master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (master_fd < 0 || grantpt(master_fd) != 0 || unlockpt(master_fd) != 0 || (name = ptsname(master_fd)) == nullptr)
+    {
+        *error = QString("Failed to create pseudo terminal: %1").arg(strerror(errno));
+        close();
+        return false;
+    }
+
+    slave_name = name;
+
+    //Binary data must pass through unmodified
+    if (tcgetattr(master_fd, &settings) == 0)
+    {
+        cfmakeraw(&settings);
+        tcsetattr(master_fd, TCSANOW, &settings);
+    }
+
+    //Writes must not block if no client is reading the port
+    fcntl(master_fd, F_SETFL, fcntl(master_fd, F_GETFL) | O_NONBLOCK);
+
+    //Hold the slave open so that reads do not fail with EIO whilst no client has the port open
+    slave_fd = ::open(name, O_RDWR | O_NOCTTY);
+
+    if (link_name.isEmpty() == false)
+    {
+        QFile::remove(link_name);
+
+        if (QFile::link(slave_name, link_name) == false)
+        {
+            *error = QString("Failed to create link %1 to %2").arg(link_name, slave_name);
+            close();
+            return false;
+        }
+
+        symlink_name = link_name;
+    }
+
+    notifier = new QSocketNotifier(master_fd, QSocketNotifier::Read, this);
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+    QObject::connect(notifier, SIGNAL(activated(int)), this, SLOT(pty_read()));
+#else
+    QObject::connect(notifier, SIGNAL(activated(QSocketDescriptor,QSocketNotifier::Type)), this, SLOT(pty_read()));
+#endif
+
+    return true;
+}
+
+void smp_simulator_uart::close()
+{
+    if (notifier != nullptr)
+    {
+        notifier->setEnabled(false);
+        delete notifier;
+        notifier = nullptr;
+    }
+
+    if (symlink_name.isEmpty() == false)
+    {
+        QFile::remove(symlink_name);
+        symlink_name.clear();
+    }
+
+    if (slave_fd >= 0)
+    {
+        ::close(slave_fd);
+        slave_fd = -1;
+    }
+
+    if (master_fd >= 0)
+    {
+        ::close(master_fd);
+        master_fd = -1;
+    }
+}
+
+QString smp_simulator_uart::port_name()
+{
+    return (symlink_name.isEmpty() == false ? symlink_name : slave_name);
+}
+
+QString smp_simulator_uart::name()
+{
+    return "uart";
+}
+
+void smp_simulator_uart::pty_read()
+{
+    QByteArray data(pty_read_size, 0);
+    ssize_t size = ::read(master_fd, data.data(), data.length());
+
+    if (size <= 0)
+    {
+        return;
+    }
+
+    data.truncate((int)size);
+    framing.serial_read(&data);
+}
+
+void smp_simulator_uart::uart_receive(smp_message *message)
+{
+    request_received(*message->data(), 0);
+}
+
+void smp_simulator_uart::transmit(const QByteArray &response, uint32_t peer)
+{
+    smp_message message;
+
+    Q_UNUSED(peer);
+
+    message.append(response);
+    framing.send(&message);
+}
+
+void smp_simulator_uart::uart_write(QByteArray *data)
+{
+    const char *position = data->constData();
+    ssize_t remaining = data->length();
+
+    while (remaining > 0)
+    {
+        ssize_t written = ::write(master_fd, position, remaining);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            //Nothing is reading the port (or it is full), the rest of the response is lost as it would be on a real UART
+            return;
+        }
+
+        position += written;
+        remaining -= written;
+    }
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,73 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_simulator_uart.h
+**
+** Notes:   Simulator transport using the SMP UART (base64 framed) protocol
+**          over a pseudo terminal, which AuTerm opens as a serial port
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_SIMULATOR_UART_H
+#define SMP_SIMULATOR_UART_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QObject>
+#include <QSocketNotifier>
+#include "smp_simulator_link.h"
+#include "smp_uart_auterm.h"
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_simulator_uart : public smp_simulator_link
+{
+    Q_OBJECT
+
+public:
+    smp_simulator_uart(smp_simulator *device, QObject *parent = nullptr);
+    ~smp_simulator_uart();
+    bool open(QString link_name, QString *error);
+    QString port_name();
+    QString name() override;
+
+protected:
+    void transmit(const QByteArray &response, uint32_t peer) override;
+
+private slots:
+    void pty_read();
+    void uart_receive(smp_message *message);
+    void uart_write(QByteArray *data);
+
+private:
+    void close();
+
+    //The framing is the same in both directions, so AuTerm's own encoder and decoder are used
+    smp_uart_auterm framing;
+    QSocketNotifier *notifier;
+    int master_fd;
+    int slave_fd;
+    QString slave_name;
+    QString symlink_name;
+};
+
+#endif // SMP_SIMULATOR_UART_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
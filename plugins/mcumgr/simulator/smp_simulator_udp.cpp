@@ -0,0 +1,108 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_simulator_udp.cpp
+**
+** Notes:   Simulator transport using the SMP UDP protocol, one SMP message
+**          per datagram
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_simulator_udp.h"
+#include <QNetworkDatagram>
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_simulator_udp::smp_simulator_udp(smp_simulator *device, QObject *parent) : smp_simulator_link(device, parent)
+{
+    QObject::connect(&socket, SIGNAL(readyRead()), this, SLOT(socket_read()));
+}
+
+smp_simulator_udp::~smp_simulator_udp()
+{
+    socket.close();
+}
+
+bool smp_simulator_udp::open(QHostAddress address, uint16_t port, QString *error)
+{
+    if (socket.bind(address, port) == false)
+    {
+        *error = QString("Failed to bind UDP port %1: %2").arg(QString::number(port), socket.errorString());
+        return false;
+    }
+
+    return true;
+}
+
+QString smp_simulator_udp::name()
+{
+    return "udp";
+}
+
+void smp_simulator_udp::socket_read()
+{
+    while (socket.hasPendingDatagrams() == true)
+    {
+        QNetworkDatagram datagram = socket.receiveDatagram();
+        uint32_t peer = 0;
+
+        if (datagram.isValid() == false)
+        {
+            continue;
+        }
+
+        //Peers are remembered so that responses can be sent back to the client which made the request
+        while (peer < (uint32_t)peers.length())
+        {
+            if (peers.at(peer).address == datagram.senderAddress() && peers.at(peer).port == datagram.senderPort())
+            {
+                break;
+            }
+
+            ++peer;
+        }
+
+        if (peer == (uint32_t)peers.length())
+        {
+            smp_simulator_udp_peer_t new_peer;
+
+            new_peer.address = datagram.senderAddress();
+            new_peer.port = (uint16_t)datagram.senderPort();
+            peers.append(new_peer);
+        }
+
+        request_received(datagram.data(), peer);
+    }
+}
+
+void smp_simulator_udp::transmit(const QByteArray &response, uint32_t peer)
+{
+    if (peer >= (uint32_t)peers.length())
+    {
+        return;
+    }
+
+    socket.writeDatagram(response, peers.at(peer).address, peers.at(peer).port);
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,77 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_simulator_udp.h
+**
+** Notes:   Simulator transport using the SMP UDP protocol, one SMP message
+**          per datagram
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_SIMULATOR_UDP_H
+#define SMP_SIMULATOR_UDP_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QObject>
+#include <QList>
+#include <QUdpSocket>
+#include <QHostAddress>
+#include "smp_simulator_link.h"
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+const uint16_t smp_simulator_default_udp_port = 1337;
+
+/******************************************************************************/
+// Forward declaration of Class, Struct & Unions
+/******************************************************************************/
+struct smp_simulator_udp_peer_t {
+    QHostAddress address;
+    uint16_t port;
+};
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_simulator_udp : public smp_simulator_link
+{
+    Q_OBJECT
+
+public:
+    smp_simulator_udp(smp_simulator *device, QObject *parent = nullptr);
+    ~smp_simulator_udp();
+    bool open(QHostAddress address, uint16_t port, QString *error);
+    QString name() override;
+
+protected:
+    void transmit(const QByteArray &response, uint32_t peer) override;
+
+private slots:
+    void socket_read();
+
+private:
+    QUdpSocket socket;
+    QList<smp_simulator_udp_peer_t> peers;
+};
+
+#endif // SMP_SIMULATOR_UDP_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
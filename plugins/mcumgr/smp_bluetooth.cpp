@@ -847,6 +847,22 @@ int smp_bluetooth::set_connection_config(struct smp_bluetooth_config_t *configur
     return SMP_TRANSPORT_ERROR_OK;
 }
 
+QString smp_bluetooth::device_identifier()
+{
+    if (controller == nullptr)
+    {
+        return "";
+    }
+
+    //Some platforms (e.g. mac) do not expose the device address, a UUID is used instead
+    if (controller->remoteAddress().isNull() == true)
+    {
+        return QString("bluetooth:").append(controller->remoteDeviceUuid().toString());
+    }
+
+    return QString("bluetooth:").append(controller->remoteAddress().toString());
+}
+
 QString smp_bluetooth::to_error_string(int error_code)
 {
     switch (error_code)
@@ -96,6 +96,7 @@ public:
     smp_transport_error_t send(smp_message *message) override;
     void setup_finished();
     QString to_error_string(int error_code) override;
+    QString device_identifier() override;
 
 private slots:
     void deviceDiscovered(const QBluetoothDeviceInfo &info);
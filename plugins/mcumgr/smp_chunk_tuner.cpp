@@ -0,0 +1,230 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_chunk_tuner.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_chunk_tuner.h"
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+//Number of acknowledged chunks which the throughput of a size is measured over
+static const uint8_t measurement_chunk_count = 8;
+//Throughput increase (in percent) needed for a larger size to be considered better
+static const uint8_t improvement_threshold_percent = 5;
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_chunk_tuner::smp_chunk_tuner()
+{
+    size_maximum = 0;
+    size_current = 0;
+    size_best = 0;
+    throughput_best = 0;
+    converged = true;
+    size_rejected = 0;
+    measurement_bytes = 0;
+    measurement_chunks = 0;
+}
+
+void smp_chunk_tuner::start(uint32_t maximum, uint32_t remembered, uint32_t remembered_limit)
+{
+    //Probing starts from the size which was remembered from a previous transfer, or a quarter of the maximum. Sizes above a
+    //remembered limit (from a size which the device previously rejected) are not probed again
+    size_maximum = maximum;
+    size_best = 0;
+    throughput_best = 0;
+    size_rejected = 0;
+
+    if (remembered_limit >= SMP_CHUNK_TUNER_MIN_SIZE && remembered_limit < size_maximum)
+    {
+        size_maximum = remembered_limit;
+        size_rejected = remembered_limit;
+    }
+
+    if (remembered > size_maximum)
+    {
+        remembered = 0;
+    }
+
+    if (remembered >= SMP_CHUNK_TUNER_MIN_SIZE)
+    {
+        size_current = remembered;
+    }
+    else
+    {
+        size_current = size_maximum / 4;
+
+        if (size_current < SMP_CHUNK_TUNER_MIN_SIZE)
+        {
+            size_current = SMP_CHUNK_TUNER_MIN_SIZE;
+        }
+    }
+
+    if (size_current > size_maximum)
+    {
+        size_current = size_maximum;
+    }
+
+    converged = false;
+    begin_measurement();
+}
+
+uint32_t smp_chunk_tuner::chunk_size()
+{
+    return size_current;
+}
+
+void smp_chunk_tuner::chunk_acknowledged(uint32_t length)
+{
+    uint64_t throughput;
+    qint64 elapsed;
+
+    if (converged == true)
+    {
+        return;
+    }
+
+    if (measurement_timer.isValid() == false)
+    {
+        //The first acknowledgement is the reference point, this excludes the time taken to erase the slot
+        measurement_timer.start();
+        return;
+    }
+
+    measurement_bytes += length;
+    ++measurement_chunks;
+
+    if (measurement_chunks < measurement_chunk_count)
+    {
+        return;
+    }
+
+    elapsed = measurement_timer.elapsed();
+
+    if (elapsed < 1)
+    {
+        elapsed = 1;
+    }
+
+    throughput = (uint64_t)measurement_bytes * 1000 / (uint64_t)elapsed;
+
+    if (throughput_best == 0 || throughput > ((uint64_t)throughput_best * (100 + improvement_threshold_percent) / 100))
+    {
+        //Larger size improved throughput, keep probing upward
+        size_best = size_current;
+        throughput_best = (throughput > UINT32_MAX ? UINT32_MAX : (uint32_t)throughput);
+
+        if (size_current >= size_maximum)
+        {
+            converged = true;
+        }
+        else
+        {
+            size_current = (size_current * 2 > size_maximum ? size_maximum : size_current * 2);
+        }
+    }
+    else
+    {
+        //No improvement, settle on the best size seen
+        size_current = size_best;
+        converged = true;
+    }
+
+    begin_measurement();
+}
+
+bool smp_chunk_tuner::back_off(bool rejected)
+{
+    //The current size timed out or was rejected by the device, sizes larger than the one backed off to are not probed again
+    //in this transfer. Only a rejection (the device reporting that the chunk does not fit its buffers) limits later transfers,
+    //a timeout may be transient. Returns false if there is no smaller size to try
+    if (size_current <= SMP_CHUNK_TUNER_MIN_SIZE)
+    {
+        return false;
+    }
+
+    if (size_best == 0 || size_best >= size_current)
+    {
+        size_current /= 2;
+
+        if (size_current < SMP_CHUNK_TUNER_MIN_SIZE)
+        {
+            size_current = SMP_CHUNK_TUNER_MIN_SIZE;
+        }
+
+        size_best = size_current;
+        throughput_best = 0;
+    }
+    else
+    {
+        size_current = size_best;
+    }
+
+    size_maximum = size_current;
+    converged = true;
+
+    if (rejected == true)
+    {
+        size_rejected = size_current;
+    }
+
+    begin_measurement();
+
+    return true;
+}
+
+bool smp_chunk_tuner::is_converged()
+{
+    return converged;
+}
+
+uint32_t smp_chunk_tuner::best_size()
+{
+    //Size to start from on the next transfer, 0 if nothing has been learnt
+    return size_best;
+}
+
+uint32_t smp_chunk_tuner::best_throughput()
+{
+    return throughput_best;
+}
+
+uint32_t smp_chunk_tuner::size_limit()
+{
+    //Largest size which may be used on the next transfer, 0 if the device has not rejected a size
+    return size_rejected;
+}
+
+void smp_chunk_tuner::begin_measurement()
+{
+    measurement_timer.invalidate();
+    measurement_bytes = 0;
+    measurement_chunks = 0;
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,72 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_chunk_tuner.h
+**
+** Notes:   Selects the size of upload chunks by measuring the throughput of
+**          each size, probing upward from a safe size
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_CHUNK_TUNER_H
+#define SMP_CHUNK_TUNER_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <stdint.h>
+#include <QElapsedTimer>
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+#define SMP_CHUNK_TUNER_MIN_SIZE 128
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_chunk_tuner
+{
+public:
+    smp_chunk_tuner();
+    void start(uint32_t maximum, uint32_t remembered, uint32_t remembered_limit);
+    uint32_t chunk_size();
+    void chunk_acknowledged(uint32_t length);
+    bool back_off(bool rejected);
+    bool is_converged();
+    uint32_t best_size();
+    uint32_t best_throughput();
+    uint32_t size_limit();
+
+private:
+    void begin_measurement();
+
+    uint32_t size_maximum;
+    uint32_t size_current;
+    uint32_t size_best;
+    uint32_t throughput_best;
+    bool converged;
+    uint32_t size_rejected;
+    QElapsedTimer measurement_timer;
+    uint32_t measurement_bytes;
+    uint8_t measurement_chunks;
+};
+
+#endif // SMP_CHUNK_TUNER_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -149,3 +149,20 @@ void smp_error::register_error_lookup_function(uint16_t group, smp_group *group_
 
     lookup_functions.append(error_list_entry);
 }
+
+void smp_error::unregister_error_lookup_function(smp_group *group_object)
+{
+    //Groups can be created and destroyed (e.g. one set per device), another instance of the same group remains registered if one exists
+    uint16_t i = 0;
+
+    while (i < lookup_functions.length())
+    {
+        if (lookup_functions[i].lookup == group_object)
+        {
+            lookup_functions.removeAt(i);
+            continue;
+        }
+
+        ++i;
+    }
+}
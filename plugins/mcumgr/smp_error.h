@@ -77,6 +77,7 @@ public:
     static QString error_lookup_string(smp_error_t *error);
     static QString error_lookup_define(smp_error_t *define);
     static void register_error_lookup_function(uint16_t group, smp_group *group_object);
+    static void unregister_error_lookup_function(smp_group *group_object);
 };
 
 #endif // SMP_ERROR_H
@@ -0,0 +1,174 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_file_writer.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_file_writer.h"
+#include <QMutexLocker>
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_file_writer::smp_file_writer(uint id)
+{
+    queued = 0;
+    queued_peak = 0;
+    written = 0;
+    finishing = false;
+    writer_id = id;
+}
+
+smp_file_writer::~smp_file_writer()
+{
+    stop();
+}
+
+bool smp_file_writer::open(QString filename)
+{
+    //Opened before the thread is started so that errors can be reported straight away
+    file.setFileName(filename);
+
+    return file.open(QFile::WriteOnly | QFile::Truncate);
+}
+
+void smp_file_writer::write(QByteArray data)
+{
+    QMutexLocker locker(&queue_lock);
+
+    queue.append(data);
+    queued += data.length();
+
+    if (queued > queued_peak)
+    {
+        queued_peak = queued;
+    }
+
+    queue_changed.wakeAll();
+}
+
+void smp_file_writer::finish()
+{
+    //No more data will be queued, the thread exits once everything has been written
+    QMutexLocker locker(&queue_lock);
+
+    finishing = true;
+    queue_changed.wakeAll();
+}
+
+void smp_file_writer::stop()
+{
+    //Abandons any data which has not yet been written
+    if (isRunning() == true)
+    {
+        queue_lock.lock();
+        requestInterruption();
+        queue_changed.wakeAll();
+        queue_lock.unlock();
+        wait();
+    }
+
+    if (file.isOpen() == true)
+    {
+        file.close();
+    }
+}
+
+qint64 smp_file_writer::get_written()
+{
+    QMutexLocker locker(&queue_lock);
+
+    return written;
+}
+
+qint64 smp_file_writer::get_queued_peak()
+{
+    QMutexLocker locker(&queue_lock);
+
+    return queued_peak;
+}
+
+void smp_file_writer::run()
+{
+    QString error;
+
+    while (true)
+    {
+        QList<QByteArray> blocks;
+        int i = 0;
+
+        queue_lock.lock();
+
+        while (queue.isEmpty() == true && finishing == false && isInterruptionRequested() == false)
+        {
+            queue_changed.wait(&queue_lock);
+        }
+
+        if (isInterruptionRequested() == true || (queue.isEmpty() == true && finishing == true))
+        {
+            queue_lock.unlock();
+            break;
+        }
+
+        //Blocks are taken in one go so the queue is not locked whilst writing
+        blocks.swap(queue);
+        queue_lock.unlock();
+
+        while (i < blocks.length())
+        {
+            if (file.write(blocks.at(i)) != blocks.at(i).length())
+            {
+                error = file.errorString();
+                break;
+            }
+
+            queue_lock.lock();
+            queued -= blocks.at(i).length();
+            written += blocks.at(i).length();
+            queue_lock.unlock();
+            ++i;
+        }
+
+        if (error.isEmpty() == false)
+        {
+            break;
+        }
+    }
+
+    if (isInterruptionRequested() == true)
+    {
+        return;
+    }
+
+    if (error.isEmpty() == true && file.flush() == false)
+    {
+        error = file.errorString();
+    }
+
+    file.close();
+    emit write_finished(writer_id, error.isEmpty(), error);
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,74 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_file_writer.h
+**
+** Notes:   Write-behind file writer, data queued from the GUI thread is
+**          written to disk by a worker thread
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_FILE_WRITER_H
+#define SMP_FILE_WRITER_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QThread>
+#include <QFile>
+#include <QList>
+#include <QByteArray>
+#include <QMutex>
+#include <QWaitCondition>
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_file_writer : public QThread
+{
+    Q_OBJECT
+
+public:
+    smp_file_writer(uint id);
+    ~smp_file_writer();
+    bool open(QString filename);
+    void write(QByteArray data);
+    void finish();
+    void stop();
+    qint64 get_written();
+    qint64 get_queued_peak();
+    void run() override;
+
+signals:
+    void write_finished(uint id, bool success, QString error);
+
+private:
+    QFile file;
+    QMutex queue_lock;
+    QWaitCondition queue_changed;
+    QList<QByteArray> queue;
+    qint64 queued;
+    qint64 queued_peak;
+    qint64 written;
+    bool finishing;
+    uint writer_id;
+};
+
+#endif // SMP_FILE_WRITER_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
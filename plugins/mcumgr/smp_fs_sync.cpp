@@ -0,0 +1,545 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_fs_sync.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_fs_sync.h"
+#include "smp_hash_checksum.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QTimer>
+#include <algorithm>
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+//Size of each block read from a local file whilst hashing it
+static const qint64 hash_block_size = 64 * 1024;
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_fs_sync::smp_fs_sync(smp_group_fs_mgmt *fs_group, smp_group_shell_mgmt *shell_group, QObject *parent) : QObject(parent)
+{
+    fs_mgmt = fs_group;
+    shell_mgmt = shell_group;
+    sync_direction = SMP_FS_SYNC_UPLOAD;
+    state = SMP_FS_SYNC_STATE_IDLE;
+    sync_user_data = 0;
+    sync_verify = false;
+    file_index = 0;
+    shell_ret = 0;
+    remote_size = 0;
+
+    connect(fs_mgmt, SIGNAL(status(uint8_t,group_status,QString)), this, SLOT(group_finished(uint8_t,group_status,QString)));
+    connect(fs_mgmt, SIGNAL(progress(uint8_t,uint8_t)), this, SLOT(group_progress(uint8_t,uint8_t)));
+    connect(shell_mgmt, SIGNAL(status(uint8_t,group_status,QString)), this, SLOT(group_finished(uint8_t,group_status,QString)));
+}
+
+smp_fs_sync::~smp_fs_sync()
+{
+    disconnect(this, SLOT(group_finished(uint8_t,group_status,QString)));
+    disconnect(this, SLOT(group_progress(uint8_t,uint8_t)));
+}
+
+bool smp_fs_sync::start(smp_fs_sync_direction_t direction, QString local_directory, QString remote_directory, QString hash_checksum, bool verify, uint8_t user_data, QString *error)
+{
+    //Group operations are started from the event loop so that no status is reported before this returns
+    if (state != SMP_FS_SYNC_STATE_IDLE)
+    {
+        *error = "Directory sync already in progress";
+        return false;
+    }
+
+    if (smp_hash_checksum::is_supported(hash_checksum) == false)
+    {
+        *error = QString("Hash/checksum \"%1\" cannot be calculated locally, use sha256 or crc32").arg(hash_checksum);
+        return false;
+    }
+
+    sync_direction = direction;
+    local_root = local_directory;
+    remote_root = remote_directory;
+    hash_type = hash_checksum;
+    sync_verify = verify;
+    sync_user_data = user_data;
+    remote_hash_available = true;
+    remote_directories_available = true;
+    pending_directories.clear();
+    created_directories.clear();
+    files.clear();
+    file_index = -1;
+    files_transferred = 0;
+    files_skipped = 0;
+    bytes_transferred = 0;
+    bytes_saved = 0;
+
+    while (remote_root.length() > 1 && remote_root.endsWith('/') == true)
+    {
+        remote_root.chop(1);
+    }
+
+    if (direction == SMP_FS_SYNC_UPLOAD)
+    {
+        QDir root(local_root);
+        QDirIterator iterator(local_root, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+
+        if (root.exists() == false)
+        {
+            *error = "Local directory does not exist";
+            return false;
+        }
+
+        while (iterator.hasNext() == true)
+        {
+            smp_fs_sync_file_t file;
+
+            iterator.next();
+            file.relative_path = root.relativeFilePath(iterator.filePath());
+            file.size = (uint32_t)iterator.fileInfo().size();
+            files.append(file);
+        }
+
+        if (files.isEmpty() == true)
+        {
+            *error = "Local directory contains no files";
+            return false;
+        }
+
+        std::sort(files.begin(), files.end(), [](const smp_fs_sync_file_t &a, const smp_fs_sync_file_t &b) { return a.relative_path < b.relative_path; });
+        state = SMP_FS_SYNC_STATE_HASH;
+    }
+    else
+    {
+        //Device directory contents are not available from fs_mgmt, the device shell is used to list them
+        pending_directories.append(QString());
+        state = SMP_FS_SYNC_STATE_LIST;
+    }
+
+    QTimer::singleShot(0, this, SLOT(begin()));
+
+    return true;
+}
+
+void smp_fs_sync::begin()
+{
+    if (state == SMP_FS_SYNC_STATE_LIST)
+    {
+        list_next_directory();
+    }
+    else if (state == SMP_FS_SYNC_STATE_HASH)
+    {
+        next_file();
+    }
+}
+
+void smp_fs_sync::cancel()
+{
+    if (state == SMP_FS_SYNC_STATE_IDLE)
+    {
+        return;
+    }
+
+    //Statuses from the groups being cancelled are ignored once idle
+    state = SMP_FS_SYNC_STATE_IDLE;
+    fs_mgmt->cancel();
+    shell_mgmt->cancel();
+    emit finished(false, "Cancelled");
+}
+
+bool smp_fs_sync::is_busy()
+{
+    return (state != SMP_FS_SYNC_STATE_IDLE);
+}
+
+bool smp_fs_sync::local_hash_checksum(QString file_name, QString hash_checksum, QByteArray *result, uint32_t *file_size)
+{
+    //Output is in the same form as the fs_mgmt hash/checksum response
+    QFile file(file_name);
+    smp_hash_checksum hash;
+
+    if (hash.start(hash_checksum) == false || file.open(QFile::ReadOnly) == false)
+    {
+        return false;
+    }
+
+    *file_size = (uint32_t)file.size();
+
+    while (file.atEnd() == false)
+    {
+        QByteArray block = file.read(hash_block_size);
+
+        if (block.isEmpty() == true)
+        {
+            return false;
+        }
+
+        hash.add_data(block);
+    }
+
+    *result = hash.result();
+
+    return true;
+}
+
+void smp_fs_sync::list_next_directory()
+{
+    if (pending_directories.isEmpty() == true)
+    {
+        if (files.isEmpty() == true)
+        {
+            finish(false, "Remote directory contains no files");
+            return;
+        }
+
+        std::sort(files.begin(), files.end(), [](const smp_fs_sync_file_t &a, const smp_fs_sync_file_t &b) { return a.relative_path < b.relative_path; });
+        next_file();
+        return;
+    }
+
+    listing_directory = pending_directories.takeFirst();
+    shell_arguments = QStringList() << "fs" << "ls" << remote_path(listing_directory);
+    state = SMP_FS_SYNC_STATE_LIST;
+    emit file_status(QString("Listing %1").arg(remote_path(listing_directory)));
+    shell_mgmt->start_execute(&shell_arguments, &shell_ret);
+}
+
+bool smp_fs_sync::parse_listing(QString output)
+{
+    //Zephyr's fs ls prints one entry per line, directories have a trailing /
+    QStringList lines = output.split('\n');
+    int i = 0;
+
+    while (i < lines.length())
+    {
+        QString name = lines.at(i).trimmed();
+        QString relative_path;
+
+        ++i;
+
+        if (name.isEmpty() == true)
+        {
+            continue;
+        }
+
+        relative_path = (listing_directory.isEmpty() == true ? name : QString("%1/%2").arg(listing_directory, name));
+
+        if (name.endsWith('/') == true)
+        {
+            relative_path.chop(1);
+            pending_directories.append(relative_path);
+        }
+        else
+        {
+            smp_fs_sync_file_t file;
+
+            file.relative_path = relative_path;
+            file.size = 0;
+            files.append(file);
+        }
+    }
+
+    return true;
+}
+
+void smp_fs_sync::next_file()
+{
+    ++file_index;
+
+    if (file_index >= files.length())
+    {
+        finish(true, QString());
+        return;
+    }
+
+    check_file();
+}
+
+void smp_fs_sync::check_file()
+{
+    const smp_fs_sync_file_t *file = &files.at(file_index);
+
+    emit progress((uint8_t)(file_index * 100 / files.length()));
+
+    if (remote_hash_available == false)
+    {
+        //Device cannot provide a hash/checksum so every file has to be transferred
+        transfer_file();
+        return;
+    }
+
+    state = SMP_FS_SYNC_STATE_HASH;
+    emit file_status(QString("Checking %1 (%2 of %3)").arg(file->relative_path, QString::number(file_index + 1), QString::number(files.length())));
+    fs_mgmt->start_hash_checksum(remote_path(file->relative_path), hash_type, &remote_hash, &remote_size);
+}
+
+void smp_fs_sync::transfer_file()
+{
+    smp_fs_sync_file_t *file = &files[file_index];
+    QString local_file = local_path(file->relative_path);
+
+    if (sync_direction == SMP_FS_SYNC_UPLOAD)
+    {
+        QString directory = QFileInfo(file->relative_path).path();
+
+        if (remote_directories_available == true && directory != ".")
+        {
+            //Parent directories are created from the top down, once per sync, before the first file which is in them
+            QStringList parts = directory.split('/');
+            QString path;
+            int i = 0;
+
+            while (i < parts.length())
+            {
+                path = (i == 0 ? parts.at(i) : QString("%1/%2").arg(path, parts.at(i)));
+
+                if (created_directories.contains(path) == false)
+                {
+                    created_directories.append(path);
+                    shell_arguments = QStringList() << "fs" << "mkdir" << remote_path(path);
+                    state = SMP_FS_SYNC_STATE_MAKE_DIRECTORY;
+                    shell_mgmt->start_execute(&shell_arguments, &shell_ret);
+                    return;
+                }
+
+                ++i;
+            }
+        }
+
+        state = SMP_FS_SYNC_STATE_TRANSFER;
+        emit file_status(QString("Uploading %1 (%2 of %3)").arg(file->relative_path, QString::number(file_index + 1), QString::number(files.length())));
+        fs_mgmt->start_upload(local_file, remote_path(file->relative_path), (sync_verify == true ? hash_type : QString()));
+    }
+    else
+    {
+        QDir().mkpath(QFileInfo(local_file).absolutePath());
+        state = SMP_FS_SYNC_STATE_TRANSFER;
+        emit file_status(QString("Downloading %1 (%2 of %3)").arg(file->relative_path, QString::number(file_index + 1), QString::number(files.length())));
+        fs_mgmt->start_download(remote_path(file->relative_path), local_file);
+    }
+}
+
+void smp_fs_sync::file_matched()
+{
+    ++files_skipped;
+    bytes_saved += files.at(file_index).size;
+    next_file();
+}
+
+void smp_fs_sync::finish(bool success, QString error)
+{
+    QString summary;
+
+    state = SMP_FS_SYNC_STATE_IDLE;
+
+    if (success == true)
+    {
+        summary = QString("Sync complete, ");
+    }
+    else
+    {
+        summary = error.append(", ");
+    }
+
+    summary.append(QString("%1 file%2 transferred (%3), %4 skipped (%5 saved)").arg(QString::number(files_transferred), (files_transferred == 1 ? "" : "s"), size_string(bytes_transferred), QString::number(files_skipped), size_string(bytes_saved)));
+
+    if (remote_hash_available == false)
+    {
+        summary.append(", device does not support hash/checksum so no files could be skipped");
+    }
+
+    if (success == true)
+    {
+        emit progress(100);
+    }
+
+    emit finished(success, summary);
+}
+
+QString smp_fs_sync::local_path(QString relative_path)
+{
+    return QDir(local_root).filePath(relative_path);
+}
+
+QString smp_fs_sync::remote_path(QString relative_path)
+{
+    if (relative_path.isEmpty() == true)
+    {
+        return remote_root;
+    }
+
+    return (remote_root.endsWith('/') == true ? QString(remote_root).append(relative_path) : QString("%1/%2").arg(remote_root, relative_path));
+}
+
+QString smp_fs_sync::size_string(uint64_t bytes)
+{
+    const char *units[] = {"B", "KiB", "MiB", "GiB"};
+    double size = (double)bytes;
+    uint8_t prefix = 0;
+
+    while (size >= 1024.0 && prefix < 3)
+    {
+        size /= 1024.0;
+        ++prefix;
+    }
+
+    if (prefix == 0)
+    {
+        return QString("%1 B").arg(QString::number(bytes));
+    }
+
+    return QString("%1 %2").arg(QString::number(size, 'f', 1), units[prefix]);
+}
+
+void smp_fs_sync::group_finished(uint8_t user_data, group_status status, QString error_string)
+{
+    if (user_data != sync_user_data || state == SMP_FS_SYNC_STATE_IDLE)
+    {
+        return;
+    }
+
+    switch (state)
+    {
+        case SMP_FS_SYNC_STATE_LIST:
+        {
+            if (status != STATUS_COMPLETE)
+            {
+                finish(false, QString("Unable to list %1 using the device shell: %2").arg(remote_path(listing_directory), error_string));
+            }
+            else if (shell_ret != 0 || parse_listing(error_string) == false)
+            {
+                finish(false, QString("Unable to list %1: %2").arg(remote_path(listing_directory), error_string.trimmed()));
+            }
+            else
+            {
+                list_next_directory();
+            }
+
+            break;
+        }
+        case SMP_FS_SYNC_STATE_MAKE_DIRECTORY:
+        {
+            if (status == STATUS_COMPLETE)
+            {
+                //A non-zero return is expected if the directory already exists, the upload will fail if it is missing
+                transfer_file();
+            }
+            else if (status == STATUS_ERROR || status == STATUS_UNSUPPORTED)
+            {
+                //Device shell is not available, directories must already exist
+                remote_directories_available = false;
+                transfer_file();
+            }
+            else
+            {
+                finish(false, QString("Unable to create remote directory: %1").arg(error_string));
+            }
+
+            break;
+        }
+        case SMP_FS_SYNC_STATE_HASH:
+        {
+            if (status == STATUS_COMPLETE)
+            {
+                smp_fs_sync_file_t *file = &files[file_index];
+                QByteArray local_hash;
+                uint32_t local_size = 0;
+                bool local_valid = local_hash_checksum(local_path(file->relative_path), hash_type, &local_hash, &local_size);
+
+                if (sync_direction == SMP_FS_SYNC_DOWNLOAD)
+                {
+                    file->size = remote_size;
+                }
+
+                if (local_valid == true && local_size == remote_size && local_hash == remote_hash)
+                {
+                    file_matched();
+                }
+                else
+                {
+                    transfer_file();
+                }
+            }
+            else if (status == STATUS_ERROR || status == STATUS_UNSUPPORTED)
+            {
+                //File is missing on the device or it cannot hash it, either way it has to be transferred
+                if (status == STATUS_UNSUPPORTED)
+                {
+                    remote_hash_available = false;
+                }
+
+                transfer_file();
+            }
+            else
+            {
+                finish(false, QString("Unable to check %1: %2").arg(files.at(file_index).relative_path, error_string));
+            }
+
+            break;
+        }
+        case SMP_FS_SYNC_STATE_TRANSFER:
+        {
+            if (status == STATUS_COMPLETE)
+            {
+                smp_fs_sync_file_t *file = &files[file_index];
+
+                if (sync_direction == SMP_FS_SYNC_DOWNLOAD)
+                {
+                    file->size = (uint32_t)QFileInfo(local_path(file->relative_path)).size();
+                }
+
+                ++files_transferred;
+                bytes_transferred += file->size;
+                next_file();
+            }
+            else
+            {
+                finish(false, QString("Unable to transfer %1: %2").arg(files.at(file_index).relative_path, error_string));
+            }
+
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+
+void smp_fs_sync::group_progress(uint8_t user_data, uint8_t percent)
+{
+    //Progress of the current file is scaled to its share of the whole sync
+    if (user_data != sync_user_data || state != SMP_FS_SYNC_STATE_TRANSFER || files.isEmpty() == true)
+    {
+        return;
+    }
+
+    emit progress((uint8_t)((file_index * 100 + percent) / files.length()));
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,127 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_fs_sync.h
+**
+** Notes:   Synchronises a local directory with a directory on a device using
+**          fs_mgmt, files whose hashes/checksums already match are skipped
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_FS_SYNC_H
+#define SMP_FS_SYNC_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QObject>
+#include <QList>
+#include <QStringList>
+#include "smp_group_fs_mgmt.h"
+#include "smp_group_shell_mgmt.h"
+
+/******************************************************************************/
+// Enum typedefs
+/******************************************************************************/
+enum smp_fs_sync_direction_t {
+    SMP_FS_SYNC_UPLOAD,
+    SMP_FS_SYNC_DOWNLOAD
+};
+
+enum smp_fs_sync_state_t {
+    SMP_FS_SYNC_STATE_IDLE,
+    SMP_FS_SYNC_STATE_LIST,
+    SMP_FS_SYNC_STATE_MAKE_DIRECTORY,
+    SMP_FS_SYNC_STATE_HASH,
+    SMP_FS_SYNC_STATE_TRANSFER
+};
+
+/******************************************************************************/
+// Forward declaration of Class, Struct & Unions
+/******************************************************************************/
+struct smp_fs_sync_file_t {
+    QString relative_path;
+    uint32_t size;
+};
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_fs_sync : public QObject
+{
+    Q_OBJECT
+
+public:
+    smp_fs_sync(smp_group_fs_mgmt *fs_group, smp_group_shell_mgmt *shell_group, QObject *parent = nullptr);
+    ~smp_fs_sync();
+    bool start(smp_fs_sync_direction_t direction, QString local_directory, QString remote_directory, QString hash_checksum, bool verify, uint8_t user_data, QString *error);
+    void cancel();
+    bool is_busy();
+    static bool local_hash_checksum(QString file_name, QString hash_checksum, QByteArray *result, uint32_t *file_size);
+
+signals:
+    void progress(uint8_t percent);
+    void file_status(QString message);
+    void finished(bool success, QString summary);
+
+private slots:
+    void begin();
+    void group_finished(uint8_t user_data, group_status status, QString error_string);
+    void group_progress(uint8_t user_data, uint8_t percent);
+
+private:
+    void list_next_directory();
+    bool parse_listing(QString output);
+    void next_file();
+    void check_file();
+    void transfer_file();
+    void file_matched();
+    void finish(bool success, QString error);
+    QString local_path(QString relative_path);
+    QString remote_path(QString relative_path);
+    static QString size_string(uint64_t bytes);
+
+    smp_group_fs_mgmt *fs_mgmt;
+    smp_group_shell_mgmt *shell_mgmt;
+    smp_fs_sync_direction_t sync_direction;
+    smp_fs_sync_state_t state;
+    uint8_t sync_user_data;
+    QString local_root;
+    QString remote_root;
+    QString hash_type;
+    bool sync_verify;
+    bool remote_hash_available;
+    bool remote_directories_available;
+    QStringList pending_directories;
+    QString listing_directory;
+    QStringList created_directories;
+    QList<smp_fs_sync_file_t> files;
+    int file_index;
+    QStringList shell_arguments;
+    int32_t shell_ret;
+    QByteArray remote_hash;
+    uint32_t remote_size;
+    uint32_t files_transferred;
+    uint32_t files_skipped;
+    uint64_t bytes_transferred;
+    uint64_t bytes_saved;
+};
+
+#endif // SMP_FS_SYNC_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
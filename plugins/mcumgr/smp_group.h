@@ -28,6 +28,7 @@
 #include "smp_message.h"
 #include "smp_processor.h"
 #include "smp_error.h"
+#include "smp_chunk_tuner.h"
 #include "debug_logger.h"
 
 /******************************************************************************/
@@ -69,6 +70,14 @@ public:
         name = group_name;
         error_lookup = error_lookup_function;
         error_define_lookup = error_define_lookup_function;
+        upload_tuning = false;
+        upload_tuning_size = 0;
+        upload_tuning_limit = 0;
+    }
+
+    ~smp_group()
+    {
+        smp_error::unregister_error_lookup_function(this);
     }
 
     void set_parameters(uint8_t version, uint16_t mtu, uint8_t retries, uint32_t timeout, uint8_t user_data)
@@ -80,6 +89,36 @@ public:
         smp_user_data = user_data;
     }
 
+    void set_upload_chunk_tuning(bool enabled, uint32_t remembered_size, uint32_t remembered_limit)
+    {
+        //Applies to uploads started after this is called, the remembered values are from a previous upload (or 0)
+        upload_tuning = enabled;
+        upload_tuning_size = remembered_size;
+        upload_tuning_limit = remembered_limit;
+    }
+
+    uint32_t get_upload_chunk_size()
+    {
+        //Best chunk size found by the most recent tuned upload, 0 if nothing was learnt
+        if (upload_tuning == false)
+        {
+            return 0;
+        }
+
+        return upload_tuner.best_size();
+    }
+
+    uint32_t get_upload_chunk_limit()
+    {
+        //Largest chunk size the device accepted after rejecting a larger one in the most recent tuned upload, 0 if none was rejected
+        if (upload_tuning == false)
+        {
+            return 0;
+        }
+
+        return upload_tuner.size_limit();
+    }
+
     bool lookup_error(int32_t rc, QString *error)
     {
         if (error_lookup != nullptr)
@@ -160,7 +199,7 @@ public:
         }
     }
 
-    void timeout(smp_message *message)
+    virtual void timeout(smp_message *message)
     {
         Q_UNUSED(message);
         QString response = QString("Timeout (Mode: %1)").arg(mode_to_string(mode));
@@ -217,6 +256,67 @@ protected:
         return STATUS_ERROR;
     }
 
+    static bool chunk_size_error(smp_error_t error)
+    {
+        //Errors which a device may return if a chunk is too large for its buffers
+        if (error.type == SMP_ERROR_RC && (error.rc == SMP_RC_ERROR_ENOMEM || error.rc == SMP_RC_ERROR_EMSGSIZE))
+        {
+            return true;
+        }
+
+        return false;
+    }
+
+    void start_upload_chunk_tuning()
+    {
+        if (upload_tuning == true)
+        {
+            upload_tuner.start(processor->max_message_data_size(smp_mtu), upload_tuning_size, upload_tuning_limit);
+        }
+    }
+
+    uint16_t upload_chunk_message_size()
+    {
+        //Maximum size of an upload message, which is reduced from the transport maximum whilst the chunk size is being tuned
+        uint16_t max_size = processor->max_message_data_size(smp_mtu);
+
+        if (upload_tuning == true && upload_tuner.chunk_size() < max_size)
+        {
+            max_size = upload_tuner.chunk_size();
+        }
+
+        return max_size;
+    }
+
+    static QString throughput_string(uint64_t bytes, qint64 elapsed_ms)
+    {
+        //Transfer rate in the largest unit which keeps the value above 1
+        const char *units[] = {"B", "KiB", "MiB", "GiB"};
+        double speed;
+        uint8_t prefix = 0;
+
+        if (elapsed_ms < 1)
+        {
+            elapsed_ms = 1;
+        }
+
+        speed = (double)bytes * 1000.0 / (double)elapsed_ms;
+
+        while (speed >= 1024.0 && prefix < 3)
+        {
+            speed /= 1024.0;
+            ++prefix;
+        }
+
+        return QString("~%1%2ps throughput").arg(QString::number(speed, 'f', 1), units[prefix]);
+    }
+
+    smp_message *transfer_message()
+    {
+        //Transfer chunks use pooled messages with room for the largest message the transport allows, so buffers are not regrown per chunk
+        return processor->acquire_message(processor->max_message_data_size(smp_mtu));
+    }
+
     virtual void cleanup() = 0;
     virtual QString mode_to_string(uint8_t mode) = 0;
     virtual QString command_to_string(uint8_t command) = 0;
@@ -237,6 +337,10 @@ protected:
     smp_error_lookup error_lookup;
     smp_error_define_lookup error_define_lookup;
     uint8_t mode;
+    smp_chunk_tuner upload_tuner;
+    bool upload_tuning;
+    uint32_t upload_tuning_size;
+    uint32_t upload_tuning_limit;
 #ifndef SKIPPLUGIN_LOGGER
     debug_logger *logger;
 #endif
@@ -112,6 +112,13 @@ static const QStringList smp_error_values = QStringList() <<
 smp_group_fs_mgmt::smp_group_fs_mgmt(smp_processor *parent) : smp_group(parent, "FS", SMP_GROUP_ID_FS, error_lookup, error_define_lookup)
 {
     mode = MODE_IDLE;
+    file_upload_acknowledged = 0;
+    upload_verify = false;
+    upload_verifying = false;
+    download_writer = nullptr;
+    download_writer_id = 0;
+    download_pipelined = false;
+    download_in_flight = 0;
 }
 
 bool smp_group_fs_mgmt::parse_upload_response(QCborStreamReader &reader, uint32_t *off, bool *off_found)
@@ -650,6 +657,14 @@ void smp_group_fs_mgmt::receive_ok(uint8_t version, uint8_t op, uint16_t group,
             //todo
             if (off_found == true)
             {
+                if (good == true && upload_tuning == true && file_upload_area > file_upload_acknowledged)
+                {
+                    //Measures the throughput of the current chunk size
+                    upload_tuner.chunk_acknowledged(file_upload_area - file_upload_acknowledged);
+                }
+
+                file_upload_acknowledged = file_upload_area;
+
                 if (file_upload_area < local_file_size)
                 {
                     //Upload next chunk
@@ -659,9 +674,26 @@ void smp_group_fs_mgmt::receive_ok(uint8_t version, uint8_t op, uint16_t group,
                 else
                 {
                     //Upload complete
+                    QString response = "Upload complete";
+
+                    if (upload_tuning == true && upload_tuner.best_size() > 0)
+                    {
+                        response.append(QString(", chunk size %1 bytes").arg(QString::number(upload_tuner.best_size())));
+                    }
+
+                    if (upload_verify == true)
+                    {
+                        //Device hash/checksum is compared with the one calculated as the chunks were read
+                        upload_verify_response = response;
+                        local_file.close();
+                        emit progress(smp_user_data, 100);
+                        start_upload_verify();
+                        return;
+                    }
+
                     cleanup();
                     emit progress(smp_user_data, 100);
-                    emit status(smp_user_data, STATUS_COMPLETE, "Upload complete");
+                    emit status(smp_user_data, STATUS_COMPLETE, response);
                 }
             }
             else
@@ -673,7 +705,7 @@ void smp_group_fs_mgmt::receive_ok(uint8_t version, uint8_t op, uint16_t group,
         else if (mode == MODE_DOWNLOAD && command == COMMAND_UPLOAD_DOWNLOAD)
         {
             //Response to download
-            uint32_t off;
+            uint32_t off = UINT32_MAX;
             uint32_t len = 0;
             QByteArray file_data;
             QCborStreamReader cbor_reader(data);
@@ -684,6 +716,12 @@ void smp_group_fs_mgmt::receive_ok(uint8_t version, uint8_t op, uint16_t group,
                 local_file_size = len;
             }
 
+            if (download_pipelined == true)
+            {
+                download_pipeline_response(off, &file_data);
+                return;
+            }
+
             if (file_upload_area != off)
             {
                 log_error() << "Error: mismatch!";
@@ -699,15 +737,17 @@ void smp_group_fs_mgmt::receive_ok(uint8_t version, uint8_t op, uint16_t group,
             if (file_upload_area < local_file_size)
             {
                 //Download next chunk
-                download_chunk();
+                download_chunk(file_upload_area);
                 emit progress(smp_user_data, file_upload_area * 100 / local_file_size);
             }
             else
             {
                 //Download complete
+                QString response = download_summary();
+
                 cleanup();
                 emit progress(smp_user_data, 100);
-                emit status(smp_user_data, STATUS_COMPLETE, "Download complete");
+                emit status(smp_user_data, STATUS_COMPLETE, response);
             }
         }
         else if (mode == MODE_STATUS && command == COMMAND_STATUS)
@@ -727,6 +767,13 @@ void smp_group_fs_mgmt::receive_ok(uint8_t version, uint8_t op, uint16_t group,
             QCborStreamReader cbor_reader(data);
 
             bool good = parse_hash_checksum_response(cbor_reader, &type, hash_checksum_result_object, file_size_object);
+
+            if (upload_verifying == true)
+            {
+                upload_verify_result(type);
+                return;
+            }
+
             cleanup();
             emit status(smp_user_data, STATUS_COMPLETE, type);
         }
@@ -767,6 +814,15 @@ void smp_group_fs_mgmt::receive_error(uint8_t version, uint8_t op, uint16_t grou
 
     if (command == COMMAND_UPLOAD_DOWNLOAD && mode == MODE_UPLOAD)
     {
+        if (upload_tuning == true && chunk_size_error(error) == true && upload_tuner.back_off(true) == true)
+        {
+            //Send the rejected chunk again at the smaller size
+            log_error() << "Upload chunk rejected by device, reducing chunk size to " << upload_tuner.chunk_size();
+            file_upload_area = file_upload_acknowledged;
+            upload_chunk();
+            return;
+        }
+
         //TODO
         if (error.type == SMP_ERROR_RET && error.group == SMP_GROUP_ID_FS && error.rc == FS_MGMT_ERR_FILE_OFFSET_NOT_VALID)
         {
@@ -788,8 +844,15 @@ void smp_group_fs_mgmt::receive_error(uint8_t version, uint8_t op, uint16_t grou
     }
     else if (command == COMMAND_HASH_CHECKSUM && mode == MODE_HASH_CHECKSUM)
     {
-        //TODO
-        emit status(smp_user_data, status_error_return(error), smp_error::error_lookup_string(&error));
+        if (upload_verifying == true)
+        {
+            emit status(smp_user_data, status_error_return(error), QString("%1, unable to verify: %2").arg(upload_verify_response, smp_error::error_lookup_string(&error)));
+        }
+        else
+        {
+            //TODO
+            emit status(smp_user_data, status_error_return(error), smp_error::error_lookup_string(&error));
+        }
     }
     else if (command == COMMAND_SUPPORTED_HASHES_CHECKSUMS && mode == MODE_SUPPORTED_HASHES_CHECKSUMS)
     {
@@ -813,6 +876,17 @@ void smp_group_fs_mgmt::receive_error(uint8_t version, uint8_t op, uint16_t grou
     }
 }
 
+void smp_group_fs_mgmt::timeout(smp_message *message)
+{
+    if (mode == MODE_UPLOAD && upload_tuning == true && upload_tuner.back_off(false) == true)
+    {
+        //The next upload starts from a smaller size, a timeout is not remembered as a limit so larger sizes are probed again
+        log_error() << "Upload timed out, reducing chunk size to " << upload_tuner.chunk_size();
+    }
+
+    smp_group::timeout(message);
+}
+
 void smp_group_fs_mgmt::cancel()
 {
     if (mode != MODE_IDLE)
@@ -824,9 +898,9 @@ void smp_group_fs_mgmt::cancel()
 
 bool smp_group_fs_mgmt::upload_chunk()
 {
-    uint max_size = processor->max_message_data_size(smp_mtu);
+    uint max_size = upload_chunk_message_size();
     uint remaining_file_size;
-    smp_message *tmp_message = new smp_message();
+    smp_message *tmp_message = transfer_message();
 
     tmp_message->start_message(SMP_OP_WRITE, smp_version, SMP_GROUP_ID_FS, COMMAND_UPLOAD_DOWNLOAD, (file_upload_area == 0 ? 4 : 3));
 
@@ -855,7 +929,17 @@ bool smp_group_fs_mgmt::upload_chunk()
     {
         max_size = remaining_file_size;
     }
-    tmp_message->writer()->append(local_file.read(max_size));
+
+    QByteArray chunk = local_file.read(max_size);
+
+    if (upload_verify == true && file_upload_area <= upload_hashed && (file_upload_area + chunk.length()) > upload_hashed)
+    {
+        //Only data which has not been hashed yet is added, chunks are read again if they are resent
+        upload_hash.add_data(chunk.mid(upload_hashed - file_upload_area));
+        upload_hashed = file_upload_area + chunk.length();
+    }
+
+    tmp_message->writer()->append(chunk);
     tmp_message->end_message();
 
     file_upload_area += max_size;
@@ -868,9 +952,9 @@ bool smp_group_fs_mgmt::upload_chunk()
     return handle_transport_error(processor->send(tmp_message, smp_timeout, smp_retries, true));
 }
 
-bool smp_group_fs_mgmt::download_chunk()
+bool smp_group_fs_mgmt::download_chunk(uint32_t offset)
 {
-    smp_message *tmp_message = new smp_message();
+    smp_message *tmp_message = transfer_message();
     tmp_message->start_message(SMP_OP_READ, smp_version, SMP_GROUP_ID_FS, COMMAND_UPLOAD_DOWNLOAD, 2);
 
 /*    if (local_file.pos() != file_upload_area)
@@ -882,7 +966,7 @@ bool smp_group_fs_mgmt::download_chunk()
     tmp_message->writer()->append("name");
     tmp_message->writer()->append(device_file_name);
     tmp_message->writer()->append("off");
-    tmp_message->writer()->append(file_upload_area);
+    tmp_message->writer()->append(offset);
     tmp_message->end_message();
 
     if (check_message_before_send(tmp_message) == false)
@@ -893,8 +977,174 @@ bool smp_group_fs_mgmt::download_chunk()
     return handle_transport_error(processor->send(tmp_message, smp_timeout, smp_retries, true));
 }
 
-bool smp_group_fs_mgmt::start_upload(QString file_name, QString destination_name)
+bool smp_group_fs_mgmt::download_pipeline_send()
 {
+    //Keeps as many offsets requested as the window allows, returns false if the download has been aborted
+    while (download_requested < local_file_size && processor->can_send() == true && download_in_flight < download_window)
+    {
+        uint32_t end = download_requested + download_chunk_size;
+
+        if (end > local_file_size)
+        {
+            end = local_file_size;
+        }
+
+        if (download_chunk(download_requested) == false)
+        {
+            return false;
+        }
+
+        download_requests.insert(download_requested, end);
+        download_requested = end;
+        ++download_in_flight;
+
+        if (download_in_flight > download_max_depth)
+        {
+            download_max_depth = download_in_flight;
+        }
+    }
+
+    return true;
+}
+
+void smp_group_fs_mgmt::download_pipeline_response(uint32_t off, QByteArray *file_data)
+{
+    //Responses can arrive in any order, data ahead of the write position is held until the gap before it has been filled
+    uint32_t expected_end;
+
+    if (download_in_flight > 0)
+    {
+        --download_in_flight;
+    }
+
+    if (download_requests.contains(off) == false)
+    {
+        log_error() << "Download response for unexpected offset " << off;
+        cleanup();
+        emit status(smp_user_data, STATUS_ERROR, QString("Download response for unexpected offset %1").arg(QString::number(off)));
+        return;
+    }
+
+    expected_end = download_requests.take(off);
+
+    if (file_data->isEmpty() == true && off < local_file_size)
+    {
+        cleanup();
+        emit status(smp_user_data, STATUS_ERROR, QString("Device returned no data at offset %1").arg(QString::number(off)));
+        return;
+    }
+
+    if (off == 0)
+    {
+        //The device decides how much data fits in a response, the first one sets the size of each request that follows
+        download_chunk_size = file_data->length();
+        download_requested = download_chunk_size;
+    }
+    else if (off + file_data->length() < expected_end)
+    {
+        //Device returned less than was expected, request the remainder separately
+        if (download_chunk(off + file_data->length()) == false)
+        {
+            return;
+        }
+
+        download_requests.insert(off + file_data->length(), expected_end);
+        ++download_in_flight;
+        ++download_gaps;
+    }
+
+    if (off == file_upload_area)
+    {
+        download_pipeline_write(file_data);
+
+        while (download_reorder.contains(file_upload_area) == true)
+        {
+            QByteArray next_data = download_reorder.take(file_upload_area);
+
+            download_pipeline_write(&next_data);
+        }
+    }
+    else if (off > file_upload_area)
+    {
+        download_reorder.insert(off, *file_data);
+
+        if (download_reorder.count() > download_reorder_peak)
+        {
+            download_reorder_peak = download_reorder.count();
+        }
+    }
+
+    if (file_upload_area >= local_file_size)
+    {
+        //All data received, the download completes once the writer has flushed it to disk
+        emit progress(smp_user_data, 100);
+        download_writer->finish();
+        return;
+    }
+
+    emit progress(smp_user_data, file_upload_area * 100 / local_file_size);
+    download_pipeline_send();
+}
+
+void smp_group_fs_mgmt::download_pipeline_write(QByteArray *file_data)
+{
+    download_writer->write(*file_data);
+    file_upload_area += file_data->length();
+}
+
+void smp_group_fs_mgmt::download_write_finished(uint id, bool success, QString error)
+{
+    //Results from a writer which has since been stopped are discarded
+    QString response;
+
+    if (download_writer == nullptr || id != download_writer_id)
+    {
+        return;
+    }
+
+    if (success == false)
+    {
+        cleanup();
+        emit status(smp_user_data, STATUS_ERROR, QString("Failed to write file: %1").arg(error));
+        return;
+    }
+
+    response = download_summary();
+    cleanup();
+    emit status(smp_user_data, STATUS_COMPLETE, response);
+}
+
+QString smp_group_fs_mgmt::download_summary()
+{
+    QString response = QString("Download complete, ").append(throughput_string(file_upload_area, upload_tmr.elapsed()));
+
+    if (download_pipelined == true)
+    {
+        //Report how deep the pipeline got and how much reordering and re-requesting was needed
+        response.append(QString(", window depth %1 of %2").arg(QString::number(download_max_depth), QString::number(download_window)));
+
+        if (download_reorder_peak > 0)
+        {
+            response.append(QString(", up to %1 chunk%2 reordered").arg(QString::number(download_reorder_peak), (download_reorder_peak == 1 ? "" : "s")));
+        }
+
+        if (download_gaps > 0)
+        {
+            response.append(QString(", %1 short response%2 re-requested").arg(QString::number(download_gaps), (download_gaps == 1 ? "" : "s")));
+        }
+    }
+
+    return response;
+}
+
+bool smp_group_fs_mgmt::start_upload(QString file_name, QString destination_name, QString verify_hash_checksum)
+{
+    if (verify_hash_checksum.isEmpty() == false && upload_hash.start(verify_hash_checksum) == false)
+    {
+        emit status(smp_user_data, STATUS_ERROR, QString("Hash/checksum \"%1\" cannot be calculated locally, use sha256 or crc32").arg(verify_hash_checksum));
+        return false;
+    }
+
     local_file.setFileName(file_name);
 
     if (!local_file.open(QFile::ReadOnly))
@@ -907,31 +1157,128 @@ bool smp_group_fs_mgmt::start_upload(QString file_name, QString destination_name
     device_file_name = destination_name;
     local_file_size = (uint32_t)local_file.size();
     file_upload_area = 0;
+    file_upload_acknowledged = 0;
+    upload_verify = !verify_hash_checksum.isEmpty();
+    upload_hashed = 0;
     upload_tmr.start();
+    start_upload_chunk_tuning();
 
     //	    qDebug() << "len: " << message.length();
 
     return upload_chunk();
 }
 
-bool smp_group_fs_mgmt::start_download(QString file_name, QString destination_name)
+bool smp_group_fs_mgmt::start_upload_verify()
 {
-    local_file.setFileName(destination_name);
+    //Requests the hash/checksum of the uploaded file from the device, the local one has already been calculated
+    smp_message *tmp_message = new smp_message();
+    tmp_message->start_message(SMP_OP_READ, smp_version, SMP_GROUP_ID_FS, COMMAND_HASH_CHECKSUM, 2);
+    tmp_message->writer()->append("name");
+    tmp_message->writer()->append(device_file_name);
+    tmp_message->writer()->append("type");
+    tmp_message->writer()->append(upload_hash.type());
+    tmp_message->end_message();
+
+    mode = MODE_HASH_CHECKSUM;
+    upload_verifying = true;
+    hash_checksum_result_object = &upload_verify_hash;
+    upload_verify_hash.clear();
+    file_size_object = &upload_verify_size;
+    upload_verify_size = 0;
 
-    if (!local_file.open(QFile::WriteOnly | QFile::Truncate))
+    if (check_message_before_send(tmp_message) == false)
     {
-        emit status(smp_user_data, STATUS_ERROR, "File could not be opened in write mode");
         return false;
     }
 
+    return handle_transport_error(processor->send(tmp_message, smp_timeout, smp_retries, true));
+}
+
+void smp_group_fs_mgmt::upload_verify_result(QString type)
+{
+    QString response = upload_verify_response;
+    QByteArray local_result = upload_hash.result();
+    bool matched = false;
+
+    if (upload_hashed != local_file_size)
+    {
+        //Device skipped part of the file, so the local calculation is incomplete
+        response.append(", unable to verify as not all data was read locally");
+    }
+    else if (upload_verify_size != 0 && upload_verify_size != local_file_size)
+    {
+        response.append(QString(", verification failed: device file is %1 bytes, local file is %2 bytes").arg(QString::number(upload_verify_size), QString::number(local_file_size)));
+    }
+    else if (upload_verify_hash != local_result)
+    {
+        response.append(QString(", verification failed: device %1 is %2, local %1 is %3").arg((type.isEmpty() == true ? upload_hash.type() : type), upload_verify_hash.toHex(), local_result.toHex()));
+    }
+    else
+    {
+        response.append(QString(", verified (%1 %2)").arg(upload_hash.type(), local_result.toHex()));
+        matched = true;
+    }
+
+    cleanup();
+    emit status(smp_user_data, (matched == true ? STATUS_COMPLETE : STATUS_ERROR), response);
+}
+
+bool smp_group_fs_mgmt::start_download(QString file_name, QString destination_name)
+{
+    download_window = processor->window();
+    download_pipelined = (download_window > 1);
+
+    if (download_pipelined == true)
+    {
+        //Several offsets are kept in flight with the file written by a worker thread so responses are not held up by disk access
+        ++download_writer_id;
+        download_writer = new smp_file_writer(download_writer_id);
+
+        if (download_writer->open(destination_name) == false)
+        {
+            delete download_writer;
+            download_writer = nullptr;
+            download_pipelined = false;
+            emit status(smp_user_data, STATUS_ERROR, "File could not be opened in write mode");
+            return false;
+        }
+
+        connect(download_writer, SIGNAL(write_finished(uint,bool,QString)), this, SLOT(download_write_finished(uint,bool,QString)));
+        download_writer->start();
+    }
+    else
+    {
+        local_file.setFileName(destination_name);
+
+        if (!local_file.open(QFile::WriteOnly | QFile::Truncate))
+        {
+            emit status(smp_user_data, STATUS_ERROR, "File could not be opened in write mode");
+            return false;
+        }
+    }
+
     mode = MODE_DOWNLOAD;
     device_file_name = file_name;
     file_upload_area = 0;
+    download_requested = 0;
+    download_chunk_size = 0;
+    download_gaps = 0;
+    download_reorder_peak = 0;
+    download_max_depth = 1;
     upload_tmr.start();
 
     //	    qDebug() << "len: " << message.length();
 
-    return download_chunk();
+    if (download_chunk(0) == false)
+    {
+        return false;
+    }
+
+    //The first response gives the file size and chunk size, so it is requested alone
+    download_requests.insert(0, 0);
+    download_in_flight = 1;
+
+    return true;
 }
 
 //TODO
@@ -1113,8 +1460,29 @@ void smp_group_fs_mgmt::cleanup()
         local_file.close();
     }
 
+    if (download_writer != nullptr)
+    {
+        //Data which has not been written yet is abandoned
+        download_writer->stop();
+        delete download_writer;
+        download_writer = nullptr;
+    }
+
+    if (download_pipelined == true)
+    {
+        //Offsets still in flight from a pipelined download are no longer wanted
+        download_pipelined = false;
+        processor->abandon_group(SMP_GROUP_ID_FS);
+    }
+
     local_file_size = 0;
     file_upload_area = 0;
+    file_upload_acknowledged = 0;
+    upload_verify = false;
+    upload_verifying = false;
+    download_in_flight = 0;
+    download_requests.clear();
+    download_reorder.clear();
 
     if (upload_tmr.isValid())
     {
@@ -34,6 +34,9 @@
 #include <QCborMap>
 #include <QCborValue>
 #include <QFile>
+#include <QMap>
+#include "smp_file_writer.h"
+#include "smp_hash_checksum.h"
 
 /******************************************************************************/
 // Forward declaration of Class, Struct & Unions
@@ -56,7 +59,8 @@ public:
     void receive_ok(uint8_t version, uint8_t op, uint16_t group, uint8_t command, QByteArray data) override;
     void receive_error(uint8_t version, uint8_t op, uint16_t group, uint8_t command, smp_error_t error) override;
     void cancel() override;
-    bool start_upload(QString file_name, QString destination_name);
+    void timeout(smp_message *message) override;
+    bool start_upload(QString file_name, QString destination_name, QString verify_hash_checksum = QString());
     bool start_download(QString file_name, QString destination_name);
     bool start_status(QString file_name, uint32_t *file_size);
     bool start_hash_checksum(QString file_name, QString hash_checksum, QByteArray *result, uint32_t *file_size);
@@ -78,18 +82,47 @@ private:
     bool parse_supported_hashes_checksums_response(QCborStreamReader &reader, bool in_data, QString *key_name, hash_checksum_t *current_item);
 //    bool parse_file_close_response(QCborStreamReader &reader, int32_t *ret, QString *response);
     bool upload_chunk();
-    bool download_chunk();
+    bool start_upload_verify();
+    void upload_verify_result(QString type);
+    bool download_chunk(uint32_t offset);
+    bool download_pipeline_send();
+    void download_pipeline_response(uint32_t off, QByteArray *file_data);
+    void download_pipeline_write(QByteArray *file_data);
+    QString download_summary();
     void flip_endian(uint8_t *data, uint8_t size);
 
     //
     QFile local_file;
     uint32_t local_file_size;
     uint32_t file_upload_area;
+    uint32_t file_upload_acknowledged;
     QElapsedTimer upload_tmr;
     QString device_file_name;
     QList<hash_checksum_t> *hash_checksum_object;
     QByteArray *hash_checksum_result_object;
     uint32_t *file_size_object;
+    smp_hash_checksum upload_hash;
+    uint32_t upload_hashed;
+    bool upload_verify;
+    bool upload_verifying;
+    QByteArray upload_verify_hash;
+    uint32_t upload_verify_size;
+    QString upload_verify_response;
+    smp_file_writer *download_writer;
+    uint download_writer_id;
+    bool download_pipelined;
+    uint8_t download_window;
+    uint8_t download_in_flight;
+    uint8_t download_max_depth;
+    uint32_t download_requested;
+    uint32_t download_chunk_size;
+    uint32_t download_gaps;
+    int download_reorder_peak;
+    QMap<uint32_t, uint32_t> download_requests;
+    QMap<uint32_t, QByteArray> download_reorder;
+
+private slots:
+    void download_write_finished(uint id, bool success, QString error);
 };
 
 #endif // SMP_GROUP_FS_MGMT_H
@@ -25,8 +25,7 @@
 // Include Files
 /******************************************************************************/
 #include "smp_group_img_mgmt.h"
-#include <QFile>
-#include <QCryptographicHash>
+#include <QFileInfo>
 #include <cmath>
 #include "smp_message.h"
 
@@ -151,6 +150,13 @@ static const QStringList smp_error_values = QStringList() <<
 smp_group_img_mgmt::smp_group_img_mgmt(smp_processor *parent) : smp_group(parent, "IMG", SMP_GROUP_ID_IMG, error_lookup, error_define_lookup)
 {
     mode = MODE_IDLE;
+    upload_pipelined = false;
+    upload_draining = false;
+    upload_in_flight = 0;
+    file_upload_sent = 0;
+    resume_session_valid = false;
+
+    connect(&upload_source, SIGNAL(hash_ready(QByteArray)), this, SLOT(upload_hash_ready(QByteArray)));
 }
 
 bool smp_group_img_mgmt::extract_header(QByteArray *file_data, image_endian_t *endian)
@@ -831,12 +837,17 @@ void smp_group_img_mgmt::file_upload(QByteArray *message)
     if (message != nullptr)
     {
         bool match = false;
+        uint32_t previous_area = this->file_upload_area;
         QCborStreamReader cbor_reader(*message);
         good = parse_upload_response(cbor_reader, &off, &match);
 
     //    qDebug() << "rc = " << rc << ", off = " << off;
 
-        if (off != -1 /*&& rc != 9*/)
+        if (this->upload_pipelined == true)
+        {
+            file_upload_pipeline_response(off);
+        }
+        else if (off != -1 /*&& rc != 9*/)
         {
             if (off < this->file_upload_area)
             {
@@ -862,24 +873,36 @@ log_error() << "Going in circles...";
         }
         //    qDebug() << "good is " << good;
 
+        if (good == true && upload_tuning == true && this->file_upload_area > previous_area)
+        {
+            //Device has written more of the image, used to measure the throughput of the current chunk size
+            upload_tuner.chunk_acknowledged(this->file_upload_area - previous_area);
+        }
+
         if (this->file_upload_area != 0)
         {
-            emit progress(smp_user_data, this->file_upload_area * 100 / this->file_upload_data.length());
-            //progress_IMG_Complete->setValue(this->file_upload_area * 100 / this->file_upload_data.length());
+            emit progress(smp_user_data, this->file_upload_area * 100 / this->upload_source.size());
+            //progress_IMG_Complete->setValue(this->file_upload_area * 100 / this->upload_source.size());
         }
     }
 
     if (good == true)
     {
         //Upload next chunk
-        uint max_size = processor->max_message_data_size(smp_mtu);
+        uint32_t chunk_length;
 
-        if (this->file_upload_area >= (uint32_t)this->file_upload_data.length())
+        if (this->file_upload_area >= this->upload_source.size())
         {
             double upload_speed = NAN;
             uint8_t prefix = 0;
             QString speed_string;
 
+            if (this->upload_in_flight > 0)
+            {
+                //Wait for the responses to chunks which are still in flight
+                return;
+            }
+
             if (this->upload_tmr.isValid() == true)
             {
                 upload_speed = (double)(this->upload_tmr.elapsed() / 1000);
@@ -890,7 +913,7 @@ log_error() << "Going in circles...";
                     upload_speed = 1.0;
                 }
 
-                upload_speed = (double)this->file_upload_data.length() / upload_speed;
+                upload_speed = (double)this->upload_source.size() / upload_speed;
 
                 while (upload_speed >= 1024.0 && prefix < 3)
                 {
@@ -931,13 +954,33 @@ log_error() << "Going in circles...";
                 speed_string = "Upload finished";
             }
 
+            if (this->upload_pipelined == true)
+            {
+                //Report how deep the pipeline got and how often it had to be restarted
+                speed_string.append(QString(", window depth %1 of %2").arg(QString::number(this->upload_max_depth), QString::number(processor->window())));
+
+                if (this->upload_rewinds > 0)
+                {
+                    speed_string.append(QString(", %1 rewind%2").arg(QString::number(this->upload_rewinds), (this->upload_rewinds == 1 ? "" : "s")));
+                }
+            }
+
+            if (upload_tuning == true && upload_tuner.best_size() > 0)
+            {
+                speed_string.append(QString(", chunk size %1 bytes").arg(QString::number(upload_tuner.best_size())));
+            }
+
             mode = MODE_IDLE;
             this->upload_image = 0;
-            this->file_upload_data.clear();
+            this->upload_source.close();
             this->upload_tmr.invalidate();
             this->upload_hash.clear();
+            this->upload_session_hash.clear();
             this->file_upload_area = 0;
+            this->file_upload_sent = 0;
+            this->upload_chunk_ends.clear();
             this->upgrade_only = false;
+            clear_resume_session();
 //                emit plugin_set_status(false, false);
 //                lbl_IMG_Status->setText("Finished.");
             emit progress(smp_user_data, 100);
@@ -946,57 +989,162 @@ log_error() << "Going in circles...";
             return;
         }
 
-        smp_message *tmp_message = new smp_message();
-        tmp_message->start_message(SMP_OP_WRITE, smp_version, SMP_GROUP_ID_IMG, COMMAND_UPLOAD, 2 + (this->file_upload_area == 0 ? ((this->upload_image != 0 ? 1 : 0) + 2 + (this->upgrade_only == true ? 1 : 0)): 0));
+        if (this->upload_pipelined == false)
+        {
+            file_upload_send(this->file_upload_area, &chunk_length);
+            return;
+        }
 
-        if (this->file_upload_area == 0)
+        //Keep as many chunks in flight as the window allows, the first chunk is sent alone as the device may need to erase the slot before responding
+        while (this->upload_draining == false && this->file_upload_sent < this->upload_source.size() && processor->can_send() == true && this->upload_in_flight < this->upload_window)
         {
-            //Initial packet, extra data is needed: generate upload hash
-            QByteArray session_hash = QCryptographicHash::hash(this->file_upload_data, QCryptographicHash::Sha256);
+            bool first_chunk = (this->file_upload_sent == 0);
 
-            if (this->upload_image != 0)
+            if (file_upload_send(this->file_upload_sent, &chunk_length) == false)
             {
-                tmp_message->writer()->append("image");
-                tmp_message->writer()->append(this->upload_image);
+                return;
             }
 
-            tmp_message->writer()->append("len");
-            tmp_message->writer()->append(this->file_upload_data.length());
-            tmp_message->writer()->append("sha");
-            tmp_message->writer()->append(session_hash);
+            this->file_upload_sent += chunk_length;
+            this->upload_chunk_ends.append(this->file_upload_sent);
+            ++this->upload_in_flight;
 
-            if (this->upgrade_only == true)
+            if (this->upload_in_flight > this->upload_max_depth)
             {
-                tmp_message->writer()->append("upgrade");
-                tmp_message->writer()->append(true);
+                this->upload_max_depth = this->upload_in_flight;
             }
+
+            if (first_chunk == true)
+            {
+                break;
+            }
+        }
+    }
+    else
+    {
+        cleanup();
+    }
+}
+
+bool smp_group_img_mgmt::file_upload_send(uint32_t offset, uint32_t *length)
+{
+    //Sends the chunk of the image starting at the supplied offset, returns false if the upload has been aborted
+    uint max_size = upload_chunk_message_size();
+    smp_message *tmp_message = transfer_message();
+    tmp_message->start_message(SMP_OP_WRITE, smp_version, SMP_GROUP_ID_IMG, COMMAND_UPLOAD, 2 + (offset == 0 ? ((this->upload_image != 0 ? 1 : 0) + 2 + (this->upgrade_only == true ? 1 : 0)): 0));
+
+    if (offset == 0)
+    {
+        //Initial packet, extra data is needed: upload hash (calculated before the upload was started)
+        if (this->upload_image != 0)
+        {
+            tmp_message->writer()->append("image");
+            tmp_message->writer()->append(this->upload_image);
         }
 
-        tmp_message->writer()->append("off");
-        tmp_message->writer()->append(this->file_upload_area);
-        tmp_message->writer()->append("data");
+        tmp_message->writer()->append("len");
+        tmp_message->writer()->append(this->upload_source.size());
+        tmp_message->writer()->append("sha");
+        tmp_message->writer()->append(this->upload_session_hash);
 
-        //CBOR element header is 2 bytes with 1 byte end token for byte string data, have to include 1 byte header and 4 bytes data for 'data' element too
-        max_size = max_size - tmp_message->size() - 3 - 5;
+        if (this->upgrade_only == true)
+        {
+            tmp_message->writer()->append("upgrade");
+            tmp_message->writer()->append(true);
+        }
+    }
 
-        tmp_message->writer()->append(this->file_upload_data.mid(this->file_upload_area, max_size));
+    tmp_message->writer()->append("off");
+    tmp_message->writer()->append(offset);
+    tmp_message->writer()->append("data");
 
-        //	    qDebug() << "off: " << this->file_upload_area << ", left: " << this->file_upload_data.length();
+    //CBOR element header is 2 bytes with 1 byte end token for byte string data, have to include 1 byte header and 4 bytes data for 'data' element too
+    max_size = max_size - tmp_message->size() - 3 - 5;
 
-        tmp_message->end_message();
+    //View of the mapped file, only copied when added to the message
+    QByteArray chunk = this->upload_source.chunk(offset, max_size);
+    *length = chunk.length();
+    tmp_message->writer()->append(chunk);
 
-        //      qDebug() << "len: " << tmp_message->data()->length();
+    //	    qDebug() << "off: " << offset << ", left: " << this->upload_source.size();
 
-        if (check_message_before_send(tmp_message) == false)
+    tmp_message->end_message();
+
+    //      qDebug() << "len: " << tmp_message->data()->length();
+
+    if (check_message_before_send(tmp_message) == false)
+    {
+        return false;
+    }
+
+    //The first chunk may require the slot to be erased so its response time is estimated separately
+    return handle_transport_error(processor->send(tmp_message, (offset == 0 ? upload_initial_timeout : smp_timeout), smp_retries, (offset == 0 ? true : false), (offset == 0 ? SMP_RTT_CLASS_ERASE : SMP_RTT_CLASS_NORMAL)));
+}
+
+void smp_group_img_mgmt::file_upload_pipeline_response(int64_t off)
+{
+    //Updates the pipelined upload state from an offset response, which may be for any in-flight chunk
+    int index;
+
+    if (this->upload_in_flight > 0)
+    {
+        --this->upload_in_flight;
+    }
+
+    if (off == -1)
+    {
+        return;
+    }
+
+    index = this->upload_chunk_ends.indexOf((uint32_t)off);
+
+    if (index != -1)
+    {
+        //Chunk was written, responses can arrive in any order so only this chunk is removed
+        this->upload_chunk_ends.removeAt(index);
+    }
+    else if (off < this->file_upload_sent && this->upload_draining == false)
+    {
+        //Device is expecting an earlier offset (a chunk was lost or arrived out of order), the remaining in-flight
+        //chunks will be rejected so stop sending until all their responses have arrived then resume from the device offset
+        this->upload_draining = true;
+        this->upload_chunk_ends.clear();
+        ++this->upload_rewinds;
+
+        if (off == this->upload_rewind_offset)
         {
-            return;
+            ++upload_repeated_parts;
+
+            if (upload_repeated_parts > 3 && this->upload_window > 1)
+            {
+                //Repeatedly rewinding to the same offset, fall back to one chunk at a time
+                log_error() << "Upload rewound to offset " << off << " repeatedly, disabling pipelining";
+                this->upload_window = 1;
+            }
         }
+        else
+        {
+            this->upload_rewind_offset = off;
+            upload_repeated_parts = 1;
+        }
+    }
 
-        handle_transport_error(processor->send(tmp_message, (this->file_upload_area == 0 ? upload_initial_timeout : smp_timeout), smp_retries, (this->file_upload_area == 0 ? true : false)));
+    if (this->upload_draining == true || off > this->file_upload_area)
+    {
+        this->file_upload_area = off;
     }
-    else
+
+    if (this->upload_draining == true && this->upload_in_flight == 0)
     {
-        cleanup();
+        //All in-flight chunks are accounted for, resume from where the device is
+        this->upload_draining = false;
+        this->file_upload_sent = this->file_upload_area;
+    }
+    else if (this->file_upload_area > this->file_upload_sent)
+    {
+        //Device is ahead of what has been sent (e.g. resumed upload)
+        this->upload_chunk_ends.clear();
+        this->file_upload_sent = this->file_upload_area;
     }
 }
 
@@ -1133,6 +1281,20 @@ void smp_group_img_mgmt::receive_error(uint8_t version, uint8_t op, uint16_t gro
     }
     else if (command == COMMAND_UPLOAD && mode == MODE_UPLOAD_FIRMWARE)
     {
+        if (upload_tuning == true && chunk_size_error(error) == true && upload_tuner.back_off(true) == true)
+        {
+            log_error() << "Upload chunk rejected by device, reducing chunk size to " << upload_tuner.chunk_size();
+
+            if (this->upload_pipelined == false)
+            {
+                //Send the rejected chunk again at the smaller size
+                uint32_t chunk_length;
+
+                file_upload_send(this->file_upload_area, &chunk_length);
+                return;
+            }
+        }
+
         //TODO
         emit status(smp_user_data, status_error_return(error), smp_error::error_lookup_string(&error));
     }
@@ -1158,6 +1320,17 @@ void smp_group_img_mgmt::receive_error(uint8_t version, uint8_t op, uint16_t gro
     }
 }
 
+void smp_group_img_mgmt::timeout(smp_message *message)
+{
+    if (mode == MODE_UPLOAD_FIRMWARE && upload_tuning == true && this->file_upload_area > 0 && upload_tuner.back_off(false) == true)
+    {
+        //The first chunk is excluded as it may time out whilst the slot is being erased, a resumed upload will use the smaller size
+        log_error() << "Upload timed out, reducing chunk size to " << upload_tuner.chunk_size();
+    }
+
+    smp_group::timeout(message);
+}
+
 void smp_group_img_mgmt::cancel()
 {
     if (mode != MODE_IDLE)
@@ -1221,53 +1394,176 @@ bool smp_group_img_mgmt::start_image_set(QByteArray *hash, bool confirm, QList<i
 //    lbl_IMG_Status->setText(QString("Marking image ").append(radio_IMG_Test->isChecked() ? "for test." : "as confirmed."));
 }
 
-bool smp_group_img_mgmt::start_firmware_update(uint8_t image, QString filename, bool upgrade, QByteArray *image_hash, uint32_t first_packet_timeout)
+bool smp_group_img_mgmt::start_upload(uint8_t image, QString filename, bool upgrade, QByteArray *image_hash, uint32_t first_packet_timeout, const QByteArray *session_hash)
 {
     //Upload
-    QFile file(filename);
+    QByteArray file_data;
 
-    if (!file.open(QFile::ReadOnly))
+    if (this->upload_source.open(filename) == false)
     {
         emit status(smp_user_data, STATUS_ERROR, "File open failed");
         return false;
     }
 
-    this->file_upload_data.clear();
-    this->file_upload_data.append(file.readAll());
+    //The MCUboot header and TLVs are read directly from the mapped file
+    file_data = this->upload_source.contents();
 
-    file.close();
-
-    if (extract_header(&this->file_upload_data, &upload_endian) == false)
+    if (extract_header(&file_data, &upload_endian) == false)
     {
-        this->file_upload_data.clear();
+        this->upload_source.close();
         emit status(smp_user_data, STATUS_ERROR, "MCUboot header was not found");
         return false;
     }
-    else if (extract_hash(&this->file_upload_data, &this->upload_hash) == false)
+    else if (extract_hash(&file_data, &this->upload_hash) == false)
     {
-        this->file_upload_data.clear();
+        this->upload_source.close();
         emit status(smp_user_data, STATUS_ERROR, "Hash was not found");
         return false;
     }
 
-    //Send start
+    //Set up upload, the first chunk is sent once the session hash of the file is known
     mode = MODE_UPLOAD_FIRMWARE;
+    this->upload_file_name = filename;
+    this->upload_file_modified = QFileInfo(filename).lastModified();
     this->upload_image = image;
     this->file_upload_area = 0;
     this->upgrade_only = upgrade;
     this->upload_tmr.start();
     this->upload_initial_timeout = first_packet_timeout;
-
-    file_upload(nullptr);
+    this->file_upload_sent = 0;
+    this->upload_chunk_ends.clear();
+    this->upload_draining = false;
+    this->upload_in_flight = 0;
+    this->upload_window = processor->window();
+    this->upload_pipelined = (this->upload_window > 1);
+    this->upload_max_depth = 0;
+    this->upload_rewind_offset = 0;
+    this->upload_rewinds = 0;
+    this->upload_repeated_parts = 0;
+    this->upload_session_hash.clear();
+    start_upload_chunk_tuning();
 
     if (image_hash != nullptr)
     {
         *image_hash = this->upload_hash;
     }
 
+    if (session_hash != nullptr)
+    {
+        //Resuming, the first chunk is a probe: if the session hash matches the device's upload it responds with the offset it has reached instead of restarting
+        this->upload_session_hash = *session_hash;
+        file_upload(nullptr);
+    }
+    else
+    {
+        this->upload_source.start_hash();
+    }
+
+    return true;
+}
+
+bool smp_group_img_mgmt::check_firmware_file(QString filename, QString *error)
+{
+    //Checks that a file is an MCUboot image without starting an upload, so that an invalid file is reported before anything is sent
+    smp_image_source source;
+    QByteArray file_data;
+    QByteArray hash;
+    image_endian_t previous_endian = upload_endian;
+
+    error->clear();
+
+    if (source.open(filename) == false)
+    {
+        *error = "File open failed";
+        return false;
+    }
+
+    file_data = source.contents();
+
+    if (extract_header(&file_data, &upload_endian) == false)
+    {
+        *error = "MCUboot header was not found";
+    }
+    else if (extract_hash(&file_data, &hash) == false)
+    {
+        *error = "Hash was not found";
+    }
+
+    source.close();
+    upload_endian = previous_endian;
+
+    return error->isEmpty();
+}
+
+bool smp_group_img_mgmt::start_firmware_update(uint8_t image, QString filename, bool upgrade, QByteArray *image_hash, uint32_t first_packet_timeout)
+{
+    clear_resume_session();
+
+    return start_upload(image, filename, upgrade, image_hash, first_packet_timeout, nullptr);
+}
+
+bool smp_group_img_mgmt::resume_firmware_update(QByteArray *image_hash, uint32_t first_packet_timeout)
+{
+    img_upload_session_t session;
+    QFileInfo file_info;
+
+    if (resume_session_valid == false)
+    {
+        emit status(smp_user_data, STATUS_ERROR, "No interrupted upload to resume");
+        return false;
+    }
+
+    //Only resume if the file is the one which was being uploaded
+    session = resume_session;
+    file_info.setFile(session.file_name);
+
+    if (file_info.exists() == false || file_info.size() != session.file_size || file_info.lastModified() != session.file_modified)
+    {
+        clear_resume_session();
+        emit status(smp_user_data, STATUS_ERROR, "File has changed since the upload was interrupted");
+        return false;
+    }
+
+    log_debug() << "Resuming upload of " << session.file_name << ", interrupted at offset " << session.offset;
+
+    return start_upload(session.image, session.file_name, session.upgrade, image_hash, first_packet_timeout, &session.session_hash);
+}
+
+bool smp_group_img_mgmt::get_resume_session(img_upload_session_t *session)
+{
+    if (resume_session_valid == false)
+    {
+        return false;
+    }
+
+    *session = resume_session;
+
     return true;
 }
 
+void smp_group_img_mgmt::set_resume_session(const img_upload_session_t *session)
+{
+    resume_session = *session;
+    resume_session_valid = true;
+}
+
+void smp_group_img_mgmt::clear_resume_session()
+{
+    resume_session_valid = false;
+    resume_session.session_hash.clear();
+}
+
+void smp_group_img_mgmt::upload_hash_ready(QByteArray hash)
+{
+    if (mode != MODE_UPLOAD_FIRMWARE)
+    {
+        return;
+    }
+
+    this->upload_session_hash = hash;
+    file_upload(nullptr);
+}
+
 bool smp_group_img_mgmt::start_firmware_update(uint8_t image, QString filename, bool upgrade, QByteArray *image_hash)
 {
     return start_firmware_update(image, filename, upgrade, image_hash, smp_timeout);
@@ -1382,9 +1678,23 @@ bool smp_group_img_mgmt::error_define_lookup(int32_t rc, QString *error)
 
 void smp_group_img_mgmt::cleanup()
 {
+    if (mode == MODE_UPLOAD_FIRMWARE && upload_session_hash.isEmpty() == false && file_upload_area > 0 && file_upload_area < upload_source.size())
+    {
+        //Upload was interrupted part way through, keep the details so that it can be resumed
+        resume_session.file_name = upload_file_name;
+        resume_session.file_size = upload_source.size();
+        resume_session.file_modified = upload_file_modified;
+        resume_session.session_hash = upload_session_hash;
+        resume_session.image = upload_image;
+        resume_session.upgrade = upgrade_only;
+        resume_session.offset = file_upload_area;
+        resume_session_valid = true;
+    }
+
     mode = MODE_IDLE;
     upload_image = 0;
-    file_upload_data.clear();
+    upload_source.close();
+    upload_session_hash.clear();
     file_upload_area = 0;
 
     if (upload_tmr.isValid())
@@ -1396,8 +1706,16 @@ void smp_group_img_mgmt::cleanup()
     upload_endian = ENDIAN_UNKNOWN;
     upgrade_only = false;
     upload_repeated_parts = 0;
+    upload_pipelined = false;
+    upload_draining = false;
+    upload_in_flight = 0;
+    file_upload_sent = 0;
+    upload_chunk_ends.clear();
     host_images = nullptr;
     host_slots = nullptr;
+
+    //Chunks still in flight from a pipelined upload are no longer wanted
+    processor->abandon_group(SMP_GROUP_ID_IMG);
     processor->cancel();
 }
 
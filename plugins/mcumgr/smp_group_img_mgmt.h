@@ -28,11 +28,13 @@
 /******************************************************************************/
 #include "smp_group.h"
 #include "smp_error.h"
+#include "smp_image_source.h"
 #include <QCborStreamReader>
 #include <QCborStreamWriter>
 #include <QCborArray>
 #include <QCborMap>
 #include <QCborValue>
+#include <QDateTime>
 
 /******************************************************************************/
 // Forward declaration of Class, Struct & Unions
@@ -70,6 +72,17 @@ struct slot_info_t {
     bool max_image_size_present;
 };
 
+//Interrupted firmware upload which can be resumed, the device keeps its upload state if the same session hash is provided
+struct img_upload_session_t {
+    QString file_name;
+    qint64 file_size;
+    QDateTime file_modified;
+    QByteArray session_hash;
+    uint8_t image;
+    bool upgrade;
+    uint32_t offset;
+};
+
 /******************************************************************************/
 // Enum typedefs
 /******************************************************************************/
@@ -92,10 +105,16 @@ public:
     void receive_ok(uint8_t version, uint8_t op, uint16_t group, uint8_t command, QByteArray data) override;
     void receive_error(uint8_t version, uint8_t op, uint16_t group, uint8_t command, smp_error_t error) override;
     void cancel() override;
+    void timeout(smp_message *message) override;
     bool start_image_get(QList<image_state_t> *images);
     bool start_image_set(QByteArray *hash, bool confirm, QList<image_state_t> *images);
     bool start_firmware_update(uint8_t image, QString filename, bool upgrade, QByteArray *image_hash);
     bool start_firmware_update(uint8_t image, QString filename, bool upgrade, QByteArray *image_hash, uint32_t first_packet_timeout);
+    bool resume_firmware_update(QByteArray *image_hash, uint32_t first_packet_timeout);
+    bool get_resume_session(img_upload_session_t *session);
+    bool check_firmware_file(QString filename, QString *error);
+    void set_resume_session(const img_upload_session_t *session);
+    void clear_resume_session();
     bool start_image_erase(uint8_t slot);
     bool start_image_slot_info(QList<slot_info_t> *images);
 
@@ -107,6 +126,9 @@ protected:
 signals:
     void plugin_to_hex(QByteArray *data);
 
+private slots:
+    void upload_hash_ready(QByteArray hash);
+
 private:
     static bool error_lookup(int32_t rc, QString *error);
     static bool error_define_lookup(int32_t rc, QString *error);
@@ -115,11 +137,19 @@ private:
     bool parse_upload_response(QCborStreamReader &reader, int64_t *new_off, bool *match);
     bool parse_state_response(QCborStreamReader &reader, QString array_name);
     bool parse_slot_info_response(QCborStreamReader &reader, QList<slot_info_t> *images, struct slot_info_t *image_data, struct slot_info_slots_t *slot_data);
+    bool start_upload(uint8_t image, QString filename, bool upgrade, QByteArray *image_hash, uint32_t first_packet_timeout, const QByteArray *session_hash);
     void file_upload(QByteArray *message);
+    bool file_upload_send(uint32_t offset, uint32_t *length);
+    void file_upload_pipeline_response(int64_t off);
 
     //
     uint8_t upload_image;
-    QByteArray file_upload_data;
+    smp_image_source upload_source;
+    QByteArray upload_session_hash;
+    QString upload_file_name;
+    QDateTime upload_file_modified;
+    img_upload_session_t resume_session;
+    bool resume_session_valid;
     uint32_t file_upload_area;
     QElapsedTimer upload_tmr;
     QByteArray upload_hash;
@@ -127,6 +157,15 @@ private:
     bool upgrade_only;
     uint8_t upload_repeated_parts;
     uint32_t upload_initial_timeout;
+    bool upload_pipelined;
+    bool upload_draining;
+    uint8_t upload_window;
+    uint8_t upload_in_flight;
+    uint8_t upload_max_depth;
+    uint32_t file_upload_sent;
+    uint32_t upload_rewind_offset;
+    uint32_t upload_rewinds;
+    QList<uint32_t> upload_chunk_ends;
     QList<image_state_t> *host_images;
     QList<slot_info_t> *host_slots;
     image_state_t image_state_buffer;
@@ -0,0 +1,106 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_hash_checksum.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_hash_checksum.h"
+#include "crc32.h"
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_hash_checksum::smp_hash_checksum() : sha256(QCryptographicHash::Sha256)
+{
+    crc = 0;
+    data_size = 0;
+}
+
+bool smp_hash_checksum::is_supported(QString type)
+{
+    return (type == "sha256" || type == "crc32");
+}
+
+bool smp_hash_checksum::start(QString type)
+{
+    if (is_supported(type) == false)
+    {
+        hash_type.clear();
+        return false;
+    }
+
+    hash_type = type;
+    sha256.reset();
+    crc = 0;
+    data_size = 0;
+
+    return true;
+}
+
+void smp_hash_checksum::add_data(const QByteArray &data)
+{
+    if (hash_type == "sha256")
+    {
+        sha256.addData(data);
+    }
+    else if (hash_type == "crc32")
+    {
+        crc = crc32_ieee_update(crc, (const uint8_t *)data.constData(), data.length());
+    }
+
+    data_size += data.length();
+}
+
+QByteArray smp_hash_checksum::result()
+{
+    //crc32 is big endian, as returned by fs_mgmt
+    QByteArray output;
+
+    if (hash_type == "sha256")
+    {
+        output = sha256.result();
+    }
+    else if (hash_type == "crc32")
+    {
+        output.append((char)(crc >> 24));
+        output.append((char)(crc >> 16));
+        output.append((char)(crc >> 8));
+        output.append((char)crc);
+    }
+
+    return output;
+}
+
+QString smp_hash_checksum::type()
+{
+    return hash_type;
+}
+
+uint64_t smp_hash_checksum::size()
+{
+    return data_size;
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
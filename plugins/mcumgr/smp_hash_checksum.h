@@ -0,0 +1,60 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_hash_checksum.h
+**
+** Notes:   Incremental local calculation of the hashes/checksums which
+**          fs_mgmt can return, in the same output format as the device
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_HASH_CHECKSUM_H
+#define SMP_HASH_CHECKSUM_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <stdint.h>
+#include <QString>
+#include <QByteArray>
+#include <QCryptographicHash>
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_hash_checksum
+{
+public:
+    smp_hash_checksum();
+    static bool is_supported(QString type);
+    bool start(QString type);
+    void add_data(const QByteArray &data);
+    QByteArray result();
+    QString type();
+    uint64_t size();
+
+private:
+    QString hash_type;
+    QCryptographicHash sha256;
+    uint32_t crc;
+    uint64_t data_size;
+};
+
+#endif // SMP_HASH_CHECKSUM_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,232 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_image_source.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_image_source.h"
+#include <QCryptographicHash>
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+//Size of each block passed to the hash function, interruption is checked between blocks
+static const qint64 hash_block_size = 256 * 1024;
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_image_hash_thread::smp_image_hash_thread(const uchar *data, qint64 size, uint id)
+{
+    hash_data = data;
+    hash_size = size;
+    hash_id = id;
+}
+
+void smp_image_hash_thread::run()
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    qint64 pos = 0;
+
+    while (pos < hash_size)
+    {
+        qint64 length = hash_size - pos;
+
+        if (isInterruptionRequested() == true)
+        {
+            return;
+        }
+
+        if (length > hash_block_size)
+        {
+            length = hash_block_size;
+        }
+
+        hash.addData(QByteArray::fromRawData((const char *)hash_data + pos, (int)length));
+        pos += length;
+    }
+
+    emit hash_finished(hash_id, hash.result());
+}
+
+smp_image_source::smp_image_source(QObject *parent) : QObject(parent)
+{
+    mapped_data = nullptr;
+    image_data = nullptr;
+    image_size = 0;
+    hash_thread = nullptr;
+    hash_id = 0;
+}
+
+smp_image_source::~smp_image_source()
+{
+    close();
+}
+
+bool smp_image_source::open(QString filename)
+{
+    close();
+    file.setFileName(filename);
+
+    if (!file.open(QFile::ReadOnly))
+    {
+        return false;
+    }
+
+    image_size = file.size();
+
+    if (image_size <= 0 || image_size >= INT32_MAX)
+    {
+        file.close();
+        image_size = 0;
+        return false;
+    }
+
+    mapped_data = file.map(0, image_size);
+
+    if (mapped_data != nullptr)
+    {
+        image_data = mapped_data;
+    }
+    else
+    {
+        //Mapping is not supported for all files (e.g. some network or virtual filesystems), fall back to reading it
+        read_data = file.readAll();
+        file.close();
+
+        if (read_data.length() != image_size)
+        {
+            read_data.clear();
+            image_size = 0;
+            return false;
+        }
+
+        image_data = (const uchar *)read_data.constData();
+    }
+
+    return true;
+}
+
+void smp_image_source::close()
+{
+    stop_hash();
+
+    if (mapped_data != nullptr)
+    {
+        file.unmap(mapped_data);
+        mapped_data = nullptr;
+    }
+
+    if (file.isOpen())
+    {
+        file.close();
+    }
+
+    read_data.clear();
+    image_data = nullptr;
+    image_size = 0;
+}
+
+bool smp_image_source::is_open()
+{
+    return (image_data != nullptr);
+}
+
+uint32_t smp_image_source::size()
+{
+    return (uint32_t)image_size;
+}
+
+QByteArray smp_image_source::contents()
+{
+    //View of the whole file, only valid until the source is closed
+    if (image_data == nullptr)
+    {
+        return QByteArray();
+    }
+
+    return QByteArray::fromRawData((const char *)image_data, (int)image_size);
+}
+
+QByteArray smp_image_source::chunk(uint32_t offset, uint32_t length)
+{
+    //View of part of the file, only valid until the source is closed
+    if (image_data == nullptr || offset >= image_size)
+    {
+        return QByteArray();
+    }
+
+    if (length > (image_size - offset))
+    {
+        length = image_size - offset;
+    }
+
+    return QByteArray::fromRawData((const char *)image_data + offset, length);
+}
+
+void smp_image_source::start_hash()
+{
+    //Calculates the SHA-256 of the whole file in a worker thread, hash_ready() is emitted when done
+    stop_hash();
+
+    if (image_data == nullptr)
+    {
+        return;
+    }
+
+    ++hash_id;
+    hash_thread = new smp_image_hash_thread(image_data, image_size, hash_id);
+    connect(hash_thread, SIGNAL(hash_finished(uint,QByteArray)), this, SLOT(hash_thread_finished(uint,QByteArray)));
+    hash_thread->start();
+}
+
+void smp_image_source::stop_hash()
+{
+    //The worker must have finished before the data it is reading can be released
+    if (hash_thread != nullptr)
+    {
+        hash_thread->requestInterruption();
+        hash_thread->wait();
+        delete hash_thread;
+        hash_thread = nullptr;
+    }
+}
+
+void smp_image_source::hash_thread_finished(uint id, QByteArray hash)
+{
+    //Results from a hash which has since been stopped or restarted are discarded
+    if (hash_thread == nullptr || id != hash_id)
+    {
+        return;
+    }
+
+    hash_thread->wait();
+    delete hash_thread;
+    hash_thread = nullptr;
+
+    emit hash_ready(hash);
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
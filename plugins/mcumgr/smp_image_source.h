@@ -0,0 +1,92 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_image_source.h
+**
+** Notes:   Read-only file source for uploads, memory mapped where possible so
+**          chunks can be served without copying the file
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_IMAGE_SOURCE_H
+#define SMP_IMAGE_SOURCE_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QObject>
+#include <QFile>
+#include <QThread>
+#include <QByteArray>
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_image_hash_thread : public QThread
+{
+    Q_OBJECT
+
+public:
+    smp_image_hash_thread(const uchar *data, qint64 size, uint id);
+    void run() override;
+
+signals:
+    void hash_finished(uint id, QByteArray hash);
+
+private:
+    const uchar *hash_data;
+    qint64 hash_size;
+    uint hash_id;
+};
+
+class smp_image_source : public QObject
+{
+    Q_OBJECT
+
+public:
+    smp_image_source(QObject *parent = nullptr);
+    ~smp_image_source();
+    bool open(QString filename);
+    void close();
+    bool is_open();
+    uint32_t size();
+    QByteArray contents();
+    QByteArray chunk(uint32_t offset, uint32_t length);
+    void start_hash();
+
+signals:
+    void hash_ready(QByteArray hash);
+
+private slots:
+    void hash_thread_finished(uint id, QByteArray hash);
+
+private:
+    void stop_hash();
+
+    QFile file;
+    uchar *mapped_data;
+    QByteArray read_data;
+    const uchar *image_data;
+    qint64 image_size;
+    smp_image_hash_thread *hash_thread;
+    uint hash_id;
+};
+
+#endif // SMP_IMAGE_SOURCE_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
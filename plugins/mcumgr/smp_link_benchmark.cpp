@@ -0,0 +1,407 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_link_benchmark.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_link_benchmark.h"
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+//SMP header, map header and "d"/"r" key of an echo request/response, excluding the text header
+static const uint16_t echo_fixed_size = 8 + 1 + 2;
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_link_benchmark::smp_link_benchmark(smp_group_os_mgmt *os_group, QObject *parent) : QObject(parent)
+{
+    os_mgmt = os_group;
+    running = false;
+    benchmark_user_data = 0;
+    max_size = 0;
+    iterations_per_size = 0;
+    sent = 0;
+    total = 0;
+
+    connect(os_mgmt, SIGNAL(status(uint8_t,group_status,QString)), this, SLOT(group_finished(uint8_t,group_status,QString)));
+}
+
+smp_link_benchmark::~smp_link_benchmark()
+{
+    disconnect(this, SLOT(group_finished(uint8_t,group_status,QString)));
+}
+
+bool smp_link_benchmark::start(QString link_name, uint16_t max_message_size, uint8_t sizes, uint16_t iterations, uint8_t user_data, QString *error)
+{
+    uint16_t max_payload = 0;
+    uint8_t i = 0;
+
+    if (running == true)
+    {
+        *error = "Benchmark already in progress";
+        return false;
+    }
+
+    if (sizes == 0 || iterations == 0)
+    {
+        *error = "At least one size and one iteration is required";
+        return false;
+    }
+
+    if (max_message_size > echo_message_size(1))
+    {
+        max_payload = max_message_size - echo_fixed_size - 1;
+
+        while (max_payload > 0 && echo_message_size(max_payload) > max_message_size)
+        {
+            --max_payload;
+        }
+    }
+
+    if (max_payload == 0)
+    {
+        *error = QString("Maximum message size (%1 bytes) is too small for an echo").arg(QString::number(max_message_size));
+        return false;
+    }
+
+    link = link_name;
+    max_size = max_message_size;
+    iterations_per_size = iterations;
+    benchmark_user_data = user_data;
+    size_results.clear();
+
+    if (sizes > max_payload)
+    {
+        sizes = (uint8_t)max_payload;
+    }
+
+    //Sizes are spread evenly up to the largest payload, which gives the latency fit an even spread of points
+    while (i < sizes)
+    {
+        smp_link_benchmark_size_t size;
+
+        size.payload = (sizes == 1 ? max_payload : (uint16_t)(1 + ((uint32_t)(max_payload - 1) * i) / (sizes - 1)));
+        size.message_bytes = echo_message_size(size.payload) * 2;
+        size.failures = 0;
+
+        if (size_results.isEmpty() == true || size_results.last().payload != size.payload)
+        {
+            size_results.append(size);
+        }
+
+        ++i;
+    }
+
+    total = (uint32_t)size_results.length() * iterations_per_size;
+    sent = -1;
+    running = true;
+
+    QTimer::singleShot(0, this, SLOT(begin()));
+
+    return true;
+}
+
+void smp_link_benchmark::begin()
+{
+    if (running == true)
+    {
+        send_next();
+    }
+}
+
+void smp_link_benchmark::cancel()
+{
+    if (running == false)
+    {
+        return;
+    }
+
+    //Statuses from the echo being cancelled are ignored once idle
+    running = false;
+    os_mgmt->cancel();
+    emit finished(false, "Cancelled");
+}
+
+bool smp_link_benchmark::is_busy()
+{
+    return running;
+}
+
+const QList<smp_link_benchmark_size_t> &smp_link_benchmark::results()
+{
+    return size_results;
+}
+
+uint16_t smp_link_benchmark::echo_message_size(uint16_t payload)
+{
+    //CBOR text string header is 1 byte for lengths under 24, then 2 bytes up to 255 and 3 bytes above
+    return echo_fixed_size + (payload < 24 ? 1 : (payload < 256 ? 2 : 3)) + payload;
+}
+
+void smp_link_benchmark::send_next()
+{
+    //Sizes are interleaved so that changes in link conditions during the run affect all sizes equally
+    const smp_link_benchmark_size_t *size = &size_results.at(sent < 0 ? 0 : (sent % size_results.length()));
+    uint16_t i = 0;
+
+    payload.resize(size->payload);
+
+    while (i < size->payload)
+    {
+        payload[i] = QChar('a' + ((i + sent + 1) % 26));
+        ++i;
+    }
+
+    //Failures to send are reported through the status signal
+    timer.start();
+    os_mgmt->start_echo(payload);
+}
+
+void smp_link_benchmark::group_finished(uint8_t user_data, group_status status, QString error_string)
+{
+    double latency;
+
+    if (user_data != benchmark_user_data || running == false)
+    {
+        return;
+    }
+
+    latency = (double)timer.nsecsElapsed() / 1000000.0;
+
+    if (sent < 0)
+    {
+        //Warm up echo, not included in the results as it can include transport start up time
+        if (status != STATUS_COMPLETE)
+        {
+            finish(false, QString("Warm up echo failed: ").append(error_string));
+            return;
+        }
+    }
+    else if (status == STATUS_COMPLETE || status == STATUS_TIMEOUT)
+    {
+        smp_link_benchmark_size_t *size = &size_results[sent % size_results.length()];
+
+        if (status == STATUS_COMPLETE && error_string == payload)
+        {
+            size->latencies.append(latency);
+        }
+        else
+        {
+            ++size->failures;
+        }
+    }
+    else
+    {
+        finish(false, error_string);
+        return;
+    }
+
+    ++sent;
+
+    if ((uint32_t)sent >= total)
+    {
+        finish(true, QString());
+        return;
+    }
+
+    emit progress((uint8_t)(((uint32_t)sent * 100) / total));
+    send_next();
+}
+
+void smp_link_benchmark::finish(bool success, QString error)
+{
+    smp_link_benchmark_fit_t model;
+    QString summary;
+
+    running = false;
+
+    if (success == true)
+    {
+        model = fit();
+        summary = "Benchmark complete";
+
+        if (model.valid == true)
+        {
+            summary.append(QString(", %1 ms per message + %2 ms per byte").arg(QString::number(model.overhead_ms, 'f', 2), QString::number(model.ms_per_byte, 'f', 4)));
+        }
+
+        emit progress(100);
+    }
+    else
+    {
+        summary = error.append(QString(", %1 of %2 echoes completed").arg(QString::number(sent < 0 ? 0 : sent), QString::number(total)));
+    }
+
+    emit finished(success, summary);
+}
+
+smp_link_benchmark_fit_t smp_link_benchmark::fit()
+{
+    //Least squares fit of latency against the number of SMP bytes sent and received
+    smp_link_benchmark_fit_t model;
+    double sum_x = 0.0;
+    double sum_y = 0.0;
+    double sum_xx = 0.0;
+    double sum_xy = 0.0;
+    double denominator;
+    double mean_y;
+    double residual = 0.0;
+    double variance = 0.0;
+    uint32_t samples = 0;
+
+    model.valid = false;
+    model.overhead_ms = 0.0;
+    model.ms_per_byte = 0.0;
+    model.r_squared = 0.0;
+
+    for (const smp_link_benchmark_size_t &size : size_results)
+    {
+        for (double latency : size.latencies)
+        {
+            sum_x += size.message_bytes;
+            sum_y += latency;
+            sum_xx += (double)size.message_bytes * size.message_bytes;
+            sum_xy += size.message_bytes * latency;
+            ++samples;
+        }
+    }
+
+    denominator = samples * sum_xx - sum_x * sum_x;
+
+    if (samples < 2 || denominator == 0.0)
+    {
+        return model;
+    }
+
+    model.ms_per_byte = (samples * sum_xy - sum_x * sum_y) / denominator;
+    model.overhead_ms = (sum_y - model.ms_per_byte * sum_x) / samples;
+    mean_y = sum_y / samples;
+
+    for (const smp_link_benchmark_size_t &size : size_results)
+    {
+        for (double latency : size.latencies)
+        {
+            double predicted = model.overhead_ms + model.ms_per_byte * size.message_bytes;
+
+            residual += (latency - predicted) * (latency - predicted);
+            variance += (latency - mean_y) * (latency - mean_y);
+        }
+    }
+
+    model.r_squared = (variance > 0.0 ? 1.0 - residual / variance : 1.0);
+    model.valid = true;
+
+    return model;
+}
+
+QString smp_link_benchmark::report()
+{
+    smp_link_benchmark_fit_t model = fit();
+    QString output;
+
+    output = QString("Link benchmark: %1, maximum message size %2 bytes, %3 iteration%4 per size\n\n").arg(link, QString::number(max_size), QString::number(iterations_per_size), (iterations_per_size == 1 ? "" : "s"));
+    output.append(QString("%1 %2 %3 %4 %5 %6 %7 %8 %9 %10\n").arg("Payload", 8).arg("SMP B", 7).arg("OK/Fail", 9).arg("Min ms", 8).arg("P50 ms", 8).arg("P90 ms", 8).arg("P99 ms", 8).arg("Max ms", 8).arg("Mean ms", 8).arg("Goodput B/s", 12));
+
+    for (const smp_link_benchmark_size_t &size : size_results)
+    {
+        QVector<double> sorted = size.latencies;
+        double mean = 0.0;
+        QString goodput = "-";
+
+        std::sort(sorted.begin(), sorted.end());
+
+        for (double latency : sorted)
+        {
+            mean += latency;
+        }
+
+        if (sorted.isEmpty() == false)
+        {
+            mean /= sorted.length();
+
+            if (mean > 0.0)
+            {
+                //Echo text is carried in both directions
+                goodput = QString::number((size.payload * 2 * 1000.0) / mean, 'f', 0);
+            }
+        }
+
+        output.append(QString("%1 %2 %3 ").arg(size.payload, 8).arg(size.message_bytes, 7).arg(QString("%1/%2").arg(QString::number(sorted.length()), QString::number(size.failures)), 9));
+
+        if (sorted.isEmpty() == true)
+        {
+            output.append(QString("%1 %2 %3 %4 %5 %6 ").arg("-", 8).arg("-", 8).arg("-", 8).arg("-", 8).arg("-", 8).arg("-", 8));
+        }
+        else
+        {
+            output.append(QString("%1 %2 %3 %4 %5 %6 ").arg(sorted.first(), 8, 'f', 2).arg(percentile(sorted, 50.0), 8, 'f', 2).arg(percentile(sorted, 90.0), 8, 'f', 2).arg(percentile(sorted, 99.0), 8, 'f', 2).arg(sorted.last(), 8, 'f', 2).arg(mean, 8, 'f', 2));
+        }
+
+        output.append(QString("%1\n").arg(goodput, 12));
+    }
+
+    output.append("\n");
+
+    if (model.valid == false)
+    {
+        output.append("Not enough results to fit latency model\n");
+    }
+    else
+    {
+        output.append(QString("Fit: latency = %1 ms + %2 ms x SMP bytes (R^2 %3)\n").arg(QString::number(model.overhead_ms, 'f', 3), QString::number(model.ms_per_byte, 'f', 5), QString::number(model.r_squared, 'f', 3)));
+
+        if (model.ms_per_byte > 0.0)
+        {
+            //Overhead as a number of bytes shows how much of each message is spent on the fixed cost, for picking chunk sizes
+            output.append(QString("Per-message overhead equivalent to %1 bytes, link rate %2 B/s (SMP bytes, both directions)\n").arg(QString::number(model.overhead_ms / model.ms_per_byte, 'f', 0), QString::number(1000.0 / model.ms_per_byte, 'f', 0)));
+        }
+    }
+
+    return output;
+}
+
+double smp_link_benchmark::percentile(const QVector<double> &sorted, double percent)
+{
+    //Nearest rank
+    int32_t index = (int32_t)std::ceil((percent / 100.0) * sorted.length()) - 1;
+
+    if (index < 0)
+    {
+        index = 0;
+    }
+    else if (index >= sorted.length())
+    {
+        index = sorted.length() - 1;
+    }
+
+    return sorted.at(index);
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
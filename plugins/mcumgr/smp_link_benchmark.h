@@ -0,0 +1,107 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_link_benchmark.h
+**
+** Notes:   Measures the latency and goodput of the current transport using
+**          os_mgmt echo commands over a range of payload sizes
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_LINK_BENCHMARK_H
+#define SMP_LINK_BENCHMARK_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QObject>
+#include <QList>
+#include <QVector>
+#include <QElapsedTimer>
+#include "smp_group_os_mgmt.h"
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+const uint8_t smp_link_benchmark_default_sizes = 8;
+const uint16_t smp_link_benchmark_default_iterations = 20;
+
+/******************************************************************************/
+// Forward declaration of Class, Struct & Unions
+/******************************************************************************/
+struct smp_link_benchmark_size_t {
+    uint16_t payload;           //Length of echo text
+    uint16_t message_bytes;     //SMP request and response, including headers
+    QVector<double> latencies;  //In ms, successful echoes only
+    uint16_t failures;          //Timeouts and responses which did not match the payload
+};
+
+struct smp_link_benchmark_fit_t {
+    bool valid;
+    double overhead_ms;         //Fixed cost of each request/response pair
+    double ms_per_byte;         //Cost of each SMP byte (request and response)
+    double r_squared;
+};
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_link_benchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    smp_link_benchmark(smp_group_os_mgmt *os_group, QObject *parent = nullptr);
+    ~smp_link_benchmark();
+    bool start(QString link_name, uint16_t max_message_size, uint8_t sizes, uint16_t iterations, uint8_t user_data, QString *error);
+    void cancel();
+    bool is_busy();
+    const QList<smp_link_benchmark_size_t> &results();
+    smp_link_benchmark_fit_t fit();
+    QString report();
+    static uint16_t echo_message_size(uint16_t payload);
+
+signals:
+    void progress(uint8_t percent);
+    void finished(bool success, QString summary);
+
+private slots:
+    void begin();
+    void group_finished(uint8_t user_data, group_status status, QString error_string);
+
+private:
+    void send_next();
+    void finish(bool success, QString error);
+    static double percentile(const QVector<double> &sorted, double percent);
+
+    smp_group_os_mgmt *os_mgmt;
+    bool running;
+    uint8_t benchmark_user_data;
+    QString link;
+    uint16_t max_size;
+    uint16_t iterations_per_size;
+    QList<smp_link_benchmark_size_t> size_results;
+    int32_t sent;               //Number of echoes sent, -1 whilst the warm up echo is outstanding
+    uint32_t total;
+    QString payload;
+    QElapsedTimer timer;
+};
+
+#endif // SMP_LINK_BENCHMARK_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
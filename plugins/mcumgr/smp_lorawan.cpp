@@ -46,6 +46,10 @@ smp_lorawan::smp_lorawan(QObject *parent)
     mqtt_is_connected = false;
     mqtt_is_ready = false;
     lorawan_config_set = false;
+    lorawan_config.fragment_size = smp_lorawan_default_fragment_size;
+    lorawan_config.confirmed_downlinks = smp_lorawan_default_confirmed_downlinks;
+    lorawan_config.resends = smp_lorawan_default_resends;
+    lorawan_config.timeout = smp_lorawan_default_timeout_ms;
     mqtt_disconnect_error_code = 0;
 
     QObject::connect(mqtt_client, SIGNAL(connected()), this, SLOT(mqtt_connected()));
@@ -170,9 +174,8 @@ smp_transport_error_t smp_lorawan::send(smp_message *message)
     uint16_t fragment_size = lorawan_window->get_fragment_size();
     bool confirmed_download = lorawan_window->get_confirmed_downlinks();
 #else
-    //TODO
-    uint16_t fragment_size = 222;
-    bool confirmed_download = true;
+    uint16_t fragment_size = lorawan_config.fragment_size;
+    bool confirmed_download = lorawan_config.confirmed_downlinks;
 #endif
 
     if (mqtt_is_connected == false)
@@ -552,23 +555,21 @@ void smp_lorawan::disconnect_from_service()
     mqtt_client->disconnectFromHost();
 }
 
-//TODO: move
 uint8_t smp_lorawan::get_retries()
 {
 #if defined(GUI_PRESENT)
     return lorawan_window->get_resends();
 #else
-    return 0;
+    return lorawan_config.resends;
 #endif
 }
 
-//TODO: move
 uint32_t smp_lorawan::get_timeout()
 {
 #if defined(GUI_PRESENT)
     return lorawan_window->get_timeout();
 #else
-    return 300 * 1000;
+    return lorawan_config.timeout;
 #endif
 }
 
@@ -586,11 +587,26 @@ int smp_lorawan::set_connection_config(struct smp_lorawan_config_t *configuratio
     lorawan_config.password = configuration->password;
     lorawan_config.topic = configuration->topic;
     lorawan_config.frame_port = configuration->frame_port;
+    lorawan_config.fragment_size = configuration->fragment_size;
+    lorawan_config.confirmed_downlinks = configuration->confirmed_downlinks;
+    lorawan_config.resends = configuration->resends;
+    lorawan_config.timeout = configuration->timeout;
     lorawan_config_set = true;
 
     return SMP_TRANSPORT_ERROR_OK;
 }
 
+QString smp_lorawan::device_identifier()
+{
+    if (mqtt_topic.isEmpty() == true)
+    {
+        return "";
+    }
+
+    //The topic is specific to the end device
+    return QString("lorawan:%1:%2").arg(mqtt_client->hostname(), mqtt_topic);
+}
+
 QString smp_lorawan::to_error_string(int error_code)
 {
     switch (error_code)
@@ -36,6 +36,15 @@
 #include <QtMqtt/QMqttSubscription>
 #include <QtMqtt/QMqttMessage>
 
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+//Connection options used when there is no setup window (non-GUI builds) until a configuration is set
+const uint16_t smp_lorawan_default_fragment_size = 222;
+const bool smp_lorawan_default_confirmed_downlinks = true;
+const uint8_t smp_lorawan_default_resends = 0;
+const uint32_t smp_lorawan_default_timeout_ms = 300 * 1000;
+
 /******************************************************************************/
 // Forward declaration of Class, Struct & Unions
 /******************************************************************************/
@@ -47,6 +56,10 @@ struct smp_lorawan_config_t {
     QString password;
     QString topic;
     uint8_t frame_port;
+    uint16_t fragment_size;
+    bool confirmed_downlinks;
+    uint8_t resends;
+    uint32_t timeout;
 };
 
 /******************************************************************************/
@@ -72,6 +85,7 @@ public:
     uint32_t get_timeout() override;
     int set_connection_config(struct smp_lorawan_config_t *configuration);
     QString to_error_string(int error_code) override;
+    QString device_identifier() override;
 
 private slots:
     void connect_to_service(QString host, uint16_t port, bool tls, QString username, QString password, QString topic);
@@ -85,6 +85,23 @@ void smp_message::clear()
     this->header_added = false;
 }
 
+void smp_message::reset()
+{
+    //Empties the message for reuse without releasing the buffer, the message must have been ended
+    this->buffer.truncate(0);
+    this->header_added = false;
+}
+
+void smp_message::reserve(int size)
+{
+    this->buffer.reserve(size);
+}
+
+int smp_message::capacity(void)
+{
+    return this->buffer.capacity();
+}
+
 smp_hdr *smp_message::get_header(void)
 {
     if (this->buffer.size() < (int)sizeof(struct smp_hdr))
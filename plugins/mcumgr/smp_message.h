@@ -68,6 +68,9 @@ public:
     void append(const QByteArray data);
     void append(const QByteArray *data);
     void clear();
+    void reset();
+    void reserve(int size);
+    int capacity(void);
     smp_hdr *get_header(void);
     int size(void);
     int data_size(void);
@@ -0,0 +1,131 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_message_pool.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_message_pool.h"
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_message_pool::smp_message_pool()
+{
+    reset_counters();
+}
+
+smp_message_pool::~smp_message_pool()
+{
+    clear();
+}
+
+smp_message *smp_message_pool::acquire(uint16_t capacity)
+{
+    //Returns an empty message with a buffer large enough for the supplied size, reusing an idle one where possible
+    smp_message *message;
+
+    if (idle.isEmpty())
+    {
+        message = new smp_message();
+        ++message_allocations;
+    }
+    else
+    {
+        message = idle.takeLast();
+    }
+
+    if (message->capacity() < (int)capacity)
+    {
+        message->reserve(capacity);
+        ++buffer_allocations;
+    }
+
+    ++acquired;
+
+    return message;
+}
+
+void smp_message_pool::release(smp_message *message)
+{
+    //Messages may have come from outside of the pool, all are accepted until the idle list is full
+    if (message == nullptr)
+    {
+        return;
+    }
+
+    ++released;
+
+    if (idle.length() >= SMP_MESSAGE_POOL_MAX_IDLE)
+    {
+        delete message;
+        return;
+    }
+
+    message->reset();
+    idle.append(message);
+}
+
+void smp_message_pool::clear()
+{
+    while (!idle.isEmpty())
+    {
+        delete idle.takeLast();
+    }
+}
+
+void smp_message_pool::reset_counters()
+{
+    acquired = 0;
+    message_allocations = 0;
+    buffer_allocations = 0;
+    released = 0;
+}
+
+uint32_t smp_message_pool::get_acquired()
+{
+    return acquired;
+}
+
+uint32_t smp_message_pool::get_message_allocations()
+{
+    return message_allocations;
+}
+
+uint32_t smp_message_pool::get_buffer_allocations()
+{
+    return buffer_allocations;
+}
+
+uint32_t smp_message_pool::get_released()
+{
+    return released;
+}
+
+uint32_t smp_message_pool::get_idle()
+{
+    return idle.length();
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,70 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_message_pool.h
+**
+** Notes:   Recycles SMP messages (and their buffers) used by transfer hot
+**          paths so that each chunk does not need fresh heap allocations
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_MESSAGE_POOL_H
+#define SMP_MESSAGE_POOL_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <stdint.h>
+#include <QList>
+#include "smp_message.h"
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+//Maximum number of idle messages kept, anything released beyond this is freed
+#define SMP_MESSAGE_POOL_MAX_IDLE 16
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_message_pool
+{
+public:
+    smp_message_pool();
+    ~smp_message_pool();
+    smp_message *acquire(uint16_t capacity);
+    void release(smp_message *message);
+    void clear();
+    void reset_counters();
+    uint32_t get_acquired();
+    uint32_t get_message_allocations();
+    uint32_t get_buffer_allocations();
+    uint32_t get_released();
+    uint32_t get_idle();
+
+private:
+    QList<smp_message *> idle;
+    uint32_t acquired;
+    uint32_t message_allocations;
+    uint32_t buffer_allocations;
+    uint32_t released;
+};
+
+#endif // SMP_MESSAGE_POOL_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,321 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_metrics.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_metrics.h"
+#include <QJsonArray>
+#include <string.h>
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_metrics::smp_metrics()
+{
+    reset();
+}
+
+void smp_metrics::reset()
+{
+    entry_list.clear();
+    sequence_mismatches = 0;
+    header_mismatches = 0;
+    unexpected_responses = 0;
+    invalid_responses = 0;
+    collection_timer.start();
+}
+
+smp_metrics_entry_t *smp_metrics::find_entry(uint16_t group, uint8_t command)
+{
+    //Finds the entry for this group and command, adding one if there is none
+    int i = 0;
+    smp_metrics_entry_t entry;
+
+    while (i < entry_list.length())
+    {
+        if (entry_list[i].group == group && entry_list[i].command == command)
+        {
+            return &entry_list[i];
+        }
+
+        ++i;
+    }
+
+    memset(&entry, 0, sizeof(entry));
+    entry.group = group;
+    entry.command = command;
+    entry.latency_min_ms = UINT32_MAX;
+    entry_list.append(entry);
+
+    return &entry_list.last();
+}
+
+void smp_metrics::request_sent(uint16_t group, uint8_t command, uint32_t size)
+{
+    smp_metrics_entry_t *entry = find_entry(group, command);
+
+    ++entry->requests;
+    entry->request_bytes += size;
+}
+
+void smp_metrics::request_failed(uint16_t group, uint8_t command)
+{
+    //Transport refused the request, it was never sent
+    ++find_entry(group, command)->send_failures;
+}
+
+void smp_metrics::request_retried(uint16_t group, uint8_t command, uint32_t size)
+{
+    smp_metrics_entry_t *entry = find_entry(group, command);
+
+    ++entry->retries;
+    entry->request_bytes += size;
+}
+
+void smp_metrics::request_timed_out(uint16_t group, uint8_t command)
+{
+    //All retries of the request timed out
+    ++find_entry(group, command)->timeouts;
+}
+
+void smp_metrics::response_received(uint16_t group, uint8_t command, uint32_t size, uint32_t latency_ms, bool error)
+{
+    //Latency is from when the request was first sent, so includes the time taken by any retries
+    smp_metrics_entry_t *entry = find_entry(group, command);
+
+    ++entry->responses;
+    entry->response_bytes += size;
+
+    if (error == true)
+    {
+        ++entry->errors;
+    }
+
+    if (latency_ms < entry->latency_min_ms)
+    {
+        entry->latency_min_ms = latency_ms;
+    }
+
+    if (latency_ms > entry->latency_max_ms)
+    {
+        entry->latency_max_ms = latency_ms;
+    }
+
+    entry->latency_total_ms += latency_ms;
+    ++entry->latency_histogram[latency_bucket(latency_ms)];
+}
+
+void smp_metrics::sequence_mismatch()
+{
+    //Response sequence did not match any outstanding request
+    ++sequence_mismatches;
+}
+
+void smp_metrics::header_mismatch()
+{
+    //Response sequence matched a request but the group, command or op did not
+    ++header_mismatches;
+}
+
+void smp_metrics::unexpected_response()
+{
+    //Response arrived when no requests were outstanding
+    ++unexpected_responses;
+}
+
+void smp_metrics::invalid_response()
+{
+    //Response header or body could not be decoded
+    ++invalid_responses;
+}
+
+const QList<smp_metrics_entry_t> &smp_metrics::entries()
+{
+    return entry_list;
+}
+
+uint32_t smp_metrics::get_sequence_mismatches()
+{
+    return sequence_mismatches;
+}
+
+uint32_t smp_metrics::get_header_mismatches()
+{
+    return header_mismatches;
+}
+
+uint32_t smp_metrics::get_unexpected_responses()
+{
+    return unexpected_responses;
+}
+
+uint32_t smp_metrics::get_invalid_responses()
+{
+    return invalid_responses;
+}
+
+qint64 smp_metrics::duration_ms()
+{
+    //Time since the metrics were last reset
+    return collection_timer.elapsed();
+}
+
+uint8_t smp_metrics::latency_bucket(uint32_t latency_ms)
+{
+    uint8_t bucket = 0;
+
+    while (bucket < (SMP_METRICS_LATENCY_BUCKETS - 1) && latency_ms >= latency_bucket_limit(bucket))
+    {
+        ++bucket;
+    }
+
+    return bucket;
+}
+
+uint32_t smp_metrics::latency_bucket_limit(uint8_t bucket)
+{
+    //Exclusive upper limit of the bucket in ms, 0 for the final (unbounded) bucket
+    if (bucket >= (SMP_METRICS_LATENCY_BUCKETS - 1))
+    {
+        return 0;
+    }
+
+    return ((uint32_t)1 << bucket);
+}
+
+QString smp_metrics::latency_bucket_name(uint8_t bucket)
+{
+    if (bucket >= (SMP_METRICS_LATENCY_BUCKETS - 1))
+    {
+        return QString(">=%1 ms").arg(QString::number(latency_bucket_limit(SMP_METRICS_LATENCY_BUCKETS - 2)));
+    }
+
+    return QString("<%1 ms").arg(QString::number(latency_bucket_limit(bucket)));
+}
+
+uint32_t smp_metrics::latency_percentile(const smp_metrics_entry_t *entry, uint8_t percent)
+{
+    //Upper limit of the bucket containing the percentile, limited to the maximum latency seen
+    uint64_t target;
+    uint64_t count = 0;
+    uint8_t bucket = 0;
+
+    if (entry->responses == 0)
+    {
+        return 0;
+    }
+
+    target = ((uint64_t)entry->responses * percent + 99) / 100;
+
+    while (bucket < SMP_METRICS_LATENCY_BUCKETS)
+    {
+        count += entry->latency_histogram[bucket];
+
+        if (count >= target)
+        {
+            break;
+        }
+
+        ++bucket;
+    }
+
+    if (bucket >= (SMP_METRICS_LATENCY_BUCKETS - 1) || latency_bucket_limit(bucket) > entry->latency_max_ms)
+    {
+        return entry->latency_max_ms;
+    }
+
+    return latency_bucket_limit(bucket);
+}
+
+QJsonObject smp_metrics::to_json()
+{
+    QJsonObject output;
+    QJsonObject totals;
+    QJsonArray commands;
+    QJsonArray bucket_limits;
+    int i = 0;
+    uint8_t l = 0;
+
+    while (l < SMP_METRICS_LATENCY_BUCKETS)
+    {
+        bucket_limits.append((qint64)latency_bucket_limit(l));
+        ++l;
+    }
+
+    while (i < entry_list.length())
+    {
+        const smp_metrics_entry_t *entry = &entry_list.at(i);
+        QJsonObject command;
+        QJsonArray histogram;
+
+        l = 0;
+
+        while (l < SMP_METRICS_LATENCY_BUCKETS)
+        {
+            histogram.append((qint64)entry->latency_histogram[l]);
+            ++l;
+        }
+
+        command.insert("group", entry->group);
+        command.insert("command", entry->command);
+        command.insert("requests", (qint64)entry->requests);
+        command.insert("request_bytes", (qint64)entry->request_bytes);
+        command.insert("responses", (qint64)entry->responses);
+        command.insert("response_bytes", (qint64)entry->response_bytes);
+        command.insert("errors", (qint64)entry->errors);
+        command.insert("retries", (qint64)entry->retries);
+        command.insert("timeouts", (qint64)entry->timeouts);
+        command.insert("send_failures", (qint64)entry->send_failures);
+
+        if (entry->responses > 0)
+        {
+            command.insert("latency_min_ms", (qint64)entry->latency_min_ms);
+            command.insert("latency_max_ms", (qint64)entry->latency_max_ms);
+            command.insert("latency_mean_ms", (double)entry->latency_total_ms / (double)entry->responses);
+            command.insert("latency_p50_ms", (qint64)latency_percentile(entry, 50));
+            command.insert("latency_p90_ms", (qint64)latency_percentile(entry, 90));
+            command.insert("latency_p99_ms", (qint64)latency_percentile(entry, 99));
+        }
+
+        command.insert("latency_histogram", histogram);
+        commands.append(command);
+        ++i;
+    }
+
+    totals.insert("sequence_mismatches", (qint64)sequence_mismatches);
+    totals.insert("header_mismatches", (qint64)header_mismatches);
+    totals.insert("unexpected_responses", (qint64)unexpected_responses);
+    totals.insert("invalid_responses", (qint64)invalid_responses);
+
+    output.insert("duration_ms", duration_ms());
+    output.insert("latency_bucket_limits_ms", bucket_limits);
+    output.insert("commands", commands);
+    output.insert("totals", totals);
+
+    return output;
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,106 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_metrics.h
+**
+** Notes:   Records per group/command SMP transaction statistics (sizes,
+**          latency histograms, retries and timeouts)
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_METRICS_H
+#define SMP_METRICS_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <stdint.h>
+#include <QList>
+#include <QString>
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+//Latency buckets are powers of 2 milliseconds: <1, <2, <4 ... <65536, the final bucket holds anything longer
+#define SMP_METRICS_LATENCY_BUCKETS 18
+
+/******************************************************************************/
+// Forward declaration of Class, Struct & Unions
+/******************************************************************************/
+struct smp_metrics_entry_t {
+    uint16_t group;
+    uint8_t command;
+    uint32_t requests;
+    uint64_t request_bytes;
+    uint32_t responses;
+    uint64_t response_bytes;
+    uint32_t errors;
+    uint32_t retries;
+    uint32_t timeouts;
+    uint32_t send_failures;
+    uint32_t latency_min_ms;
+    uint32_t latency_max_ms;
+    uint64_t latency_total_ms;
+    uint32_t latency_histogram[SMP_METRICS_LATENCY_BUCKETS];
+};
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_metrics
+{
+public:
+    smp_metrics();
+    void reset();
+    void request_sent(uint16_t group, uint8_t command, uint32_t size);
+    void request_failed(uint16_t group, uint8_t command);
+    void request_retried(uint16_t group, uint8_t command, uint32_t size);
+    void request_timed_out(uint16_t group, uint8_t command);
+    void response_received(uint16_t group, uint8_t command, uint32_t size, uint32_t latency_ms, bool error);
+    void sequence_mismatch();
+    void header_mismatch();
+    void unexpected_response();
+    void invalid_response();
+    const QList<smp_metrics_entry_t> &entries();
+    uint32_t get_sequence_mismatches();
+    uint32_t get_header_mismatches();
+    uint32_t get_unexpected_responses();
+    uint32_t get_invalid_responses();
+    qint64 duration_ms();
+    static uint8_t latency_bucket(uint32_t latency_ms);
+    static uint32_t latency_bucket_limit(uint8_t bucket);
+    static QString latency_bucket_name(uint8_t bucket);
+    static uint32_t latency_percentile(const smp_metrics_entry_t *entry, uint8_t percent);
+    QJsonObject to_json();
+
+private:
+    smp_metrics_entry_t *find_entry(uint16_t group, uint8_t command);
+
+    QList<smp_metrics_entry_t> entry_list;
+    uint32_t sequence_mismatches;
+    uint32_t header_mismatches;
+    uint32_t unexpected_responses;
+    uint32_t invalid_responses;
+    QElapsedTimer collection_timer;
+};
+
+#endif // SMP_METRICS_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -29,33 +29,20 @@ smp_processor::smp_processor(QObject *parent)
     Q_UNUSED(parent);
 
     sequence = 0;
-    last_message = nullptr;
-    last_message_header = nullptr;
-    repeat_times = 0;
-    busy = false;
+    transport = nullptr;
+    window_size = SMP_PROCESSOR_DEFAULT_WINDOW;
+    window_known = false;
 #if defined(PLUGIN_MCUMGR_JSON)
     json_object = nullptr;
 #endif
     message_logging = false;
     custom_message = false;
-
-    connect(&repeat_timer, SIGNAL(timeout()), this, SLOT(message_timeout()));
-    repeat_timer.setSingleShot(true);
 }
 
 smp_processor::~smp_processor()
 {
     cleanup();
-    disconnect(this, SLOT(message_timeout()));
     group_handlers.clear();
-
-    //Ensure object is deleted if it was part-way through creation
-    if (last_message != nullptr)
-    {
-        delete last_message;
-        last_message = nullptr;
-        last_message_header = nullptr;
-    }
 }
 
 #ifndef SKIPPLUGIN_LOGGER
@@ -65,11 +52,11 @@ void smp_processor::set_logger(debug_logger *object)
 }
 #endif
 
-smp_transport_error_t smp_processor::send(smp_message *message, uint32_t timeout_ms, uint8_t repeats, bool allow_version_check)
+smp_transport_error_t smp_processor::send(smp_message *message, uint32_t timeout_ms, uint8_t repeats, bool allow_version_check, smp_rtt_class_t rtt_class)
 {
     smp_transport_error_t transport_error = SMP_TRANSPORT_ERROR_OK;
 
-    if (busy)
+    if (pending.length() >= window_size)
     {
         transport_error = SMP_TRANSPORT_ERROR_PROCESSOR_BUSY;
     }
@@ -80,22 +67,34 @@ smp_transport_error_t smp_processor::send(smp_message *message, uint32_t timeout
 
     if (transport_error == SMP_TRANSPORT_ERROR_OK)
     {
-        last_message = message;
-        last_message_header = message->get_header();
+        smp_pending_t request;
 
-        //Set message sequence
-        last_message_header->nh_seq = sequence;
-        last_message_version_check = allow_version_check;
-        last_message_version = last_message_header->nh_version;
-        repeat_timer.setInterval(timeout_ms);
-        repeat_times = repeats;
-        busy = true;
+        request.message = message;
+        request.header = message->get_header();
 
-        transport_error = transport->send(last_message);
+        //Set message sequence
+        request.header->nh_seq = sequence;
+        request.version_check = allow_version_check;
+        request.version = request.header->nh_version;
+        request.repeats = repeats;
+        request.custom = custom_message;
+        request.retransmitted = false;
+
+        //Each outstanding request has its own retry timer, the supplied timeout is extended if this command has been measured to take longer
+        request.rtt_index = find_rtt_index(header_group(request.header), request.header->nh_id, rtt_class);
+        request.timer = new QTimer(this);
+        request.timer->setSingleShot(true);
+        request.timer->setInterval(rtt_estimators[request.rtt_index].estimator.timeout(timeout_ms));
+        connect(request.timer, SIGNAL(timeout()), this, SLOT(message_timeout()));
+        pending.append(request);
+
+        transport_error = transport->send(message);
 
         if (transport_error == SMP_TRANSPORT_ERROR_OK)
         {
-            repeat_timer.start();
+            transaction_metrics.request_sent(header_group(request.header), request.header->nh_id, message->size());
+            pending.last().sent.start();
+            request.timer->start();
             ++sequence;
 
 #if defined(PLUGIN_MCUMGR_JSON)
@@ -105,19 +104,85 @@ smp_transport_error_t smp_processor::send(smp_message *message, uint32_t timeout
             }
 #endif
         }
+        else
+        {
+            transaction_metrics.request_failed(header_group(request.header), request.header->nh_id);
+            release_pending((pending.length() - 1), true);
+        }
     }
-
-    if (transport_error != SMP_TRANSPORT_ERROR_OK)
+    else
     {
-        cleanup();
+        //Message was not queued, ownership was passed so it must be freed
+        recycle_message(message);
     }
 
+    custom_message = false;
+
     return transport_error;
 }
 
 bool smp_processor::is_busy()
 {
-    return busy;
+    return !pending.isEmpty();
+}
+
+bool smp_processor::can_send()
+{
+    return (pending.length() < window_size);
+}
+
+uint8_t smp_processor::pending_count()
+{
+    return pending.length();
+}
+
+void smp_processor::set_window(uint8_t size)
+{
+    if (size < SMP_PROCESSOR_DEFAULT_WINDOW)
+    {
+        size = SMP_PROCESSOR_DEFAULT_WINDOW;
+    }
+    else if (size > SMP_PROCESSOR_MAX_WINDOW)
+    {
+        size = SMP_PROCESSOR_MAX_WINDOW;
+    }
+
+    window_size = size;
+    window_known = true;
+    log_debug() << "Request window set to " << window_size;
+}
+
+uint8_t smp_processor::window()
+{
+    return window_size;
+}
+
+bool smp_processor::window_negotiated()
+{
+    //False until the window has been set for the current connection
+    return window_known;
+}
+
+void smp_processor::reset_window()
+{
+    //Connection has closed, the next device may have fewer buffers so it must be negotiated again
+    window_size = SMP_PROCESSOR_DEFAULT_WINDOW;
+    window_known = false;
+}
+
+uint8_t smp_processor::window_for_buffer_count(uint32_t buffer_count)
+{
+    //One buffer on the device is reserved for the response being generated, the remainder can hold queued requests
+    if (buffer_count <= 1)
+    {
+        return SMP_PROCESSOR_DEFAULT_WINDOW;
+    }
+    else if ((buffer_count - 1) > SMP_PROCESSOR_MAX_WINDOW)
+    {
+        return SMP_PROCESSOR_MAX_WINDOW;
+    }
+
+    return (uint8_t)(buffer_count - 1);
 }
 
 void smp_processor::register_handler(uint16_t group, smp_group *handler)
@@ -142,113 +207,193 @@ void smp_processor::unregister_handler(uint16_t group)
 
 void smp_processor::cleanup()
 {
-    if (!busy)
+    while (!pending.isEmpty())
     {
-        return;
+        release_pending((pending.length() - 1), true);
+    }
+}
+
+void smp_processor::release_pending(int index, bool delete_message)
+{
+    smp_pending_t request = pending.takeAt(index);
+
+    //Timer may be the sender of the slot currently executing so defer deletion
+    request.timer->stop();
+    request.timer->disconnect(this);
+    request.timer->deleteLater();
+
+    if (delete_message == true)
+    {
+        recycle_message(request.message);
+    }
+}
+
+uint16_t smp_processor::header_group(const smp_hdr *header)
+{
+    uint16_t group = header->nh_group;
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    group = ((group & 0xff) << 8) | ((group & 0xff00) >> 8);
+#endif
+
+    return group;
+}
+
+int smp_processor::find_handler(uint16_t group)
+{
+    //Search for the handler for this group, returns -1 if there is none
+    int i = 0;
+
+    while (i < group_handlers.length())
+    {
+        if (group_handlers[i].group == group)
+        {
+            return i;
+        }
+
+        ++i;
     }
 
-    repeat_timer.stop();
+    return -1;
+}
 
-    if (last_message != nullptr)
+int smp_processor::find_pending_group(uint16_t group, int exclude_index)
+{
+    //Finds another outstanding request for the same group, returns -1 if there is none
+    int i = 0;
+
+    while (i < pending.length())
     {
-        delete last_message;
-        last_message = nullptr;
-        last_message_header = nullptr;
+        if (i != exclude_index && !pending[i].custom && header_group(pending[i].header) == group)
+        {
+            return i;
+        }
+
+        ++i;
     }
 
-    repeat_times = 0;
-    busy = false;
+    return -1;
 }
 
 void smp_processor::message_timeout()
 {
-    if (!busy)
+    int index = 0;
+
+    while (index < pending.length())
     {
-        //No longer busy
+        if (pending[index].timer == sender())
+        {
+            break;
+        }
+
+        ++index;
+    }
+
+    if (index == pending.length())
+    {
+        //No longer awaiting this request
         return;
     }
 
-    if (repeat_times == 0)
+    smp_pending_t *request = &pending[index];
+    uint32_t interval;
+
+    rtt_estimators[request->rtt_index].estimator.backoff();
+
+    if (request->repeats == 0)
     {
-        uint16_t group = last_message_header->nh_group;
-        uint8_t i = 0;
+        uint16_t group = header_group(request->header);
 
-#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
-        group = ((group & 0xff) << 8) | ((group & 0xff00) >> 8);
-#endif
+        transaction_metrics.request_timed_out(group, request->header->nh_id);
 
-        if (!custom_message)
+        if (!request->custom)
         {
-            //Search for the handler for this group
-            while (i < group_handlers.length())
+            int handler = find_handler(group);
+            int other;
+
+            //Any other requests for this group are abandoned, the handler is reset by the timeout
+            while ((other = find_pending_group(group, index)) != -1)
             {
-                if (group_handlers[i].group == group)
+                release_pending(other, true);
+
+                if (other < index)
                 {
-                    break;
+                    --index;
                 }
-
-                ++i;
             }
 
-            if (i == group_handlers.length())
+            request = &pending[index];
+
+            if (handler == -1)
             {
                 //There is no registered handler for this group
                 log_error() << "No registered handler for group " << group << ", cannot send timeout message.";
-                cleanup();
+                release_pending(index, true);
             }
             else
             {
-                //Keep message pointer valid but cleanup so callback can send a message
-                smp_message *backup_message = last_message;
-                last_message = nullptr;
-                last_message_header = nullptr;
+                //Keep message pointer valid but release request so callback can send a message
+                smp_message *backup_message = request->message;
 
-                cleanup();
-                group_handlers[i].handler->timeout(backup_message);
+                release_pending(index, false);
+                group_handlers[handler].handler->timeout(backup_message);
 
-                //Delete backup pointer
-                delete backup_message;
+                //Return backup pointer to the pool
+                recycle_message(backup_message);
             }
         }
         else
         {
+            release_pending(index, true);
             emit custom_message_callback(CUSTOM_MESSAGE_CALLBACK_TIMEOUT, nullptr);
-
-            custom_message = false;
         }
 
         return;
     }
 
     //If this is a version 2 message, try sending a version 1 packet to see if version 2 is unsupported by the server
-    if (last_message_version_check == true && last_message_version == 1)
+    if (request->version_check == true && request->version == 1)
     {
-        if (last_message_header->nh_version == last_message_version)
+        if (request->header->nh_version == request->version)
         {
-            last_message_header->nh_version = 0;
+            request->header->nh_version = 0;
         }
         else
         {
-            last_message_header->nh_version = 1;
+            request->header->nh_version = 1;
         }
     }
 
-    //Resend message
-    --repeat_times;
-    repeat_timer.start();
-    transport->send(last_message);
+    //Resend message with exponential backoff, the response can no longer be used to measure the round trip time
+    interval = (uint32_t)request->timer->interval() * 2;
+
+    if (interval > SMP_RTO_MAX_MS)
+    {
+        //Timeouts longer than the maximum which were explicitly requested are kept
+        interval = ((uint32_t)request->timer->interval() > SMP_RTO_MAX_MS ? (uint32_t)request->timer->interval() : SMP_RTO_MAX_MS);
+    }
+
+    transaction_metrics.request_retried(header_group(request->header), request->header->nh_id, request->message->size());
+    --request->repeats;
+    request->retransmitted = true;
+    request->timer->setInterval(interval);
+    request->timer->start();
+    transport->send(request->message);
 }
 
 void smp_processor::message_received(smp_message *response)
 {
     const smp_hdr *response_header = nullptr;
+    const smp_hdr *request_header = nullptr;
+    int index = 0;
 
     log_debug() << "got message";
 
-    if (!busy)
+    if (pending.isEmpty())
     {
         //Not busy so this message probably isn't wanted anymore
         log_error() << "Received message when not awaiting for a repsonse";
+        transaction_metrics.unexpected_response();
         return;
     }
 
@@ -259,54 +404,61 @@ void smp_processor::message_received(smp_message *response)
     {
         //Cannot do anything without a header
         log_error() << "Invalid response header";
+        transaction_metrics.invalid_response();
+        return;
+    }
+
+    //Find the request with the same sequence number
+    while (index < pending.length())
+    {
+        if (pending[index].header->nh_seq == response_header->nh_seq)
+        {
+            request_header = pending[index].header;
+            break;
+        }
+
+        ++index;
     }
-    else if (response_header->nh_group != last_message_header->nh_group)
+
+    if (request_header == nullptr)
     {
-        log_error() << "Invalid group, expected " << last_message_header->nh_group << " got " << response_header->nh_group;
+        log_error() << "Invalid sequence, no request awaiting response with sequence " << response_header->nh_seq;
+        transaction_metrics.sequence_mismatch();
     }
-    else if (response_header->nh_id != last_message_header->nh_id)
+    else if (response_header->nh_group != request_header->nh_group)
     {
-        log_error() << "Invalid command, expected " << last_message_header->nh_id << " got " << response_header->nh_id;
+        log_error() << "Invalid group, expected " << request_header->nh_group << " got " << response_header->nh_group;
+        transaction_metrics.header_mismatch();
     }
-    else if (response_header->nh_seq != last_message_header->nh_seq)
+    else if (response_header->nh_id != request_header->nh_id)
     {
-        log_error() << "Invalid sequence, expected " << last_message_header->nh_seq << " got " << response_header->nh_seq;
+        log_error() << "Invalid command, expected " << request_header->nh_id << " got " << response_header->nh_id;
+        transaction_metrics.header_mismatch();
     }
-    else if (response_header->nh_op != smp_message::response_op(last_message_header->nh_op))
+    else if (response_header->nh_op != smp_message::response_op(request_header->nh_op))
     {
-        log_error() << "Invalid op, expected " << smp_message::response_op(last_message_header->nh_op) << " got " << response_header->nh_op;
+        log_error() << "Invalid op, expected " << smp_message::response_op(request_header->nh_op) << " got " << response_header->nh_op;
+        transaction_metrics.header_mismatch();
     }
     else
     {
         //Headers look valid
         uint8_t version = response_header->nh_version;
         uint8_t op = response_header->nh_op;
-        uint16_t group = response_header->nh_group;
+        uint16_t group = header_group(response_header);
         uint8_t command = response_header->nh_id;
-        uint8_t i = 0;
-
-#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
-        group = ((group & 0xff) << 8) | ((group & 0xff00) >> 8);
-#endif
+        bool custom = pending[index].custom;
+        int handler = -1;
 
-        if (!custom_message)
+        if (!custom)
         {
-            //Search for the handler for this group
-            while (i < group_handlers.length())
-            {
-                if (group_handlers[i].group == group)
-                {
-                    break;
-                }
+            handler = find_handler(group);
 
-                ++i;
-            }
-
-            if (i == group_handlers.length())
+            if (handler == -1)
             {
                 //There is no registered handler for this group, clean up
                 log_error() << "No registered handler for group " << group << ", dropping response.";
-                this->cleanup();
+                release_pending(index, true);
                 return;
             }
         }
@@ -319,23 +471,35 @@ void smp_processor::message_received(smp_message *response)
         if (!parsed)
         {
             log_error() << "parse failed";
+            transaction_metrics.invalid_response();
             return;
         }
 
+        transaction_metrics.response_received(group, command, response->size(), (uint32_t)pending[index].sent.elapsed(), (error.type != SMP_ERROR_NONE));
+
+        if (pending[index].retransmitted == false)
+        {
+            //Update response time estimate
+            int rtt_index = pending[index].rtt_index;
+
+            rtt_estimators[rtt_index].estimator.add_sample((uint32_t)pending[index].sent.elapsed());
+            emit rtt_updated(rtt_entry_summary(rtt_index));
+        }
+
         //Clean up before triggering callback
-        this->cleanup();
+        release_pending(index, true);
 
-        if (!custom_message)
+        if (!custom)
         {
             if (error.type != SMP_ERROR_NONE)
             {
                 //Received either "rc" (legacy/SMP version 1) error or "err" error (SMP version 2)
-                group_handlers[i].handler->receive_error(version, op, group, command, error);
+                group_handlers[handler].handler->receive_error(version, op, group, command, error);
             }
             else
             {
                 //No error, good response
-                group_handlers[i].handler->receive_ok(version, op, group, command, response->contents());
+                group_handlers[handler].handler->receive_ok(version, op, group, command, response->contents());
             }
         }
         else
@@ -351,14 +515,12 @@ void smp_processor::message_received(smp_message *response)
         }
 
 #if defined(PLUGIN_MCUMGR_JSON)
-        if (json_object != nullptr && (message_logging || custom_message))
+        if (json_object != nullptr && (message_logging || custom))
         {
             json_object->append_data(false, response);
         }
 #endif
     }
-
-    custom_message = false;
 }
 
 bool smp_processor::decode_message(QCborStreamReader &reader, uint8_t version, uint16_t level, QString *parent, smp_error_t *error)
@@ -463,7 +625,21 @@ bool smp_processor::decode_message(QCborStreamReader &reader, uint8_t version, u
 
 void smp_processor::set_transport(smp_transport *transport_object)
 {
+    bool changed = (transport_object != transport);
+
+    if (changed == true)
+    {
+        //Window must be negotiated again with the new device
+        reset_window();
+    }
+
     transport = transport_object;
+
+    if (changed == true)
+    {
+        //Response time estimates are kept per transport
+        emit rtt_updated(QString());
+    }
 }
 
 uint16_t smp_processor::max_message_data_size(uint16_t mtu)
@@ -490,124 +666,181 @@ void smp_processor::set_custom_message(bool enabled)
 
 void smp_processor::transport_disconnect(int error_code)
 {
-    uint16_t group;
-    uint8_t i = 0;
-
     if (sender() != transport)
     {
         log_error() << "Non-active transport emitted error: " << sender() << ", code: " << error_code;
         return;
     }
 
-    if (!busy)
+    //The transport object persists across reconnects, which may be to a different device
+    reset_window();
+
+    if (pending.isEmpty())
     {
         //No longer busy
         return;
     }
 
-    group = last_message_header->nh_group;
-
-#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
-    group = ((group & 0xff) << 8) | ((group & 0xff00) >> 8);
-#endif
+    abort_pending(true, error_code);
+}
 
-    if (!custom_message)
+void smp_processor::cancel()
+{
+    if (transport != nullptr)
     {
-        //Search for the handler for this group
-        while (i < group_handlers.length())
-        {
-            if (group_handlers[i].group == group)
-            {
-                break;
-            }
+        //Done even if nothing is pending, requests abandoned by a group may have left a partially received response
+        transport->cancel();
+    }
 
-            ++i;
-        }
+    if (pending.isEmpty())
+    {
+        //No longer busy
+        return;
+    }
 
-        if (i == group_handlers.length())
-        {
-            //There is no registered handler for this group
-            log_error() << "No registered handler for group " << group << ", cannot send transport disconnected message.";
-            cleanup();
-        }
-        else
-        {
-            //Keep message pointer valid but cleanup so callback can send a message
-            smp_message *backup_message = last_message;
-            last_message = nullptr;
-            last_message_header = nullptr;
+    abort_pending(false, 0);
+}
 
-            cleanup();
-            group_handlers[i].handler->transport_disconnected(backup_message, transport, error_code);
+void smp_processor::abandon_group(uint16_t group)
+{
+    //Releases outstanding requests for a group without notifying it, used when the group has already finished or failed
+    int index;
 
-            //Delete backup pointer
-            delete backup_message;
-        }
-    }
-    else
+    while ((index = find_pending_group(group, -1)) != -1)
     {
-        emit custom_message_callback(CUSTOM_MESSAGE_CALLBACK_TRANSPORT_DISCONNECTED, nullptr);
-
-        custom_message = false;
+        release_pending(index, true);
     }
 }
 
-void smp_processor::cancel()
+int smp_processor::find_rtt_index(uint16_t group, uint8_t command, smp_rtt_class_t rtt_class)
 {
-    uint16_t group;
-    uint8_t i = 0;
+    //Finds the estimator for this command on the current transport, adding one if there is none
+    int i = 0;
+    smp_rtt_entry_t entry;
 
-    if (!busy)
+    while (i < rtt_estimators.length())
     {
-        //No longer busy
-        return;
+        if (rtt_estimators[i].transport == transport && rtt_estimators[i].group == group && rtt_estimators[i].command == command && rtt_estimators[i].rtt_class == rtt_class)
+        {
+            return i;
+        }
+
+        ++i;
     }
 
-    group = last_message_header->nh_group;
+    entry.transport = transport;
+    entry.group = group;
+    entry.command = command;
+    entry.rtt_class = rtt_class;
+    rtt_estimators.append(entry);
 
-#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
-    group = ((group & 0xff) << 8) | ((group & 0xff00) >> 8);
-#endif
+    return (rtt_estimators.length() - 1);
+}
+
+QString smp_processor::rtt_entry_summary(int index)
+{
+    smp_rtt_entry_t *entry = &rtt_estimators[index];
+
+    return QString("Group %1 command %2%3: SRTT %4 ms, RTTVAR %5 ms, RTO %6 ms (%7 samples)").arg(QString::number(entry->group), QString::number(entry->command), (entry->rtt_class == SMP_RTT_CLASS_ERASE ? " (erase)" : ""), QString::number(entry->estimator.srtt()), QString::number(entry->estimator.rttvar()), QString::number(entry->estimator.timeout(0)), QString::number(entry->estimator.sample_count()));
+}
+
+smp_metrics *smp_processor::metrics()
+{
+    return &transaction_metrics;
+}
+
+smp_message *smp_processor::acquire_message(uint16_t capacity)
+{
+    //Messages taken from here are returned to the pool once their response (or timeout) has been handled
+    return message_pool.acquire(capacity);
+}
+
+void smp_processor::recycle_message(smp_message *message)
+{
+    message_pool.release(message);
+}
+
+smp_message_pool *smp_processor::messages()
+{
+    return &message_pool;
+}
 
-    transport->cancel();
+QStringList smp_processor::rtt_summary()
+{
+    //Estimates which have been measured on the current transport
+    QStringList summary;
+    int i = 0;
 
-    if (!custom_message)
+    while (i < rtt_estimators.length())
     {
-        //Search for the handler for this group
-        while (i < group_handlers.length())
+        if (rtt_estimators[i].transport == transport && rtt_estimators[i].estimator.has_samples() == true)
         {
-            if (group_handlers[i].group == group)
-            {
-                break;
-            }
-
-            ++i;
+            summary.append(rtt_entry_summary(i));
         }
 
-        if (i == group_handlers.length())
+        ++i;
+    }
+
+    return summary;
+}
+
+void smp_processor::abort_pending(bool disconnected, int error_code)
+{
+    //Releases all outstanding requests, then notifies each group (or the custom message owner) which had one once
+    QList<smp_pending_t> aborted;
+    QList<uint16_t> notified_groups;
+    bool notify_custom = false;
+    int i = 0;
+
+    while (!pending.isEmpty())
+    {
+        aborted.append(pending.first());
+        release_pending(0, false);
+    }
+
+    while (i < aborted.length())
+    {
+        uint16_t group = header_group(aborted[i].header);
+
+        if (aborted[i].custom)
         {
-            //There is no registered handler for this group
-            log_error() << "No registered handler for group " << group << ", cannot send cancelled message.";
-            cleanup();
+            notify_custom = true;
         }
-        else
+        else if (!notified_groups.contains(group))
         {
-            //Keep message pointer valid but cleanup so callback can send a message
-            smp_message *backup_message = last_message;
-            last_message = nullptr;
-            last_message_header = nullptr;
+            int handler = find_handler(group);
 
-            cleanup();
-            group_handlers[i].handler->cancelled(backup_message);
+            notified_groups.append(group);
 
-            //Delete backup pointer
-            delete backup_message;
+            if (handler == -1)
+            {
+                //There is no registered handler for this group
+                log_error() << "No registered handler for group " << group << ", cannot send " << (disconnected == true ? "transport disconnected" : "cancelled") << " message.";
+            }
+            else if (disconnected == true)
+            {
+                group_handlers[handler].handler->transport_disconnected(aborted[i].message, transport, error_code);
+            }
+            else
+            {
+                group_handlers[handler].handler->cancelled(aborted[i].message);
+            }
         }
+
+        ++i;
     }
-    else
+
+    //Return message pointers to the pool
+    i = 0;
+
+    while (i < aborted.length())
     {
-        emit custom_message_callback(CUSTOM_MESSAGE_CALLBACK_CANCELLED, nullptr);
+        recycle_message(aborted[i].message);
+        ++i;
+    }
 
-        custom_message = false;
+    if (notify_custom == true)
+    {
+        emit custom_message_callback((disconnected == true ? CUSTOM_MESSAGE_CALLBACK_TRANSPORT_DISCONNECTED : CUSTOM_MESSAGE_CALLBACK_CANCELLED), nullptr);
     }
 }
@@ -26,14 +26,21 @@
 #include <QObject>
 #include <QTimer>
 #include <QElapsedTimer>
+#include <QStringList>
 #include <QCborStreamReader>
 #include "smp_message.h"
 #include "smp_transport.h"
 #include "debug_logger.h"
+#include "smp_rtt_estimator.h"
+#include "smp_metrics.h"
+#include "smp_message_pool.h"
 #if defined(PLUGIN_MCUMGR_JSON)
 #include "smp_json.h"
 #endif
 
+#define SMP_PROCESSOR_DEFAULT_WINDOW 1
+#define SMP_PROCESSOR_MAX_WINDOW 16
+
 /******************************************************************************/
 // Enum typedefs
 /******************************************************************************/
@@ -55,6 +62,29 @@ struct smp_group_match_t {
     smp_group *handler;
 };
 
+//Request which has been sent and is awaiting a response
+struct smp_pending_t {
+    smp_message *message;
+    smp_hdr *header;
+    QTimer *timer;
+    QElapsedTimer sent;
+    int rtt_index;
+    bool retransmitted;
+    uint8_t repeats;
+    bool version_check;
+    uint8_t version;
+    bool custom;
+};
+
+//Response time estimate for one command (and class) on one transport
+struct smp_rtt_entry_t {
+    smp_transport *transport;
+    uint16_t group;
+    uint8_t command;
+    smp_rtt_class_t rtt_class;
+    smp_rtt_estimator estimator;
+};
+
 class smp_processor : public QObject
 {
     Q_OBJECT
@@ -65,8 +95,15 @@ public:
 #ifndef SKIPPLUGIN_LOGGER
     void set_logger(debug_logger *object);
 #endif
-    smp_transport_error_t send(smp_message *message, uint32_t timeout_ms, uint8_t repeats, bool allow_version_check);
+    smp_transport_error_t send(smp_message *message, uint32_t timeout_ms, uint8_t repeats, bool allow_version_check, smp_rtt_class_t rtt_class = SMP_RTT_CLASS_NORMAL);
     bool is_busy();
+    bool can_send();
+    uint8_t pending_count();
+    void set_window(uint8_t size);
+    uint8_t window();
+    bool window_negotiated();
+    void reset_window();
+    static uint8_t window_for_buffer_count(uint32_t buffer_count);
     void register_handler(uint16_t group, smp_group *handler);
     void unregister_handler(uint16_t group);
     void set_transport(smp_transport *transport_object);
@@ -77,9 +114,22 @@ public:
     void set_message_logging(bool enabled);
     void set_custom_message(bool enabled);
     void cancel();
+    void abandon_group(uint16_t group);
+    QStringList rtt_summary();
+    smp_metrics *metrics();
+    smp_message *acquire_message(uint16_t capacity);
+    smp_message_pool *messages();
 
 private:
     void cleanup();
+    void release_pending(int index, bool delete_message);
+    void recycle_message(smp_message *message);
+    int find_pending_group(uint16_t group, int exclude_index);
+    int find_handler(uint16_t group);
+    static uint16_t header_group(const smp_hdr *header);
+    void abort_pending(bool disconnected, int error_code);
+    int find_rtt_index(uint16_t group, uint8_t command, smp_rtt_class_t rtt_class);
+    QString rtt_entry_summary(int index);
     bool decode_message(QCborStreamReader &reader, uint8_t version, uint16_t level, QString *parent, smp_error_t *error);
 
 public slots:
@@ -89,18 +139,18 @@ public slots:
 
 signals:
     void custom_message_callback(enum custom_message_callback_t type, smp_error_t *data);
+    void rtt_updated(QString summary);
 
 private:
     uint8_t sequence;
     smp_transport *transport;
-    smp_message *last_message;
-    smp_hdr *last_message_header;
-    bool last_message_version_check;
-    uint8_t last_message_version;
-    QTimer repeat_timer;
-    uint8_t repeat_times;
-    bool busy;
+    QList<smp_pending_t> pending;
+    uint8_t window_size;
+    bool window_known;
     QList<smp_group_match_t> group_handlers;
+    QList<smp_rtt_entry_t> rtt_estimators;
+    smp_metrics transaction_metrics;
+    smp_message_pool message_pool;
 #if defined(PLUGIN_MCUMGR_JSON)
     smp_json *json_object;
 #endif
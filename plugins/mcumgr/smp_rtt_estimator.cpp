@@ -0,0 +1,136 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_rtt_estimator.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_rtt_estimator.h"
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+//Maximum number of times the timeout is doubled
+static const uint8_t backoff_shift_max = 10;
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_rtt_estimator::smp_rtt_estimator()
+{
+    smoothed_rtt = 0;
+    rtt_variance = 0;
+    samples = 0;
+    backoff_shift = 0;
+}
+
+void smp_rtt_estimator::add_sample(uint32_t rtt_ms)
+{
+    //Samples must only be taken from requests which were not retransmitted (Karn's algorithm)
+    if (samples == 0)
+    {
+        smoothed_rtt = rtt_ms;
+        rtt_variance = rtt_ms / 2;
+    }
+    else
+    {
+        uint32_t difference = (smoothed_rtt > rtt_ms ? (smoothed_rtt - rtt_ms) : (rtt_ms - smoothed_rtt));
+
+        //RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R|, SRTT = 7/8 SRTT + 1/8 R
+        rtt_variance = (rtt_variance * 3 + difference) / 4;
+        smoothed_rtt = (smoothed_rtt * 7 + rtt_ms) / 8;
+    }
+
+    ++samples;
+    backoff_shift = 0;
+}
+
+void smp_rtt_estimator::backoff()
+{
+    //A request timed out, double the timeout until a new sample is taken
+    if (backoff_shift < backoff_shift_max)
+    {
+        ++backoff_shift;
+    }
+}
+
+uint32_t smp_rtt_estimator::timeout(uint32_t default_ms)
+{
+    //The supplied default is a lower bound, the estimate only extends it for devices or links which are slower than expected
+    uint64_t rto;
+    uint64_t limit = (default_ms > SMP_RTO_MAX_MS ? default_ms : SMP_RTO_MAX_MS);
+
+    if (samples == 0)
+    {
+        rto = default_ms;
+    }
+    else
+    {
+        uint32_t variance = rtt_variance * 4;
+
+        rto = smoothed_rtt + (variance > SMP_RTO_GRANULARITY_MS ? variance : SMP_RTO_GRANULARITY_MS);
+
+        if (rto < SMP_RTO_MIN_MS)
+        {
+            rto = SMP_RTO_MIN_MS;
+        }
+
+        if (rto < default_ms)
+        {
+            //Some commands (hashing, erasing, resetting) take far longer on the device than others of the same kind, so a fast history must not shorten the timeout
+            rto = default_ms;
+        }
+    }
+
+    rto <<= backoff_shift;
+
+    if (rto > limit)
+    {
+        rto = limit;
+    }
+
+    return (uint32_t)rto;
+}
+
+bool smp_rtt_estimator::has_samples()
+{
+    return (samples > 0);
+}
+
+uint32_t smp_rtt_estimator::srtt()
+{
+    return smoothed_rtt;
+}
+
+uint32_t smp_rtt_estimator::rttvar()
+{
+    return rtt_variance;
+}
+
+uint32_t smp_rtt_estimator::sample_count()
+{
+    return samples;
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
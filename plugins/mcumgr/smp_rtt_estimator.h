@@ -0,0 +1,74 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_rtt_estimator.h
+**
+** Notes:   Round trip time estimator for request timeouts, based on the TCP
+**          retransmission timer (RFC 6298)
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_RTT_ESTIMATOR_H
+#define SMP_RTT_ESTIMATOR_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+#define SMP_RTO_MIN_MS 250
+#define SMP_RTO_MAX_MS 120000
+#define SMP_RTO_GRANULARITY_MS 10
+
+/******************************************************************************/
+// Enum typedefs
+/******************************************************************************/
+//Requests of the same command with very different response times are estimated separately
+enum smp_rtt_class_t {
+    SMP_RTT_CLASS_NORMAL,
+    SMP_RTT_CLASS_ERASE,
+};
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_rtt_estimator
+{
+public:
+    smp_rtt_estimator();
+    void add_sample(uint32_t rtt_ms);
+    void backoff();
+    uint32_t timeout(uint32_t default_ms);
+    bool has_samples();
+    uint32_t srtt();
+    uint32_t rttvar();
+    uint32_t sample_count();
+
+private:
+    uint32_t smoothed_rtt;
+    uint32_t rtt_variance;
+    uint32_t samples;
+    uint8_t backoff_shift;
+};
+
+#endif // SMP_RTT_ESTIMATOR_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,338 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_stat_history.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_stat_history.h"
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+static QString csv_field(QString field)
+{
+    if (field.contains(',') == true || field.contains('"') == true)
+    {
+        return QString("\"%1\"").arg(field.replace("\"", "\"\""));
+    }
+
+    return field;
+}
+
+smp_stat_history::smp_stat_history(uint32_t capacity)
+{
+    ring_capacity = (capacity > 1 ? capacity : 2);
+    clear();
+}
+
+void smp_stat_history::clear()
+{
+    series_list.clear();
+    clock.start();
+    started = QDateTime::currentDateTime();
+}
+
+uint32_t smp_stat_history::now()
+{
+    return (uint32_t)clock.elapsed();
+}
+
+QDateTime smp_stat_history::start_time()
+{
+    return started;
+}
+
+int smp_stat_history::find_series(QString group, QString counter)
+{
+    int i = 0;
+
+    while (i < series_list.length())
+    {
+        if (series_list.at(i).counter == counter && series_list.at(i).group == group)
+        {
+            return i;
+        }
+
+        ++i;
+    }
+
+    return -1;
+}
+
+int smp_stat_history::add_series(QString group, QString counter)
+{
+    int index = find_series(group, counter);
+
+    if (index < 0)
+    {
+        smp_stat_series_t series;
+
+        series.group = group;
+        series.counter = counter;
+        series.oldest = 0;
+        series_list.append(series);
+        index = series_list.length() - 1;
+    }
+
+    return index;
+}
+
+int smp_stat_history::series_count()
+{
+    return series_list.length();
+}
+
+QString smp_stat_history::series_group(int series)
+{
+    return series_list.at(series).group;
+}
+
+QString smp_stat_history::series_counter(int series)
+{
+    return series_list.at(series).counter;
+}
+
+void smp_stat_history::append(int series, uint32_t time, uint32_t value)
+{
+    //The ring is only grown as samples arrive, counters which are polled briefly do not use the full capacity
+    smp_stat_series_t *entry = &series_list[series];
+    smp_stat_sample_t new_sample;
+
+    new_sample.time = time;
+    new_sample.value = value;
+
+    if ((uint32_t)entry->samples.length() < ring_capacity)
+    {
+        entry->samples.append(new_sample);
+    }
+    else
+    {
+        entry->samples[entry->oldest] = new_sample;
+        entry->oldest = (entry->oldest + 1) % ring_capacity;
+    }
+}
+
+uint32_t smp_stat_history::length(int series)
+{
+    return (uint32_t)series_list.at(series).samples.length();
+}
+
+smp_stat_sample_t smp_stat_history::sample(int series, uint32_t index)
+{
+    //Index 0 is the oldest sample
+    const smp_stat_series_t *entry = &series_list.at(series);
+
+    return entry->samples.at((entry->oldest + index) % entry->samples.length());
+}
+
+bool smp_stat_history::latest(int series, uint32_t *value, uint32_t *delta, double *rate)
+{
+    uint32_t samples = length(series);
+
+    if (samples == 0)
+    {
+        return false;
+    }
+
+    *value = sample(series, samples - 1).value;
+
+    if (samples == 1)
+    {
+        *delta = 0;
+        *rate = 0.0;
+    }
+    else
+    {
+        *delta = counter_delta(sample(series, samples - 2).value, *value);
+        *rate = sample_rate(series, samples - 1);
+    }
+
+    return true;
+}
+
+uint32_t smp_stat_history::counter_delta(uint32_t previous, uint32_t current)
+{
+    //Stats are 16 or 32 bits on the device, a small value following one close to the top of
+    //either range is taken as a wrap, any other decrease as the device resetting its stats
+    if (current >= previous)
+    {
+        return current - previous;
+    }
+    else if (previous >= 0xc0000000 && current < 0x40000000)
+    {
+        return current - previous;
+    }
+    else if (previous >= 0xc000 && previous <= 0xffff && current < 0x4000)
+    {
+        return current + 0x10000 - previous;
+    }
+
+    return current;
+}
+
+double smp_stat_history::sample_rate(int series, uint32_t index)
+{
+    smp_stat_sample_t previous = sample(series, index - 1);
+    smp_stat_sample_t current = sample(series, index);
+
+    if (current.time <= previous.time)
+    {
+        return 0.0;
+    }
+
+    return ((double)counter_delta(previous.value, current.value) * 1000.0) / (double)(current.time - previous.time);
+}
+
+void smp_stat_history::decimate(int series, bool rate, uint32_t start, uint32_t end, uint16_t buckets, QVector<QPointF> *points)
+{
+    //Min-max decimation: each bucket contributes its lowest and highest points in time order, so
+    //spikes are kept however much history is shown and the output size only depends on the bucket count
+    uint32_t samples = length(series);
+    uint32_t low = 0;
+    uint32_t high = samples;
+    double bucket_width;
+    int32_t current_bucket = -1;
+    QPointF bucket_min;
+    QPointF bucket_max;
+
+    points->clear();
+
+    if (samples == 0 || buckets == 0 || end <= start)
+    {
+        return;
+    }
+
+    //Samples are in time order, find the first one in range
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+
+        if (sample(series, middle).time < start)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if (rate == true && low == 0)
+    {
+        //Rate needs the previous sample
+        low = 1;
+    }
+
+    bucket_width = (double)(end - start) / (double)buckets;
+
+    while (low < samples)
+    {
+        smp_stat_sample_t current = sample(series, low);
+        QPointF point((double)current.time, (rate == true ? sample_rate(series, low) : (double)current.value));
+        int32_t bucket;
+
+        if (current.time > end)
+        {
+            break;
+        }
+
+        bucket = (int32_t)((double)(current.time - start) / bucket_width);
+
+        if (bucket != current_bucket)
+        {
+            if (current_bucket >= 0)
+            {
+                points->append(bucket_min.x() <= bucket_max.x() ? bucket_min : bucket_max);
+
+                if (bucket_min != bucket_max)
+                {
+                    points->append(bucket_min.x() <= bucket_max.x() ? bucket_max : bucket_min);
+                }
+            }
+
+            current_bucket = bucket;
+            bucket_min = point;
+            bucket_max = point;
+        }
+        else if (point.y() < bucket_min.y())
+        {
+            bucket_min = point;
+        }
+        else if (point.y() > bucket_max.y())
+        {
+            bucket_max = point;
+        }
+
+        ++low;
+    }
+
+    if (current_bucket >= 0)
+    {
+        points->append(bucket_min.x() <= bucket_max.x() ? bucket_min : bucket_max);
+
+        if (bucket_min != bucket_max)
+        {
+            points->append(bucket_min.x() <= bucket_max.x() ? bucket_max : bucket_min);
+        }
+    }
+}
+
+void smp_stat_history::write_csv(QTextStream *stream)
+{
+    //One row per sample, so groups polled at different times do not need to be aligned
+    int i = 0;
+
+    *stream << "timestamp,seconds,group,counter,value,delta,rate_per_second\n";
+
+    while (i < series_list.length())
+    {
+        uint32_t samples = length(i);
+        uint32_t l = 0;
+        QString prefix = QString(",%1,%2,").arg(csv_field(series_list.at(i).group), csv_field(series_list.at(i).counter));
+
+        while (l < samples)
+        {
+            smp_stat_sample_t current = sample(i, l);
+
+            *stream << started.addMSecs(current.time).toString(Qt::ISODateWithMs) << "," << QString::number((double)current.time / 1000.0, 'f', 3) << prefix << current.value;
+
+            if (l > 0)
+            {
+                *stream << "," << counter_delta(sample(i, l - 1).value, current.value) << "," << QString::number(sample_rate(i, l), 'f', 3);
+            }
+            else
+            {
+                *stream << ",,";
+            }
+
+            *stream << "\n";
+            ++l;
+        }
+
+        ++i;
+    }
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,94 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_stat_history.h
+**
+** Notes:   Time series storage for polled stat_mgmt counters, each counter
+**          has a fixed size ring of samples so memory use is bounded
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_STAT_HISTORY_H
+#define SMP_STAT_HISTORY_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QString>
+#include <QVector>
+#include <QPointF>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+//Samples kept per counter, 8 bytes each: 4.5 hours of history at a 1 second poll rate
+const uint32_t smp_stat_history_default_capacity = 16384;
+
+/******************************************************************************/
+// Forward declaration of Class, Struct & Unions
+/******************************************************************************/
+struct smp_stat_sample_t {
+    uint32_t time;              //ms since the history was cleared
+    uint32_t value;
+};
+
+struct smp_stat_series_t {
+    QString group;
+    QString counter;
+    QVector<smp_stat_sample_t> samples;
+    uint32_t oldest;            //Index of the oldest sample once the ring is full
+};
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_stat_history
+{
+public:
+    smp_stat_history(uint32_t capacity = smp_stat_history_default_capacity);
+    void clear();
+    uint32_t now();
+    QDateTime start_time();
+    int find_series(QString group, QString counter);
+    int add_series(QString group, QString counter);
+    int series_count();
+    QString series_group(int series);
+    QString series_counter(int series);
+    void append(int series, uint32_t time, uint32_t value);
+    uint32_t length(int series);
+    smp_stat_sample_t sample(int series, uint32_t index);
+    bool latest(int series, uint32_t *value, uint32_t *delta, double *rate);
+    void decimate(int series, bool rate, uint32_t start, uint32_t end, uint16_t buckets, QVector<QPointF> *points);
+    void write_csv(QTextStream *stream);
+    static uint32_t counter_delta(uint32_t previous, uint32_t current);
+
+private:
+    double sample_rate(int series, uint32_t index);
+
+    uint32_t ring_capacity;
+    QVector<smp_stat_series_t> series_list;
+    QElapsedTimer clock;
+    QDateTime started;
+};
+
+#endif // SMP_STAT_HISTORY_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
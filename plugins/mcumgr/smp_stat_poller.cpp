@@ -0,0 +1,218 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_stat_poller.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_stat_poller.h"
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_stat_poller::smp_stat_poller(smp_processor *processor_object, smp_group_stat_mgmt *stat_group, smp_stat_history *history_object, QObject *parent) : QObject(parent)
+{
+    processor = processor_object;
+    stat_mgmt = stat_group;
+    history = history_object;
+    running = false;
+    request_pending = false;
+    poll_user_data = 0;
+    group_index = 0;
+    interval = smp_stat_poller_default_interval_ms;
+    cycle_start = 0;
+    request_sent = 0;
+    cycles = 0;
+    samples = 0;
+    missed = 0;
+
+    poll_timer.setSingleShot(true);
+    connect(&poll_timer, SIGNAL(timeout()), this, SLOT(poll_next()));
+    connect(stat_mgmt, SIGNAL(status(uint8_t,group_status,QString)), this, SLOT(group_finished(uint8_t,group_status,QString)));
+}
+
+smp_stat_poller::~smp_stat_poller()
+{
+    poll_timer.stop();
+    disconnect(this, SLOT(poll_next()));
+    disconnect(this, SLOT(group_finished(uint8_t,group_status,QString)));
+}
+
+bool smp_stat_poller::start(QStringList groups, uint32_t interval_ms, uint8_t user_data, QString *error)
+{
+    if (running == true)
+    {
+        *error = "Polling already in progress";
+        return false;
+    }
+
+    if (groups.isEmpty() == true)
+    {
+        *error = "No stat groups to poll";
+        return false;
+    }
+
+    if (interval_ms < smp_stat_poller_minimum_interval_ms)
+    {
+        *error = QString("Poll interval must be at least %1 ms").arg(QString::number(smp_stat_poller_minimum_interval_ms));
+        return false;
+    }
+
+    poll_groups = groups;
+    interval = interval_ms;
+    poll_user_data = user_data;
+    group_index = 0;
+    request_pending = false;
+    cycles = 0;
+    samples = 0;
+    missed = 0;
+    running = true;
+
+    //Started from the event loop so that no status is reported before this returns
+    poll_timer.start(0);
+
+    return true;
+}
+
+void smp_stat_poller::cancel()
+{
+    if (running == false)
+    {
+        return;
+    }
+
+    //Stopping is the normal way for polling to end, statuses from the request being cancelled are ignored once stopped
+    running = false;
+
+    if (request_pending == true)
+    {
+        request_pending = false;
+        stat_mgmt->cancel();
+    }
+
+    finish(true, QString());
+}
+
+bool smp_stat_poller::is_busy()
+{
+    return running;
+}
+
+void smp_stat_poller::poll_next()
+{
+    if (running == false)
+    {
+        return;
+    }
+
+    if (processor->is_busy() == true)
+    {
+        //Another operation is using the transport, only one request is sent at a time
+        poll_timer.start(smp_stat_poller_busy_retry_ms);
+        return;
+    }
+
+    if (group_index == 0)
+    {
+        cycle_start = history->now();
+    }
+
+    //Failures to send are reported through the status signal
+    request_sent = history->now();
+    request_pending = true;
+    stat_mgmt->start_group_data(poll_groups.at(group_index), &stat_values);
+}
+
+void smp_stat_poller::group_finished(uint8_t user_data, group_status status, QString error_string)
+{
+    uint32_t cycle_time;
+
+    if (user_data != poll_user_data || running == false || request_pending == false)
+    {
+        return;
+    }
+
+    request_pending = false;
+
+    if (status == STATUS_COMPLETE)
+    {
+        //The counters were read at some point during the request, the midpoint is the best estimate
+        uint32_t sample_time = request_sent + (history->now() - request_sent) / 2;
+        const QString &group = poll_groups.at(group_index);
+
+        for (const stat_value_t &value : stat_values)
+        {
+            history->append(history->add_series(group, value.name), sample_time, value.value);
+            ++samples;
+        }
+
+        emit polled(group);
+    }
+    else if (status == STATUS_TIMEOUT)
+    {
+        ++missed;
+    }
+    else
+    {
+        finish(false, error_string);
+        return;
+    }
+
+    ++group_index;
+
+    if (group_index < poll_groups.length())
+    {
+        poll_timer.start(0);
+        return;
+    }
+
+    //If a cycle takes longer than the interval, a minimum gap is still left so the link is not saturated
+    group_index = 0;
+    ++cycles;
+    cycle_time = history->now() - cycle_start;
+    poll_timer.start(cycle_time + smp_stat_poller_minimum_interval_ms > interval ? smp_stat_poller_minimum_interval_ms : interval - cycle_time);
+}
+
+void smp_stat_poller::finish(bool success, QString error)
+{
+    QString summary;
+
+    running = false;
+    poll_timer.stop();
+
+    if (success == true)
+    {
+        summary = "Polling stopped, ";
+    }
+    else
+    {
+        summary = error.append(", ");
+    }
+
+    summary.append(QString("%1 cycle%2, %3 sample%4, %5 missed").arg(QString::number(cycles), (cycles == 1 ? "" : "s"), QString::number(samples), (samples == 1 ? "" : "s"), QString::number(missed)));
+
+    emit finished(success, summary);
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,93 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_stat_poller.h
+**
+** Notes:   Periodically fetches a list of stat_mgmt groups, one request at a
+**          time, and stores the counters in a stat history
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_STAT_POLLER_H
+#define SMP_STAT_POLLER_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QObject>
+#include <QTimer>
+#include <QStringList>
+#include "smp_processor.h"
+#include "smp_group_stat_mgmt.h"
+#include "smp_stat_history.h"
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+const uint32_t smp_stat_poller_default_interval_ms = 1000;
+const uint32_t smp_stat_poller_minimum_interval_ms = 100;
+
+//Delay before trying again when another operation is using the processor
+const uint32_t smp_stat_poller_busy_retry_ms = 50;
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_stat_poller : public QObject
+{
+    Q_OBJECT
+
+public:
+    smp_stat_poller(smp_processor *processor_object, smp_group_stat_mgmt *stat_group, smp_stat_history *history_object, QObject *parent = nullptr);
+    ~smp_stat_poller();
+    bool start(QStringList groups, uint32_t interval_ms, uint8_t user_data, QString *error);
+    void cancel();
+    bool is_busy();
+
+signals:
+    void polled(QString group);
+    void finished(bool success, QString summary);
+
+private slots:
+    void poll_next();
+    void group_finished(uint8_t user_data, group_status status, QString error_string);
+
+private:
+    void finish(bool success, QString error);
+
+    smp_processor *processor;
+    smp_group_stat_mgmt *stat_mgmt;
+    smp_stat_history *history;
+    bool running;
+    bool request_pending;
+    uint8_t poll_user_data;
+    QStringList poll_groups;
+    int group_index;
+    uint32_t interval;
+    uint32_t cycle_start;
+    uint32_t request_sent;
+    QList<stat_value_t> stat_values;
+    QTimer poll_timer;
+    uint32_t cycles;
+    uint32_t samples;
+    uint32_t missed;
+};
+
+#endif // SMP_STAT_POLLER_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -0,0 +1,392 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_task_sampler.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "smp_task_sampler.h"
+#include <QtMath>
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+smp_task_sampler::smp_task_sampler(smp_processor *processor_object, smp_group_os_mgmt *os_group, QObject *parent) : QObject(parent)
+{
+    processor = processor_object;
+    os_mgmt = os_group;
+    running = false;
+    request_pending = false;
+    sampler_user_data = 0;
+    interval = smp_task_sampler_default_interval_ms;
+    request_sent = 0;
+    samples_taken = 0;
+    missed = 0;
+
+    sample_timer.setSingleShot(true);
+    connect(&sample_timer, SIGNAL(timeout()), this, SLOT(sample_next()));
+    connect(os_mgmt, SIGNAL(status(uint8_t,group_status,QString)), this, SLOT(group_finished(uint8_t,group_status,QString)));
+}
+
+smp_task_sampler::~smp_task_sampler()
+{
+    sample_timer.stop();
+    disconnect(this, SLOT(sample_next()));
+    disconnect(this, SLOT(group_finished(uint8_t,group_status,QString)));
+}
+
+bool smp_task_sampler::start(uint32_t interval_ms, uint8_t user_data, QString *error)
+{
+    if (running == true)
+    {
+        *error = "Sampling already in progress";
+        return false;
+    }
+
+    if (interval_ms < smp_task_sampler_minimum_interval_ms)
+    {
+        *error = QString("Sample interval must be at least %1 ms").arg(QString::number(smp_task_sampler_minimum_interval_ms));
+        return false;
+    }
+
+    interval = interval_ms;
+    sampler_user_data = user_data;
+    request_pending = false;
+    samples_taken = 0;
+    missed = 0;
+    thread_list.clear();
+    clock.start();
+    running = true;
+
+    //Started from the event loop so that no status is reported before this returns
+    sample_timer.start(0);
+
+    return true;
+}
+
+void smp_task_sampler::cancel()
+{
+    if (running == false)
+    {
+        return;
+    }
+
+    //Stopping is the normal way for sampling to end, statuses from the request being cancelled are ignored once stopped
+    running = false;
+
+    if (request_pending == true)
+    {
+        request_pending = false;
+        os_mgmt->cancel();
+    }
+
+    finish(true, QString());
+}
+
+bool smp_task_sampler::is_busy()
+{
+    return running;
+}
+
+const QList<smp_task_thread_t> &smp_task_sampler::threads()
+{
+    return thread_list;
+}
+
+uint32_t smp_task_sampler::sample_count(const smp_task_thread_t *thread)
+{
+    return thread->samples.length();
+}
+
+smp_task_sample_t smp_task_sampler::sample(const smp_task_thread_t *thread, uint32_t index)
+{
+    //Index 0 is the oldest sample
+    return thread->samples.at((thread->oldest + index) % thread->samples.length());
+}
+
+double smp_task_sampler::average_cpu_percent(const smp_task_thread_t *thread)
+{
+    double total = 0.0;
+
+    if (thread->samples.isEmpty() == true)
+    {
+        return 0.0;
+    }
+
+    for (const smp_task_sample_t &entry : thread->samples)
+    {
+        total += entry.cpu_percent;
+    }
+
+    return total / thread->samples.length();
+}
+
+int32_t smp_task_sampler::stack_trend(const smp_task_thread_t *thread)
+{
+    //Change in stack usage across the retained history
+    if (thread->samples.isEmpty() == true)
+    {
+        return 0;
+    }
+
+    return (int32_t)(sample(thread, thread->samples.length() - 1).stack_usage - sample(thread, 0).stack_usage);
+}
+
+void smp_task_sampler::sample_next()
+{
+    if (running == false)
+    {
+        return;
+    }
+
+    if (processor->is_busy() == true)
+    {
+        //Another operation is using the transport, only one request is sent at a time
+        sample_timer.start(smp_task_sampler_busy_retry_ms);
+        return;
+    }
+
+    //Failures to send are reported through the status signal
+    request_sent = clock.elapsed();
+    request_pending = true;
+    os_mgmt->start_task_stats(&task_list);
+}
+
+void smp_task_sampler::group_finished(uint8_t user_data, group_status status, QString error_string)
+{
+    uint32_t request_time;
+
+    if (user_data != sampler_user_data || running == false || request_pending == false)
+    {
+        return;
+    }
+
+    request_pending = false;
+    request_time = clock.elapsed() - request_sent;
+
+    if (status == STATUS_COMPLETE)
+    {
+        //The counters were read at some point during the request, the midpoint is the best estimate
+        process_sample(request_sent + request_time / 2);
+        ++samples_taken;
+        emit sampled();
+    }
+    else if (status == STATUS_TIMEOUT)
+    {
+        ++missed;
+    }
+    else
+    {
+        finish(false, error_string);
+        return;
+    }
+
+    //If a request takes longer than the interval, a minimum gap is still left so the link is not saturated
+    sample_timer.start(request_time + smp_task_sampler_minimum_interval_ms > interval ? smp_task_sampler_minimum_interval_ms : interval - request_time);
+}
+
+int smp_task_sampler::find_thread(const task_list_t *task)
+{
+    int i = 0;
+
+    //Thread IDs can be reused once a thread exits, so the name must also match
+    while (i < thread_list.length())
+    {
+        if (thread_list.at(i).id == task->id && thread_list.at(i).name == task->name)
+        {
+            return i;
+        }
+
+        ++i;
+    }
+
+    return -1;
+}
+
+void smp_task_sampler::add_sample(smp_task_thread_t *thread, const smp_task_sample_t *new_sample)
+{
+    //History grows up to the capacity, then the oldest sample is overwritten
+    if ((uint32_t)thread->samples.length() < smp_task_sampler_history_capacity)
+    {
+        thread->samples.append(*new_sample);
+    }
+    else
+    {
+        thread->samples[thread->oldest] = *new_sample;
+        thread->oldest = (thread->oldest + 1) % smp_task_sampler_history_capacity;
+    }
+}
+
+void smp_task_sampler::process_sample(uint32_t time)
+{
+    QVector<int> indexes;
+    QVector<uint32_t> runtime_deltas;
+    QVector<uint32_t> context_switch_deltas;
+    QVector<bool> new_thread;
+    uint64_t total_runtime_delta = 0;
+    int i = 0;
+
+    for (smp_task_thread_t &thread : thread_list)
+    {
+        thread.present = false;
+        thread.flagged = false;
+    }
+
+    //First pass matches each task to a thread and works out how much it ran since the last sample
+    for (const task_list_t &task : task_list)
+    {
+        int index = find_thread(&task);
+        uint32_t runtime_delta = 0;
+        uint32_t context_switch_delta = 0;
+
+        new_thread.append(index == -1);
+
+        if (index == -1)
+        {
+            smp_task_thread_t thread;
+
+            thread.name = task.name;
+            thread.id = task.id;
+            thread.stack_peak = 0;
+            thread.stack_warned = false;
+            thread.flagged = (samples_taken > 0);
+            thread.oldest = 0;
+            thread_list.append(thread);
+            index = thread_list.length() - 1;
+
+            if (samples_taken > 0)
+            {
+                emit thread_event(QString("%1: thread started").arg(task.name));
+            }
+        }
+        else
+        {
+            //Counters are unsigned so a single wrap between samples still gives the correct difference
+            runtime_delta = task.runtime - thread_list.at(index).runtime;
+            context_switch_delta = task.context_switches - thread_list.at(index).context_switches;
+            total_runtime_delta += runtime_delta;
+        }
+
+        indexes.append(index);
+        runtime_deltas.append(runtime_delta);
+        context_switch_deltas.append(context_switch_delta);
+        thread_list[index].present = true;
+        thread_list[index].runtime = task.runtime;
+        thread_list[index].context_switches = task.context_switches;
+    }
+
+    //Second pass gives each thread its share of the total runtime of all threads, including idle
+    while (i < task_list.length())
+    {
+        const task_list_t &task = task_list.at(i);
+        smp_task_thread_t &thread = thread_list[indexes.at(i)];
+        smp_task_sample_t new_sample;
+
+        //Stack sizes are reported in words
+        thread.priority = task.priority;
+        thread.state = task.state;
+        thread.stack_size = task.stack_size * sizeof(uint32_t);
+        thread.stack_usage = task.stack_usage * sizeof(uint32_t);
+
+        if (new_thread.at(i) == true)
+        {
+            //Nothing to compare against until the next sample
+            thread.stack_peak = thread.stack_usage;
+            ++i;
+            continue;
+        }
+
+        new_sample.time = time;
+        new_sample.cpu_percent = (total_runtime_delta > 0 ? (float)(((double)runtime_deltas.at(i) * 100.0) / (double)total_runtime_delta) : 0.0f);
+        new_sample.runtime_delta = runtime_deltas.at(i);
+        new_sample.context_switch_delta = context_switch_deltas.at(i);
+        new_sample.stack_usage = thread.stack_usage;
+
+        if (thread.samples.isEmpty() == false)
+        {
+            float previous_cpu = sample(&thread, thread.samples.length() - 1).cpu_percent;
+
+            if (qFabs(new_sample.cpu_percent - previous_cpu) >= smp_task_sampler_cpu_change_threshold)
+            {
+                emit thread_event(QString("%1: CPU %2% -> %3%").arg(thread.name, QString::number(previous_cpu, 'f', 1), QString::number(new_sample.cpu_percent, 'f', 1)));
+                thread.flagged = true;
+            }
+        }
+
+        if (thread.stack_usage > thread.stack_peak)
+        {
+            emit thread_event(QString("%1: stack high-water up %2 to %3 of %4 bytes").arg(thread.name, QString::number(thread.stack_usage - thread.stack_peak), QString::number(thread.stack_usage), QString::number(thread.stack_size)));
+            thread.stack_peak = thread.stack_usage;
+            thread.flagged = true;
+        }
+
+        if (thread.stack_warned == false && thread.stack_size > 0 && ((uint64_t)thread.stack_usage * 100) >= ((uint64_t)thread.stack_size * smp_task_sampler_stack_warning_percent))
+        {
+            emit thread_event(QString("%1: stack usage at %2% of %3 bytes").arg(thread.name, QString::number(((uint64_t)thread.stack_usage * 100) / thread.stack_size), QString::number(thread.stack_size)));
+            thread.stack_warned = true;
+            thread.flagged = true;
+        }
+
+        add_sample(&thread, &new_sample);
+        ++i;
+    }
+
+    //Threads which have exited are dropped so the list stays bounded
+    i = 0;
+
+    while (i < thread_list.length())
+    {
+        if (thread_list.at(i).present == false)
+        {
+            emit thread_event(QString("%1: thread exited").arg(thread_list.at(i).name));
+            thread_list.removeAt(i);
+            continue;
+        }
+
+        ++i;
+    }
+}
+
+void smp_task_sampler::finish(bool success, QString error)
+{
+    QString summary;
+
+    running = false;
+    sample_timer.stop();
+
+    if (success == true)
+    {
+        summary = "Sampling stopped, ";
+    }
+    else
+    {
+        summary = error.append(", ");
+    }
+
+    summary.append(QString("%1 sample%2, %3 missed").arg(QString::number(samples_taken), (samples_taken == 1 ? "" : "s"), QString::number(missed)));
+
+    emit finished(success, summary);
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
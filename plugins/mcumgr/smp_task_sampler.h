@@ -0,0 +1,138 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  smp_task_sampler.h
+**
+** Notes:   Periodically fetches os_mgmt task stats and works out the CPU
+**          share and stack usage trend of each thread from the differences
+**          between samples
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef SMP_TASK_SAMPLER_H
+#define SMP_TASK_SAMPLER_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QObject>
+#include <QTimer>
+#include <QList>
+#include <QVector>
+#include <QElapsedTimer>
+#include "smp_processor.h"
+#include "smp_group_os_mgmt.h"
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+const uint32_t smp_task_sampler_default_interval_ms = 1000;
+const uint32_t smp_task_sampler_minimum_interval_ms = 100;
+
+//Delay before trying again when another operation is using the processor
+const uint32_t smp_task_sampler_busy_retry_ms = 50;
+
+//Samples kept per thread, 1 hour at a 1 second interval
+const uint32_t smp_task_sampler_history_capacity = 3600;
+
+//Change in CPU share between samples (in percentage points) which is reported
+const double smp_task_sampler_cpu_change_threshold = 20.0;
+
+//Stack usage (as a percentage of the stack size) which is reported
+const uint8_t smp_task_sampler_stack_warning_percent = 90;
+
+/******************************************************************************/
+// Forward declaration of Class, Struct & Unions
+/******************************************************************************/
+struct smp_task_sample_t {
+    uint32_t time;                  //ms since sampling started
+    float cpu_percent;
+    uint32_t runtime_delta;
+    uint32_t context_switch_delta;
+    uint32_t stack_usage;           //Bytes
+};
+
+struct smp_task_thread_t {
+    QString name;
+    uint32_t id;
+    uint32_t priority;
+    uint32_t state;
+    uint32_t stack_size;            //Bytes
+    uint32_t stack_usage;           //Bytes
+    uint32_t stack_peak;            //Highest usage seen whilst sampling
+    uint32_t runtime;
+    uint32_t context_switches;
+    bool stack_warned;
+    bool flagged;                   //An event was reported for the thread in the latest sample
+    bool present;
+    QVector<smp_task_sample_t> samples;
+    uint32_t oldest;                //Index of the oldest sample once the ring is full
+};
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class smp_task_sampler : public QObject
+{
+    Q_OBJECT
+
+public:
+    smp_task_sampler(smp_processor *processor_object, smp_group_os_mgmt *os_group, QObject *parent = nullptr);
+    ~smp_task_sampler();
+    bool start(uint32_t interval_ms, uint8_t user_data, QString *error);
+    void cancel();
+    bool is_busy();
+    const QList<smp_task_thread_t> &threads();
+    static uint32_t sample_count(const smp_task_thread_t *thread);
+    static smp_task_sample_t sample(const smp_task_thread_t *thread, uint32_t index);
+    static double average_cpu_percent(const smp_task_thread_t *thread);
+    static int32_t stack_trend(const smp_task_thread_t *thread);
+
+signals:
+    void sampled();
+    void thread_event(QString message);
+    void finished(bool success, QString summary);
+
+private slots:
+    void sample_next();
+    void group_finished(uint8_t user_data, group_status status, QString error_string);
+
+private:
+    void process_sample(uint32_t time);
+    int find_thread(const task_list_t *task);
+    void add_sample(smp_task_thread_t *thread, const smp_task_sample_t *new_sample);
+    void finish(bool success, QString error);
+
+    smp_processor *processor;
+    smp_group_os_mgmt *os_mgmt;
+    bool running;
+    bool request_pending;
+    uint8_t sampler_user_data;
+    uint32_t interval;
+    uint32_t request_sent;
+    QList<task_list_t> task_list;
+    QList<smp_task_thread_t> thread_list;
+    QTimer sample_timer;
+    QElapsedTimer clock;
+    uint32_t samples_taken;
+    uint32_t missed;
+};
+
+#endif // SMP_TASK_SAMPLER_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
@@ -102,6 +102,18 @@ public:
         return DEFAULT_TRANSPORT_TIMEOUT_MS;
     }
 
+    virtual QString device_identifier()
+    {
+        //Identifies the device which the transport is connected to, used to remember per-device settings, empty if unknown
+        return "";
+    }
+
+    virtual bool device_identifier_is_unique()
+    {
+        //False if every device on the transport has the same identifier, settings learnt from one device are then not applied to others
+        return true;
+    }
+
     virtual QString to_error_string(int error_code)
     {
         Q_UNUSED(error_code);
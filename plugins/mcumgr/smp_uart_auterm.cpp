@@ -22,7 +22,71 @@
 *******************************************************************************/
 #include "smp_uart_auterm.h"
 #include "crc16.h"
-#include <math.h>
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+static const uint8_t smp_uart_first_header_1 = 0x06;
+static const uint8_t smp_uart_first_header_2 = 0x09;
+static const uint8_t smp_uart_continuation_header_1 = 0x04;
+static const uint8_t smp_uart_continuation_header_2 = 0x14;
+static const uint8_t smp_uart_frame_end = 0x0a;
+static const int8_t base64_invalid = -1;
+static const int8_t base64_padding = -2;
+static const uint8_t smp_uart_length_size = 2;
+static const uint8_t smp_uart_crc_size = 2;
+static const uint8_t smp_uart_frame_data_size = 93; //Maximum decoded bytes per frame
+static const uint8_t smp_uart_frame_overhead = 3; //Frame header and footer
+static const uint8_t smp_uart_frame_size = 127; //Maximum encoded frame size, including header and footer
+static const char base64_characters[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+static inline int8_t base64_value(uint8_t character)
+{
+    if (character >= 'A' && character <= 'Z')
+    {
+        return character - 'A';
+    }
+    else if (character >= 'a' && character <= 'z')
+    {
+        return character - 'a' + 26;
+    }
+    else if (character >= '0' && character <= '9')
+    {
+        return character - '0' + 52;
+    }
+    else if (character == '+')
+    {
+        return 62;
+    }
+    else if (character == '/')
+    {
+        return 63;
+    }
+    else if (character == '=')
+    {
+        return base64_padding;
+    }
+
+    return base64_invalid;
+}
+
+static inline uint8_t frame_byte(uint32_t pos, const uint8_t *data, uint16_t size, uint16_t packet_length, uint16_t crc)
+{
+    //Byte at pos of the unencoded frame data: packet length, message data, then CRC (all big endian)
+    if (pos < smp_uart_length_size)
+    {
+        return (pos == 0 ? (uint8_t)(packet_length >> 8) : (uint8_t)(packet_length & 0xff));
+    }
+    else if (pos < ((uint32_t)size + smp_uart_length_size))
+    {
+        return data[(pos - smp_uart_length_size)];
+    }
+
+    return (pos == ((uint32_t)size + smp_uart_length_size) ? (uint8_t)(crc >> 8) : (uint8_t)(crc & 0xff));
+}
 
 smp_uart_auterm::smp_uart_auterm(QObject *parent)
 {
@@ -47,6 +111,10 @@ void smp_uart_auterm::data_received(QByteArray *message)
 
 void smp_uart_auterm::serial_read(QByteArray *rec_data)
 {
+    const uint8_t *data;
+    int length;
+    int i = 0;
+
     if (this->raw_mode == true)
     {
         received_data.append(*rec_data);
@@ -60,240 +128,398 @@ void smp_uart_auterm::serial_read(QByteArray *rec_data)
         return;
     }
 
-    SerialData.append(*rec_data);
+    //Decode frames in a single forward pass, the received data is not kept
+    data = (const uint8_t *)rec_data->constData();
+    length = rec_data->length();
 
-    //Search for SMP packets
-    int32_t pos = SerialData.indexOf(smp_first_header);
-    int32_t pos_other = SerialData.indexOf(smp_continuation_header);
-    int32_t posA = SerialData.indexOf(0x0a, pos + 2);
-    int32_t posA_other = SerialData.indexOf(0x0a, pos_other + 2);
-
-    while ((pos != -1 && posA != -1) || (pos_other != -1 && posA_other != -1))
-//        while (pos != -1 && posA != -1 /*&& SMPWaitingForContinuation == false*/)
+    while (i < length)
     {
-        if (pos >= 0 && (pos_other == -1 || pos < pos_other))
+        uint8_t byte = data[i];
+
+        switch (decode_state)
         {
-            //Start
-            //Check this header
-            SMPBuffer.clear();
-#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
-            SMPBuffer = QByteArray::fromBase64(SerialData.mid((pos + 2), (posA - pos - 2)), QByteArray::AbortOnBase64DecodingErrors);
-#else
-            SMPBuffer = QByteArray::fromBase64(SerialData.mid((pos + 2), (posA - pos - 2)));
-#endif
-
-            if (SMPBuffer.length() == 0)
-            {
-                log_error() << "Failed decoding base64";
-            }
-            else if (SMPBuffer.length() > 2)
+            case SMP_UART_DECODE_BODY:
             {
-                //Check length
-                waiting_packet_length = ((uint16_t)SMPBuffer[0]) << 8;
-                waiting_packet_length |= ((uint16_t)SMPBuffer[1] & 0xff);
-                SMPBuffer.remove(0, 2);
-                if (SMPBuffer.length() >= (waiting_packet_length))
-                {
-                    //We have a full packet, check the checksum
-                    uint16_t crc = crc16(&SMPBuffer, 0, SMPBuffer.length() - 2, 0x1021, 0, true);
-                    uint16_t message_crc = ((uint16_t)SMPBuffer[(SMPBuffer.length() - 2)]) << 8;
-                    message_crc |= SMPBuffer[(SMPBuffer.length() - 1)] & 0xff;
+                int8_t value;
 
-                    if (crc == message_crc)
-                    {
-                        //Good to parse message after removing CRC
-                        SMPBuffer.remove((SMPBuffer.length() - 2), 2);
-                        data_received(&SMPBuffer);
-                    }
-                    else
-                    {
-                        //CRC failure
-                        log_error() << "CRC failure, expected " << message_crc << " but got " << crc;
-                    }
-                }
-                else
+                if (byte == smp_uart_frame_end)
                 {
-                    //More data expected in another packet
-                    SMPWaitingForContinuation = true;
-                    SMPBufferActualData = SMPBuffer;
+                    decode_frame_end();
+                    decode_state = SMP_UART_DECODE_IDLE;
+                    break;
                 }
-            }
 
-            SerialData.remove(pos, (posA - pos + 1));
+                value = base64_value(byte);
 
-            pos = SerialData.indexOf(smp_first_header);
-            posA = SerialData.indexOf(0x0a, pos + 2);
-            pos_other = SerialData.indexOf(smp_continuation_header);
-            posA_other = SerialData.indexOf(0x0a, pos_other + 2);
-        }
-        else if (SMPWaitingForContinuation == true)
-        {
-            //Continuation
-            //Check this header
-            SMPBuffer.clear();
-#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
-            SMPBuffer = QByteArray::fromBase64(SerialData.mid((pos_other + 2), (posA_other - pos_other - 2)), QByteArray::AbortOnBase64DecodingErrors);
-#else
-            SMPBuffer = QByteArray::fromBase64(SerialData.mid((pos_other + 2), (posA_other - pos_other - 2)));
-#endif
-
-            if (SMPBuffer.length() == 0)
-            {
-                log_error() << "Failed decoding base64";
-            }
-            else if (SMPBuffer.length() > 0)
-            {
-                //Check length
-                SMPBufferActualData.append(SMPBuffer);
-                if (SMPBufferActualData.length() >= (waiting_packet_length /*+ 2*/))
+                if (value >= 0 && decode_padding == 0)
                 {
-                    //We have a full packet, check the checksum
-                    uint16_t crc = crc16(&SMPBufferActualData, 0, SMPBufferActualData.length() - 2, 0x1021, 0, true);
-                    uint16_t message_crc = ((uint16_t)SMPBufferActualData[(SMPBufferActualData.length() - 2)]) << 8;
-                    message_crc |= SMPBufferActualData[(SMPBufferActualData.length() - 1)] & 0xff;
+                    decode_quantum_data[decode_quantum_count] = value;
+                    ++decode_quantum_count;
 
-                    if (crc == message_crc)
+                    if (decode_quantum_count == 4)
                     {
-                        //Good to parse message after removing CRC
-                        SMPBufferActualData.remove((SMPBufferActualData.length() - 2), 2);
-                        data_received(&SMPBufferActualData);
+                        decode_quantum_count = 0;
+
+                        if (decode_quantum(3) == false)
+                        {
+                            decode_reset_packet();
+                            decode_state = SMP_UART_DECODE_SKIP_FRAME;
+                        }
                     }
-                    else
+
+                    break;
+                }
+                else if (value == base64_padding && decode_quantum_count >= 2 && (decode_quantum_count + decode_padding) < 4)
+                {
+                    //Padding ends the frame data
+                    ++decode_padding;
+
+                    if ((decode_quantum_count + decode_padding) == 4)
                     {
-                        //CRC failure
-                        log_error() << "CRC failure, expected " << message_crc << " but got " << crc;
+                        uint8_t count = decode_quantum_count - 1;
+                        decode_quantum_count = 0;
+
+                        if (decode_quantum(count) == false)
+                        {
+                            decode_reset_packet();
+                            decode_state = SMP_UART_DECODE_SKIP_FRAME;
+                        }
                     }
 
-                    SMPBufferActualData.clear();
-                    SMPWaitingForContinuation = false;
+                    break;
+                }
+
+                //Not valid base64, drop the packet and check if this byte starts a new frame
+                log_error() << "Failed decoding base64";
+                decode_reset_packet();
+                decode_state = SMP_UART_DECODE_IDLE;
+                continue;
+            }
+
+            case SMP_UART_DECODE_SKIP_FRAME:
+            {
+                if (byte == smp_uart_frame_end)
+                {
+                    decode_state = SMP_UART_DECODE_IDLE;
                 }
-                else
+                else if (byte == smp_uart_first_header_1 || byte == smp_uart_continuation_header_1)
                 {
-                    //More data expected in another packet
-                    SMPWaitingForContinuation = true;
+                    //Cannot be part of base64 data, frame has been cut short
+                    decode_state = SMP_UART_DECODE_IDLE;
+                    continue;
                 }
-            }
 
-            SerialData.remove(pos_other, (posA_other - pos_other + 1));
+                break;
+            }
 
-            pos = SerialData.indexOf(smp_first_header);
-            if (pos == -1)
+            case SMP_UART_DECODE_HEADER_FIRST:
             {
-                posA = -1;
+                if (byte != smp_uart_first_header_2)
+                {
+                    decode_state = SMP_UART_DECODE_IDLE;
+                    continue;
+                }
+
+                //Start of a new packet, any incomplete packet is discarded
+                decode_reset_packet();
+                decode_packet_open = true;
+                decode_first_frame = true;
+                decode_quantum_count = 0;
+                decode_padding = 0;
+                decode_state = SMP_UART_DECODE_BODY;
+                break;
             }
-            else
+
+            case SMP_UART_DECODE_HEADER_CONTINUATION:
             {
-                posA = SerialData.indexOf(0x0a, pos + 2);
+                if (byte != smp_uart_continuation_header_2)
+                {
+                    decode_state = SMP_UART_DECODE_IDLE;
+                    continue;
+                }
+
+                if (decode_packet_open == false)
+                {
+                    //Continuation without a first frame, ignore it
+                    decode_state = SMP_UART_DECODE_SKIP_FRAME;
+                    break;
+                }
+
+                decode_first_frame = false;
+                decode_quantum_count = 0;
+                decode_padding = 0;
+                decode_state = SMP_UART_DECODE_BODY;
+                break;
             }
-            pos_other = SerialData.indexOf(smp_continuation_header);
-            if (pos_other == -1)
+
+            default:
             {
-                posA_other = -1;
+                //Search for a frame header, anything else is non-SMP data
+                if (byte == smp_uart_first_header_1)
+                {
+                    decode_state = SMP_UART_DECODE_HEADER_FIRST;
+                }
+                else if (byte == smp_uart_continuation_header_1)
+                {
+                    decode_state = SMP_UART_DECODE_HEADER_CONTINUATION;
+                }
+
+                break;
             }
-            else
+        }
+
+        ++i;
+    }
+}
+
+void smp_uart_auterm::decode_reset_packet()
+{
+    //The reassembly buffer is kept allocated for the next packet
+    decode_packet_open = false;
+    decode_length_bytes = 0;
+    decode_packet_length = 0;
+    decode_packet_received = 0;
+    decode_crc = 0;
+}
+
+bool smp_uart_auterm::decode_quantum(uint8_t count)
+{
+    //Decodes the current base64 quantum into count (1-3) bytes and writes them directly into the reassembly buffer
+    uint8_t decoded[3];
+    uint8_t i = 0;
+    int start = decode_packet_received;
+    int crc_end;
+
+    decoded[0] = (decode_quantum_data[0] << 2) | (decode_quantum_data[1] >> 4);
+    decoded[1] = (decode_quantum_data[1] << 4) | (decode_quantum_data[2] >> 2);
+    decoded[2] = (decode_quantum_data[2] << 6) | decode_quantum_data[3];
+
+    while (i < count)
+    {
+        if (decode_length_bytes < smp_uart_length_size)
+        {
+            //Packet length is at the start of the first frame
+            decode_packet_length = (decode_packet_length << 8) | decoded[i];
+            ++decode_length_bytes;
+
+            if (decode_length_bytes == smp_uart_length_size)
             {
-                posA_other = SerialData.indexOf(0x0a, pos_other + 2);
+                if (decode_packet_length <= smp_uart_crc_size)
+                {
+                    log_error() << "Invalid packet length " << decode_packet_length;
+                    return false;
+                }
+
+                decode_packet.resize(decode_packet_length);
+                start = 0;
             }
         }
+        else if (decode_packet_received < decode_packet_length)
+        {
+            decode_packet.data()[decode_packet_received] = (char)decoded[i];
+            ++decode_packet_received;
+        }
+
+        ++i;
+    }
+
+    //Update the CRC with the newly received data, excluding the CRC itself
+    crc_end = decode_packet_length - smp_uart_crc_size;
+
+    if (decode_packet_received < crc_end)
+    {
+        crc_end = decode_packet_received;
+    }
+
+    if (crc_end > start)
+    {
+        decode_crc = crc16_itu_t(decode_crc, (const uint8_t *)decode_packet.constData() + start, (crc_end - start));
+    }
+
+    return true;
+}
+
+void smp_uart_auterm::decode_frame_end()
+{
+    //Handles the end of a frame, base64 padding may have been omitted from the final quantum
+    if (decode_quantum_count == 1)
+    {
+        log_error() << "Failed decoding base64";
+        decode_reset_packet();
+        return;
+    }
+    else if (decode_quantum_count > 1)
+    {
+        uint8_t count = decode_quantum_count - 1;
+        decode_quantum_count = 0;
+
+        if (decode_quantum(count) == false)
+        {
+            decode_reset_packet();
+            return;
+        }
     }
 
-    if (SerialData.length() > 10 && SerialData.indexOf(smp_first_header) == -1 && SerialData.indexOf(smp_continuation_header) == -1)
+    if (decode_packet_open == true && decode_length_bytes == smp_uart_length_size && decode_packet_received >= decode_packet_length)
     {
-        log_error() << "Cleared garbage data in UART SMP transport buffer";
-        SerialData.clear();
+        //We have a full packet, check the checksum
+        const uint8_t *packet = (const uint8_t *)decode_packet.constData();
+        uint16_t message_crc = ((uint16_t)packet[(decode_packet_length - 2)]) << 8;
+        message_crc |= packet[(decode_packet_length - 1)];
+
+        if (decode_crc == message_crc)
+        {
+            //Good to parse message without the CRC
+            QByteArray message = QByteArray::fromRawData(decode_packet.constData(), (decode_packet_length - smp_uart_crc_size));
+            decode_reset_packet();
+            data_received(&message);
+        }
+        else
+        {
+            //CRC failure
+            log_error() << "CRC failure, expected " << message_crc << " but got " << decode_crc;
+            decode_reset_packet();
+        }
     }
 }
 
+uint32_t smp_uart_auterm::encoded_size(uint16_t message_size)
+{
+    //The length, message and CRC are split into frames of up to 93 bytes, each base64 encoded with a header and footer
+    uint32_t raw_size = (uint32_t)message_size + smp_uart_length_size + smp_uart_crc_size;
+    uint32_t remainder = raw_size % smp_uart_frame_data_size;
+    uint32_t size = (raw_size / smp_uart_frame_data_size) * smp_uart_frame_size;
+
+    if (remainder > 0)
+    {
+        size += smp_uart_frame_overhead + ((remainder + 2) / 3) * 4;
+    }
+
+    return size;
+}
+
 smp_transport_error_t smp_uart_auterm::send(smp_message *message)
 {
     //127 bytes = 3 + base 64 message
     //base64 = 4 bytes output per 3 byte input
 
-    //Clear buffers in case there was a partial receive previously
-    cancel();
-
     if (this->raw_mode == true)
     {
+        //Clear buffers in case there was a partial receive previously, frames are not used in raw mode so there is no other way to resynchronise
+        cancel();
         emit serial_write(message->data());
         return SMP_TRANSPORT_ERROR_OK;
     }
 
-    QByteArray output;
+    //Encode all frames directly into a single buffer which is written in one go
+    const uint8_t *data = (const uint8_t *)message->data()->constData();
     uint16_t size = message->size();
-    size += 2;
-    output.append((uint8_t)((size & 0xff00) >> 8));
-    output.append((uint8_t)(size & 0xff));
-    uint16_t crc = crc16(message->data(), 0, message->size(), 0x1021, 0, true);
+    uint16_t packet_length = size + smp_uart_crc_size;
+    uint16_t crc = crc16_itu_t(0, data, size);
+    uint32_t raw_size = (uint32_t)size + smp_uart_length_size + smp_uart_crc_size;
+    uint32_t data_end = (uint32_t)size + smp_uart_length_size;
+    uint32_t pos = 0;
+    QByteArray output;
+    char *out;
 
-    QByteArray inbase;
-    inbase.append(smp_first_header);
-    int32_t pos = 0;
+    output.resize(encoded_size(size));
+    out = output.data();
 
-    while (pos < (message->size() + 1))
+    while (pos < raw_size)
     {
-        /* Chunking required */
-        int16_t chunk_size = 93 - output.length();
+        uint32_t frame_end = pos + smp_uart_frame_data_size;
+
+        if (frame_end > raw_size)
+        {
+            frame_end = raw_size;
+        }
+
+        if (pos == 0)
+        {
+            *out++ = smp_uart_first_header_1;
+            *out++ = smp_uart_first_header_2;
+        }
+        else
+        {
+            *out++ = smp_uart_continuation_header_1;
+            *out++ = smp_uart_continuation_header_2;
+        }
 
-        if ((chunk_size + pos) > message->size())
+        while (pos < frame_end)
         {
-            chunk_size = message->size() - pos;
+            uint32_t remaining = frame_end - pos;
+            uint8_t byte_1;
+            uint8_t byte_2 = 0;
+            uint8_t byte_3 = 0;
 
-            if (chunk_size == 0)
+            if (pos >= smp_uart_length_size && (pos + 3) <= data_end)
             {
-                goto end;
+                //Entirely message data
+                byte_1 = data[(pos - smp_uart_length_size)];
+                byte_2 = data[(pos - smp_uart_length_size + 1)];
+                byte_3 = data[(pos - smp_uart_length_size + 2)];
             }
-        }
+            else
+            {
+                //Includes the length or CRC
+                byte_1 = frame_byte(pos, data, size, packet_length, crc);
 
-        output.append(message->data()->mid(pos, chunk_size));
-        pos += chunk_size;
+                if (remaining > 1)
+                {
+                    byte_2 = frame_byte((pos + 1), data, size, packet_length, crc);
+                }
 
-        if (pos == message->size() && (93 - chunk_size) > 2)
-        {
-end:
-            output.append((uint8_t)((crc & 0xff00) >> 8));
-            output.append((uint8_t)(crc & 0xff));
-            pos += 2;
-        }
+                if (remaining > 2)
+                {
+                    byte_3 = frame_byte((pos + 2), data, size, packet_length, crc);
+                }
+            }
 
-        inbase.append(output.toBase64());
-        inbase.append((uint8_t)0x0a);
-        emit serial_write(&inbase);
+            *out++ = base64_characters[(byte_1 >> 2)];
+            *out++ = base64_characters[(((byte_1 & 0x03) << 4) | (byte_2 >> 4))];
+            *out++ = (remaining > 1 ? base64_characters[(((byte_2 & 0x0f) << 2) | (byte_3 >> 6))] : '=');
+            *out++ = (remaining > 2 ? base64_characters[(byte_3 & 0x3f)] : '=');
+            pos += (remaining > 3 ? 3 : remaining);
+        }
 
-        inbase.clear();
-        inbase.append(smp_continuation_header);
-        output.clear();
+        *out++ = smp_uart_frame_end;
     }
 
+    emit serial_write(&output);
+
     return SMP_TRANSPORT_ERROR_OK;
 }
 
+QString smp_uart_auterm::device_identifier()
+{
+    //The serial port is owned by the main window so the port name is not known here
+    return (this->raw_mode == true ? "uart:raw" : "uart");
+}
+
+bool smp_uart_auterm::device_identifier_is_unique()
+{
+    return false;
+}
+
 uint16_t smp_uart_auterm::max_message_data_size(uint16_t mtu)
 {
     if (this->raw_mode == false)
     {
-        float available_mtu = mtu;
-        int packets = ceil(available_mtu / 124.0);
+        //Inverse of encoded_size(): full frames, then whole base64 quanta which fit in a final partial frame
+        uint32_t remainder = mtu % smp_uart_frame_size;
+        uint32_t raw_size = (mtu / smp_uart_frame_size) * smp_uart_frame_data_size;
 
-        //Convert to number of base64 encoded bytes
-        available_mtu = available_mtu * 3.0 / 4.0;
-
-        //Remove packet length and CRC (2 bytes each)
-        available_mtu -= 4.0;
-
-        //Remove header and footer of each packet
-        available_mtu -= (float)packets * 3.0;
-
-        //Remove possible padding bytes for narrow final packets
-        if (((uint16_t)available_mtu % 93) >= 91)
+        if (remainder > smp_uart_frame_overhead)
         {
-            available_mtu -= 3.0;
+            raw_size += ((remainder - smp_uart_frame_overhead) / 4) * 3;
         }
-        else if (((uint16_t)available_mtu % 93) >= 88)
+
+        if (raw_size <= (uint32_t)(smp_uart_length_size + smp_uart_crc_size))
         {
-            available_mtu -= 1.0;
+            return 0;
         }
 
-        return (uint16_t)available_mtu;
+        return (uint16_t)(raw_size - smp_uart_length_size - smp_uart_crc_size);
     }
 
     return mtu - 8;
@@ -306,10 +532,9 @@ void smp_uart_auterm::set_raw_mode(bool raw)
 
 void smp_uart_auterm::cancel()
 {
-    this->SerialData.clear();
     this->received_data.clear();
-    this->SMPBuffer.clear();
-    this->SMPBufferActualData.clear();
-    this->SMPWaitingForContinuation = false;
-    this->waiting_packet_length = 0;
+    this->decode_state = SMP_UART_DECODE_IDLE;
+    this->decode_quantum_count = 0;
+    this->decode_padding = 0;
+    decode_reset_packet();
 }
@@ -28,6 +28,17 @@
 #include "smp_message.h"
 #include "debug_logger.h"
 
+/******************************************************************************/
+// Enum typedefs
+/******************************************************************************/
+enum smp_uart_decode_state_t {
+    SMP_UART_DECODE_IDLE,
+    SMP_UART_DECODE_HEADER_FIRST,
+    SMP_UART_DECODE_HEADER_CONTINUATION,
+    SMP_UART_DECODE_BODY,
+    SMP_UART_DECODE_SKIP_FRAME,
+};
+
 class smp_uart_auterm : public smp_transport
 {
     Q_OBJECT
@@ -37,11 +48,17 @@ public:
     ~smp_uart_auterm();
     smp_transport_error_t send(smp_message *message) override;
     uint16_t max_message_data_size(uint16_t mtu) override;
+    QString device_identifier() override;
+    bool device_identifier_is_unique() override;
     void set_raw_mode(bool raw);
     void cancel() override;
+    static uint32_t encoded_size(uint16_t message_size);
 
 private:
     void data_received(QByteArray *message);
+    void decode_reset_packet();
+    bool decode_quantum(uint8_t count);
+    void decode_frame_end();
 
 signals:
     void serial_write(QByteArray *data);
@@ -50,15 +67,21 @@ public slots:
     void serial_read(QByteArray *rec_data);
 
 private:
-    QByteArray SerialData;
     smp_message received_data;
-    QByteArray SMPBuffer;
-    QByteArray SMPBufferActualData;
-    bool SMPWaitingForContinuation = false;
-    const QByteArray smp_first_header = QByteArrayLiteral("\x06\x09");
-    const QByteArray smp_continuation_header = QByteArrayLiteral("\x04\x14");
-    uint16_t waiting_packet_length = 0;
     bool raw_mode = false;
+
+    //Incremental frame decoder state, frames are decoded as bytes arrive without buffering the encoded data
+    smp_uart_decode_state_t decode_state = SMP_UART_DECODE_IDLE;
+    bool decode_first_frame = false; //Current frame is a first (06 09) frame rather than a continuation (04 14) frame
+    uint8_t decode_quantum_data[4]; //Base64 characters (as 6-bit values) of the quantum being decoded
+    uint8_t decode_quantum_count = 0; //Number of characters in the current base64 quantum
+    uint8_t decode_padding = 0; //Number of padding characters seen in the current frame
+    bool decode_packet_open = false; //A first frame has been received and the packet is awaiting completion
+    uint8_t decode_length_bytes = 0; //Number of packet length bytes received (2 needed)
+    uint16_t decode_packet_length = 0; //Length of the packet (including CRC) from the first frame
+    QByteArray decode_packet; //Reassembly buffer for the packet, sized when the length is known
+    int decode_packet_received = 0; //Number of packet bytes written to the reassembly buffer
+    uint16_t decode_crc = 0; //CRC of the packet data received so far (excludes the CRC bytes)
 };
 
 #endif // SMP_UART_AUTERM_H
@@ -421,6 +421,16 @@ int smp_udp::set_connection_config(struct smp_udp_config_t *configuration)
     return SMP_TRANSPORT_ERROR_OK;
 }
 
+QString smp_udp::device_identifier()
+{
+    if (socket_is_connected == false)
+    {
+        return "";
+    }
+
+    return QString("udp:%1:%2").arg((socket->peerAddress().isNull() == true ? socket->peerName() : socket->peerAddress().toString()), QString::number(socket->peerPort()));
+}
+
 QString smp_udp::to_error_string(int error_code)
 {
     if (error_code == 0)
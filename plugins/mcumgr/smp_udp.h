@@ -68,6 +68,7 @@ public:
     void setup_finished();
     int set_connection_config(struct smp_udp_config_t *configuration);
     QString to_error_string(int error_code) override;
+    QString device_identifier() override;
 
 private slots:
 #if defined(PLUGIN_MCUMGR_TRANSPORT_UDP_DTLS)
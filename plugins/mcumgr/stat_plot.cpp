@@ -0,0 +1,213 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  stat_plot.cpp
+**
+** Notes:
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include "stat_plot.h"
+#include <QPainter>
+#include <QPolygonF>
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+static const int plot_margin_left = 70;
+static const int plot_margin_right = 10;
+static const int plot_margin_top = 10;
+static const int plot_margin_bottom = 20;
+
+static const Qt::GlobalColor plot_colours[] = {
+    Qt::blue,
+    Qt::red,
+    Qt::darkGreen,
+    Qt::magenta,
+    Qt::darkCyan,
+    Qt::darkYellow,
+    Qt::darkRed,
+    Qt::darkBlue,
+};
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+stat_plot::stat_plot(QWidget *parent) : QWidget(parent)
+{
+    history = nullptr;
+    plot_rate = true;
+    plot_window = 0;
+    setMinimumHeight(120);
+}
+
+void stat_plot::set_history(smp_stat_history *history_object)
+{
+    history = history_object;
+    update();
+}
+
+void stat_plot::set_series(QList<int> series)
+{
+    plot_series = series;
+    update();
+}
+
+void stat_plot::set_rate(bool enabled)
+{
+    plot_rate = enabled;
+    update();
+}
+
+void stat_plot::set_window(uint32_t window_ms)
+{
+    //0 shows all of the history
+    plot_window = window_ms;
+    update();
+}
+
+void stat_plot::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    QRect area = rect().adjusted(plot_margin_left, plot_margin_top, -plot_margin_right, -plot_margin_bottom);
+    QList<QVector<QPointF>> series_points;
+    uint32_t end;
+    uint32_t start = 0;
+    double minimum = 0.0;
+    double maximum = 0.0;
+    bool have_points = false;
+    int i = 0;
+
+    painter.fillRect(rect(), palette().base());
+
+    if (history == nullptr || plot_series.isEmpty() == true || area.width() < 2 || area.height() < 2)
+    {
+        painter.setPen(palette().color(QPalette::Text));
+        painter.drawText(rect(), Qt::AlignCenter, "Select polled counters to plot");
+        return;
+    }
+
+    end = history->now();
+
+    if (plot_window > 0 && end > plot_window)
+    {
+        start = end - plot_window;
+    }
+
+    //Decimated to one bucket per pixel, the amount drawn does not depend on how much history there is
+    while (i < plot_series.length())
+    {
+        QVector<QPointF> points;
+
+        if (plot_series.at(i) < history->series_count())
+        {
+            history->decimate(plot_series.at(i), plot_rate, start, end, (uint16_t)area.width(), &points);
+        }
+
+        for (const QPointF &point : points)
+        {
+            if (have_points == false)
+            {
+                minimum = point.y();
+                maximum = point.y();
+                have_points = true;
+            }
+            else if (point.y() < minimum)
+            {
+                minimum = point.y();
+            }
+            else if (point.y() > maximum)
+            {
+                maximum = point.y();
+            }
+        }
+
+        series_points.append(points);
+        ++i;
+    }
+
+    painter.setPen(palette().color(QPalette::Mid));
+    painter.drawRect(area);
+    painter.setPen(palette().color(QPalette::Text));
+
+    if (have_points == false || end <= start)
+    {
+        painter.drawText(area, Qt::AlignCenter, "No samples");
+        return;
+    }
+
+    if (maximum == minimum)
+    {
+        maximum += 1.0;
+        minimum = (minimum >= 1.0 ? minimum - 1.0 : 0.0);
+    }
+
+    painter.drawText(QRect(0, area.top(), plot_margin_left - 4, 16), Qt::AlignRight | Qt::AlignTop, QString::number(maximum, 'g', 6));
+    painter.drawText(QRect(0, area.bottom() - 16, plot_margin_left - 4, 16), Qt::AlignRight | Qt::AlignBottom, QString::number(minimum, 'g', 6));
+    painter.drawText(QRect(area.left(), area.bottom() + 2, area.width(), plot_margin_bottom - 2), Qt::AlignLeft | Qt::AlignTop, QString("-").append(duration_string(end - start)));
+    painter.drawText(QRect(area.left(), area.bottom() + 2, area.width(), plot_margin_bottom - 2), Qt::AlignRight | Qt::AlignTop, (plot_rate == true ? "now (per second)" : "now"));
+
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setClipRect(area);
+    i = 0;
+
+    while (i < series_points.length())
+    {
+        QPolygonF line;
+        QColor colour(plot_colours[i % (sizeof(plot_colours) / sizeof(plot_colours[0]))]);
+
+        for (const QPointF &point : series_points.at(i))
+        {
+            line.append(QPointF(area.left() + ((point.x() - start) * area.width()) / (end - start), area.bottom() - ((point.y() - minimum) * area.height()) / (maximum - minimum)));
+        }
+
+        painter.setPen(QPen(colour, 1.5));
+        painter.drawPolyline(line);
+
+        //Legend
+        if (series_points.at(i).isEmpty() == false)
+        {
+            painter.setPen(colour);
+            painter.drawText(area.left() + 4, area.top() + 14 + i * 14, QString("%1/%2").arg(history->series_group(plot_series.at(i)), history->series_counter(plot_series.at(i))));
+        }
+
+        ++i;
+    }
+}
+
+QString stat_plot::duration_string(uint32_t ms)
+{
+    if (ms < 120000)
+    {
+        return QString("%1 s").arg(QString::number(ms / 1000));
+    }
+    else if (ms < 7200000)
+    {
+        return QString("%1 min").arg(QString::number(ms / 60000));
+    }
+
+    return QString("%1 h").arg(QString::number((double)ms / 3600000.0, 'f', 1));
+}
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
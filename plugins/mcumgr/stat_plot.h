@@ -0,0 +1,64 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  stat_plot.h
+**
+** Notes:   Plots polled stat_mgmt counters from a stat history, the history
+**          is decimated to the width of the widget before drawing
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+#ifndef STAT_PLOT_H
+#define STAT_PLOT_H
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QWidget>
+#include <QList>
+#include "smp_stat_history.h"
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class stat_plot : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit stat_plot(QWidget *parent = nullptr);
+    void set_history(smp_stat_history *history_object);
+    void set_series(QList<int> series);
+    void set_rate(bool enabled);
+    void set_window(uint32_t window_ms);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    static QString duration_string(uint32_t ms);
+
+    smp_stat_history *history;
+    QList<int> plot_series;
+    bool plot_rate;
+    uint32_t plot_window;
+};
+
+#endif // STAT_PLOT_H
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/
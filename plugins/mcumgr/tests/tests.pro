@@ -0,0 +1,32 @@
+include(../../../AuTerm-includes.pri)
+
+QT -= gui
+QT += core testlib
+
+TEMPLATE = app
+
+CONFIG += console
+CONFIG += c++17
+CONFIG += testcase
+CONFIG -= app_bundle
+
+INCLUDEPATH    += ..
+TARGET          = tst_smp_uart_auterm
+
+# Run with "make check". The logger plugin is not available, debug output goes
+# to the console.
+DEFINES += SKIPPLUGIN_LOGGER
+
+SOURCES += \
+    ../crc16.cpp \
+    ../smp_message.cpp \
+    ../smp_uart_auterm.cpp \
+    tst_smp_uart_auterm.cpp
+
+HEADERS += \
+    ../crc16.h \
+    ../debug_logger.h \
+    ../smp_error.h \
+    ../smp_message.h \
+    ../smp_transport.h \
+    ../smp_uart_auterm.h
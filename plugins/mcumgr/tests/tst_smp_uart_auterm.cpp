@@ -0,0 +1,293 @@
+/******************************************************************************
+** Copyright (C) 2026 Jamie M.
+**
+** Project: AuTerm
+**
+** Module:  tst_smp_uart_auterm.cpp
+**
+** Notes:   Tests for the SMP UART transport frame size arithmetic
+**          (encoded_size() and max_message_data_size()) and the frame
+**          encoder and decoder
+**
+** License: This program is free software: you can redistribute it and/or
+**          modify it under the terms of the GNU General Public License as
+**          published by the Free Software Foundation, version 3.
+**
+**          This program is distributed in the hope that it will be useful,
+**          but WITHOUT ANY WARRANTY; without even the implied warranty of
+**          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**          GNU General Public License for more details.
+**
+**          You should have received a copy of the GNU General Public License
+**          along with this program.  If not, see http://www.gnu.org/licenses/
+**
+*******************************************************************************/
+
+/******************************************************************************/
+// Include Files
+/******************************************************************************/
+#include <QtTest>
+#include "smp_uart_auterm.h"
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+static const int frame_size_max = 127;
+static const uint16_t mtu_checked_max = 8192;
+
+/******************************************************************************/
+// Class definitions
+/******************************************************************************/
+class tst_smp_uart_auterm : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void encoded_size_data();
+    void encoded_size();
+    void max_message_data_size_data();
+    void max_message_data_size();
+    void max_message_data_size_is_largest();
+    void round_trip_data();
+    void round_trip();
+    void corrupted_frame_dropped();
+
+public slots:
+    void uart_written(QByteArray *data);
+    void message_received(smp_message *message);
+
+private:
+    static QByteArray build_message(uint16_t payload_length);
+
+    QByteArray written;
+    QList<QByteArray> received;
+};
+
+/******************************************************************************/
+// Local Functions or Private Members
+/******************************************************************************/
+QByteArray tst_smp_uart_auterm::build_message(uint16_t payload_length)
+{
+    //Read response with a payload that includes the frame header and footer bytes, which must be carried inside the base64 data
+    QByteArray message;
+    int i = 0;
+
+    message.append((char)(SMP_OP_READ_RESPONSE | (1 << 3)));
+    message.append((char)0x00);
+    message.append((char)(payload_length >> 8));
+    message.append((char)(payload_length & 0xff));
+    message.append((char)0x00);
+    message.append((char)0x01);
+    message.append((char)0x2a);
+    message.append((char)0x00);
+
+    while (i < payload_length)
+    {
+        message.append((char)((i * 7 + 0x04) & 0xff));
+        ++i;
+    }
+
+    return message;
+}
+
+void tst_smp_uart_auterm::uart_written(QByteArray *data)
+{
+    written.append(*data);
+}
+
+void tst_smp_uart_auterm::message_received(smp_message *message)
+{
+    received.append(*message->data());
+}
+
+void tst_smp_uart_auterm::encoded_size_data()
+{
+    //Each frame carries up to 93 bytes of length (2), message and CRC (2), base64 encoded (4 characters per 3 bytes,
+    //padded) plus a 2 byte header and 1 byte footer, so a full frame is 3 + 124 = 127 bytes
+    QTest::addColumn<int>("message_size");
+    QTest::addColumn<int>("expected");
+
+    QTest::newRow("empty, 4 bytes in 2 padded quanta") << 0 << 11;
+    QTest::newRow("1 byte, 5 bytes in 2 padded quanta") << 1 << 11;
+    QTest::newRow("2 bytes, 6 bytes in 2 quanta") << 2 << 11;
+    QTest::newRow("3 bytes, 7 bytes in 3 padded quanta") << 3 << 15;
+    QTest::newRow("6 bytes, 10 bytes in 4 padded quanta") << 6 << 19;
+    QTest::newRow("86 bytes, 90 bytes in 30 quanta") << 86 << 123;
+    QTest::newRow("87 bytes, 91 bytes padded to a full frame") << 87 << 127;
+    QTest::newRow("88 bytes, 92 bytes padded to a full frame") << 88 << 127;
+    QTest::newRow("89 bytes, exactly one full frame") << 89 << 127;
+    QTest::newRow("90 bytes, splits with 1 padded byte in the second frame") << 90 << 134;
+    QTest::newRow("92 bytes, splits with 3 bytes in the second frame") << 92 << 134;
+    QTest::newRow("93 bytes, splits with 4 bytes in the second frame") << 93 << 138;
+    QTest::newRow("179 bytes, second frame padded") << 179 << 250;
+    QTest::newRow("182 bytes, exactly two full frames") << 182 << 254;
+    QTest::newRow("183 bytes, splits into a third frame") << 183 << 261;
+    QTest::newRow("275 bytes, exactly three full frames") << 275 << 381;
+}
+
+void tst_smp_uart_auterm::encoded_size()
+{
+    QFETCH(int, message_size);
+    QFETCH(int, expected);
+
+    QCOMPARE(smp_uart_auterm::encoded_size((uint16_t)message_size), (uint32_t)expected);
+}
+
+void tst_smp_uart_auterm::max_message_data_size_data()
+{
+    QTest::addColumn<int>("mtu");
+    QTest::addColumn<int>("expected");
+
+    QTest::newRow("too small for length and CRC") << 0 << 0;
+    QTest::newRow("2 quanta do not fit") << 10 << 0;
+    QTest::newRow("2 quanta fit") << 11 << 2;
+    QTest::newRow("3 quanta do not fit") << 14 << 2;
+    QTest::newRow("one byte short of a full frame") << 126 << 86;
+    QTest::newRow("one full frame") << 127 << 89;
+    QTest::newRow("partial second frame too small for a quantum") << 133 << 89;
+    QTest::newRow("second frame with 1 quantum") << 134 << 92;
+    QTest::newRow("one byte short of two full frames") << 253 << 179;
+    QTest::newRow("two full frames") << 254 << 182;
+    QTest::newRow("two full frames and frame overhead only") << 257 << 182;
+    QTest::newRow("three full frames") << 381 << 275;
+    QTest::newRow("default 512 byte MTU") << 512 << 368;
+}
+
+void tst_smp_uart_auterm::max_message_data_size()
+{
+    QFETCH(int, mtu);
+    QFETCH(int, expected);
+
+    smp_uart_auterm uart;
+
+    QCOMPARE(uart.max_message_data_size((uint16_t)mtu), (uint16_t)expected);
+}
+
+void tst_smp_uart_auterm::max_message_data_size_is_largest()
+{
+    //max_message_data_size() is the inverse of encoded_size(): the size returned fits the MTU and one byte more does not
+    smp_uart_auterm uart;
+    uint16_t mtu = 0;
+
+    while (mtu <= mtu_checked_max)
+    {
+        uint16_t size = uart.max_message_data_size(mtu);
+
+        if (size > 0)
+        {
+            QVERIFY2(smp_uart_auterm::encoded_size(size) <= mtu, qPrintable(QString("MTU %1").arg(mtu)));
+        }
+
+        QVERIFY2(smp_uart_auterm::encoded_size(size + 1) > mtu, qPrintable(QString("MTU %1").arg(mtu)));
+        ++mtu;
+    }
+}
+
+void tst_smp_uart_auterm::round_trip_data()
+{
+    QTest::addColumn<int>("payload_length");
+    QTest::addColumn<int>("read_size");
+
+    //Message sizes are the payload plus the 8 byte header, around the frame boundaries of the table above
+    QTest::newRow("header only") << 0 << 0;
+    QTest::newRow("1 full frame") << 81 << 0;
+    QTest::newRow("1 full frame, read 1 byte at a time") << 81 << 1;
+    QTest::newRow("split after 1 byte") << 82 << 0;
+    QTest::newRow("split after 1 byte, read 1 byte at a time") << 82 << 1;
+    QTest::newRow("2 full frames") << 174 << 0;
+    QTest::newRow("split into a third frame, read 5 bytes at a time") << 175 << 5;
+    QTest::newRow("many frames, read 127 bytes at a time") << 1000 << 127;
+    QTest::newRow("many frames, read 128 bytes at a time") << 1000 << 128;
+}
+
+void tst_smp_uart_auterm::round_trip()
+{
+    QFETCH(int, payload_length);
+    QFETCH(int, read_size);
+
+    smp_uart_auterm encoder;
+    smp_uart_auterm decoder;
+    smp_message message;
+    QByteArray input = build_message((uint16_t)payload_length);
+    QByteArray stream;
+    int pos = 0;
+
+    written.clear();
+    received.clear();
+    connect(&encoder, SIGNAL(serial_write(QByteArray*)), this, SLOT(uart_written(QByteArray*)));
+    connect(&decoder, SIGNAL(receive_waiting(smp_message*)), this, SLOT(message_received(smp_message*)));
+
+    message.append(input);
+    QCOMPARE(encoder.send(&message), SMP_TRANSPORT_ERROR_OK);
+    QCOMPARE((uint32_t)written.length(), smp_uart_auterm::encoded_size((uint16_t)input.length()));
+
+    //Every frame starts with a first or continuation header, ends with a newline and fits the maximum frame size
+    while (pos < written.length())
+    {
+        int end = written.indexOf('\n', pos);
+
+        QVERIFY(end > pos);
+        QVERIFY((end - pos + 1) <= frame_size_max);
+
+        if (pos == 0)
+        {
+            QCOMPARE(written.mid(pos, 2), QByteArray("\x06\x09"));
+        }
+        else
+        {
+            QCOMPARE(written.mid(pos, 2), QByteArray("\x04\x14"));
+        }
+
+        pos = end + 1;
+    }
+
+    //Terminal output before the frames is not SMP data and is skipped
+    stream = QByteArray("boot> ").append(written);
+    pos = 0;
+
+    while (pos < stream.length())
+    {
+        QByteArray chunk = (read_size > 0 ? stream.mid(pos, read_size) : stream.mid(pos));
+
+        decoder.serial_read(&chunk);
+        pos += chunk.length();
+    }
+
+    QCOMPARE(received.length(), 1);
+    QCOMPARE(received.at(0), input);
+}
+
+void tst_smp_uart_auterm::corrupted_frame_dropped()
+{
+    //A changed character fails the CRC check, the next packet is still received
+    smp_uart_auterm encoder;
+    smp_uart_auterm decoder;
+    smp_message message;
+    QByteArray input = build_message(100);
+    QByteArray corrupted;
+
+    written.clear();
+    received.clear();
+    connect(&encoder, SIGNAL(serial_write(QByteArray*)), this, SLOT(uart_written(QByteArray*)));
+    connect(&decoder, SIGNAL(receive_waiting(smp_message*)), this, SLOT(message_received(smp_message*)));
+
+    message.append(input);
+    encoder.send(&message);
+    corrupted = written;
+    corrupted[20] = (corrupted.at(20) == 'A' ? 'B' : 'A');
+
+    decoder.serial_read(&corrupted);
+    QCOMPARE(received.length(), 0);
+
+    decoder.serial_read(&written);
+    QCOMPARE(received.length(), 1);
+    QCOMPARE(received.at(0), input);
+}
+
+QTEST_GUILESS_MAIN(tst_smp_uart_auterm)
+
+#include "tst_smp_uart_auterm.moc"
+
+/******************************************************************************/
+// END OF FILE
+/******************************************************************************/